@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/collision/ChCollisionModel.h"
+#include "chrono/core/ChGlobal.h"
 #include "chrono/physics/ChBody.h"
 
 namespace chrono {
@@ -24,7 +25,8 @@ namespace collision {
 static double default_model_envelope = 0.03;
 static double default_safe_margin = 0.01;
 
-ChCollisionModel::ChCollisionModel() : mcontactable(nullptr), family_group(1), family_mask(0x7FFF) {
+ChCollisionModel::ChCollisionModel()
+    : mcontactable(nullptr), m_identifier(GetUniqueIntID()), family_group(1), family_mask(0x7FFF) {
     model_envelope = (float)default_model_envelope;
     model_safe_margin = (float)default_safe_margin;
 }
@@ -57,6 +57,11 @@ class ChApi ChCollisionModel {
     /// Return the type of this collision model.
     virtual ChCollisionSystemType GetType() const = 0;
 
+    /// Return the unique identifier of this collision model.
+    /// Identifiers are assigned at construction and never reused, so they remain valid keys for data persisting
+    /// across collision passes even after the model is destroyed.
+    int GetIdentifier() const { return m_identifier; }
+
     /// Delete all inserted geometries.
     /// Addition of collision shapes must be done between calls to ClearModel() and BuildModel().
     /// This function must be invoked before adding geometric collision shapes.
@@ -424,6 +429,7 @@ class ChApi ChCollisionModel {
     float model_envelope;         ///< Maximum envelope: surrounding volume from surface to the exterior
     float model_safe_margin;      ///< Maximum margin value to be used for fast penetration contact detection
     ChContactable* mcontactable;  ///< Pointer to the contactable object
+    int m_identifier;             ///< unique model identifier
 
     short int family_group;  ///< Collision family group
     short int family_mask;   ///< Collision family mask
@@ -44,16 +44,25 @@ void ChCollisionSystemChrono::SetEnvelope(double envelope) {
 void ChCollisionSystemChrono::SetBroadphaseGridResolution(const ChVector<int>& num_bins) {
     broadphase.grid_resolution = vec3(num_bins.x(), num_bins.y(), num_bins.z());
     broadphase.grid_type = ChBroadphase::GridType::FIXED_RESOLUTION;
+    broadphase.inc_valid = false;
 }
 
 void ChCollisionSystemChrono::SetBroadphaseGridSize(const ChVector<>& bin_size) {
     broadphase.bin_size = real3(bin_size.x(), bin_size.y(), bin_size.z());
     broadphase.grid_type = ChBroadphase::GridType::FIXED_RESOLUTION;
+    broadphase.inc_valid = false;
 }
 
 void ChCollisionSystemChrono::SetBroadphaseGridDensity(double density) {
     broadphase.grid_density = real(density);
     broadphase.grid_type = ChBroadphase::GridType::FIXED_DENSITY;
+    broadphase.inc_valid = false;
+}
+
+void ChCollisionSystemChrono::SetBroadphaseIncremental(bool val, double margin) {
+    broadphase.incremental = val;
+    broadphase.fat_margin = real(margin);
+    broadphase.inc_valid = false;
 }
 
 void ChCollisionSystemChrono::SetNarrowphaseAlgorithm(ChNarrowphase::Algorithm algorithm) {
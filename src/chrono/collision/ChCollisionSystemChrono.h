@@ -67,6 +67,14 @@ class ChApi ChCollisionSystemChrono : public ChCollisionSystem {
     /// By default, a fixed number of bins is used (see SetBroadphaseGridResolution).
     void SetBroadphaseGridDensity(double density);
 
+    /// Enable or disable the incremental broadphase (default: false).
+    /// In incremental mode, the broadphase grid and the list of candidate shape pairs are kept between steps. Only the
+    /// shapes whose AABB left their AABB fattened by the specified margin are re-binned and have their candidate pairs
+    /// regenerated, and pairs of shapes on sleeping or fixed bodies are never tested. This is beneficial for systems in
+    /// which only a small fraction of the shapes move at each step. A larger margin results in fewer updates, but more
+    /// candidate pairs. The grid resolution (see SetBroadphaseGridResolution) is evaluated only when the grid is rebuilt.
+    void SetBroadphaseIncremental(bool val, double margin);
+
     /// Set the narrowphase algorithm (default: ChNarrowphase::Algorithm::HYBRID).
     /// The Chrono collision detection system provides several analytical collision detection algorithms, for particular
     /// pairs of shapes (see ChNarrowphasePRIMS). For general convex shapes, the collision system relies on the
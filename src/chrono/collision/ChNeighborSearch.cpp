@@ -0,0 +1,215 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "chrono/collision/ChNeighborSearch.h"
+#include "chrono/utils/ChOpenMP.h"
+
+namespace chrono {
+namespace collision {
+
+// Max number of cells per direction (Morton codes use 21 bits per coordinate)
+static const int MAX_GRID_DIM = (1 << 21) - 1;
+
+ChNeighborSearch::ChNeighborSearch()
+    : m_skin(0),
+      m_num_threads(ChOMP::GetNumProcs()),
+      m_num_points(0),
+      m_radius(0),
+      m_cell_size(1),
+      m_grid_min(VNULL),
+      m_num_rebuilds(0),
+      m_num_updates(0) {
+    m_grid_dim[0] = m_grid_dim[1] = m_grid_dim[2] = 1;
+    m_nbr_start.push_back(0);
+    m_timer_rebuild.reset();
+}
+
+void ChNeighborSearch::SetSkin(double skin) {
+    skin = std::max(0.0, skin);
+    if (skin != m_skin)
+        Reset();
+    m_skin = skin;
+}
+
+void ChNeighborSearch::SetNumThreads(int num_threads) {
+    m_num_threads = std::max(1, num_threads);
+}
+
+uint64_t ChNeighborSearch::MortonCode(uint32_t x, uint32_t y, uint32_t z) {
+    auto spread = [](uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | (v << 32)) & 0x1f00000000ffffULL;
+        v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+        v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+        v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+        v = (v | (v << 2)) & 0x1249249249249249ULL;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1) | (spread(z) << 2);
+}
+
+int ChNeighborSearch::CellCoord(const ChVector<>& p, int dir) const {
+    int c = (int)std::floor((p[dir] - m_grid_min[dir]) / m_cell_size);
+    return std::min(std::max(c, 0), m_grid_dim[dir] - 1);
+}
+
+void ChNeighborSearch::FindAdjacentCells(size_t cell, int* adj_cells, int& num_adj) const {
+    const ChVector<>& p = m_sorted_pos[m_cell_start[cell]];
+    int c[3] = {CellCoord(p, 0), CellCoord(p, 1), CellCoord(p, 2)};
+    num_adj = 0;
+    for (int ix = std::max(c[0] - 1, 0); ix <= std::min(c[0] + 1, m_grid_dim[0] - 1); ix++) {
+        for (int iy = std::max(c[1] - 1, 0); iy <= std::min(c[1] + 1, m_grid_dim[1] - 1); iy++) {
+            for (int iz = std::max(c[2] - 1, 0); iz <= std::min(c[2] + 1, m_grid_dim[2] - 1); iz++) {
+                uint64_t code = MortonCode(ix, iy, iz);
+                auto it = std::lower_bound(m_cell_code.begin(), m_cell_code.end(), code);
+                if (it != m_cell_code.end() && *it == code)
+                    adj_cells[num_adj++] = (int)(it - m_cell_code.begin());
+            }
+        }
+    }
+}
+
+bool ChNeighborSearch::IsValid(const std::vector<ChVector<>>& points, double radius) const {
+    if (m_num_points == 0 || points.size() != m_num_points || radius > m_radius)
+        return false;
+
+    // The list remains valid as long as no point moved more than half the skin
+    // (two points approaching each other cannot have covered more than the skin).
+    double max_disp2 = 0.25 * m_skin * m_skin;
+    int num_points = (int)m_num_points;
+    bool moved = false;
+#pragma omp parallel for num_threads(m_num_threads) reduction(|| : moved)
+    for (int i = 0; i < num_points; i++) {
+        moved = moved || (points[i] - m_ref_pos[i]).Length2() > max_disp2;
+    }
+
+    return !moved;
+}
+
+bool ChNeighborSearch::Update(const std::vector<ChVector<>>& points, double radius) {
+    m_num_updates++;
+    if (IsValid(points, radius))
+        return false;
+
+    m_timer_rebuild.start();
+    Rebuild(points, radius);
+    m_timer_rebuild.stop();
+    m_num_rebuilds++;
+
+    return true;
+}
+
+void ChNeighborSearch::Rebuild(const std::vector<ChVector<>>& points, double radius) {
+    int num_points = (int)points.size();
+    m_num_points = points.size();
+    m_radius = radius;
+    m_ref_pos = points;
+
+    m_nbr_start.assign(num_points + 1, 0);
+    m_nbrs.clear();
+    m_order.clear();
+    m_sorted_pos.clear();
+    m_cell_code.clear();
+    m_cell_start.clear();
+    if (num_points == 0)
+        return;
+
+    // Grid covering the bounding box of all points, with cell size equal to the search distance
+    ChVector<> pmin = points[0];
+    ChVector<> pmax = points[0];
+    for (const auto& p : points) {
+        pmin = Vmin(pmin, p);
+        pmax = Vmax(pmax, p);
+    }
+    double cutoff = radius + m_skin;
+    double extent = (pmax - pmin).LengthInf();
+    m_cell_size = std::max(cutoff, extent / (MAX_GRID_DIM - 1));
+    if (m_cell_size <= 0)
+        m_cell_size = 1;
+    m_grid_min = pmin;
+    for (int dir = 0; dir < 3; dir++)
+        m_grid_dim[dir] = (int)std::floor((pmax[dir] - pmin[dir]) / m_cell_size) + 1;
+
+    // Sort points by the Morton code of their cell
+    std::vector<std::pair<uint64_t, unsigned int>> codes(num_points);
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_points; i++) {
+        const ChVector<>& p = points[i];
+        codes[i].first = MortonCode(CellCoord(p, 0), CellCoord(p, 1), CellCoord(p, 2));
+        codes[i].second = (unsigned int)i;
+    }
+    std::sort(codes.begin(), codes.end());
+
+    m_order.resize(num_points);
+    m_sorted_pos.resize(num_points);
+    for (int k = 0; k < num_points; k++) {
+        m_order[k] = codes[k].second;
+        m_sorted_pos[k] = points[codes[k].second];
+        if (k == 0 || codes[k].first != codes[k - 1].first) {
+            m_cell_code.push_back(codes[k].first);
+            m_cell_start.push_back((unsigned int)k);
+        }
+    }
+    m_cell_start.push_back((unsigned int)num_points);
+
+    // Two passes over the grid cells: count the neighbors, then fill the lists.
+    // The adjacent cells are looked up once per cell and shared by all points in the cell.
+    int num_cells = (int)m_cell_code.size();
+    std::vector<int> adj_cells(27 * num_cells);
+    std::vector<int> num_adj(num_cells);
+    double cutoff2 = cutoff * cutoff;
+
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 64)
+    for (int cell = 0; cell < num_cells; cell++) {
+        int* adj = &adj_cells[27 * cell];
+        FindAdjacentCells(cell, adj, num_adj[cell]);
+        for (unsigned int k = m_cell_start[cell]; k < m_cell_start[cell + 1]; k++) {
+            const ChVector<>& pk = m_sorted_pos[k];
+            unsigned int count = 0;
+            for (int a = 0; a < num_adj[cell]; a++) {
+                for (unsigned int l = m_cell_start[adj[a]]; l < m_cell_start[adj[a] + 1]; l++) {
+                    if (l != k && (m_sorted_pos[l] - pk).Length2() <= cutoff2)
+                        count++;
+                }
+            }
+            m_nbr_start[m_order[k] + 1] = count;
+        }
+    }
+
+    for (int i = 0; i < num_points; i++)
+        m_nbr_start[i + 1] += m_nbr_start[i];
+    m_nbrs.resize(m_nbr_start[num_points]);
+
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 64)
+    for (int cell = 0; cell < num_cells; cell++) {
+        const int* adj = &adj_cells[27 * cell];
+        for (unsigned int k = m_cell_start[cell]; k < m_cell_start[cell + 1]; k++) {
+            const ChVector<>& pk = m_sorted_pos[k];
+            unsigned int* nbrs = m_nbrs.data() + m_nbr_start[m_order[k]];
+            for (int a = 0; a < num_adj[cell]; a++) {
+                for (unsigned int l = m_cell_start[adj[a]]; l < m_cell_start[adj[a] + 1]; l++) {
+                    if (l != k && (m_sorted_pos[l] - pk).Length2() <= cutoff2)
+                        *nbrs++ = m_order[l];
+                }
+            }
+        }
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,129 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#ifndef CH_NEIGHBOR_SEARCH_H
+#define CH_NEIGHBOR_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup chrono_collision
+/// @{
+
+/// Fixed-radius neighbor search for clouds of points (e.g. SPH or meshless FEA nodes).
+/// Points are binned in a uniform grid with cell size equal to the search radius plus a Verlet skin.
+/// Only non-empty cells are stored, identified by their Morton (Z-order) code and sorted, so that
+/// points in nearby cells are also close in memory.
+/// The result is a contiguous (CSR) list of neighbors for each point. Each list is symmetric, i.e. if j
+/// is a neighbor of i then i is a neighbor of j, so that per-point quantities can be gathered in parallel
+/// without write conflicts. The list is rebuilt only when a point has moved more than half the skin since
+/// the last build; otherwise the existing list remains a superset of all pairs within the search radius.
+class ChApi ChNeighborSearch {
+  public:
+    ChNeighborSearch();
+    ~ChNeighborSearch() {}
+
+    /// Set the Verlet skin (default: 0). The list contains all pairs closer than radius + skin.
+    /// A larger skin means fewer rebuilds, but longer neighbor lists.
+    void SetSkin(double skin);
+    double GetSkin() const { return m_skin; }
+
+    /// Set the number of OpenMP threads used to build the list (default: number of processors).
+    void SetNumThreads(int num_threads);
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Update the neighbor list for the given points, using the specified search radius.
+    /// The list is rebuilt only if the number of points changed, if the radius increased, or if any point
+    /// moved more than half the skin since the last build. Return true if the list was rebuilt.
+    bool Update(const std::vector<ChVector<>>& points, double radius);
+
+    /// Force a rebuild of the neighbor list at the next call to Update().
+    void Reset() { m_num_points = 0; }
+
+    /// Get the number of points in the current list.
+    size_t GetNumPoints() const { return m_num_points; }
+
+    /// Get the number of neighbors of the i-th point.
+    unsigned int GetNumNeighbors(size_t i) const { return m_nbr_start[i + 1] - m_nbr_start[i]; }
+
+    /// Get the indices of the neighbors of the i-th point (contiguous, GetNumNeighbors(i) entries).
+    const unsigned int* GetNeighbors(size_t i) const { return m_nbrs.data() + m_nbr_start[i]; }
+
+    /// Get the number of distinct neighbor pairs (i,j) in the current list.
+    size_t GetNumPairs() const { return m_nbrs.size() / 2; }
+
+    /// Get the point indices sorted by grid cell (Morton order) at the last rebuild.
+    /// Traversing points in this order improves memory locality.
+    const std::vector<unsigned int>& GetSortedOrder() const { return m_order; }
+
+    /// Get the number of list rebuilds so far.
+    unsigned int GetNumRebuilds() const { return m_num_rebuilds; }
+
+    /// Get the number of calls to Update() so far.
+    unsigned int GetNumUpdates() const { return m_num_updates; }
+
+    /// Get the cumulative time spent in list rebuilds (seconds).
+    double GetTimeRebuild() const { return m_timer_rebuild.GetTimeSeconds(); }
+
+  private:
+    /// Check whether the current list is still valid for the given points and radius.
+    bool IsValid(const std::vector<ChVector<>>& points, double radius) const;
+
+    /// Bin the points in grid cells and rebuild the neighbor list.
+    void Rebuild(const std::vector<ChVector<>>& points, double radius);
+
+    /// Find the non-empty cells adjacent to the specified cell (including itself, at most 27).
+    void FindAdjacentCells(size_t cell, int* adj_cells, int& num_adj) const;
+
+    /// Get the grid coordinate of the cell containing the given point, along the specified direction.
+    int CellCoord(const ChVector<>& p, int dir) const;
+
+    /// Interleave the bits of the three cell coordinates (21 bits each).
+    static uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z);
+
+    double m_skin;                           ///< Verlet skin
+    int m_num_threads;                       ///< number of OpenMP threads
+
+    size_t m_num_points;                     ///< number of points at last rebuild
+    double m_radius;                         ///< search radius at last rebuild
+    double m_cell_size;                      ///< grid cell size
+    ChVector<> m_grid_min;                   ///< grid origin
+    int m_grid_dim[3];                       ///< number of cells in each direction
+
+    std::vector<ChVector<>> m_ref_pos;       ///< point positions at last rebuild
+    std::vector<unsigned int> m_order;       ///< point indices, sorted by cell Morton code
+    std::vector<ChVector<>> m_sorted_pos;    ///< point positions, sorted by cell Morton code
+    std::vector<uint64_t> m_cell_code;       ///< Morton codes of non-empty cells (sorted)
+    std::vector<unsigned int> m_cell_start;  ///< start of each non-empty cell in m_order (plus end marker)
+    std::vector<unsigned int> m_nbr_start;   ///< start of each point's neighbors in m_nbrs (plus end marker)
+    std::vector<unsigned int> m_nbrs;        ///< concatenated neighbor lists
+
+    unsigned int m_num_rebuilds;
+    unsigned int m_num_updates;
+    ChTimer<double> m_timer_rebuild;
+};
+
+/// @} chrono_collision
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
@@ -39,6 +39,14 @@ ChBroadphase::ChBroadphase()
       grid_resolution(vec3(10, 10, 10)),
       bin_size(real3(1, 1, 1)),
       grid_density(5),
+      incremental(false),
+      fat_margin(0),
+      inc_valid(false),
+      inc_grid_type(GridType::FIXED_RESOLUTION),
+      inc_grid_resolution(vec3(0, 0, 0)),
+      inc_bin_size(real3(0, 0, 0)),
+      inc_grid_density(0),
+      inc_box_size(real3(0, 0, 0)),
       cd_data(nullptr) {}
 
 // -----------------------------------------------------------------------------
@@ -211,6 +219,14 @@ void ChBroadphase::ComputeTopLevelResolution() {
 
 // Use spatial subdivision to detect the list of POSSIBLE collisions
 void ChBroadphase::Process() {
+    // The incremental mode only applies to rigid shapes
+    if (incremental && cd_data->num_rigid_shapes != 0 && cd_data->state_data.num_fluid_bodies == 0) {
+        IncrementalBroadphase();
+        cd_data->num_rigid_contacts = cd_data->num_possible_collisions;
+        return;
+    }
+    inc_valid = false;
+
     // Compute overall AABB and then offset all AABBs
     DetermineBoundingBox();
     OffsetAABB();
@@ -344,5 +360,426 @@ void ChBroadphase::OneLevelBroadphase() {
     }
 }
 
+// -----------------------------------------------------------------------------
+
+// Check if the AABB (Amin, Amax) is contained in the AABB (Bmin, Bmax).
+static inline bool inside(const real3& Amin, const real3& Amax, const real3& Bmin, const real3& Bmax) {
+    return (Bmin.x <= Amin.x && Amax.x <= Bmax.x) && (Bmin.y <= Amin.y && Amax.y <= Bmax.y) &&
+           (Bmin.z <= Amin.z && Amax.z <= Bmax.z);
+}
+
+// Range of grid bins intersected by the AABB (Amin, Amax), clamped to the grid.
+static inline void bin_range(const real3& Amin,
+                             const real3& Amax,
+                             const real3& origin,
+                             const real3& inv_bin_size,
+                             const vec3& bins_per_axis,
+                             vec3& gmin,
+                             vec3& gmax) {
+    vec3 top = bins_per_axis - vec3(1, 1, 1);
+    gmin = Clamp(HashMin(Amin - origin, inv_bin_size), vec3(0, 0, 0), top);
+    gmax = Clamp(HashMax(Amax - origin, inv_bin_size), gmin, top);
+}
+
+// Incremental broadphase.
+// The grid and the list of candidate pairs (shape pairs with overlapping fattened AABBs) are kept between calls. Only
+// shapes whose AABB left their fattened AABB (or whose body was re-activated) are re-binned and have their candidate
+// pairs regenerated. Candidate pairs between shapes on inactive (sleeping or fixed) bodies are never generated. The
+// grid is rebuilt if the number of shapes or the grid parameters change, if the overall AABB (or the fattened AABB of
+// an updated shape) leaves the grid domain, or if the overall AABB shrinks to less than half its size at the last
+// rebuild in some direction (the grid would then be too coarse).
+void ChBroadphase::IncrementalBroadphase() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const std::vector<short2>& fam_data = cd_data->shape_data.fam_rigid;
+
+    const std::vector<char>& obj_active = *cd_data->state_data.active_rigid;
+    const std::vector<char>& obj_collide = *cd_data->state_data.collide_rigid;
+
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+    std::vector<long long>& pair_shapeIDs = cd_data->pair_shapeIDs;
+
+    const int num_shapes = cd_data->num_rigid_shapes;
+    uint& num_possible_collisions = cd_data->num_possible_collisions;
+
+    // Compute overall AABB (overwritten below by the grid domain)
+    DetermineBoundingBox();
+
+    bool rebuild = !inc_valid || fat_min.size() != (size_t)num_shapes;
+
+    if (!rebuild) {
+        const real3& box_min = cd_data->min_bounding_point;
+        const real3& box_max = cd_data->max_bounding_point;
+        real3 box_size = box_max - box_min;
+        bool grid_changed = grid_type != inc_grid_type;
+        switch (grid_type) {
+            case GridType::FIXED_RESOLUTION:
+                grid_changed |= grid_resolution.x != inc_grid_resolution.x ||
+                                grid_resolution.y != inc_grid_resolution.y ||
+                                grid_resolution.z != inc_grid_resolution.z;
+                break;
+            case GridType::FIXED_BIN_SIZE:
+                grid_changed |= !(bin_size == inc_bin_size);
+                break;
+            case GridType::FIXED_DENSITY:
+                grid_changed |= grid_density != inc_grid_density;
+                break;
+        }
+        rebuild = grid_changed || !inside(box_min, box_max, inc_min, inc_max) ||
+                  box_size.x < real(0.5) * inc_box_size.x || box_size.y < real(0.5) * inc_box_size.y ||
+                  box_size.z < real(0.5) * inc_box_size.z;
+    }
+
+    // Flag shapes whose AABB left their fattened AABB or whose body was re-activated.
+    // Binned shapes which are no longer associated with a body (e.g., removed from the system) are also flagged, so
+    // that they are removed from the grid and their candidate pairs are discarded.
+    std::vector<uint> updated;
+    std::vector<uint> removed;
+    if (!rebuild) {
+        moved.resize(num_shapes);
+#pragma omp parallel for
+        for (int i = 0; i < num_shapes; i++) {
+            uint body = obj_data_id[i];
+            if (body == UINT_MAX) {
+                moved[i] = fat_binned[i];
+                continue;
+            }
+            moved[i] = !fat_binned[i] || !inside(aabb_min[i], aabb_max[i], fat_min[i], fat_max[i]) ||
+                       (obj_active[body] && !fat_active[i]);
+            fat_active[i] = obj_active[body];
+        }
+
+        for (int i = 0; i < num_shapes; i++) {
+            if (!moved[i])
+                continue;
+            if (obj_data_id[i] == UINT_MAX) {
+                removed.push_back(i);
+                continue;
+            }
+            // Rebuild if the new fattened AABB of a colliding shape is not contained in the grid domain
+            if (obj_collide[obj_data_id[i]] &&
+                !inside(aabb_min[i] - fat_margin, aabb_max[i] + fat_margin, inc_min, inc_max)) {
+                rebuild = true;
+                break;
+            }
+            updated.push_back(i);
+        }
+    }
+
+    if (rebuild) {
+        IncrementalRebuild();
+    } else if (!updated.empty() || !removed.empty()) {
+        const vec3& bins_per_axis = cd_data->bins_per_axis;
+        const real3& inv_bin_size = cd_data->inv_bin_size;
+
+        // Bins modified in this call
+        std::vector<uint> dirty;
+
+        auto unbin = [&](uint s) {
+            if (!fat_binned[s])
+                return;
+            vec3 gmin, gmax;
+            bin_range(fat_min[s], fat_max[s], inc_min, inv_bin_size, bins_per_axis, gmin, gmax);
+            for (int z = gmin.z; z <= gmax.z; z++) {
+                for (int y = gmin.y; y <= gmax.y; y++) {
+                    for (int x = gmin.x; x <= gmax.x; x++) {
+                        uint b = Hash_Index(vec3(x, y, z), bins_per_axis);
+                        auto& bin = bin_shapes[b];
+                        auto it = std::find(bin.begin(), bin.end(), s);
+                        if (it != bin.end()) {
+                            *it = bin.back();
+                            bin.pop_back();
+                            dirty.push_back(b);
+                        }
+                    }
+                }
+            }
+            fat_binned[s] = 0;
+        };
+
+        // Remove the shapes without a body from the grid
+        for (auto s : removed)
+            unbin(s);
+
+        // Move the updated shapes to the bins intersected by their new fattened AABB
+        for (auto s : updated) {
+            unbin(s);
+
+            fat_min[s] = aabb_min[s] - fat_margin;
+            fat_max[s] = aabb_max[s] + fat_margin;
+
+            vec3 gmin, gmax;
+            bin_range(fat_min[s], fat_max[s], inc_min, inv_bin_size, bins_per_axis, gmin, gmax);
+            for (int z = gmin.z; z <= gmax.z; z++) {
+                for (int y = gmin.y; y <= gmax.y; y++) {
+                    for (int x = gmin.x; x <= gmax.x; x++) {
+                        uint b = Hash_Index(vec3(x, y, z), bins_per_axis);
+                        bin_shapes[b].push_back(s);
+                        dirty.push_back(b);
+                    }
+                }
+            }
+            fat_binned[s] = 1;
+        }
+
+        // Discard the candidate pairs of updated and removed shapes and generate new ones
+        candidate_pairs.erase(std::remove_if(candidate_pairs.begin(), candidate_pairs.end(),
+                                             [this](long long p) {
+                                                 return moved[(uint)(p >> 32)] || moved[(uint)(p & 0xffffffff)];
+                                             }),
+                              candidate_pairs.end());
+        IncrementalPairs(updated);
+
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        IncrementalBins(dirty);
+    }
+
+    // Use the grid domain as overall AABB and offset all AABBs
+    cd_data->min_bounding_point = inc_min;
+    cd_data->max_bounding_point = inc_max;
+    cd_data->global_origin = inc_min;
+    OffsetAABB();
+
+    // Extract the candidate pairs with overlapping shape AABBs
+    const int num_candidates = (int)candidate_pairs.size();
+    std::vector<uint> pair_index(num_candidates + 1);
+    pair_index[num_candidates] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_candidates; i++) {
+        uint shapeA = (uint)(candidate_pairs[i] >> 32);
+        uint shapeB = (uint)(candidate_pairs[i] & 0xffffffff);
+        uint bodyA = obj_data_id[shapeA];
+        uint bodyB = obj_data_id[shapeB];
+        if (bodyA == UINT_MAX || bodyB == UINT_MAX) {
+            pair_index[i] = 0;
+            continue;
+        }
+        pair_index[i] = obj_collide[bodyA] != 0 && obj_collide[bodyB] != 0 &&
+                        (obj_active[bodyA] || obj_active[bodyB]) && collide(fam_data[shapeA], fam_data[shapeB]) &&
+                        overlap(aabb_min[shapeA], aabb_max[shapeA], aabb_min[shapeB], aabb_max[shapeB]);
+    }
+
+    Thrust_Exclusive_Scan(pair_index);
+    num_possible_collisions = pair_index.back();
+    pair_shapeIDs.resize(num_possible_collisions);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_candidates; i++) {
+        if (pair_index[i + 1] != pair_index[i])
+            pair_shapeIDs[pair_index[i]] = candidate_pairs[i];
+    }
+}
+
+// Set up the grid, bin all shapes, and generate all candidate pairs.
+void ChBroadphase::IncrementalRebuild() {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+    const std::vector<char>& obj_active = *cd_data->state_data.active_rigid;
+
+    const std::vector<real3>& aabb_min = cd_data->aabb_min;
+    const std::vector<real3>& aabb_max = cd_data->aabb_max;
+
+    const int num_shapes = cd_data->num_rigid_shapes;
+
+    // Grid domain: overall AABB, inflated to accommodate the fattened AABBs and some further motion
+    real3 size = cd_data->max_bounding_point - cd_data->min_bounding_point;
+    inc_box_size = size;
+    inc_grid_type = grid_type;
+    inc_grid_resolution = grid_resolution;
+    inc_bin_size = bin_size;
+    inc_grid_density = grid_density;
+    inc_min = cd_data->min_bounding_point - fat_margin - real(0.1) * size;
+    inc_max = cd_data->max_bounding_point + fat_margin + real(0.1) * size;
+
+    cd_data->min_bounding_point = inc_min;
+    cd_data->max_bounding_point = inc_max;
+    cd_data->global_origin = inc_min;
+    ComputeTopLevelResolution();
+
+    const vec3& bins_per_axis = cd_data->bins_per_axis;
+    const real3& inv_bin_size = cd_data->inv_bin_size;
+    cd_data->num_bins = bins_per_axis.x * bins_per_axis.y * bins_per_axis.z;
+
+    // Fattened shape AABBs
+    fat_min.resize(num_shapes);
+    fat_max.resize(num_shapes);
+    fat_active.resize(num_shapes);
+    fat_binned.resize(num_shapes);
+    moved.assign(num_shapes, 1);
+
+    std::vector<uint> shapes;
+    for (int i = 0; i < num_shapes; i++) {
+        fat_min[i] = aabb_min[i] - fat_margin;
+        fat_max[i] = aabb_max[i] + fat_margin;
+        fat_active[i] = 0;
+        fat_binned[i] = 0;
+        if (obj_data_id[i] == UINT_MAX)
+            continue;
+        fat_active[i] = obj_active[obj_data_id[i]];
+        fat_binned[i] = 1;
+        shapes.push_back(i);
+    }
+
+    // Bin all shapes
+    bin_shapes.assign(cd_data->num_bins, std::vector<uint>());
+    for (auto s : shapes) {
+        vec3 gmin, gmax;
+        bin_range(fat_min[s], fat_max[s], inc_min, inv_bin_size, bins_per_axis, gmin, gmax);
+        for (int z = gmin.z; z <= gmax.z; z++) {
+            for (int y = gmin.y; y <= gmax.y; y++) {
+                for (int x = gmin.x; x <= gmax.x; x++) {
+                    bin_shapes[Hash_Index(vec3(x, y, z), bins_per_axis)].push_back(s);
+                }
+            }
+        }
+    }
+
+    candidate_pairs.clear();
+    IncrementalPairs(shapes);
+    IncrementalBins();
+
+    inc_valid = true;
+}
+
+// Generate the candidate pairs of the specified (updated) shapes.
+// A pair of two updated shapes is generated only from the shape with lower index.
+void ChBroadphase::IncrementalPairs(const std::vector<uint>& shapes) {
+    const std::vector<uint>& obj_data_id = cd_data->shape_data.id_rigid;
+
+    const vec3& bins_per_axis = cd_data->bins_per_axis;
+    const real3& inv_bin_size = cd_data->inv_bin_size;
+
+    const int num_updated = (int)shapes.size();
+    std::vector<std::vector<long long>> pairs(num_updated);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < num_updated; k++) {
+        uint s = shapes[k];
+        vec3 gmin, gmax;
+        bin_range(fat_min[s], fat_max[s], inc_min, inv_bin_size, bins_per_axis, gmin, gmax);
+        for (int z = gmin.z; z <= gmax.z; z++) {
+            for (int y = gmin.y; y <= gmax.y; y++) {
+                for (int x = gmin.x; x <= gmax.x; x++) {
+                    uint bin = Hash_Index(vec3(x, y, z), bins_per_axis);
+                    for (auto t : bin_shapes[bin]) {
+                        if (t == s || (moved[t] && t < s))
+                            continue;
+                        if (obj_data_id[t] == obj_data_id[s])
+                            continue;
+                        if (!fat_active[s] && !fat_active[t])
+                            continue;
+                        if (!overlap(fat_min[s], fat_max[s], fat_min[t], fat_max[t]))
+                            continue;
+                        // Store the pair only from the bin containing the lower corner of the AABB intersection
+                        vec3 g = Clamp(HashMin(Max(fat_min[s], fat_min[t]) - inc_min, inv_bin_size), gmin, gmax);
+                        if (Hash_Index(g, bins_per_axis) != bin)
+                            continue;
+                        uint shapeA = std::min(s, t);
+                        uint shapeB = std::max(s, t);
+                        pairs[k].push_back((long long)shapeA << 32 | (long long)shapeB);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& p : pairs)
+        candidate_pairs.insert(candidate_pairs.end(), p.begin(), p.end());
+}
+
+// Flatten the bin lists into the arrays used for ray intersection tests.
+// The list of active (non-empty) bins is also updated, as done by the non-incremental broadphase.
+void ChBroadphase::IncrementalBins() {
+    std::vector<uint>& bin_aabb_number = cd_data->bin_aabb_number;
+    std::vector<uint>& bin_start_index_ext = cd_data->bin_start_index_ext;
+    std::vector<uint>& bin_active = cd_data->bin_active;
+    std::vector<uint>& bin_start_index = cd_data->bin_start_index;
+    const uint num_bins = cd_data->num_bins;
+
+    bin_start_index_ext.resize(num_bins + 1);
+    bin_start_index_ext[0] = 0;
+    for (uint i = 0; i < num_bins; i++)
+        bin_start_index_ext[i + 1] = bin_start_index_ext[i] + (uint)bin_shapes[i].size();
+
+    cd_data->num_bin_aabb_intersections = bin_start_index_ext[num_bins];
+    bin_aabb_number.resize(cd_data->num_bin_aabb_intersections);
+
+#pragma omp parallel for
+    for (int i = 0; i < (signed)num_bins; i++) {
+        std::copy(bin_shapes[i].begin(), bin_shapes[i].end(), bin_aabb_number.begin() + bin_start_index_ext[i]);
+    }
+
+    bin_active.clear();
+    bin_start_index.clear();
+    for (uint i = 0; i < num_bins; i++) {
+        if (!bin_shapes[i].empty()) {
+            bin_active.push_back(i);
+            bin_start_index.push_back(bin_start_index_ext[i]);
+        }
+    }
+    bin_start_index.push_back(bin_start_index_ext[num_bins]);
+    cd_data->num_active_bins = (uint)bin_active.size();
+}
+
+// Update the flattened bin arrays after the specified (sorted) bins were modified.
+// Bins before the first bin whose size changed are copied in place; all following bins are shifted.
+void ChBroadphase::IncrementalBins(const std::vector<uint>& bins) {
+    std::vector<uint>& bin_aabb_number = cd_data->bin_aabb_number;
+    std::vector<uint>& bin_start_index_ext = cd_data->bin_start_index_ext;
+    std::vector<uint>& bin_active = cd_data->bin_active;
+    std::vector<uint>& bin_start_index = cd_data->bin_start_index;
+    const uint num_bins = cd_data->num_bins;
+
+    uint first = num_bins;
+    bool active_changed = false;
+    for (auto b : bins) {
+        uint old_size = bin_start_index_ext[b + 1] - bin_start_index_ext[b];
+        uint new_size = (uint)bin_shapes[b].size();
+        if (new_size != old_size && first == num_bins)
+            first = b;
+        active_changed |= (new_size == 0) != (old_size == 0);
+    }
+
+    const int num_inplace = (int)(std::lower_bound(bins.begin(), bins.end(), first) - bins.begin());
+#pragma omp parallel for
+    for (int k = 0; k < num_inplace; k++) {
+        uint b = bins[k];
+        std::copy(bin_shapes[b].begin(), bin_shapes[b].end(), bin_aabb_number.begin() + bin_start_index_ext[b]);
+    }
+
+    if (first < num_bins) {
+        for (uint i = first; i < num_bins; i++)
+            bin_start_index_ext[i + 1] = bin_start_index_ext[i] + (uint)bin_shapes[i].size();
+
+        cd_data->num_bin_aabb_intersections = bin_start_index_ext[num_bins];
+        bin_aabb_number.resize(cd_data->num_bin_aabb_intersections);
+
+#pragma omp parallel for
+        for (int i = (signed)first; i < (signed)num_bins; i++) {
+            std::copy(bin_shapes[i].begin(), bin_shapes[i].end(), bin_aabb_number.begin() + bin_start_index_ext[i]);
+        }
+    }
+
+    if (active_changed) {
+        bin_active.clear();
+        bin_start_index.clear();
+        for (uint i = 0; i < num_bins; i++) {
+            if (!bin_shapes[i].empty()) {
+                bin_active.push_back(i);
+                bin_start_index.push_back(bin_start_index_ext[i]);
+            }
+        }
+        bin_start_index.push_back(bin_start_index_ext[num_bins]);
+        cd_data->num_active_bins = (uint)bin_active.size();
+    } else if (first < num_bins) {
+        const int num_active = (int)bin_active.size();
+#pragma omp parallel for
+        for (int k = 0; k < num_active; k++)
+            bin_start_index[k] = bin_start_index_ext[bin_active[k]];
+        bin_start_index[num_active] = bin_start_index_ext[num_bins];
+    }
+}
+
 }  // end namespace collision
 }  // end namespace chrono
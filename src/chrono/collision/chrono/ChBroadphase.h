@@ -45,6 +45,11 @@ class ChApi ChBroadphase {
 
   private:
     void OneLevelBroadphase();
+    void IncrementalBroadphase();
+    void IncrementalRebuild();
+    void IncrementalPairs(const std::vector<uint>& shapes);
+    void IncrementalBins();
+    void IncrementalBins(const std::vector<uint>& bins);
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -57,6 +62,25 @@ class ChApi ChBroadphase {
     vec3 grid_resolution;  ///< (input) number of bins (used for GridType::FIXED_RESOLUTION)
     real3 bin_size;        ///< (input) desired bin dimensions (used for GridType::FIXED_BIN_SIZE)
     real grid_density;     ///< (input) collision grid density (used for GridType::FIXED_DENSITY)
+    bool incremental;      ///< (input) keep grid and candidate pairs between calls
+    real fat_margin;       ///< (input) margin for fattened shape AABBs (used in incremental mode)
+
+    // Persistent data for the incremental mode
+    bool inc_valid;                             ///< persistent data is up to date
+    real3 inc_min;                              ///< lower corner of the persistent grid
+    real3 inc_max;                              ///< upper corner of the persistent grid
+    std::vector<real3> fat_min;                 ///< lower corners of fattened shape AABBs
+    std::vector<real3> fat_max;                 ///< upper corners of fattened shape AABBs
+    std::vector<char> fat_active;               ///< body activity flag when the shape was last binned
+    std::vector<char> fat_binned;               ///< flag for shapes currently stored in the grid bins
+    std::vector<char> moved;                    ///< flag for shapes updated in the current call
+    std::vector<std::vector<uint>> bin_shapes;  ///< shapes intersecting each grid bin
+    std::vector<long long> candidate_pairs;     ///< shape pairs with overlapping fattened AABBs
+    GridType inc_grid_type;                     ///< grid type used at the last rebuild
+    vec3 inc_grid_resolution;                   ///< grid resolution used at the last rebuild
+    real3 inc_bin_size;                         ///< desired bin dimensions used at the last rebuild
+    real inc_grid_density;                      ///< grid density used at the last rebuild
+    real3 inc_box_size;                         ///< size of the overall AABB at the last rebuild
 
     friend class ChCollisionSystemChrono;
     friend class ChCollisionSystemChronoMulticore;
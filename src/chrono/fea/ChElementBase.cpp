@@ -0,0 +1,45 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#include "chrono/fea/ChElementBase.h"
+
+namespace chrono {
+namespace fea {
+
+// Load the element matrix in the (single) K block injected by the element, which also provides the variables of the
+// element (and therefore the offsets in the system descriptor space).
+static ChKblock* LoadKRMblock(ChElementBase* element, double Kfactor, double Rfactor, double Mfactor) {
+    ChSystemDescriptor descriptor;
+    element->InjectKRMmatrices(descriptor);
+    if (descriptor.GetKblocksList().size() != 1)
+        throw ChException("ChElementBase: default matrix-free products require a single K block per element");
+    ChKblock* kblock = descriptor.GetKblocksList()[0];
+    element->ComputeKRMmatricesGlobal(kblock->Get_K(), Kfactor, Rfactor, Mfactor);
+    return kblock;
+}
+
+void ChElementBase::KRMmatricesMultiplyAndAdd(ChVectorRef result,
+                                              ChVectorConstRef vect,
+                                              double Kfactor,
+                                              double Rfactor,
+                                              double Mfactor) {
+    LoadKRMblock(this, Kfactor, Rfactor, Mfactor)->MultiplyAndAdd(result, vect);
+}
+
+void ChElementBase::KRMmatricesDiagonalAdd(ChVectorRef result, double Kfactor, double Rfactor, double Mfactor) {
+    LoadKRMblock(this, Kfactor, Rfactor, Mfactor)->DiagonalAdd(result);
+}
+
+}  // end namespace fea
+}  // end namespace chrono
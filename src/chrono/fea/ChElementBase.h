@@ -102,6 +102,8 @@ class ChApi ChElementBase {
     /// Add the internal forces (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += forces * c
+    /// Note that ChMesh calls this function concurrently for elements which do not share nodes; an implementation
+    /// must only write to the entries of R corresponding to its own nodes.
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {}
 
     /// Add the product of element mass M by a vector w (pasted at global nodes offsets) into
@@ -115,6 +117,7 @@ class ChApi ChElementBase {
     /// contains G_acc values in the proper stride (ex. tetahedrons have 4x copies of G_acc in g).
     /// Note that elements can provide fast implementations that do not need to build any internal M matrix,
     /// and not even the g vector, for instance if using lumped masses.
+    /// As for EleIntLoadResidual_F, this function is called concurrently for elements which do not share nodes.
     virtual void EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const ChVector<>& G_acc, const double c) = 0;
 
     // Functions for interfacing to the solver
@@ -126,6 +129,23 @@ class ChApi ChElementBase {
     /// The K, R, M matrices are added with scaling values Kfactor, Rfactor, Mfactor.
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) = 0;
 
+    /// Add the product of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M by the vector 'vect' to 'result',
+    /// without storing H. Both vectors are in the system descriptor space (i.e., indexed by the variable offsets).
+    /// Used by a ChMesh in matrix-free mode. As for EleIntLoadResidual_F, this function is called concurrently for
+    /// elements which do not share nodes.
+    /// The default implementation loads H with ComputeKRMmatricesGlobal in the K block injected by the element (see
+    /// InjectKRMmatrices), which must be unique.
+    virtual void KRMmatricesMultiplyAndAdd(ChVectorRef result,
+                                           ChVectorConstRef vect,
+                                           double Kfactor,
+                                           double Rfactor,
+                                           double Mfactor);
+
+    /// Add the diagonal of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M to 'result', in the system
+    /// descriptor space. Used by a ChMesh in matrix-free mode, for diagonal preconditioning.
+    /// The default implementation loads H as in KRMmatricesMultiplyAndAdd.
+    virtual void KRMmatricesDiagonalAdd(ChVectorRef result, double Kfactor, double Rfactor, double Mfactor);
+
     /// Add the internal forces, expressed as nodal forces, into the encapsulated ChVariables.
     /// Update the 'fb' part: qf+=forces*factor
     /// WILL BE DEPRECATED - see EleIntLoadResidual_F
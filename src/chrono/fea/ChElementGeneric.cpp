@@ -24,17 +24,14 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
     ComputeInternalForces(Fi);
     Fi *= c;
 
-    //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// Attention: this is called from within a parallel OMP for loop (see ChMesh).
+    //// Elements processed concurrently do not share nodes, so no atomic update of R is needed.
 
     int stride = 0;
     for (int in = 0; in < GetNnodes(); in++) {
         int node_dofs = GetNodeNdofs_active(in);
-        if (!GetNodeN(in)->IsFixed()) {
-            for (int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNodeN(in)->NodeGetOffsetW() + j) += Fi(stride + j);
-        }
+        if (!GetNodeN(in)->IsFixed())
+            R.segment(GetNodeN(in)->NodeGetOffsetW(), node_dofs) += Fi.segment(stride, node_dofs);
         stride += GetNodeNdofs(in);
     }
     // GetLog() << "EleIntLoadResidual_F , R=" << R << "\n";
@@ -71,17 +68,14 @@ void ChElementGeneric::EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const
     ComputeGravityForces(Fg, G_acc);
     Fg *= c;
 
-    //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// Attention: this is called from within a parallel OMP for loop (see ChMesh).
+    //// Elements processed concurrently do not share nodes, so no atomic update of R is needed.
 
     int stride = 0;
     for (int in = 0; in < GetNnodes(); in++) {
         int node_dofs = GetNodeNdofs_active(in);
-        if (!GetNodeN(in)->IsFixed()) {
-            for (int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNodeN(in)->NodeGetOffsetW() + j) += Fg(stride + j);
-        }
+        if (!GetNodeN(in)->IsFixed())
+            R.segment(GetNodeN(in)->NodeGetOffsetW(), node_dofs) += Fg.segment(stride, node_dofs);
         stride += GetNodeNdofs(in);
     }
 }
@@ -121,6 +115,75 @@ void ChElementGeneric::KRMmatricesLoad(double Kfactor, double Rfactor, double Mf
     ComputeKRMmatricesGlobal(Kmatr.Get_K(), Kfactor, Rfactor, Mfactor);
 }
 
+const ChMatrixDynamic<>& ChElementGeneric::GetCachedKRMmatrix(double Kfactor, double Rfactor, double Mfactor) {
+    if (!KRM_cached || Kfactor != KRM_cache_factors[0] || Rfactor != KRM_cache_factors[1] ||
+        Mfactor != KRM_cache_factors[2]) {
+        KRM_cache.resize(GetNdofs(), GetNdofs());
+        ComputeKRMmatricesGlobal(KRM_cache, Kfactor, Rfactor, Mfactor);
+        KRM_cached = true;
+        KRM_cache_factors[0] = Kfactor;
+        KRM_cache_factors[1] = Rfactor;
+        KRM_cache_factors[2] = Mfactor;
+    }
+    return KRM_cache;
+}
+
+void ChElementGeneric::ComputeKRMproduct(const ChVectorDynamic<>& v,
+                                         ChVectorDynamic<>& Hv,
+                                         double Kfactor,
+                                         double Rfactor,
+                                         double Mfactor) {
+    Hv = GetCachedKRMmatrix(Kfactor, Rfactor, Mfactor) * v;
+}
+
+void ChElementGeneric::ComputeKRMdiagonal(ChVectorDynamic<>& diag, double Kfactor, double Rfactor, double Mfactor) {
+    diag = GetCachedKRMmatrix(Kfactor, Rfactor, Mfactor).diagonal();
+}
+
+void ChElementGeneric::KRMmatricesMultiplyAndAdd(ChVectorRef result,
+                                                 ChVectorConstRef vect,
+                                                 double Kfactor,
+                                                 double Rfactor,
+                                                 double Mfactor) {
+    // Gather the element DOFs from the descriptor vector (the variables of the K block are those of the nodes)
+    ChVectorDynamic<> v(GetNdofs());
+    v.setZero();
+    int stride = 0;
+    for (unsigned int iv = 0; iv < Kmatr.GetNvars(); iv++) {
+        ChVariables* var = Kmatr.GetVariableN(iv);
+        if (var->IsActive())
+            v.segment(stride, var->Get_ndof()) = vect.segment(var->GetOffset(), var->Get_ndof());
+        stride += var->Get_ndof();
+    }
+
+    ChVectorDynamic<> Hv(GetNdofs());
+    ComputeKRMproduct(v, Hv, Kfactor, Rfactor, Mfactor);
+
+    //// Attention: this is called from within a parallel OMP for loop (see ChMesh).
+    //// Elements processed concurrently do not share nodes, so no atomic update of result is needed.
+
+    stride = 0;
+    for (unsigned int iv = 0; iv < Kmatr.GetNvars(); iv++) {
+        ChVariables* var = Kmatr.GetVariableN(iv);
+        if (var->IsActive())
+            result.segment(var->GetOffset(), var->Get_ndof()) += Hv.segment(stride, var->Get_ndof());
+        stride += var->Get_ndof();
+    }
+}
+
+void ChElementGeneric::KRMmatricesDiagonalAdd(ChVectorRef result, double Kfactor, double Rfactor, double Mfactor) {
+    ChVectorDynamic<> diag(GetNdofs());
+    ComputeKRMdiagonal(diag, Kfactor, Rfactor, Mfactor);
+
+    int stride = 0;
+    for (unsigned int iv = 0; iv < Kmatr.GetNvars(); iv++) {
+        ChVariables* var = Kmatr.GetVariableN(iv);
+        if (var->IsActive())
+            result.segment(var->GetOffset(), var->Get_ndof()) += diag.segment(stride, var->Get_ndof());
+        stride += var->Get_ndof();
+    }
+}
+
 void ChElementGeneric::VariablesFbLoadInternalForces(double factor) {
     throw(ChException("ChElementGeneric::VariablesFbLoadInternalForces is deprecated"));
 }
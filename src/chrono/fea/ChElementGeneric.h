@@ -30,7 +30,7 @@ namespace fea {
 /// ComputeKRMmatricesGlobal(), ComputeInternalForces(), and optionally ComputeGravityForces().
 class ChApi ChElementGeneric : public ChElementBase {
   public:
-    ChElementGeneric() {}
+    ChElementGeneric() : KRM_cached(false), KRM_cache_factors{0, 0, 0} {}
     virtual ~ChElementGeneric() {}
 
     /// Access the proxy to stiffness, for sparse solver
@@ -69,6 +69,26 @@ class ChApi ChElementGeneric : public ChElementBase {
     /// efficient version.
     virtual void ComputeMmatrixGlobal(ChMatrixRef M) override;
 
+    /// Compute the product Hv = H*v of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M (as set by
+    /// ComputeKRMmatricesGlobal) by the vector v, both ordered as the element DOFs.
+    /// This default implementation forms H at the first product after ResetKRMcache() (or after a change of the
+    /// factors) and caches it, so that the element matrix is evaluated only once per Jacobian update, as in assembled
+    /// mode. Derived classes can override it with a version that does not need the element matrix (see
+    /// ChElementTetraCorot_4 and ChElementHexaCorot_8).
+    virtual void ComputeKRMproduct(const ChVectorDynamic<>& v,
+                                   ChVectorDynamic<>& Hv,
+                                   double Kfactor,
+                                   double Rfactor = 0,
+                                   double Mfactor = 0);
+
+    /// Compute the diagonal of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M.
+    /// This default implementation uses the element matrix cached by ComputeKRMproduct.
+    virtual void ComputeKRMdiagonal(ChVectorDynamic<>& diag, double Kfactor, double Rfactor = 0, double Mfactor = 0);
+
+    /// Invalidate the element matrix cached by the default ComputeKRMproduct and ComputeKRMdiagonal.
+    /// This is called by ChMesh at each Jacobian update in matrix-free mode.
+    void ResetKRMcache() { KRM_cached = false; }
+
     // Functions for interfacing to the solver
 
     /// Tell to a system descriptor that there are item(s) of type
@@ -79,6 +99,18 @@ class ChApi ChElementGeneric : public ChElementBase {
     /// The K, R, M matrices are load with scaling values Kfactor, Rfactor, Mfactor.
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
 
+    /// Add the product of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M by 'vect' to 'result', in the
+    /// system descriptor space. The element matrix is not stored (see ComputeKRMproduct).
+    virtual void KRMmatricesMultiplyAndAdd(ChVectorRef result,
+                                           ChVectorConstRef vect,
+                                           double Kfactor,
+                                           double Rfactor,
+                                           double Mfactor) override;
+
+    /// Add the diagonal of the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M to 'result', in the system
+    /// descriptor space (see ComputeKRMdiagonal).
+    virtual void KRMmatricesDiagonalAdd(ChVectorRef result, double Kfactor, double Rfactor, double Mfactor) override;
+
     /// Add the internal forces, expressed as nodal forces, into the encapsulated ChVariables.
     virtual void VariablesFbLoadInternalForces(double factor = 1.) override;
 
@@ -86,7 +118,13 @@ class ChApi ChElementGeneric : public ChElementBase {
     virtual void VariablesFbIncrementMq() override;
 
   protected:
+    /// Return the element matrix H = Kfactor*K + Rfactor*R + Mfactor*M, evaluated only if not already cached.
+    const ChMatrixDynamic<>& GetCachedKRMmatrix(double Kfactor, double Rfactor, double Mfactor);
+
     ChKblockGeneric Kmatr;
+    ChMatrixDynamic<> KRM_cache;  ///< element matrix cached by the default matrix-free products
+    bool KRM_cached;              ///< true if KRM_cache is valid for KRM_cache_factors
+    double KRM_cache_factors[3];  ///< scaling factors of K, R, M used for the cached element matrix
 };
 
 /// @} fea_elements
@@ -338,6 +338,49 @@ void ChElementHexaCorot_8::ComputeKRMmatricesGlobal(ChMatrixRef H, double Kfacto
     //***TO DO*** better per-node lumping, or 12x12 consistent mass matrix.
 }
 
+void ChElementHexaCorot_8::ComputeKRMproduct(const ChVectorDynamic<>& v,
+                                             ChVectorDynamic<>& Hv,
+                                             double Kfactor,
+                                             double Rfactor,
+                                             double Mfactor) {
+    assert(v.size() == 24);
+
+    // H*v = C*Kl*C'*v, with C the block-diagonal matrix of the element rotation A
+    ChVectorDynamic<> vl(24);
+    for (int i = 0; i < 8; i++)
+        vl.segment(3 * i, 3) = A.transpose() * v.segment(3 * i, 3);
+    ChVectorDynamic<> Kvl = StiffnessMatrix * vl;
+
+    // For K stiffness matrix and R damping matrix:
+    double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
+    Hv.resize(24);
+    for (int i = 0; i < 8; i++)
+        Hv.segment(3 * i, 3) = mkfactor * (A * Kvl.segment(3 * i, 3));
+
+    // For M mass matrix (lumped, as in ComputeKRMmatricesGlobal):
+    if (Mfactor) {
+        double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 8.0;
+        double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
+        Hv += (amfactor * lumped_node_mass) * v;
+    }
+}
+
+void ChElementHexaCorot_8::ComputeKRMdiagonal(ChVectorDynamic<>& diag, double Kfactor, double Rfactor, double Mfactor) {
+    // Diagonal of C*Kl*C' from the 3x3 diagonal blocks of Kl, rotated
+    double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
+    diag.resize(24);
+    for (int i = 0; i < 8; i++) {
+        ChMatrix33<> Kii = A * StiffnessMatrix.block<3, 3>(3 * i, 3 * i) * A.transpose();
+        diag.segment(3 * i, 3) = mkfactor * Kii.diagonal();
+    }
+
+    if (Mfactor) {
+        double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 8.0;
+        double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
+        diag.array() += amfactor * lumped_node_mass;
+    }
+}
+
 void ChElementHexaCorot_8::ComputeInternalForces(ChVectorDynamic<>& Fi) {
     assert(Fi.size() == GetNdofs());
 
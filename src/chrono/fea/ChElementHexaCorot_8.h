@@ -124,6 +124,20 @@ class ChApi ChElementHexaCorot_8 : public ChElementHexahedron,
                                           double Rfactor = 0,
                                           double Mfactor = 0) override;
 
+    /// Computes the product of the global K, R, M matrices (scaled as in ComputeKRMmatricesGlobal) by v, as the
+    /// corotation of the product with the local stiffness matrix, without forming the global element matrix.
+    virtual void ComputeKRMproduct(const ChVectorDynamic<>& v,
+                                   ChVectorDynamic<>& Hv,
+                                   double Kfactor,
+                                   double Rfactor = 0,
+                                   double Mfactor = 0) override;
+
+    /// Computes the diagonal of the global K, R, M matrices (scaled as in ComputeKRMmatricesGlobal).
+    virtual void ComputeKRMdiagonal(ChVectorDynamic<>& diag,
+                                    double Kfactor,
+                                    double Rfactor = 0,
+                                    double Mfactor = 0) override;
+
     /// Computes the internal forces (ex. the actual position of nodes is not in relaxed reference position) and set
     /// values in the Fi vector.
     virtual void ComputeInternalForces(ChVectorDynamic<>& Fi) override;
@@ -233,6 +233,9 @@ class ChApi ChMatterMeshless : public ChIndexedNodes {
         return nodes[n];
     }
 
+    /// Access the list of nodes.
+    const std::vector<std::shared_ptr<ChNodeMeshless>>& GetNodes() const { return nodes; }
+
     /// Resize the node cluster. Also clear the state of
     /// previously created particles, if any.
     void ResizeNnodes(int newsize);
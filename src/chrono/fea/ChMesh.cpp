@@ -13,17 +13,20 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
 
+#include "chrono/fea/ChElementGeneric.h"
 #include "chrono/fea/ChElementTetraCorot_4.h"
 #include "chrono/fea/ChMesh.h"
 #include "chrono/fea/ChNodeFEAxyz.h"
@@ -32,7 +35,7 @@
 namespace chrono {
 namespace fea {
 
-ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
+ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other), KRM_kblock(this) {
     vnodes = other.vnodes;
     velements = other.velements;
 
@@ -47,6 +50,12 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
 
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
+
+    topology_revision = 0;
+    coloring_revision = 0;
+
+    matrix_free = other.matrix_free;
+    KRM_factors[0] = KRM_factors[1] = KRM_factors[2] = 0;
 }
 
 void ChMesh::SetupInitial() {
@@ -67,6 +76,86 @@ void ChMesh::SetupInitial() {
         // precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    ColorElements();
+}
+
+void ChMesh::ColorElements() {
+    // Greedy coloring. For each node, keep track of the first 64 colors used by its elements (as a bit mask)
+    // and of the highest color used by its elements.
+    struct NodeColors {
+        std::uint64_t mask = 0;
+        int last = -1;
+    };
+    std::unordered_map<ChNodeFEAbase*, NodeColors> node_colors;
+    node_colors.reserve(vnodes.size());
+
+    auto num_elements = velements.size();
+    std::vector<int> color(num_elements);
+    int num_colors = 0;
+
+    for (size_t ie = 0; ie < num_elements; ie++) {
+        int nnodes = velements[ie]->GetNnodes();
+
+        std::uint64_t used = 0;
+        int last = -1;
+        for (int in = 0; in < nnodes; in++) {
+            const auto& nc = node_colors[velements[ie]->GetNodeN(in).get()];
+            used |= nc.mask;
+            last = std::max(last, nc.last);
+        }
+
+        // smallest color not used by any of the nodes (or a new color, if the first 64 are all used)
+        int c = last + 1;
+        if (~used != 0) {
+            c = 0;
+            while (used & (std::uint64_t(1) << c))
+                c++;
+        }
+
+        for (int in = 0; in < nnodes; in++) {
+            auto& nc = node_colors[velements[ie]->GetNodeN(in).get()];
+            if (c < 64)
+                nc.mask |= std::uint64_t(1) << c;
+            nc.last = std::max(nc.last, c);
+        }
+
+        color[ie] = c;
+        num_colors = std::max(num_colors, c + 1);
+    }
+
+    // Sort elements by color
+    element_color_start.assign(num_colors + 1, 0);
+    for (size_t ie = 0; ie < num_elements; ie++)
+        element_color_start[color[ie] + 1]++;
+    for (int k = 0; k < num_colors; k++)
+        element_color_start[k + 1] += element_color_start[k];
+
+    std::vector<unsigned int> pos(element_color_start.begin(), element_color_start.end() - 1);
+    element_order.resize(num_elements);
+    for (size_t ie = 0; ie < num_elements; ie++)
+        element_order[pos[color[ie]]++] = (unsigned int)ie;
+
+    coloring_revision = topology_revision;
+}
+
+template <class Function>
+void ChMesh::ForEachElementColored(Function func) {
+    // The mesh topology may have changed since the last coloring
+    if (coloring_revision != topology_revision || element_order.size() != velements.size())
+        ColorElements();
+
+    int nthreads = GetSystem()->nthreads_chrono;
+    int num_colors = (int)GetNumElementColors();
+
+#pragma omp parallel num_threads(nthreads)
+    for (int k = 0; k < num_colors; k++) {
+        int start = (int)element_color_start[k];
+        int end = (int)element_color_start[k + 1];
+#pragma omp for schedule(dynamic, 4)
+        for (int i = start; i < end; i++)
+            func(velements[element_order[i]].get());
+    }
 }
 
 void ChMesh::Relax() {
@@ -96,6 +185,7 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    topology_revision++;
 
     // If the mesh is already added to a system, mark the system uninitialized and out-of-date
     if (system) {
@@ -107,6 +197,9 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    element_order.clear();
+    element_color_start.clear();
+    topology_revision++;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -118,6 +211,9 @@ void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    element_order.clear();
+    element_color_start.clear();
+    topology_revision++;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -294,25 +390,18 @@ void ChMesh::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, con
         }
     }
 
-    int nthreads = GetSystem()->nthreads_chrono;
-
     // elements internal forces
     timer_internal_forces.start();
-    //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
-    }
+    //***PARALLEL FOR***, over elements of the same color (no race condition in writing to R)
+    ForEachElementColored([&](ChElementBase* element) { element->EleIntLoadResidual_F(R, c); });
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // elements gravity forces
     if (automatic_gravity_load) {
-        //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-        for (int ie = 0; ie < velements.size(); ie++) {
-            velements[ie]->EleIntLoadResidual_F_gravity(R, GetSystem()->Get_G_acc(), c);
-        }
+        //***PARALLEL FOR***, over elements of the same color (no race condition in writing to R)
+        const ChVector<>& G_acc = GetSystem()->Get_G_acc();
+        ForEachElementColored([&](ChElementBase* element) { element->EleIntLoadResidual_F_gravity(R, G_acc, c); });
     }
 
     // nodes gravity forces
@@ -410,6 +499,12 @@ void ChMesh::IntFromDescriptor(const unsigned int off_v,
 //// SOLVER FUNCTIONS
 
 void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    if (matrix_free) {
+        if (!velements.empty())
+            mdescriptor.InsertKblock(&KRM_kblock);
+        return;
+    }
+
     for (unsigned int ie = 0; ie < velements.size(); ie++)
         velements[ie]->InjectKRMmatrices(mdescriptor);
 }
@@ -418,6 +513,23 @@ void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     int nthreads = GetSystem()->nthreads_chrono;
 
     timer_KRMload.start();
+    if (matrix_free) {
+        // The element matrices are evaluated on the fly (see MatrixFreeKblock).
+        // Invalidate the element matrices cached by the default ChElementGeneric products.
+        KRM_factors[0] = Kfactor;
+        KRM_factors[1] = Rfactor;
+        KRM_factors[2] = Mfactor;
+#pragma omp parallel for num_threads(nthreads)
+        for (int ie = 0; ie < velements.size(); ie++) {
+            if (auto element = dynamic_cast<ChElementGeneric*>(velements[ie].get()))
+                element->ResetKRMcache();
+        }
+        timer_KRMload.stop();
+        ncalls_KRMload++;
+        return;
+    }
+
+    //***PARALLEL FOR***, each element loads its own KRM block (no race condition)
 #pragma omp parallel for num_threads(nthreads)
     for (int ie = 0; ie < velements.size(); ie++)
         velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
@@ -425,6 +537,38 @@ void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     ncalls_KRMload++;
 }
 
+void ChMesh::MatrixFreeKblock::MultiplyAndAdd(ChVectorRef result, ChVectorConstRef vect) const {
+    double Kfactor = m_mesh->KRM_factors[0];
+    double Rfactor = m_mesh->KRM_factors[1];
+    double Mfactor = m_mesh->KRM_factors[2];
+
+    // Elements of the same color do not share nodes and can update the result concurrently
+    m_mesh->ForEachElementColored([&](ChElementBase* element) {
+        element->KRMmatricesMultiplyAndAdd(result, vect, Kfactor, Rfactor, Mfactor);
+    });
+}
+
+void ChMesh::MatrixFreeKblock::DiagonalAdd(ChVectorRef result) {
+    double Kfactor = m_mesh->KRM_factors[0];
+    double Rfactor = m_mesh->KRM_factors[1];
+    double Mfactor = m_mesh->KRM_factors[2];
+
+    m_mesh->ForEachElementColored([&](ChElementBase* element) {
+        element->KRMmatricesDiagonalAdd(result, Kfactor, Rfactor, Mfactor);
+    });
+}
+
+void ChMesh::MatrixFreeKblock::Build_K(ChSparseMatrix& storage, bool add) {
+    // Fallback for solvers that need the assembled matrix: load and paste the element matrices
+    for (auto& element : m_mesh->velements) {
+        auto element_generic = std::dynamic_pointer_cast<ChElementGeneric>(element);
+        if (!element_generic)
+            throw ChException("ChMesh: matrix-free mode requires elements derived from ChElementGeneric to build K");
+        element_generic->KRMmatricesLoad(m_mesh->KRM_factors[0], m_mesh->KRM_factors[1], m_mesh->KRM_factors[2]);
+        element_generic->Kstiffness().Build_K(storage, add);
+    }
+}
+
 void ChMesh::VariablesFbReset() {
     for (unsigned int ie = 0; ie < vnodes.size(); ie++)
         vnodes[ie]->VariablesFbReset();
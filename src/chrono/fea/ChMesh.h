@@ -20,6 +20,7 @@
 
 #include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChIndexedNodes.h"
+#include "chrono/solver/ChKblock.h"
 #include "chrono/fea/ChContinuumMaterial.h"
 #include "chrono/fea/ChContactSurface.h"
 #include "chrono/fea/ChElementBase.h"
@@ -40,6 +41,23 @@ namespace fea {
 class ChApi ChMesh : public ChIndexedNodes {
 
   private:
+    /// Proxy to the mesh K, R, M matrices in matrix-free mode.
+    /// Products and diagonal are evaluated element by element, without storing the element matrices.
+    class MatrixFreeKblock : public ChKblock {
+      public:
+        MatrixFreeKblock(ChMesh* mesh) : m_mesh(mesh) {}
+
+        virtual size_t GetNvars() const override { return m_mesh->vnodes.size(); }
+        virtual ChMatrixRef Get_K() override { return m_K; }
+        virtual void MultiplyAndAdd(ChVectorRef result, ChVectorConstRef vect) const override;
+        virtual void DiagonalAdd(ChVectorRef result) override;
+        virtual void Build_K(ChSparseMatrix& storage, bool add = true) override;
+
+      private:
+        ChMesh* m_mesh;
+        ChMatrixDynamic<> m_K;  ///< empty (the mesh matrix is never formed)
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAbase>> vnodes;     ///<  nodes
     std::vector<std::shared_ptr<ChElementBase>> velements;  ///<  elements
 
@@ -57,6 +75,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     int ncalls_internal_forces;
     int ncalls_KRMload;
 
+    std::vector<unsigned int> element_order;        ///< element indices, sorted by color
+    std::vector<unsigned int> element_color_start;  ///< start of each color in element_order (plus end marker)
+    unsigned int topology_revision;                 ///< incremented at each change of the mesh topology
+    unsigned int coloring_revision;                 ///< topology revision at the last element coloring
+
+    bool matrix_free;             ///< if true, evaluate products with the K, R, M matrices element by element
+    double KRM_factors[3];        ///< scaling factors of K, R, M from the last call to KRMmatricesLoad
+    MatrixFreeKblock KRM_kblock;  ///< proxy to the mesh K, R, M matrices in matrix-free mode
+
   public:
     ChMesh()
         : n_dofs(0),
@@ -64,7 +91,12 @@ class ChApi ChMesh : public ChIndexedNodes {
           automatic_gravity_load(true),
           num_points_gravity(1),
           ncalls_internal_forces(0),
-          ncalls_KRMload(0) {}
+          ncalls_KRMload(0),
+          topology_revision(0),
+          coloring_revision(0),
+          matrix_free(false),
+          KRM_factors{0, 0, 0},
+          KRM_kblock(this) {}
     ChMesh(const ChMesh& other);
     ~ChMesh() {}
 
@@ -120,6 +152,35 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get cumulative time for Jacobian load calls.
     double GetTimeJacobianLoad() { return timer_KRMload(); }
 
+    /// Get the number of element colors used for the parallel assembly of element forces.
+    /// Elements of the same color do not share any node, so that their contributions to the
+    /// global residual can be loaded concurrently, without atomic operations.
+    unsigned int GetNumElementColors() const {
+        return element_color_start.empty() ? 0 : (unsigned int)element_color_start.size() - 1;
+    }
+
+    /// Mark the mesh topology as changed, so that the element coloring is recomputed before the next use.
+    /// This is done automatically when elements are added or removed; call this function after changing
+    /// the nodes of existing elements.
+    void InvalidateTopology() { topology_revision++; }
+
+    /// Get the topology revision counter, incremented at each change of the mesh topology.
+    unsigned int GetTopologyRevision() const { return topology_revision; }
+
+    /// Enable or disable the matrix-free evaluation of the mesh K, R, M matrices (default: false).
+    /// In matrix-free mode, the element matrices are never stored: each product with the Newton matrix is evaluated
+    /// element by element when the solver needs it (see ChElementBase::KRMmatricesMultiplyAndAdd) and its diagonal,
+    /// used by the Jacobi preconditioner of the iterative solvers, is accumulated from the element diagonals.
+    /// This avoids the cost of loading the element matrices at each Newton iteration and their storage, and is meant to
+    /// be used with the iterative linear solvers (ChIterativeSolverLS), which only access the system matrix through
+    /// products. A direct solver can still be used, but the element matrices are then computed during assembly.
+    /// Elements that do not provide their own matrix-free product (see ChElementGeneric::ComputeKRMproduct) still
+    /// compute and store their element matrix, once per Jacobian update.
+    void SetMatrixFree(bool val) { matrix_free = val; }
+
+    /// Return true if the mesh K, R, M matrices are evaluated in matrix-free mode.
+    bool IsMatrixFree() const { return matrix_free; }
+
     /// Add a contact surface.
     void AddContactSurface(std::shared_ptr<ChContactSurface> m_surf);
 
@@ -235,6 +296,7 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Adds the current stiffness K and damping R and mass M matrices in encapsulated
     /// ChKblock item(s), if any. The K, R, M matrices are added with scaling
     /// values Kfactor, Rfactor, Mfactor.
+    /// In matrix-free mode, only the scaling factors are recorded.
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
 
     /// Sets the 'fb' part (the known term) of the encapsulated ChVariables to zero.
@@ -285,6 +347,13 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// </pre>
     virtual void SetupInitial() override;
 
+    /// Partition the elements in colors, such that elements of the same color do not share nodes.
+    void ColorElements();
+
+    /// Invoke the specified function for all elements, in parallel over the elements of each color.
+    template <class Function>
+    void ForEachElementColored(Function func);
+
     friend class chrono::ChSystem;
     friend class chrono::ChAssembly;
     friend class chrono::modal::ChModalAssembly;
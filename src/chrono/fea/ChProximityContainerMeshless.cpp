@@ -26,97 +26,62 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerMeshless)
 
-ChProximityContainerMeshless::ChProximityContainerMeshless() : n_added(0) {
-    lastproximity = proximitylist.begin();
-}
+ChProximityContainerMeshless::ChProximityContainerMeshless() : m_skin_factor(0.2) {}
 
 ChProximityContainerMeshless::ChProximityContainerMeshless(const ChProximityContainerMeshless& other)
     : ChProximityContainer(other) {
-    n_added = other.n_added;
-    proximitylist = other.proximitylist;
-    lastproximity = proximitylist.begin();
-}
-
-ChProximityContainerMeshless::~ChProximityContainerMeshless() {
-    std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
-    proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
-    n_added = 0;
+    m_skin_factor = other.m_skin_factor;
 }
 
-void ChProximityContainerMeshless::RemoveAllProximities() {
-    std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
-    proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
-    n_added = 0;
+void ChProximityContainerMeshless::SetSkinFactor(double factor) {
+    m_skin_factor = ChMax(0.0, factor);
+    m_search.Reset();
 }
 
-void ChProximityContainerMeshless::BeginAddProximities() {
-    lastproximity = proximitylist.begin();
-    n_added = 0;
-}
-
-void ChProximityContainerMeshless::EndAddProximities() {
-    // remove proximities that are beyond last proximity
-    while (lastproximity != proximitylist.end()) {
-        delete (*lastproximity);
-        lastproximity = proximitylist.erase(lastproximity);
+void ChProximityContainerMeshless::ReportAllProximities(ReportProximityCallback* mcallback) {
+    for (size_t i = 0; i < m_search.GetNumPoints(); i++) {
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        for (unsigned int k = 0; k < m_search.GetNumNeighbors(i); k++) {
+            if (nbrs[k] < i)
+                continue;
+            bool proceed = mcallback->OnReportProximity(m_nodes[i]->collision_model, m_nodes[nbrs[k]]->collision_model);
+            if (!proceed)
+                return;
+        }
     }
 }
 
-void ChProximityContainerMeshless::AddProximity(collision::ChCollisionModel* modA, collision::ChCollisionModel* modB) {
-    // Fetch the frames of that proximity and other infos
-
-    ChNodeMeshless* mnA = dynamic_cast<ChNodeMeshless*>(modA->GetContactable());
-    ChNodeMeshless* mnB = dynamic_cast<ChNodeMeshless*>(modB->GetContactable());
-
-    if (!(mnA && mnB))
-        return;
-
-    // Launch the proximity callback, if implemented by the user
-
-    if (this->add_proximity_callback) {
-        this->add_proximity_callback->OnAddProximity(*modA, *modB);
+void ChProximityContainerMeshless::UpdateNeighbors() {
+    // Collect the nodes of all meshless matter items in the system
+    m_nodes.clear();
+    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
+        if (auto matter = std::dynamic_pointer_cast<ChMatterMeshless>(otherphysics)) {
+            for (const auto& node : matter->GetNodes())
+                m_nodes.push_back(node.get());
+        }
     }
 
-    // %%%%%%% Create and add a ChProximityMeshless object
-
-    if (lastproximity != proximitylist.end()) {
-        // reuse old proximity pairs
-        (*lastproximity)->Reset(modA, modB);
-
-        lastproximity++;
-    } else {
-        // add new proximity
-        ChProximityMeshless* mp = new ChProximityMeshless(modA, modB);
-
-        proximitylist.push_back(mp);
-        lastproximity = proximitylist.end();
+    double h_max = 0;
+    m_pos.resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        m_pos[i] = m_nodes[i]->GetPos();
+        h_max = ChMax(h_max, m_nodes[i]->GetKernelRadius());
     }
-    n_added++;
-}
 
-void ChProximityContainerMeshless::ReportAllProximities(ReportProximityCallback* mcallback) {
-    std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
-        if (!proceed)
-            break;
-        ++iterproximity;
+    m_search.SetNumThreads(GetSystem()->GetNumThreadsChrono());
+    m_search.SetSkin(m_skin_factor * h_max);
+    bool rebuilt = m_search.Update(m_pos, h_max);
+
+    // Launch the proximity callback on the new pairs, if implemented by the user
+    if (rebuilt && add_proximity_callback) {
+        for (size_t i = 0; i < m_search.GetNumPoints(); i++) {
+            const unsigned int* nbrs = m_search.GetNeighbors(i);
+            for (unsigned int k = 0; k < m_search.GetNumNeighbors(i); k++) {
+                if (nbrs[k] > i)
+                    add_proximity_callback->OnAddProximity(*m_nodes[i]->collision_model,
+                                                           *m_nodes[nbrs[k]]->collision_model);
+            }
+        }
     }
 }
 
@@ -124,110 +89,108 @@ void ChProximityContainerMeshless::ReportAllProximities(ReportProximityCallback*
 
 static double W_sph(double r, double h) {
     if (r < h) {
-        return (315.0 / (64.0 * CH_C_PI * pow(h, 9))) * pow((h * h - r * r), 3);
+        double h3 = h * h * h;
+        double q = h * h - r * r;
+        return (315.0 / (64.0 * CH_C_PI * h3 * h3 * h3)) * (q * q * q);
     } else
         return 0;
 }
 
 static double W_sq_visco(double r, double h) {
     if (r < h) {
-        return (45.0 / (CH_C_PI * pow(h, 6))) * (h - r);
+        double h3 = h * h * h;
+        return (45.0 / (CH_C_PI * h3 * h3)) * (h - r);
     } else
         return 0;
 }
 
-void ChProximityContainerMeshless::AccumulateStep1() {
-    // Per-edge data computation
-    std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeMeshless* mnodeA = dynamic_cast<ChNodeMeshless*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeMeshless* mnodeB = dynamic_cast<ChNodeMeshless*>((*iterproximity)->GetModelB()->GetContactable());
-
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
-        ChVector<> x_Aref = mnodeA->GetPosReference();
-        ChVector<> x_Bref = mnodeB->GetPosReference();
-        ChVector<> u_A = (x_A - x_Aref);
-        ChVector<> u_B = (x_B - x_Bref);
-
-        ChVector<> d_BA = x_Bref - x_Aref;
-        ChVector<> g_BA = u_B - u_A;
-        double dist_BA = d_BA.Length();
-        double W_BA = W_sph(dist_BA, mnodeA->GetKernelRadius());
-        double W_AB = W_sph(dist_BA, mnodeB->GetKernelRadius());
-
-        // increment data of connected nodes
-
-        mnodeA->density += mnodeB->GetMass() * W_BA;
-        mnodeB->density += mnodeA->GetMass() * W_AB;
-
-        ChVectorN<double, 3> mdist;
-        mdist.segment(0,3) = d_BA.eigen();
-        
-        ChMatrix33<> ddBA = mdist * mdist.transpose();        
-        ChMatrix33<> ddAB(ddBA);
+// Note: the elastic terms use the kernel radius of each node, as in the original pairwise formulation.
+// The viscous term uses the average kernel radius of the pair, so that pairwise forces are equal and opposite.
 
-        mnodeA->Amoment += W_BA * ddBA;  // increment the moment matrix: Aa += d_BA*d_BA'*W_BA
-        mnodeB->Amoment += W_AB * ddAB;  // increment the moment matrix: Ab += d_AB*d_AB'*W_AB
-
-        ChVector<> m_inc_BA = W_BA * d_BA;
-        ChVector<> m_inc_AB = -W_AB * d_BA;
-
-        // increment the J matrix
-        mnodeA->J.col(0) += g_BA.x() * m_inc_BA.eigen();
-        mnodeA->J.col(1) += g_BA.y() * m_inc_BA.eigen();
-        mnodeA->J.col(2) += g_BA.z() * m_inc_BA.eigen();
-
-        // increment the J matrix
-        mnodeB->J.col(0) -= g_BA.x() * m_inc_AB.eigen();
-        mnodeB->J.col(1) -= g_BA.y() * m_inc_AB.eigen();
-        mnodeB->J.col(2) -= g_BA.z() * m_inc_AB.eigen();
+void ChProximityContainerMeshless::AccumulateStep1() {
+    UpdateNeighbors();
 
-        ++iterproximity;
+    // Per-node gathering of density, moment matrix, and J matrix from the neighbor nodes
+    int num_nodes = (int)m_nodes.size();
+#pragma omp parallel for num_threads(GetSystem()->GetNumThreadsChrono())
+    for (int i = 0; i < num_nodes; i++) {
+        ChNodeMeshless* mnodeA = m_nodes[i];
+        ChVector<> x_Aref = mnodeA->GetPosReference();
+        ChVector<> u_A = m_pos[i] - x_Aref;
+        double h_A = mnodeA->GetKernelRadius();
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        unsigned int num_nbrs = m_search.GetNumNeighbors(i);
+
+        double density = 0;
+        ChMatrix33<> Amoment;
+        ChMatrix33<> J;
+        Amoment.setZero();
+        J.setZero();
+        for (unsigned int k = 0; k < num_nbrs; k++) {
+            ChNodeMeshless* mnodeB = m_nodes[nbrs[k]];
+            ChVector<> x_Bref = mnodeB->GetPosReference();
+            ChVector<> u_B = m_pos[nbrs[k]] - x_Bref;
+
+            ChVector<> d_BA = x_Bref - x_Aref;
+            ChVector<> g_BA = u_B - u_A;
+            double W_BA = W_sph(d_BA.Length(), h_A);
+            if (W_BA == 0)
+                continue;
+
+            density += mnodeB->GetMass() * W_BA;
+
+            // increment the moment matrix: Aa += d_BA*d_BA'*W_BA
+            Amoment += W_BA * (d_BA.eigen() * d_BA.eigen().transpose());
+
+            // increment the J matrix
+            ChVector<> m_inc_BA = W_BA * d_BA;
+            J.col(0) += g_BA.x() * m_inc_BA.eigen();
+            J.col(1) += g_BA.y() * m_inc_BA.eigen();
+            J.col(2) += g_BA.z() * m_inc_BA.eigen();
+        }
+
+        mnodeA->density += density;
+        mnodeA->Amoment += Amoment;
+        mnodeA->J += J;
     }
 }
 
 void ChProximityContainerMeshless::AccumulateStep2() {
-    // Per-edge data computation (transfer stress to forces)
-    std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeMeshless* mnodeA = dynamic_cast<ChNodeMeshless*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeMeshless* mnodeB = dynamic_cast<ChNodeMeshless*>((*iterproximity)->GetModelB()->GetContactable());
-
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
+    // Per-node gathering of elastoplastic and viscous forces from the neighbor nodes
+    int num_nodes = (int)m_nodes.size();
+#pragma omp parallel for num_threads(GetSystem()->GetNumThreadsChrono())
+    for (int i = 0; i < num_nodes; i++) {
+        ChNodeMeshless* mnodeA = m_nodes[i];
+        const ChVector<>& x_A = m_pos[i];
         ChVector<> x_Aref = mnodeA->GetPosReference();
-        ChVector<> x_Bref = mnodeB->GetPosReference();
-
-        ChVector<> d_BA = x_Bref - x_Aref;
-
-        double dist_BA = d_BA.Length();
-        double W_BA = W_sph(dist_BA, mnodeA->GetKernelRadius());
-        double W_AB = W_sph(dist_BA, mnodeB->GetKernelRadius());
-
-        // increment elastoplastic forces of connected nodes
-
-        mnodeA->UserForce += mnodeA->FA * (d_BA * W_BA);
-        mnodeB->UserForce -= mnodeA->FA * (d_BA * W_BA);
-
-        mnodeB->UserForce += mnodeB->FA * (d_BA * (-W_AB));
-        mnodeA->UserForce -= mnodeB->FA * (d_BA * (-W_AB));
-
-        // increment viscous forces..
-
-        ChVector<> r_BA = x_B - x_A;
-        double r_length = r_BA.Length();
-        double W_BA_visc = W_sq_visco(r_length, mnodeA->GetKernelRadius());
-        ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
-
-        double avg_viscosity =
-            0.5 * (mnodeA->GetMatterContainer()->GetViscosity() + mnodeB->GetMatterContainer()->GetViscosity());
-
-        ChVector<> viscforceBA = velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_BA_visc);
-        mnodeA->UserForce += viscforceBA;
-        mnodeB->UserForce -= viscforceBA;
-
-        ++iterproximity;
+        double h_A = mnodeA->GetKernelRadius();
+        double visc_A = mnodeA->GetMatterContainer()->GetViscosity();
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        unsigned int num_nbrs = m_search.GetNumNeighbors(i);
+
+        ChVector<> force(VNULL);
+        for (unsigned int k = 0; k < num_nbrs; k++) {
+            ChNodeMeshless* mnodeB = m_nodes[nbrs[k]];
+            double h_B = mnodeB->GetKernelRadius();
+
+            ChVector<> d_BA = mnodeB->GetPosReference() - x_Aref;
+            double dist_BA = d_BA.Length();
+            double W_BA = W_sph(dist_BA, h_A);
+            double W_AB = W_sph(dist_BA, h_B);
+
+            // elastoplastic forces
+            force += mnodeA->FA * (d_BA * W_BA);
+            force += mnodeB->FA * (d_BA * W_AB);
+
+            // viscous force
+            ChVector<> r_BA = m_pos[nbrs[k]] - x_A;
+            double W_BA_visc = W_sq_visco(r_BA.Length(), 0.5 * (h_A + h_B));
+            ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
+            double avg_viscosity = 0.5 * (visc_A + mnodeB->GetMatterContainer()->GetViscosity());
+            force += velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_BA_visc);
+        }
+
+        mnodeA->UserForce += force;
     }
 }
 
@@ -15,103 +15,76 @@
 #ifndef CHPROXIMITYCONTAINERMESHLESS_H
 #define CHPROXIMITYCONTAINERMESHLESS_H
 
-#include <list>
+#include <vector>
 
+#include "chrono/collision/ChNeighborSearch.h"
 #include "chrono/physics/ChProximityContainer.h"
 
 namespace chrono {
 
+namespace fea {
+class ChNodeMeshless;
+}
+
 /// @addtogroup chrono_fea
 /// @{
 
-/// Class for a proximity pair information in a meshless deformable continumm,
-/// made with a cluster of particles - that is, an 'edge' topological connectivity in
-/// in a meshless FEA approach, similar to the Smoothed Particle Hydrodynamics.
-class ChApi ChProximityMeshless {
-  public:
-    ChProximityMeshless(collision::ChCollisionModel* mmodA,  ///< model A
-                        collision::ChCollisionModel* mmodB   ///< model B
-                        ) {
-        Reset(mmodA, mmodB);
-    }
-
-    virtual ~ChProximityMeshless() {}
-
-    /// Initialize again this constraint.
-    virtual void Reset(collision::ChCollisionModel* mmodA,  ///< model A
-                       collision::ChCollisionModel* mmodB   ///< model B
-                       ) {
-        assert(mmodA);
-        assert(mmodB);
-
-        this->modA = mmodA;
-        this->modB = mmodB;
-    }
-
-    /// Get the collision model A, with point P1
-    virtual collision::ChCollisionModel* GetModelA() { return this->modA; }
-    /// Get the collision model B, with point P2
-    virtual collision::ChCollisionModel* GetModelB() { return this->modB; }
-
-  private:
-    collision::ChCollisionModel* modA;  ///< model A
-    collision::ChCollisionModel* modB;  ///< model B
-};
-
-/// Class for container of many proximity pairs for a meshless
-/// deformable continuum (necessary for inter-particle material forces),
-/// as CPU typical linked list of ChProximityMeshless objects.
+/// Class for container of proximity pairs for a meshless
+/// deformable continuum (necessary for inter-particle material forces).
+/// The pairs are not obtained from the collision system: the container collects the nodes of
+/// all ChMatterMeshless items in the system and finds their neighbors with a uniform grid search
+/// (see collision::ChNeighborSearch), with the same Verlet-skin lists used by ChProximityContainerSPH.
 /// Such an item must be addd to the physical system if you added
 /// an object of class ChMatterMeshless.
 
 class ChApi ChProximityContainerMeshless : public ChProximityContainer {
-
-  protected:
-    std::list<ChProximityMeshless*> proximitylist;
-    std::list<ChProximityMeshless*>::iterator lastproximity;
-    int n_added;
-
   public:
     ChProximityContainerMeshless();
     ChProximityContainerMeshless(const ChProximityContainerMeshless& other);
-    virtual ~ChProximityContainerMeshless();
+    virtual ~ChProximityContainerMeshless() {}
 
     /// "Virtual" copy constructor (covariant return type).
     virtual ChProximityContainerMeshless* Clone() const override { return new ChProximityContainerMeshless(*this); }
 
-    /// Tell the number of added contacts
-    virtual int GetNproximities() const override { return n_added; }
+    /// Tell the number of neighbor pairs (within kernel radius plus skin) in the current lists.
+    virtual int GetNproximities() const override { return (int)m_search.GetNumPairs(); }
 
-    /// Remove (delete) all contained contact data.
-    virtual void RemoveAllProximities() override;
+    /// Remove all neighbor data. The neighbor lists will be rebuilt at the next update.
+    virtual void RemoveAllProximities() override { m_search.Reset(); }
 
-    /// The collision system will call BeginAddProximities() before adding
-    /// all pairs (for example with AddProximity() or similar). Instead of
-    /// simply deleting all list of the previous pairs, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous pairs objects
-    /// until possible, to avoid too much allocation/deallocation.
-    virtual void BeginAddProximities() override;
+    /// Proximities reported by the collision system are ignored (the neighbor search is done by this container).
+    virtual void BeginAddProximities() override {}
 
-    /// Add a proximity SPH data between two collision models, if possible.
+    /// Proximities reported by the collision system are ignored (the neighbor search is done by this container).
     virtual void AddProximity(collision::ChCollisionModel* modA,  ///< get contact model 1
                               collision::ChCollisionModel* modB   ///< get contact model 2
-                              ) override;
+                              ) override {}
 
-    /// The collision system will call BeginAddContact() after adding
-    /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
-    virtual void EndAddProximities() override;
+    /// Proximities reported by the collision system are ignored (the neighbor search is done by this container).
+    virtual void EndAddProximities() override {}
 
-    /// Scans all the proximity pairs and, for each pair, executes the OnReportProximity()
+    /// Scans all the neighbor pairs and, for each pair, executes the OnReportProximity()
     /// function of the provided callback object.
     virtual void ReportAllProximities(ReportProximityCallback* mcallback) override;
 
-    // Perform some SPH per-edge initializations and accumulations of values
-    // into the connected pairs of particles (summation into particle's  J, Amoment, m_v, UserForce -viscous only- )
+    /// Set the Verlet skin, as a fraction of the largest kernel radius (default: 0.2).
+    void SetSkinFactor(double factor);
+    double GetSkinFactor() const { return m_skin_factor; }
+
+    /// Access the neighbor search (e.g. for statistics on list rebuilds).
+    const collision::ChNeighborSearch& GetNeighborSearch() const { return m_search; }
+
+    /// Collect the meshless nodes in the system and update their neighbor lists, if needed.
+    /// Called automatically by AccumulateStep1().
+    void UpdateNeighbors();
+
+    // Perform some per-node accumulations of values from the neighbor nodes
+    // (summation into particle's J, Amoment, density).
     // Will be called by the ChMatterMeshless item.
     void AccumulateStep1();
 
-    // Perform some SPH per-edge transfer of forces, given stress tensors in A B nodes
+    // Perform some per-node transfer of forces from the neighbor nodes, given stress tensors in the nodes
+    // (summation into particle's UserForce).
     // Will be called by the ChMatterMeshless item.
     void AccumulateStep2();
 
@@ -124,6 +97,12 @@ class ChApi ChProximityContainerMeshless : public ChProximityContainer {
 
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  protected:
+    std::vector<fea::ChNodeMeshless*> m_nodes;  ///< nodes of all ChMatterMeshless items in the system
+    std::vector<ChVector<>> m_pos;              ///< current node positions
+    collision::ChNeighborSearch m_search;       ///< grid neighbor search
+    double m_skin_factor;                       ///< Verlet skin, as a fraction of the kernel radius
 };
 
 /// @} chrono_fea
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChContactContainerNSC.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
@@ -25,30 +27,16 @@ using namespace geometry;
 CH_FACTORY_REGISTER(ChContactContainerNSC)
 
 ChContactContainerNSC::ChContactContainerNSC()
-    : n_added_6_6(0),
-      n_added_6_3(0),
-      n_added_3_3(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0),
-      n_added_6_6_rolling(0) {}
+    : use_contact_cache(true),
+      contact_cache_tol(ChCollisionModel::GetDefaultSuggestedEnvelope()),
+      n_matched(0),
+      n_new(0) {}
 
 ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {
-    n_added_6_6 = 0;
-    n_added_6_3 = 0;
-    n_added_3_3 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-    n_added_6_6_rolling = 0;
+    use_contact_cache = other.use_contact_cache;
+    contact_cache_tol = other.contact_cache_tol;
+    n_matched = 0;
+    n_new = 0;
 }
 
 ChContactContainerNSC::~ChContactContainerNSC() {
@@ -60,138 +48,56 @@ void ChContactContainerNSC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
-}
-
 void ChContactContainerNSC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+    contacts_6_6.Clear();
+    contacts_6_3.Clear();
+    contacts_3_3.Clear();
+    contacts_333_3.Clear();
+    contacts_333_6.Clear();
+    contacts_333_333.Clear();
+    contacts_666_3.Clear();
+    contacts_666_6.Clear();
+    contacts_666_333.Clear();
+    contacts_666_666.Clear();
+    contacts_6_6_rolling.Clear();
+
+    contact_cache.clear();
+    contact_cache_prev.clear();
+    n_matched = 0;
+    n_new = 0;
+}
+
+void ChContactContainerNSC::EnableContactCache(bool val) {
+    use_contact_cache = val;
+    if (!use_contact_cache)
+        contact_cache_prev.clear();
 }
 
 void ChContactContainerNSC::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
-
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
-
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
-
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
-
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
-
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
-    n_added_6_6_rolling = 0;
+    contacts_6_6.Rewind();
+    contacts_6_3.Rewind();
+    contacts_3_3.Rewind();
+    contacts_333_3.Rewind();
+    contacts_333_6.Rewind();
+    contacts_333_333.Rewind();
+    contacts_666_3.Rewind();
+    contacts_666_6.Rewind();
+    contacts_666_333.Rewind();
+    contacts_666_666.Rewind();
+    contacts_6_6_rolling.Rewind();
+
+    // Move the cached contacts from the last collision pass into the lookup table
+    n_matched = 0;
+    n_new = 0;
+    if (use_contact_cache) {
+        contact_cache_prev.assign(contact_cache.begin(), contact_cache.end());
+        std::sort(contact_cache_prev.begin(), contact_cache_prev.end());
+    }
+    contact_cache.clear();
 }
 
 void ChContactContainerNSC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
-    }
-
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
-}
-
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,           // contact list
-                           Titer& lastcontact,                       // last contact acquired
-                           int& n_added,                             // number of contacts inserted
-                           ChContactContainer* container,            // contact container
-                           Ta* objA,                                 // collidable object A
-                           Tb* objB,                                 // collidable object B
-                           const collision::ChCollisionInfo& cinfo,  // collision information
-                           const ChMaterialCompositeNSC& cmat        // composite material
-) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo, cmat);
-        lastcontact++;
-    } else {
-        // add new contact
-        Tcont* mc = new Tcont(container, objA, objB, cinfo, cmat);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
-    }
-    n_added++;
+    // Nothing to do: contacts that were not reused are kept in the pools for subsequent collision passes
 }
 
 void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& cinfo,
@@ -251,6 +157,66 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& cinfo)
 }
 
 void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
+    // If the collision system does not provide a persistent reaction cache for this contact, attach one from the
+    // container cache, initialized with the reactions of the matching contact from the previous collision pass.
+    if (use_contact_cache && !cinfo.reaction_cache) {
+        collision::ChCollisionInfo cached_cinfo(cinfo);
+        cached_cinfo.reaction_cache = CacheContact(cinfo);
+        CreateContact(cached_cinfo, cmat);
+        return;
+    }
+
+    CreateContact(cinfo, cmat);
+}
+
+// Return the index of the specified shape in the given collision model (-1 if not found).
+static int GetShapeIndex(collision::ChCollisionModel* model, collision::ChCollisionShape* shape) {
+    const auto& shapes = model->GetShapes();
+    for (int i = 0; i < (int)shapes.size(); i++) {
+        if (shapes[i].get() == shape)
+            return i;
+    }
+    return -1;
+}
+
+float* ChContactContainerNSC::CacheContact(const collision::ChCollisionInfo& cinfo) {
+    CachedContact entry;
+    entry.modelA = cinfo.modelA->GetIdentifier();
+    entry.modelB = cinfo.modelB->GetIdentifier();
+    entry.shapeA = GetShapeIndex(cinfo.modelA, cinfo.shapeA);
+    entry.shapeB = GetShapeIndex(cinfo.modelB, cinfo.shapeB);
+    entry.point = cinfo.modelA->GetContactable()->GetCsysForCollisionModel().TransformPointParentToLocal(cinfo.vpA);
+    std::fill(entry.reactions, entry.reactions + 6, 0.0f);
+    entry.matched = false;
+
+    // Find the closest contact point (within tolerance) among the unmatched contacts from the previous collision pass
+    // with the same pair of collision models and shapes
+    auto range = std::equal_range(contact_cache_prev.begin(), contact_cache_prev.end(), entry);
+    auto match = range.second;
+    double min_dist2 = contact_cache_tol * contact_cache_tol;
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->matched)
+            continue;
+        double dist2 = (it->point - entry.point).Length2();
+        if (dist2 <= min_dist2) {
+            min_dist2 = dist2;
+            match = it;
+        }
+    }
+
+    if (match != range.second) {
+        match->matched = true;
+        std::copy(match->reactions, match->reactions + 6, entry.reactions);
+        n_matched++;
+    } else {
+        n_new++;
+    }
+
+    contact_cache.push_back(entry);
+    return contact_cache.back().reactions;
+}
+
+void ChContactContainerNSC::CreateContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
     auto contactableA = cinfo.modelA->GetContactable();
     auto contactableB = cinfo.modelB->GetContactable();
 
@@ -271,22 +237,22 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, objA, objB, cinfo, cmat);
+                contacts_3_3.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objB, objA, swapped_cinfo, cmat);
+                contacts_6_3.Add(this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objB, objA, swapped_cinfo, cmat);
+                contacts_333_3.Add(this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objB, objA, swapped_cinfo, cmat);
+                contacts_666_3.Add(this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -295,25 +261,25 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objA, objB, cinfo, cmat);
+                contacts_6_3.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6    ***NOTE: for body-body one could have rolling friction: ***
                 if (cmat.rolling_friction || cmat.spinning_friction) {
-                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this, objA, objB, cinfo, cmat);
+                    contacts_6_6_rolling.Add(this, objA, objB, cinfo, cmat);
                 } else {
-                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, objA, objB, cinfo, cmat);
+                    contacts_6_6.Add(this, objA, objB, cinfo, cmat);
                 }
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objB, objA, swapped_cinfo, cmat);
+                contacts_333_6.Add(this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objB, objA, swapped_cinfo, cmat);
+                contacts_666_6.Add(this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -322,20 +288,20 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objA, objB, cinfo, cmat);
+                contacts_333_3.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objA, objB, cinfo, cmat);
+                contacts_333_6.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, objA, objB, cinfo, cmat);
+                contacts_333_333.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objB, objA, swapped_cinfo, cmat);
+                contacts_666_333.Add(this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -344,19 +310,19 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objA, objB, cinfo, cmat);
+                contacts_666_3.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objA, objB, cinfo, cmat);
+                contacts_666_6.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objA, objB, cinfo, cmat);
+                contacts_666_333.Add(this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, objA, objB, cinfo, cmat);
+                contacts_666_666.Add(this, objA, objB, cinfo, cmat);
             }
         } break;
 
@@ -369,17 +335,17 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
 
 void ChContactContainerNSC::ComputeContactForces() {
     contact_forces.clear();
-    SumAllContactForces(contactlist_3_3, contact_forces);
-    SumAllContactForces(contactlist_6_3, contact_forces);
-    SumAllContactForces(contactlist_6_6, contact_forces);
-    SumAllContactForces(contactlist_333_3, contact_forces);
-    SumAllContactForces(contactlist_333_6, contact_forces);
-    SumAllContactForces(contactlist_333_333, contact_forces);
-    SumAllContactForces(contactlist_666_3, contact_forces);
-    SumAllContactForces(contactlist_666_6, contact_forces);
-    SumAllContactForces(contactlist_666_333, contact_forces);
-    SumAllContactForces(contactlist_666_666, contact_forces);
-    SumAllContactForces(contactlist_6_6_rolling, contact_forces);
+    SumAllContactForces(contacts_3_3, contact_forces);
+    SumAllContactForces(contacts_6_3, contact_forces);
+    SumAllContactForces(contacts_6_6, contact_forces);
+    SumAllContactForces(contacts_333_3, contact_forces);
+    SumAllContactForces(contacts_333_6, contact_forces);
+    SumAllContactForces(contacts_333_333, contact_forces);
+    SumAllContactForces(contacts_666_3, contact_forces);
+    SumAllContactForces(contacts_666_6, contact_forces);
+    SumAllContactForces(contacts_666_333, contact_forces);
+    SumAllContactForces(contacts_666_666, contact_forces);
+    SumAllContactForces(contacts_6_6_rolling, contact_forces);
 }
 
 ChVector<> ChContactContainerNSC::GetContactableForce(ChContactable* contactable) {
@@ -399,168 +365,156 @@ ChVector<> ChContactContainerNSC::GetContactableTorque(ChContactable* contactabl
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContacts(ChContactPool<Tcont>& contacts, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        Tcont& contact = contacts[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), VNULL, contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contacts, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        Tcont& contact = contacts[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), (*itercontact)->GetContactTorque(), (*itercontact)->GetObjA(),
-            (*itercontact)->GetObjB());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), contact.GetContactTorque(), contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 void ChContactContainerNSC::ReportAllContacts(std::shared_ptr<ReportContactCallback> callback) {
-    _ReportAllContacts(contactlist_6_6, callback.get());
-    _ReportAllContacts(contactlist_6_3, callback.get());
-    _ReportAllContacts(contactlist_3_3, callback.get());
-    _ReportAllContacts(contactlist_333_3, callback.get());
-    _ReportAllContacts(contactlist_333_6, callback.get());
-    _ReportAllContacts(contactlist_333_333, callback.get());
-    _ReportAllContacts(contactlist_666_3, callback.get());
-    _ReportAllContacts(contactlist_666_6, callback.get());
-    _ReportAllContacts(contactlist_666_333, callback.get());
-    _ReportAllContacts(contactlist_666_666, callback.get());
-    _ReportAllContactsRolling(contactlist_6_6_rolling, callback.get());
+    _ReportAllContacts(contacts_6_6, callback.get());
+    _ReportAllContacts(contacts_6_3, callback.get());
+    _ReportAllContacts(contacts_3_3, callback.get());
+    _ReportAllContacts(contacts_333_3, callback.get());
+    _ReportAllContacts(contacts_333_6, callback.get());
+    _ReportAllContacts(contacts_333_333, callback.get());
+    _ReportAllContacts(contacts_666_3, callback.get());
+    _ReportAllContacts(contacts_666_6, callback.get());
+    _ReportAllContacts(contacts_666_333, callback.get());
+    _ReportAllContacts(contacts_666_666, callback.get());
+    _ReportAllContactsRolling(contacts_6_6_rolling, callback.get());
 }
 
 
 template <class Tcont>
-void _ReportAllContactsNSC(std::list<Tcont*>& contactlist, ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContactsNSC(ChContactPool<Tcont>& contacts, ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        Tcont& contact = contacts[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB(),
-            (*itercontact)->GetConstraintNx()->GetOffset());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), VNULL, contact.GetObjA(), contact.GetObjB(),
+            contact.GetConstraintNx()->GetOffset());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 template <class Tcont>
-void _ReportAllContactsRollingNSC(std::list<Tcont*>& contactlist, ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContactsRollingNSC(ChContactPool<Tcont>& contacts, ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        Tcont& contact = contacts[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), (*itercontact)->GetContactTorque(), (*itercontact)->GetObjA(),
-            (*itercontact)->GetObjB(),
-            (*itercontact)->GetConstraintNx()->GetOffset());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), contact.GetContactTorque(), contact.GetObjA(), contact.GetObjB(),
+            contact.GetConstraintNx()->GetOffset());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 void ChContactContainerNSC::ReportAllContactsNSC(std::shared_ptr<ReportContactCallbackNSC> callback) {
-    _ReportAllContactsNSC(contactlist_6_6, callback.get());
-    _ReportAllContactsNSC(contactlist_6_3, callback.get());
-    _ReportAllContactsNSC(contactlist_3_3, callback.get());
-    _ReportAllContactsNSC(contactlist_333_3, callback.get());
-    _ReportAllContactsNSC(contactlist_333_6, callback.get());
-    _ReportAllContactsNSC(contactlist_333_333, callback.get());
-    _ReportAllContactsNSC(contactlist_666_3, callback.get());
-    _ReportAllContactsNSC(contactlist_666_6, callback.get());
-    _ReportAllContactsNSC(contactlist_666_333, callback.get());
-    _ReportAllContactsNSC(contactlist_666_666, callback.get());
-    _ReportAllContactsRollingNSC(contactlist_6_6_rolling, callback.get());
+    _ReportAllContactsNSC(contacts_6_6, callback.get());
+    _ReportAllContactsNSC(contacts_6_3, callback.get());
+    _ReportAllContactsNSC(contacts_3_3, callback.get());
+    _ReportAllContactsNSC(contacts_333_3, callback.get());
+    _ReportAllContactsNSC(contacts_333_6, callback.get());
+    _ReportAllContactsNSC(contacts_333_333, callback.get());
+    _ReportAllContactsNSC(contacts_666_3, callback.get());
+    _ReportAllContactsNSC(contacts_666_6, callback.get());
+    _ReportAllContactsNSC(contacts_666_333, callback.get());
+    _ReportAllContactsNSC(contacts_666_666, callback.get());
+    _ReportAllContactsRollingNSC(contacts_6_6_rolling, callback.get());
 }
 
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contacts,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
 void ChContactContainerNSC::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
     unsigned int coffset = 0;
-    _IntStateGatherReactions(coffset, contactlist_6_6, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_6_3, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_3_3, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_333_3, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_333_6, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_333_333, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_666_3, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_666_6, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_666_333, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_666_666, off_L, L, 3);
-    _IntStateGatherReactions(coffset, contactlist_6_6_rolling, off_L, L, 6);
+    _IntStateGatherReactions(coffset, contacts_6_6, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_6_3, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_3_3, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_333_3, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_333_6, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_333_333, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_666_3, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_666_6, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_666_333, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_666_666, off_L, L, 3);
+    _IntStateGatherReactions(coffset, contacts_6_6_rolling, off_L, L, 6);
 }
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contacts,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
 void ChContactContainerNSC::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
     unsigned int coffset = 0;
-    _IntStateScatterReactions(coffset, contactlist_6_6, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_6_3, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_3_3, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_333_3, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_333_6, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_333_333, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_666_3, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_666_6, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_666_333, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_666_666, off_L, L, 3);
-    _IntStateScatterReactions(coffset, contactlist_6_6_rolling, off_L, L, 6);
+    _IntStateScatterReactions(coffset, contacts_6_6, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_6_3, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_3_3, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_333_3, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_333_6, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_333_333, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_666_3, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_666_6, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_666_333, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_666_666, off_L, L, 3);
+    _IntStateScatterReactions(coffset, contacts_6_6_rolling, off_L, L, 6);
 }
 
 template <class Tcont>
 void _IntLoadResidual_CqL(unsigned int& coffset,           // offset of the contacts
-                          std::list<Tcont*>& contactlist,  // list of contacts
+                          ChContactPool<Tcont>& contacts,  // list of contacts
                           const unsigned int off_L,        // offset in L multipliers
                           ChVectorDynamic<>& R,            // result: the R residual, R += c*Cq'*L
                           const ChVectorDynamic<>& L,      // the L vector
                           const double c,                  // a scaling factor
                           const int stride                 // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -569,22 +523,22 @@ void ChContactContainerNSC::IntLoadResidual_CqL(const unsigned int off_L,
                                                 const ChVectorDynamic<>& L,
                                                 const double c) {
     unsigned int coffset = 0;
-    _IntLoadResidual_CqL(coffset, contactlist_6_6, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_6_3, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_3_3, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_333_3, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_333_6, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_333_333, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_666_3, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_666_6, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_666_333, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_666_666, off_L, R, L, c, 3);
-    _IntLoadResidual_CqL(coffset, contactlist_6_6_rolling, off_L, R, L, c, 6);
+    _IntLoadResidual_CqL(coffset, contacts_6_6, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_6_3, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_3_3, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_333_3, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_333_6, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_333_333, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_666_3, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_666_6, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_666_333, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_666_666, off_L, R, L, c, 3);
+    _IntLoadResidual_CqL(coffset, contacts_6_6_rolling, off_L, R, L, c, 6);
 }
 
 template <class Tcont>
 void _IntLoadConstraint_C(unsigned int& coffset,           // contact offset
-                          std::list<Tcont*>& contactlist,  // contact list
+                          ChContactPool<Tcont>& contacts,  // contact list
                           const unsigned int off,          // offset in Qc residual
                           ChVectorDynamic<>& Qc,           // result: the Qc residual, Qc += c*C
                           const double c,                  // a scaling factor
@@ -592,11 +546,9 @@ void _IntLoadConstraint_C(unsigned int& coffset,           // contact offset
                           double recovery_clamp,           // value for min/max clamping of c*C
                           const int stride                 // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -606,22 +558,22 @@ void ChContactContainerNSC::IntLoadConstraint_C(const unsigned int off,
                                                 bool do_clamp,
                                                 double recovery_clamp) {
     unsigned int coffset = 0;
-    _IntLoadConstraint_C(coffset, contactlist_6_6, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_6_3, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_3_3, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_333_3, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_333_6, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_333_333, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_666_3, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_666_6, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_666_333, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_666_666, off, Qc, c, do_clamp, recovery_clamp, 3);
-    _IntLoadConstraint_C(coffset, contactlist_6_6_rolling, off, Qc, c, do_clamp, recovery_clamp, 6);
+    _IntLoadConstraint_C(coffset, contacts_6_6, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_6_3, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_3_3, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_333_3, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_333_6, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_333_333, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_666_3, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_666_6, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_666_333, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_666_666, off, Qc, c, do_clamp, recovery_clamp, 3);
+    _IntLoadConstraint_C(coffset, contacts_6_6_rolling, off, Qc, c, do_clamp, recovery_clamp, 6);
 }
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contacts,
                       const unsigned int off_v,
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -629,11 +581,9 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -644,32 +594,30 @@ void ChContactContainerNSC::IntToDescriptor(const unsigned int off_v,
                                             const ChVectorDynamic<>& L,
                                             const ChVectorDynamic<>& Qc) {
     unsigned int coffset = 0;
-    _IntToDescriptor(coffset, contactlist_6_6, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_6_3, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_3_3, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_333_3, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_333_6, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_333_333, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_666_3, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_666_6, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_666_333, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_666_666, off_v, v, R, off_L, L, Qc, 3);
-    _IntToDescriptor(coffset, contactlist_6_6_rolling, off_v, v, R, off_L, L, Qc, 6);
+    _IntToDescriptor(coffset, contacts_6_6, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_6_3, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_3_3, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_333_3, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_333_6, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_333_333, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_666_3, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_666_6, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_666_333, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_666_666, off_v, v, R, off_L, L, Qc, 3);
+    _IntToDescriptor(coffset, contacts_6_6_rolling, off_v, v, R, off_L, L, Qc, 6);
 }
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contacts,
                         const unsigned int off_v,
                         ChStateDelta& v,
                         const unsigned int off_L,
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -678,88 +626,82 @@ void ChContactContainerNSC::IntFromDescriptor(const unsigned int off_v,
                                               const unsigned int off_L,
                                               ChVectorDynamic<>& L) {
     unsigned int coffset = 0;
-    _IntFromDescriptor(coffset, contactlist_6_6, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_6_3, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_3_3, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_333_3, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_333_6, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_333_333, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_666_3, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_666_6, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_666_333, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_666_666, off_v, v, off_L, L, 3);
-    _IntFromDescriptor(coffset, contactlist_6_6_rolling, off_v, v, off_L, L, 6);
+    _IntFromDescriptor(coffset, contacts_6_6, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_6_3, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_3_3, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_333_3, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_333_6, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_333_333, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_666_3, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_666_6, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_666_333, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_666_666, off_v, v, off_L, L, 3);
+    _IntFromDescriptor(coffset, contacts_6_6_rolling, off_v, v, off_L, L, 6);
 }
 
 // SOLVER INTERFACES
 
 template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->InjectConstraints(mdescriptor);
-        ++itercontact;
+void _InjectConstraints(ChContactPool<Tcont>& contacts, ChSystemDescriptor& mdescriptor) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].InjectConstraints(mdescriptor);
     }
 }
 
 void ChContactContainerNSC::InjectConstraints(ChSystemDescriptor& mdescriptor) {
-    _InjectConstraints(contactlist_6_6, mdescriptor);
-    _InjectConstraints(contactlist_6_3, mdescriptor);
-    _InjectConstraints(contactlist_3_3, mdescriptor);
-    _InjectConstraints(contactlist_333_3, mdescriptor);
-    _InjectConstraints(contactlist_333_6, mdescriptor);
-    _InjectConstraints(contactlist_333_333, mdescriptor);
-    _InjectConstraints(contactlist_666_3, mdescriptor);
-    _InjectConstraints(contactlist_666_6, mdescriptor);
-    _InjectConstraints(contactlist_666_333, mdescriptor);
-    _InjectConstraints(contactlist_666_666, mdescriptor);
-    _InjectConstraints(contactlist_6_6_rolling, mdescriptor);
+    _InjectConstraints(contacts_6_6, mdescriptor);
+    _InjectConstraints(contacts_6_3, mdescriptor);
+    _InjectConstraints(contacts_3_3, mdescriptor);
+    _InjectConstraints(contacts_333_3, mdescriptor);
+    _InjectConstraints(contacts_333_6, mdescriptor);
+    _InjectConstraints(contacts_333_333, mdescriptor);
+    _InjectConstraints(contacts_666_3, mdescriptor);
+    _InjectConstraints(contacts_666_6, mdescriptor);
+    _InjectConstraints(contacts_666_333, mdescriptor);
+    _InjectConstraints(contacts_666_666, mdescriptor);
+    _InjectConstraints(contacts_6_6_rolling, mdescriptor);
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiReset();
-        ++itercontact;
+void _ConstraintsBiReset(ChContactPool<Tcont>& contacts) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ConstraintsBiReset();
     }
 }
 
 void ChContactContainerNSC::ConstraintsBiReset() {
-    _ConstraintsBiReset(contactlist_6_6);
-    _ConstraintsBiReset(contactlist_6_3);
-    _ConstraintsBiReset(contactlist_3_3);
-    _ConstraintsBiReset(contactlist_333_3);
-    _ConstraintsBiReset(contactlist_333_6);
-    _ConstraintsBiReset(contactlist_333_333);
-    _ConstraintsBiReset(contactlist_666_3);
-    _ConstraintsBiReset(contactlist_666_6);
-    _ConstraintsBiReset(contactlist_666_333);
-    _ConstraintsBiReset(contactlist_666_666);
-    _ConstraintsBiReset(contactlist_6_6_rolling);
+    _ConstraintsBiReset(contacts_6_6);
+    _ConstraintsBiReset(contacts_6_3);
+    _ConstraintsBiReset(contacts_3_3);
+    _ConstraintsBiReset(contacts_333_3);
+    _ConstraintsBiReset(contacts_333_6);
+    _ConstraintsBiReset(contacts_333_333);
+    _ConstraintsBiReset(contacts_666_3);
+    _ConstraintsBiReset(contacts_666_6);
+    _ConstraintsBiReset(contacts_666_333);
+    _ConstraintsBiReset(contacts_666_666);
+    _ConstraintsBiReset(contacts_6_6_rolling);
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-        ++itercontact;
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contacts, double factor, double recovery_clamp, bool do_clamp) {
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
 }
 
 void ChContactContainerNSC::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
-    _ConstraintsBiLoad_C(contactlist_6_6, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_6_3, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_3_3, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_333_3, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_333_6, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_333_333, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_666_3, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_666_6, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_666_333, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_666_666, factor, recovery_clamp, do_clamp);
-    _ConstraintsBiLoad_C(contactlist_6_6_rolling, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_6_6, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_6_3, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_3_3, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_333_3, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_333_6, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_333_333, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_666_3, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_666_6, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_666_333, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_666_666, factor, recovery_clamp, do_clamp);
+    _ConstraintsBiLoad_C(contacts_6_6_rolling, factor, recovery_clamp, do_clamp);
 }
 
 void ChContactContainerNSC::ConstraintsLoadJacobians() {
@@ -767,27 +709,25 @@ void ChContactContainerNSC::ConstraintsLoadJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contacts, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsFetch_react(factor);
-        ++itercontact;
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contacts[i].ConstraintsFetch_react(factor);
     }
 }
 
 void ChContactContainerNSC::ConstraintsFetch_react(double factor) {
-    _ConstraintsFetch_react(contactlist_6_6, factor);
-    _ConstraintsFetch_react(contactlist_6_3, factor);
-    _ConstraintsFetch_react(contactlist_3_3, factor);
-    _ConstraintsFetch_react(contactlist_333_3, factor);
-    _ConstraintsFetch_react(contactlist_333_6, factor);
-    _ConstraintsFetch_react(contactlist_333_333, factor);
-    _ConstraintsFetch_react(contactlist_666_3, factor);
-    _ConstraintsFetch_react(contactlist_666_6, factor);
-    _ConstraintsFetch_react(contactlist_666_333, factor);
-    _ConstraintsFetch_react(contactlist_666_666, factor);
-    _ConstraintsFetch_react(contactlist_6_6_rolling, factor);
+    _ConstraintsFetch_react(contacts_6_6, factor);
+    _ConstraintsFetch_react(contacts_6_3, factor);
+    _ConstraintsFetch_react(contacts_3_3, factor);
+    _ConstraintsFetch_react(contacts_333_3, factor);
+    _ConstraintsFetch_react(contacts_333_6, factor);
+    _ConstraintsFetch_react(contacts_333_333, factor);
+    _ConstraintsFetch_react(contacts_666_3, factor);
+    _ConstraintsFetch_react(contacts_666_6, factor);
+    _ConstraintsFetch_react(contacts_666_333, factor);
+    _ConstraintsFetch_react(contacts_666_666, factor);
+    _ConstraintsFetch_react(contacts_6_6_rolling, factor);
 }
 
 void ChContactContainerNSC::ArchiveOUT(ChArchiveOut& marchive) {
@@ -15,17 +15,20 @@
 #ifndef CH_CONTACTCONTAINER_NSC_H
 #define CH_CONTACTCONTAINER_NSC_H
 
-#include <list>
+#include <deque>
+#include <tuple>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many non-smooth contacts.
-/// Implemented using linked lists of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
+/// Implemented using pools of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
 /// reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC, with 6 reactions,
 /// that account also for rolling and spinning resistance), but also for '6dof vs 6dof' contactables.
 class ChApi ChContactContainerNSC : public ChContactContainer {
@@ -44,46 +47,45 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     typedef ChContactNSCrolling<ChContactable_1vars<6>, ChContactable_1vars<6> > ChContactNSCrolling_6_6;
 
   protected:
-    std::list<ChContactNSC_6_6*> contactlist_6_6;
-    std::list<ChContactNSC_6_3*> contactlist_6_3;
-    std::list<ChContactNSC_3_3*> contactlist_3_3;
-    std::list<ChContactNSC_333_3*> contactlist_333_3;
-    std::list<ChContactNSC_333_6*> contactlist_333_6;
-    std::list<ChContactNSC_333_333*> contactlist_333_333;
-    std::list<ChContactNSC_666_3*> contactlist_666_3;
-    std::list<ChContactNSC_666_6*> contactlist_666_6;
-    std::list<ChContactNSC_666_333*> contactlist_666_333;
-    std::list<ChContactNSC_666_666*> contactlist_666_666;
-
-    std::list<ChContactNSCrolling_6_6*> contactlist_6_6_rolling;
-
-    int n_added_6_6;
-    int n_added_6_3;
-    int n_added_3_3;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-    int n_added_6_6_rolling;
-
-    std::list<ChContactNSC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactNSC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactNSC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactNSC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactNSC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactNSC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactNSC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactNSC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactNSC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactNSC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
+    ChContactPool<ChContactNSC_6_6> contacts_6_6;
+    ChContactPool<ChContactNSC_6_3> contacts_6_3;
+    ChContactPool<ChContactNSC_3_3> contacts_3_3;
+    ChContactPool<ChContactNSC_333_3> contacts_333_3;
+    ChContactPool<ChContactNSC_333_6> contacts_333_6;
+    ChContactPool<ChContactNSC_333_333> contacts_333_333;
+    ChContactPool<ChContactNSC_666_3> contacts_666_3;
+    ChContactPool<ChContactNSC_666_6> contacts_666_6;
+    ChContactPool<ChContactNSC_666_333> contacts_666_333;
+    ChContactPool<ChContactNSC_666_666> contacts_666_666;
+
+    ChContactPool<ChContactNSCrolling_6_6> contacts_6_6_rolling;
 
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
+    /// Persistent data for a contact, used to warm start its multipliers in the next collision pass.
+    struct CachedContact {
+        int modelA;          ///< identifier of collision model A
+        int modelB;          ///< identifier of collision model B
+        int shapeA;          ///< index of the collision shape in model A
+        int shapeB;          ///< index of the collision shape in model B
+        ChVector<> point;    ///< contact point on A, in the collision frame of contactable A
+        float reactions[6];  ///< cached reactions (same layout as collision system reaction caches)
+        bool matched;        ///< already matched to a contact in the current collision pass
+
+        /// Order cached contacts by their key (pair of collision model identifiers and shape indices).
+        bool operator<(const CachedContact& other) const {
+            return std::tie(modelA, modelB, shapeA, shapeB) <
+                   std::tie(other.modelA, other.modelB, other.shapeA, other.shapeB);
+        }
+    };
+
+    bool use_contact_cache;                         ///< match contacts across collision passes for warm starting
+    double contact_cache_tol;                       ///< tolerance on contact point position for matching contacts
+    std::deque<CachedContact> contact_cache;        ///< cache entries for current collision pass (stable addresses)
+    std::vector<CachedContact> contact_cache_prev;  ///< cache entries from previous collision pass, sorted by key
+    int n_matched;                                  ///< number of contacts matched to a previous contact
+    int n_new;                                      ///< number of contacts with no match in the previous pass
+
   public:
     ChContactContainerNSC();
     ChContactContainerNSC(const ChContactContainerNSC& other);
@@ -94,17 +96,39 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// Report the number of added contacts.
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666 + n_added_6_6_rolling;
+        return (int)(contacts_3_3.size() + contacts_6_3.size() + contacts_6_6.size() + contacts_333_3.size() +
+                     contacts_333_6.size() + contacts_333_333.size() + contacts_666_3.size() + contacts_666_6.size() +
+                     contacts_666_333.size() + contacts_666_666.size() + contacts_6_6_rolling.size());
     }
 
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllContacts() override;
 
+    /// Enable/disable the persistent contact cache (default: true).
+    /// If enabled, each new contact is matched against the contacts from the previous collision pass with the same
+    /// pair of collision models and shapes (identified by the model identifiers and the shape indices); the nearest one (see SetContactCacheTolerance) provides the initial value
+    /// of the contact multipliers. Together with a solver warm start (see ChIterativeSolver::EnableWarmStart), this
+    /// reduces the number of solver iterations for persistent contacts (e.g. stacking).
+    /// The container cache is used only for contacts which do not carry a reaction cache provided by the collision
+    /// system (such as the persistent contact manifolds of the Bullet collision system).
+    void EnableContactCache(bool val);
+
+    /// Set the maximum distance between the contact points (in the collision frame of the first contactable) of two
+    /// contacts from consecutive collision passes for them to be considered the same contact.
+    /// By default, this is the default suggested collision envelope.
+    void SetContactCacheTolerance(double tol) { contact_cache_tol = tol; }
+
+    /// Report the number of contacts in the last collision pass matched to a contact from the previous pass.
+    /// Only contacts managed through the container cache are counted (see EnableContactCache).
+    int GetNcontactsMatched() const { return n_matched; }
+
+    /// Report the number of contacts in the last collision pass with no match in the previous pass.
+    /// Only contacts managed through the container cache are counted (see EnableContactCache).
+    int GetNcontactsNew() const { return n_new; }
+
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
-    /// allocation/deallocation.
+    /// similar). Instead of simply deleting all the previous contacts, this optimized implementation rewinds the
+    /// contact pools and reuses the previous contact objects as much as possible, to avoid allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two collision shapes, storing it into this container.
@@ -120,7 +144,7 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). Contact objects that were not reused are kept in the pools, available for the next collision pass.
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
@@ -159,9 +183,7 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Report the number of scalar unilateral constraints.
     /// Note: friction constraints aren't exactly unilaterals, but they are still counted.
     virtual int GetDOC_d() override {
-        return 3 * (n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-                    n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666) +
-               6 * (n_added_6_6_rolling);
+        return 3 * GetNcontacts() + 3 * (int)contacts_6_6_rolling.size();
     }
 
     /// Update state of this contact container: compute jacobians, violations, etc.
@@ -226,6 +248,8 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
   private:
     void InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat);
+    void CreateContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat);
+    float* CacheContact(const collision::ChCollisionInfo& cinfo);
 };
 
 CH_CLASS_VERSION(ChContactContainerNSC, 0)
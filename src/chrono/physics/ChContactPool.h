@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace chrono {
+
+/// Pooled storage for contacts of a given type.
+/// Contact objects are constructed in place in fixed-size blocks of contiguous memory. Objects are never relocated
+/// once constructed, so that pointers to their constraints (as injected in the system descriptor) remain valid.
+/// Slots are reused from one collision detection pass to the next: Rewind() resets the number of active contacts,
+/// Add() re-initializes an already constructed contact when one is available and only constructs a new one when the
+/// pool must grow. Storage is kept at its high-water mark until Clear() is called.
+template <class Tcont>
+class ChContactPool {
+  public:
+    ChContactPool() : m_size(0), m_constructed(0) {}
+    ~ChContactPool() { Clear(); }
+
+    ChContactPool(const ChContactPool&) = delete;
+    ChContactPool& operator=(const ChContactPool&) = delete;
+
+    /// Return the number of active contacts.
+    size_t size() const { return m_size; }
+
+    /// Return the number of contact slots currently allocated.
+    size_t capacity() const { return m_blocks.size() * BLOCK_SIZE; }
+
+    /// Access the i-th active contact.
+    Tcont& operator[](size_t i) { return m_blocks[i >> BLOCK_SHIFT][i & BLOCK_MASK]; }
+    const Tcont& operator[](size_t i) const { return m_blocks[i >> BLOCK_SHIFT][i & BLOCK_MASK]; }
+
+    /// Mark all contacts as inactive, without releasing them. Subsequent calls to Add() reuse existing slots.
+    void Rewind() { m_size = 0; }
+
+    /// Add a contact to the pool, reusing a previously constructed contact object if possible.
+    template <class Tcontainer, class Ta, class Tb, class Tinfo, class Tmat>
+    Tcont& Add(Tcontainer* container, Ta* objA, Tb* objB, const Tinfo& cinfo, const Tmat& cmat) {
+        if (m_size < m_constructed) {
+            // reuse old contact
+            Tcont& contact = (*this)[m_size++];
+            contact.Reset(objA, objB, cinfo, cmat);
+            return contact;
+        }
+
+        // construct new contact (allocate a new block if needed)
+        if (m_constructed == capacity())
+            m_blocks.push_back(m_allocator.allocate(BLOCK_SIZE));
+        Tcont* slot = &m_blocks[m_constructed >> BLOCK_SHIFT][m_constructed & BLOCK_MASK];
+        ::new (static_cast<void*>(slot)) Tcont(container, objA, objB, cinfo, cmat);
+        m_constructed++;
+        m_size++;
+        return *slot;
+    }
+
+    /// Destroy all contacts and release all storage.
+    void Clear() {
+        for (size_t i = 0; i < m_constructed; i++)
+            m_blocks[i >> BLOCK_SHIFT][i & BLOCK_MASK].~Tcont();
+        for (auto block : m_blocks)
+            m_allocator.deallocate(block, BLOCK_SIZE);
+        m_blocks.clear();
+        m_size = 0;
+        m_constructed = 0;
+    }
+
+  private:
+    static const size_t BLOCK_SHIFT = 7;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_SHIFT;
+    static const size_t BLOCK_MASK = BLOCK_SIZE - 1;
+
+    std::vector<Tcont*> m_blocks;                 ///< blocks of BLOCK_SIZE contiguous contact slots
+    Eigen::aligned_allocator<Tcont> m_allocator;  ///< allocator (contacts contain fixed-size Eigen objects)
+    size_t m_size;                                ///< number of active contacts
+    size_t m_constructed;                         ///< number of constructed contacts (active or available for reuse)
+};
+
+}  // end namespace chrono
+
+#endif
@@ -12,8 +12,6 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
-#include <list>
-
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChMatterSPH.h"
 #include "chrono/physics/ChProximityContainerSPH.h"
@@ -27,97 +25,62 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerSPH)
 
-ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0) {
-    lastproximity = proximitylist.begin();
-}
+ChProximityContainerSPH::ChProximityContainerSPH() : m_skin_factor(0.2) {}
 
 ChProximityContainerSPH::ChProximityContainerSPH(const ChProximityContainerSPH& other)
     : ChProximityContainer(other) {
-    n_added = other.n_added;
-    proximitylist = other.proximitylist;
-    lastproximity = proximitylist.begin();
-}
-
-ChProximityContainerSPH::~ChProximityContainerSPH() {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
-    proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
-    n_added = 0;
-}
-
-void ChProximityContainerSPH::RemoveAllProximities() {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        delete (*iterproximity);
-        (*iterproximity) = 0;
-        ++iterproximity;
-        // proximitylist.erase(iterproximity); //no! do later with clear(), all together
-    }
-    proximitylist.clear();
-
-    lastproximity = proximitylist.begin();
-    n_added = 0;
+    m_skin_factor = other.m_skin_factor;
 }
 
-void ChProximityContainerSPH::BeginAddProximities() {
-    lastproximity = proximitylist.begin();
-    n_added = 0;
+void ChProximityContainerSPH::SetSkinFactor(double factor) {
+    m_skin_factor = ChMax(0.0, factor);
+    m_search.Reset();
 }
 
-void ChProximityContainerSPH::EndAddProximities() {
-    // remove proximities that are beyond last proximity
-    while (lastproximity != proximitylist.end()) {
-        delete (*lastproximity);
-        lastproximity = proximitylist.erase(lastproximity);
+void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcallback) {
+    for (size_t i = 0; i < m_search.GetNumPoints(); i++) {
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        for (unsigned int k = 0; k < m_search.GetNumNeighbors(i); k++) {
+            if (nbrs[k] < i)
+                continue;
+            bool proceed = mcallback->OnReportProximity(m_nodes[i]->collision_model, m_nodes[nbrs[k]]->collision_model);
+            if (!proceed)
+                return;
+        }
     }
 }
 
-void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, collision::ChCollisionModel* modB) {
-    // Fetch the frames of that proximity and other infos
-
-    ChNodeSPH* mnA = dynamic_cast<ChNodeSPH*>(modA->GetContactable());
-    ChNodeSPH* mnB = dynamic_cast<ChNodeSPH*>(modB->GetContactable());
-
-    if (!(mnA && mnB))
-        return;
-
-    // Launch the proximity callback, if implemented by the user
-
-    if (this->add_proximity_callback) {
-        this->add_proximity_callback->OnAddProximity(*modA, *modB);
+void ChProximityContainerSPH::UpdateNeighbors() {
+    // Collect the nodes of all SPH matter items in the system
+    m_nodes.clear();
+    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
+        if (auto matter = std::dynamic_pointer_cast<ChMatterSPH>(otherphysics)) {
+            for (const auto& node : matter->GetNodes())
+                m_nodes.push_back(node.get());
+        }
     }
 
-    // %%%%%%% Create and add a ChProximitySPH object
-
-    if (lastproximity != proximitylist.end()) {
-        // reuse old proximity pairs
-        (*lastproximity)->Reset(modA, modB);
-
-        lastproximity++;
-    } else {
-        // add new proximity
-        ChProximitySPH* mp = new ChProximitySPH(modA, modB);
-
-        proximitylist.push_back(mp);
-        lastproximity = proximitylist.end();
+    double h_max = 0;
+    m_pos.resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        m_pos[i] = m_nodes[i]->GetPos();
+        h_max = ChMax(h_max, m_nodes[i]->GetKernelRadius());
     }
-    n_added++;
-}
 
-void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcallback) {
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
-        if (!proceed)
-            break;
-        ++iterproximity;
+    m_search.SetNumThreads(GetSystem()->GetNumThreadsChrono());
+    m_search.SetSkin(m_skin_factor * h_max);
+    bool rebuilt = m_search.Update(m_pos, h_max);
+
+    // Launch the proximity callback on the new pairs, if implemented by the user
+    if (rebuilt && add_proximity_callback) {
+        for (size_t i = 0; i < m_search.GetNumPoints(); i++) {
+            const unsigned int* nbrs = m_search.GetNeighbors(i);
+            for (unsigned int k = 0; k < m_search.GetNumNeighbors(i); k++) {
+                if (nbrs[k] > i)
+                    add_proximity_callback->OnAddProximity(*m_nodes[i]->collision_model,
+                                                           *m_nodes[nbrs[k]]->collision_model);
+            }
+        }
     }
 }
 
@@ -125,89 +88,92 @@ void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcal
 
 static double W_poly6(double r, double h) {
     if (r < h) {
-        return (315.0 / (64.0 * CH_C_PI * pow(h, 9))) * pow((h * h - r * r), 3);
+        double h3 = h * h * h;
+        double q = h * h - r * r;
+        return (315.0 / (64.0 * CH_C_PI * h3 * h3 * h3)) * (q * q * q);
     } else
         return 0;
 }
 
 static double W_sq_visco(double r, double h) {
     if (r < h) {
-        return (45.0 / (CH_C_PI * pow(h, 6))) * (h - r);
+        double h3 = h * h * h;
+        return (45.0 / (CH_C_PI * h3 * h3)) * (h - r);
     } else
         return 0;
 }
 
 static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_length, const double h) {
     if (r_length < h) {
+        double h3 = h * h * h;
         Wresult = r;
-        Wresult *= -(45.0 / (CH_C_PI * pow(h, 6))) * pow((h - r_length), 2.0);
+        Wresult *= -(45.0 / (CH_C_PI * h3 * h3)) * (h - r_length) * (h - r_length);
     } else
         Wresult = VNULL;
 }
 
-void ChProximityContainerSPH::AccumulateStep1() {
-    // Per-edge data computation
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
-
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
-
-        ChVector<> r_BA = x_B - x_A;
-        double dist_BA = r_BA.Length();
-
-        double W_k_poly6 = W_poly6(dist_BA, mnodeA->GetKernelRadius());
-
-        // increment data of connected nodes
+// Note: for each pair, the kernel radius is the average of the radii of the two nodes, so that
+// densities are consistent and the pairwise forces are equal and opposite.
 
-        mnodeA->density += mnodeB->GetMass() * W_k_poly6;
-        mnodeB->density += mnodeA->GetMass() * W_k_poly6;
-
-        ++iterproximity;
+void ChProximityContainerSPH::AccumulateStep1() {
+    UpdateNeighbors();
+
+    // Per-node gathering of densities from the neighbor nodes
+    int num_nodes = (int)m_nodes.size();
+#pragma omp parallel for num_threads(GetSystem()->GetNumThreadsChrono())
+    for (int i = 0; i < num_nodes; i++) {
+        ChNodeSPH* mnodeA = m_nodes[i];
+        const ChVector<>& x_A = m_pos[i];
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        unsigned int num_nbrs = m_search.GetNumNeighbors(i);
+
+        double density = 0;
+        for (unsigned int k = 0; k < num_nbrs; k++) {
+            ChNodeSPH* mnodeB = m_nodes[nbrs[k]];
+            double dist_BA = (m_pos[nbrs[k]] - x_A).Length();
+            double h = 0.5 * (mnodeA->GetKernelRadius() + mnodeB->GetKernelRadius());
+            density += mnodeB->GetMass() * W_poly6(dist_BA, h);
+        }
+
+        mnodeA->density += density;
     }
 }
 
 void ChProximityContainerSPH::AccumulateStep2() {
-    // Per-edge data computation (transfer stress to forces)
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
-
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
-
-        ChVector<> r_BA = x_B - x_A;
-        double dist_BA = r_BA.Length();
-
-        // increment pressure forces
-
-        ChVector<> W_k_press;
-        W_gr_press(W_k_press, r_BA, dist_BA, mnodeA->GetKernelRadius());
-
-        double avg_press = 0.5 * (mnodeA->pressure + mnodeB->pressure);
-
-        ChVector<> pressureForceA = W_k_press * mnodeA->volume * avg_press * mnodeB->volume;
-        mnodeA->UserForce += pressureForceA;
-
-        // ChVector<> pressureForceB  = - W_k_press * mnodeB->volume * avg_dens * mnodeA->volume;
-        mnodeB->UserForce -= pressureForceA;
-
-        // increment viscous forces..
-
-        double W_k_visc = W_sq_visco(dist_BA, mnodeA->GetKernelRadius());
-        ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
-
-        double avg_viscosity = 0.5 * (mnodeA->GetContainer()->GetMaterial().Get_viscosity() +
-                                      mnodeB->GetContainer()->GetMaterial().Get_viscosity());
-
-        ChVector<> viscforceBA = velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
-        mnodeA->UserForce += viscforceBA;
-        mnodeB->UserForce -= viscforceBA;
-
-        ++iterproximity;
+    // Per-node gathering of pressure and viscous forces from the neighbor nodes
+    int num_nodes = (int)m_nodes.size();
+#pragma omp parallel for num_threads(GetSystem()->GetNumThreadsChrono())
+    for (int i = 0; i < num_nodes; i++) {
+        ChNodeSPH* mnodeA = m_nodes[i];
+        const ChVector<>& x_A = m_pos[i];
+        const unsigned int* nbrs = m_search.GetNeighbors(i);
+        unsigned int num_nbrs = m_search.GetNumNeighbors(i);
+        double visc_A = mnodeA->GetContainer()->GetMaterial().Get_viscosity();
+
+        ChVector<> force(VNULL);
+        for (unsigned int k = 0; k < num_nbrs; k++) {
+            ChNodeSPH* mnodeB = m_nodes[nbrs[k]];
+
+            ChVector<> r_BA = m_pos[nbrs[k]] - x_A;
+            double dist_BA = r_BA.Length();
+            double h = 0.5 * (mnodeA->GetKernelRadius() + mnodeB->GetKernelRadius());
+            if (dist_BA >= h)
+                continue;
+
+            // pressure force
+            ChVector<> W_k_press;
+            W_gr_press(W_k_press, r_BA, dist_BA, h);
+            double avg_press = 0.5 * (mnodeA->pressure + mnodeB->pressure);
+            force += W_k_press * (mnodeA->volume * avg_press * mnodeB->volume);
+
+            // viscous force
+            double W_k_visc = W_sq_visco(dist_BA, h);
+            ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
+            double avg_viscosity = 0.5 * (visc_A + mnodeB->GetContainer()->GetMaterial().Get_viscosity());
+            force += velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
+        }
+
+        mnodeA->UserForce += force;
     }
 }
 
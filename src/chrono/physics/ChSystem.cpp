@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <unordered_map>
 
 #include "chrono/collision/ChCollisionSystemBullet.h"
 #ifdef CHRONO_COLLISION
@@ -26,11 +27,13 @@
 #include "chrono/solver/ChSolverPJacobi.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverPSORparallel.h"
 #include "chrono/solver/ChSolverPSSOR.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/solver/ChDirectSolverLS.h"
 #include "chrono/core/ChMatrix.h"
 #include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChUnionFind.h"
 
 using namespace chrono::collision;
 
@@ -266,6 +269,12 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         case ChSolver::Type::PSSOR:
             solver = chrono_types::make_shared<ChSolverPSSOR>();
             break;
+        case ChSolver::Type::PSOR_PARALLEL: {
+            auto psor = chrono_types::make_shared<ChSolverPSORparallel>();
+            psor->SetNumThreads(nthreads_chrono);
+            solver = psor;
+            break;
+        }
         case ChSolver::Type::PJACOBI:
             solver = chrono_types::make_shared<ChSolverPJacobi>();
             break;
@@ -290,6 +299,12 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         case ChSolver::Type::SPARSE_QR:
             solver = chrono_types::make_shared<ChSolverSparseQR>();
             break;
+        case ChSolver::Type::SPARSE_LDLT: {
+            auto ldlt = chrono_types::make_shared<ChSolverSparseLDLT>();
+            ldlt->SetNumThreads(nthreads_chrono);
+            solver = ldlt;
+            break;
+        }
         default:
             GetLog() << "Solver type not supported. Use SetSolver instead.\n";
             break;
@@ -390,6 +405,9 @@ void ChSystem::SetNumThreads(int num_threads_chrono, int num_threads_collision,
     nthreads_eigen = (num_threads_eigen <= 0) ? num_threads_chrono : num_threads_eigen;
 
     collision_system->SetNumThreads(nthreads_collision);
+
+    if (auto psor = std::dynamic_pointer_cast<ChSolverPSORparallel>(solver))
+        psor->SetNumThreads(nthreads_chrono);
 }
 
 // -----------------------------------------------------------------------------
@@ -519,13 +537,36 @@ bool ChSystem::ManageSleepingBodies() {
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one,
-    // if so, set to no sleep.
+    // Group the bodies in islands, i.e. bodies connected through links (that require waking) and contacts.
+    // Fixed bodies do not connect islands. An island sleeps as a whole: if some of its bodies is awake and
+    // could not sleep, all the bodies in the island are woken up.
+
+    int nbodies = (int)assembly.bodylist.size();
+    std::unordered_map<ChBody*, int> body_index;
+    body_index.reserve(nbodies);
+    for (int i = 0; i < nbodies; i++)
+        body_index.emplace(assembly.bodylist[i].get(), i);
+
+    utils::ChUnionFind islands(nbodies);
 
     // Make this class for iterating through contacts
 
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
+    class _island_reporter_class : public ChContactContainer::ReportContactCallback {
       public:
+        _island_reporter_class(std::unordered_map<ChBody*, int>& index, utils::ChUnionFind& sets)
+            : body_index(index), islands(sets) {}
+
+        // Merge the islands of the two bodies, unless one of them is fixed or not in the system
+        void Connect(ChBody* b1, ChBody* b2) {
+            if (!(b1 && b2) || b1->GetBodyFixed() || b2->GetBodyFixed())
+                return;
+            auto i1 = body_index.find(b1);
+            auto i2 = body_index.find(b2);
+            if (i1 == body_index.end() || i2 == body_index.end())
+                return;
+            islands.Union(i1->second, i2->second);
+        }
+
         // Callback, used to report contact points already added to the container.
         // If returns false, the contact scanning will be stopped.
         virtual bool OnReportContact(
@@ -539,87 +580,47 @@ bool ChSystem::ManageSleepingBodies() {
             ChContactable* contactobjA,  // get model A (note: some containers may not support it and could be zero!)
             ChContactable* contactobjB   // get model B (note: some containers may not support it and could be zero!)
             ) override {
-            if (!(contactobjA && contactobjB))
-                return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = sleep1 | sleep2 | someone_sleeps;
-
+            Connect(dynamic_cast<ChBody*>(contactobjA), dynamic_cast<ChBody*>(contactobjB));
             return true;  // to continue scanning contacts
         }
 
-        // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        std::unordered_map<ChBody*, int>& body_index;
+        utils::ChUnionFind& islands;
     };
 
-    auto my_waker = chrono_types::make_shared<_wakeup_reporter_class>();
-    my_waker->need_Setup_A = false;
-
-    bool need_Setup_L = false;
+    auto my_islands = chrono_types::make_shared<_island_reporter_class>(body_index, islands);
 
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker->someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (auto& link : assembly.linklist) {
-            if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
-                if (Lpointer->IsRequiringWaking()) {
-                    ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                    ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                    if (b1 && b2) {
-                        bool sleep1 = b1->GetSleeping();
-                        bool sleep2 = b2->GetSleeping();
-                        bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        if (sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                        if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                    }
-                }
-            }
+    // scan all links and connect their bodies
+    for (auto& link : assembly.linklist) {
+        if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(link)) {
+            if (Lpointer->IsRequiringWaking())
+                my_islands->Connect(dynamic_cast<ChBody*>(Lpointer->GetBody1()),
+                                    dynamic_cast<ChBody*>(Lpointer->GetBody2()));
         }
+    }
 
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(my_waker);
+    // scan all contacts and connect the bodies in contact
+    contact_container->ReportAllContacts(my_islands);
 
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker->someone_sleeps)
-            break;
+    // An island is awake if some of its bodies is neither sleeping nor a sleep candidate
+    std::vector<char> island_awake(nbodies, 0);
+    for (int i = 0; i < nbodies; i++) {
+        auto& body = assembly.bodylist[i];
+        if (!body->GetBodyFixed() && !body->GetSleeping() && !body->BFlagGet(ChBody::BodyFlag::COULDSLEEP))
+            island_awake[islands.Find(i)] = 1;
+    }
+
+    // wake up all bodies in awake islands
+    bool need_Setup_A = false;
+    for (int i = 0; i < nbodies; i++) {
+        if (!island_awake[islands.Find(i)])
+            continue;
+        auto& body = assembly.bodylist[i];
+        if (body->GetSleeping()) {
+            body->SetSleeping(false);
+            need_Setup_A = true;
+        }
+        body->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
     }
 
     /// If some body still must change from no sleep-> sleep, do it
@@ -633,7 +634,7 @@ bool ChSystem::ManageSleepingBodies() {
 
     // if some body has been activated/deactivated because of sleep state changes,
     // the offsets and DOF counts must be updated:
-    if (my_waker->need_Setup_A || need_Setup_B || need_Setup_L) {
+    if (need_Setup_A || need_Setup_B) {
         Setup();
         return true;
     }
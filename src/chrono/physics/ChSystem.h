@@ -218,8 +218,10 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
     /// Set the number of OpenMP threads used by Chrono itself, Eigen, and the collision detection system.
     /// <pre>
-    ///   num_threads_chrono    - used in FEA (parallel evaluation of internal forces and Jacobians) and
-    ///                           in SCM deformable terrain calculations.
+    ///   num_threads_chrono    - used in FEA (parallel evaluation of internal forces and Jacobians),
+    ///                           in SCM deformable terrain calculations, and in the parallel PSOR solver.
+    ///                           Parallel system descriptor products are enabled separately, see
+    ///                           ChSystemDescriptor::SetNumThreads().
     ///   num_threads_collision - used in parallelization of collision detection (if applicable).
     ///                           If passing 0, then num_threads_collision = num_threads_chrono.
     ///   num_threads_eigen     - used in the Eigen sparse direct solvers and a few linear algebra operations.
@@ -712,6 +714,7 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// motion has almost come to a rest. This feature will allow faster simulation
     /// of large scenarios for real-time purposes, but it will affect the precision!
     /// This functionality can be turned off selectively for specific ChBodies.
+    /// Bodies connected through links and contacts (islands) are put to sleep and woken up together.
     void SetUseSleeping(bool ms) { use_sleeping = ms; }
 
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
@@ -19,8 +19,12 @@
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
 
+#include <vector>
+
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -264,6 +268,14 @@ class ChApi ChConstraint {
     /// a 'boxed constraint': l_i= ChMin(ChMax(min., l_i), max); etc. etc.
     virtual void Project();
 
+    /// Append to 'vars' the ChVariables objects referenced by this constraint.
+    /// This is used by ChSystemDescriptor to schedule race-free parallel updates of the variables.
+    /// Return false if the referenced variables are not known, in which case parallel operations
+    /// on the descriptor fall back to the serial implementation.
+    /// Note that Project() must only modify the multipliers of this constraint (or of constraints
+    /// whose Project() does nothing, like the tangential components of a frictional contact).
+    virtual bool ListVariables(std::vector<ChVariables*>& vars) { return false; }
+
     /// Given the residual of the constraint computed as the
     /// linear map  mc_i =  [Cq]*q + b_i + cfm*l_i , returns the
     /// violation of the constraint, considering inequalities, etc.
@@ -111,6 +111,12 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_b.MultiplyTandAdd(result, l);
     }
 
+    virtual bool ListVariables(std::vector<ChVariables*>& vars) override {
+        tuple_a.ListVariables(vars);
+        tuple_b.ListVariables(vars);
+        return true;
+    }
+
     /// Puts the two jacobian parts into the 'insrow' row of a sparse matrix,
     /// where both portions of the jacobian are shifted in order to match the
     /// offset of the corresponding ChVariable.The same is done
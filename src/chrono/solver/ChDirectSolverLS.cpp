@@ -30,7 +30,11 @@ ChDirectSolverLS::ChDirectSolverLS()
       m_dim(0),
       m_sparsity(-1),
       m_solve_call(0),
-      m_setup_call(0) {}
+      m_setup_call(0),
+      m_analyze_call(0),
+      m_analyze(true),
+      m_analyze_dim(0),
+      m_analyze_nnz(0) {}
 
 void ChDirectSolverLS::ResetTimers() {
     m_timer_setup_assembly.reset();
@@ -83,6 +87,10 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     // Allow the matrix to be compressed
     m_mat.makeCompressed();
 
+    // Redo the symbolic analysis unless the sparsity pattern is locked and the matrix structure did not change
+    m_analyze = !m_lock || call_learner || m_analyze_call == 0 || m_dim != m_analyze_dim ||
+                (int)m_mat.nonZeros() != m_analyze_nnz;
+
     m_timer_setup_assembly.stop();
 
     if (write_matrix)
@@ -96,9 +104,15 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     if (write_matrix)
         WriteMatrix("LS_" + frame_id + "_F.dat", m_mat);
 
+    if (result && m_analyze) {
+        m_analyze_call++;
+        m_analyze_dim = m_dim;
+        m_analyze_nnz = (int)m_mat.nonZeros();
+    }
+
     if (verbose) {
         GetLog() << " Solver setup [" << m_setup_call << "] n = " << m_dim << "  nnz = " << (int)m_mat.nonZeros()
-                 << "\n";
+                 << "  analyze? " << m_analyze << "\n";
         GetLog() << "  assembly matrix:   " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s\n"
                  << "  analyze+factorize: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "s\n";
     }
@@ -159,6 +173,9 @@ bool ChDirectSolverLS::SetupCurrent() {
     // Allow the matrix to be compressed, if not yet compressed
     m_mat.makeCompressed();
 
+    // The matrix may have been modified arbitrarily by the caller
+    m_analyze = true;
+
     m_timer_setup_assembly.stop();
 
     // Let the concrete solver perform the factorization
@@ -166,6 +183,12 @@ bool ChDirectSolverLS::SetupCurrent() {
     bool result = FactorizeMatrix();
     m_timer_setup_solvercall.stop();
 
+    if (result) {
+        m_analyze_call++;
+        m_analyze_dim = (int)m_mat.rows();
+        m_analyze_nnz = (int)m_mat.nonZeros();
+    }
+
     if (verbose) {
         GetLog() << " Solver SetupCurrent() [" << m_setup_call << "] n = " << m_dim
                  << "  nnz = " << (int)m_mat.nonZeros() << "\n";
@@ -265,7 +288,9 @@ void ChDirectSolverLS::ArchiveIN(ChArchiveIn& marchive) {
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseLU::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (m_analyze)
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
@@ -294,7 +319,9 @@ void ChSolverSparseLU::PrintErrorMessage() {
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseQR::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (m_analyze)
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
@@ -320,4 +347,40 @@ void ChSolverSparseQR::PrintErrorMessage() {
     }
 }
 
+// ---------------------------------------------------------------------------
+
+bool ChSolverSparseLDLT::Setup(ChSystemDescriptor& sysd) {
+    m_num_vars = sysd.CountActiveVariables();
+    return ChDirectSolverLS::Setup(sysd);
+}
+
+bool ChSolverSparseLDLT::FactorizeMatrix() {
+    if (m_analyze || !m_engine.IsAnalyzed())
+        m_engine.Analyze(m_mat, m_num_vars);
+    return m_engine.Factorize(m_mat);
+}
+
+bool ChSolverSparseLDLT::SolveSystem() {
+    m_sol = m_rhs;
+    m_engine.Solve(m_sol);
+
+    // Iterative refinement, to compensate for perturbed pivots
+    if (m_engine.GetNumPerturbedPivots() > 0) {
+        ChVectorDynamic<double> res(m_rhs.size());
+        for (int i = 0; i < m_refinement_steps; i++) {
+            res = m_rhs - m_mat * m_sol;
+            m_engine.Solve(res);
+            m_sol += res;
+        }
+    }
+
+    return m_sol.allFinite();
+}
+
+void ChSolverSparseLDLT::PrintErrorMessage() {
+    GetLog() << "LDLT factorization or solution is not finite (singular or non-symmetric matrix?)\n";
+    if (m_engine.GetNumPerturbedPivots() > 0)
+        GetLog() << "  perturbed pivots: " << m_engine.GetNumPerturbedPivots() << "\n";
+}
+
 }  // end namespace chrono
@@ -18,6 +18,7 @@
 #include "chrono/core/ChMatrix.h"
 #include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolverLS.h"
+#include "chrono/solver/ChSupernodalLDLT.h"
 
 #include <Eigen/SparseLU>
 
@@ -123,10 +124,13 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// Get cumulative time for Pardiso calls in Setup phase.
     double GetTimeSetup_SolverCall() const { return m_timer_setup_solvercall(); }
 
-    /// Return the number of calls to the solver's Setup function.
+    /// Return the number of calls to the solver's Setup function (i.e., the number of numeric factorizations).
     int GetNumSetupCalls() const { return m_setup_call; }
     /// Return the number of calls to the solver's Setup function.
     int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of symbolic analyses of the matrix sparsity pattern.
+    /// With a locked sparsity pattern, the symbolic analysis is reused by all factorizations with unchanged pattern.
+    int GetNumAnalyzeCalls() const { return m_analyze_call; }
 
     /// Get a handle to the underlying matrix.
     ChSparseMatrix& GetMatrix() { return m_mat; }
@@ -173,6 +177,8 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     ChDirectSolverLS();
 
     /// Factorize the current sparse matrix and return true if successful.
+    /// If m_analyze is false, the sparsity pattern did not change since the last factorization and a concrete solver
+    /// may skip the symbolic analysis and only perform the numeric factorization.
     virtual bool FactorizeMatrix() = 0;
 
     /// Solve the linear system using the current factorization and right-hand side vector.
@@ -194,8 +200,13 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     ChVectorDynamic<double> m_rhs;  ///< right-hand side vector
     ChVectorDynamic<double> m_sol;  ///< solution vector
 
-    int m_solve_call;  ///< counter for calls to Solve
-    int m_setup_call;  ///< counter for calls to Setup
+    int m_solve_call;    ///< counter for calls to Solve
+    int m_setup_call;    ///< counter for calls to Setup
+    int m_analyze_call;  ///< counter for symbolic analyses
+
+    bool m_analyze;       ///< must the factorization redo the symbolic analysis?
+    int m_analyze_dim;    ///< problem size at the last symbolic analysis
+    int m_analyze_nnz;    ///< number of nonzeros at the last symbolic analysis
 
     bool m_lock;          ///< is the matrix sparsity pattern locked?
     bool m_use_learner;   ///< use the sparsity pattern learner?
@@ -267,6 +278,51 @@ class ChApi ChSolverSparseQR : public ChDirectSolverLS {
     Eigen::SparseQR<ChSparseMatrix, Eigen::COLAMDOrdering<int>> m_engine;  ///< Eigen SparseQR solver
 };
 
+/// Sparse LDL^T direct solver.\n
+/// Built-in supernodal LDL^T factorization for symmetric matrices (see ChSupernodalLDLT), with approximate minimum
+/// degree ordering and multithreaded numeric factorization. Intended for symmetric positive definite or quasi-definite
+/// KKT systems, such as those from FEA static analyses. The system matrix must be stored in full (both triangles).\n
+/// No dynamic pivoting is performed: small pivots (e.g., for constraints with zero compliance) are perturbed and the
+/// solution is then improved with a few steps of iterative refinement.\n
+/// If the sparsity pattern is locked, the symbolic analysis is performed only once and reused by all factorizations.\n
+/// Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.\n
+/// See ChDirectSolverLS for more details.
+class ChApi ChSolverSparseLDLT : public ChDirectSolverLS {
+  public:
+    ChSolverSparseLDLT() : m_num_vars(-1), m_refinement_steps(2) {}
+    ~ChSolverSparseLDLT() {}
+    virtual Type GetType() const override { return Type::SPARSE_LDLT; }
+
+    /// Set the number of OpenMP threads used in the numeric factorization (default: number of processors).
+    void SetNumThreads(int num_threads) { m_engine.SetNumThreads(num_threads); }
+
+    /// Set the maximum number of iterative refinement steps, performed only if pivots were perturbed (default: 2).
+    void SetRefinementSteps(int steps) { m_refinement_steps = steps; }
+
+    /// Get the underlying factorization engine.
+    const ChSupernodalLDLT& GetEngine() const { return m_engine; }
+
+    /// Perform the solver setup operations.
+    /// Records the number of variables (rows with positive pivots) before calling ChDirectSolverLS::Setup.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+  private:
+    /// Factorize the current sparse matrix and return true if successful.
+    virtual bool FactorizeMatrix() override;
+
+    /// Solve the linear system using the current factorization and right-hand side vector.
+    /// Load the solution vector (already of appropriate size) and return true if succesful.
+    virtual bool SolveSystem() override;
+
+    /// Display an error message corresponding to the last failure.
+    /// This function is only called if Factorize or Solve returned false.
+    virtual void PrintErrorMessage() override;
+
+    ChSupernodalLDLT m_engine;  ///< supernodal LDLT factorization
+    int m_num_vars;             ///< number of variables (rows with positive pivots)
+    int m_refinement_steps;     ///< maximum number of iterative refinement steps
+};
+
 /// @} chrono_solver
 
 }  // end namespace chrono
@@ -34,6 +34,8 @@ class my_enum_mappers : public ChSolver {
     CH_ENUM_VAL(Type::GMRES);
     CH_ENUM_VAL(Type::MINRES);
     CH_ENUM_VAL(Type::BICGSTAB);
+    CH_ENUM_VAL(Type::PSOR_PARALLEL);
+    CH_ENUM_VAL(Type::SPARSE_LDLT);
     CH_ENUM_VAL(Type::CUSTOM);
     CH_ENUM_MAPPER_END(Type);
 };
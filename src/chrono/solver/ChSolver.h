@@ -51,6 +51,10 @@ class ChApi ChSolver {
         GMRES,     ///< Generalized Minimal RESidual Algorithm
         MINRES,    ///< MINimum RESidual method
         BICGSTAB,  ///< Bi-conjugate gradient stabilized
+        // Iterative VI solvers (appended to preserve the values of existing types)
+        PSOR_PARALLEL,  ///< Projected SOR with graph coloring and parallel sweeps
+        // Direct linear solvers (appended to preserve the values of existing types)
+        SPARSE_LDLT,  ///< Sparse supernodal LDLT factorization (symmetric matrices)
         // Other
         CUSTOM,
     };
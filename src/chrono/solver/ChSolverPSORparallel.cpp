@@ -0,0 +1,436 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#include <algorithm>
+#include <cstdint>
+
+#include "chrono/solver/ChSolverPSORparallel.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/utils/ChOpenMP.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverPSORparallel)
+
+ChSolverPSORparallel::ChSolverPSORparallel()
+    : m_nthreads(ChOMP::GetNumProcs()),
+      m_serial(false),
+      m_color_start(1, 0),
+      m_use_islands(false),
+      m_island_start(1, 0),
+      maxviolation(0) {}
+
+void ChSolverPSORparallel::SetNumThreads(int num_threads) {
+    m_nthreads = std::max(1, num_threads);
+}
+
+void ChSolverPSORparallel::ColorBlocks(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+
+    // Group the active constraints in blocks: a triplet of frictional contact constraints n,u,v
+    // (processed together, as in ChSolverPSOR) or a single constraint.
+    m_constraints.clear();
+    m_block_start.clear();
+    int i_friction_comp = 0;
+    for (auto constr : mconstraints) {
+        if (!constr->IsActive())
+            continue;
+        if (constr->GetMode() == CONSTRAINT_FRIC) {
+            if (i_friction_comp == 0)
+                m_block_start.push_back((int)m_constraints.size());
+            i_friction_comp = (i_friction_comp + 1) % 3;
+        } else {
+            m_block_start.push_back((int)m_constraints.size());
+            i_friction_comp = 0;
+        }
+        m_constraints.push_back(constr);
+    }
+    int num_blocks = (int)m_block_start.size();
+    m_block_start.push_back((int)m_constraints.size());
+
+    // Greedy coloring of the blocks, such that blocks sharing an active variable have different colors.
+    // Active variables are identified by their offset; for each of them, keep track of the first 64 colors
+    // used (as a bit mask) and of the highest color used.
+    struct VarColors {
+        std::uint64_t mask = 0;
+        int last = -1;
+    };
+    std::vector<VarColors> var_colors(sysd.CountActiveVariables());
+
+    std::vector<int> color(num_blocks, 0);
+    std::vector<ChVariables*> vars;
+    int num_colors = num_blocks > 0 ? 1 : 0;
+    m_serial = false;
+
+    for (int ib = 0; ib < num_blocks && !m_serial; ib++) {
+        vars.clear();
+        for (int ic = m_block_start[ib]; ic < m_block_start[ib + 1]; ic++) {
+            if (!m_constraints[ic]->ListVariables(vars))
+                m_serial = true;
+        }
+        if (m_serial)
+            break;
+
+        std::uint64_t used = 0;
+        int last = -1;
+        for (auto var : vars) {
+            if (!var || !var->IsActive() || var->Get_ndof() == 0)
+                continue;
+            const auto& vc = var_colors[var->GetOffset()];
+            used |= vc.mask;
+            last = std::max(last, vc.last);
+        }
+
+        int c = last + 1;
+        if (~used != 0) {
+            c = 0;
+            while (used & (std::uint64_t(1) << c))
+                c++;
+        }
+
+        for (auto var : vars) {
+            if (!var || !var->IsActive() || var->Get_ndof() == 0)
+                continue;
+            auto& vc = var_colors[var->GetOffset()];
+            if (c < 64)
+                vc.mask |= std::uint64_t(1) << c;
+            vc.last = std::max(vc.last, c);
+        }
+
+        color[ib] = c;
+        num_colors = std::max(num_colors, c + 1);
+    }
+
+    // If some constraint cannot be colored, process all blocks serially, in their original order.
+    if (m_serial) {
+        std::fill(color.begin(), color.end(), 0);
+        num_colors = num_blocks > 0 ? 1 : 0;
+    }
+
+    // Sort blocks by color (stable, so that blocks of the same color keep their original order)
+    m_color_start.assign(num_colors + 1, 0);
+    for (int ib = 0; ib < num_blocks; ib++)
+        m_color_start[color[ib] + 1]++;
+    for (int k = 0; k < num_colors; k++)
+        m_color_start[k + 1] += m_color_start[k];
+
+    std::vector<int> pos(m_color_start.begin(), m_color_start.end() - 1);
+    m_block_order.resize(num_blocks);
+    for (int ib = 0; ib < num_blocks; ib++)
+        m_block_order[pos[color[ib]]++] = ib;
+}
+
+bool ChSolverPSORparallel::GroupIslands(ChSystemDescriptor& sysd) {
+    m_island_blocks.clear();
+    m_island_start.assign(1, 0);
+
+    std::vector<int> island;
+    int num_islands = sysd.ComputeIslands(island);
+    if (num_islands == 0)
+        return false;
+
+    // Island of each block, i.e. that of its first constraint (the constraints of a block share their variables).
+    // Blocks were built from the active constraints, in the order of the constraint list.
+    int num_blocks = (int)m_block_start.size() - 1;
+    std::vector<int> block_island(num_blocks);
+    int ib = 0;
+    int k = 0;
+    for (size_t ic = 0; ic < island.size() && ib < num_blocks; ic++) {
+        if (island[ic] < 0)
+            continue;
+        if (k == m_block_start[ib])
+            block_island[ib++] = island[ic];
+        k++;
+    }
+
+    // Sort blocks by island (stable, so that blocks of an island keep their original order)
+    m_island_start.assign(num_islands + 1, 0);
+    for (ib = 0; ib < num_blocks; ib++)
+        m_island_start[block_island[ib] + 1]++;
+    for (int i = 0; i < num_islands; i++)
+        m_island_start[i + 1] += m_island_start[i];
+
+    std::vector<int> pos(m_island_start.begin(), m_island_start.end() - 1);
+    m_island_blocks.resize(num_blocks);
+    for (ib = 0; ib < num_blocks; ib++)
+        m_island_blocks[pos[block_island[ib]]++] = ib;
+
+    return true;
+}
+
+void ChSolverPSORparallel::SolveIslands() {
+    int num_islands = GetNumIslands();
+
+    // Process the largest islands first, for a better load balance
+    std::vector<int> order(num_islands);
+    for (int i = 0; i < num_islands; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return m_island_start[a + 1] - m_island_start[a] > m_island_start[b + 1] - m_island_start[b];
+    });
+
+    std::vector<double> island_violation(num_islands, 0.0);
+    std::vector<int> island_iterations(num_islands, 0);
+
+#pragma omp parallel for schedule(dynamic) num_threads(m_nthreads)
+    for (int i = 0; i < num_islands; i++) {
+        int k = order[i];
+        double violation = 0;
+        int iter = 0;
+        while (iter < m_max_iterations) {
+            violation = 0;
+            double deltalambda = 0;
+            for (int j = m_island_start[k]; j < m_island_start[k + 1]; j++) {
+                int ib = m_island_blocks[j];
+                UpdateBlock(&m_constraints[m_block_start[ib]], m_block_start[ib + 1] - m_block_start[ib], violation,
+                            deltalambda);
+            }
+            iter++;
+
+            // Terminate the loop if violation in constraints of this island has been successfully limited.
+            if (violation < m_tolerance)
+                break;
+        }
+        island_violation[k] = violation;
+        island_iterations[k] = iter;
+    }
+
+    for (int k = 0; k < num_islands; k++) {
+        maxviolation = ChMax(maxviolation, island_violation[k]);
+        m_iterations = ChMax(m_iterations, island_iterations[k]);
+    }
+}
+
+void ChSolverPSORparallel::UpdateBlock(ChConstraint** constraints,
+                                       int num_constraints,
+                                       double& max_violation,
+                                       double& max_deltalambda) {
+    if (constraints[0]->GetMode() == CONSTRAINT_FRIC) {
+        // Triplet of frictional contact constraints n,u,v
+        double old_lambda_friction[3];
+
+        for (int j = 0; j < num_constraints; j++) {
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = constraints[j]->Compute_Cq_q() + constraints[j]->Get_b_i() +
+                               constraints[j]->Get_cfm_i() * constraints[j]->Get_l_i();
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (m_omega / constraints[j]->Get_g_i()) * (-mresidual);
+
+            // update:   lambda += delta_lambda;
+            old_lambda_friction[j] = constraints[j]->Get_l_i();
+            constraints[j]->Set_l_i(old_lambda_friction[j] + deltal);
+
+            if (j == 0)
+                max_violation = ChMax(max_violation, fabs(ChMin(0.0, mresidual)));
+        }
+
+        if (num_constraints < 3)
+            return;
+
+        constraints[0]->Project();  // the N normal component will take care of N,U,V
+        double new_lambda_0 = constraints[0]->Get_l_i();
+        double new_lambda_1 = constraints[1]->Get_l_i();
+        double new_lambda_2 = constraints[2]->Get_l_i();
+        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+        if (m_shlambda != 1.0) {
+            new_lambda_0 = m_shlambda * new_lambda_0 + (1.0 - m_shlambda) * old_lambda_friction[0];
+            new_lambda_1 = m_shlambda * new_lambda_1 + (1.0 - m_shlambda) * old_lambda_friction[1];
+            new_lambda_2 = m_shlambda * new_lambda_2 + (1.0 - m_shlambda) * old_lambda_friction[2];
+            constraints[0]->Set_l_i(new_lambda_0);
+            constraints[1]->Set_l_i(new_lambda_1);
+            constraints[2]->Set_l_i(new_lambda_2);
+        }
+        double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
+        double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
+        double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
+        constraints[0]->Increment_q(true_delta_0);
+        constraints[1]->Increment_q(true_delta_1);
+        constraints[2]->Increment_q(true_delta_2);
+
+        if (this->record_violation_history) {
+            max_deltalambda = ChMax(max_deltalambda, fabs(true_delta_0));
+            max_deltalambda = ChMax(max_deltalambda, fabs(true_delta_1));
+            max_deltalambda = ChMax(max_deltalambda, fabs(true_delta_2));
+        }
+
+        return;
+    }
+
+    // Single constraint
+    ChConstraint* constr = constraints[0];
+
+    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+    double mresidual = constr->Compute_Cq_q() + constr->Get_b_i() + constr->Get_cfm_i() * constr->Get_l_i();
+
+    // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+    double candidate_violation = fabs(constr->Violation(mresidual));
+
+    // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+    double deltal = (m_omega / constr->Get_g_i()) * (-mresidual);
+
+    // update:   lambda += delta_lambda;
+    double old_lambda = constr->Get_l_i();
+    constr->Set_l_i(old_lambda + deltal);
+
+    // If new lagrangian multiplier does not satisfy inequalities, project
+    // it into an admissible orthant (or, in general, onto an admissible set)
+    constr->Project();
+
+    // After projection, the lambda may have changed a bit..
+    double new_lambda = constr->Get_l_i();
+
+    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+    if (m_shlambda != 1.0) {
+        new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda;
+        constr->Set_l_i(new_lambda);
+    }
+
+    double true_delta = new_lambda - old_lambda;
+
+    // For all items with variables, add the effect of incremented
+    // (and projected) lagrangian reactions:
+    constr->Increment_q(true_delta);
+
+    if (this->record_violation_history)
+        max_deltalambda = ChMax(max_deltalambda, fabs(true_delta));
+
+    max_violation = ChMax(max_violation, candidate_violation);
+}
+
+double ChSolverPSORparallel::Solve(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    int nc = (int)mconstraints.size();
+    int nv = (int)mvariables.size();
+
+    m_iterations = 0;
+    maxviolation = 0;
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+#pragma omp parallel for num_threads(m_nthreads)
+    for (int ic = 0; ic < nc; ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    //
+    int j_friction_comp = 0;
+    double gi_values[3];
+    for (int ic = 0; ic < nc; ic++) {
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+            j_friction_comp++;
+            if (j_friction_comp == 3) {
+                double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                mconstraints[ic - 2]->Set_g_i(average_g_i);
+                mconstraints[ic - 1]->Set_g_i(average_g_i);
+                mconstraints[ic - 0]->Set_g_i(average_g_i);
+                j_friction_comp = 0;
+            }
+        }
+    }
+
+    // Group the constraints in blocks and color the blocks
+    ColorBlocks(sysd);
+
+    int nthreads = m_serial ? 1 : m_nthreads;
+    int num_colors = GetNumColors();
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < nv; iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    }
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (m_warm_start) {
+#pragma omp parallel num_threads(nthreads)
+        for (int k = 0; k < num_colors; k++) {
+            int start = m_color_start[k];
+            int end = m_color_start[k + 1];
+#pragma omp for
+            for (int i = start; i < end; i++) {
+                int ib = m_block_order[i];
+                for (int ic = m_block_start[ib]; ic < m_block_start[ib + 1]; ic++)
+                    m_constraints[ic]->Increment_q(m_constraints[ic]->Get_l_i());
+            }
+        }
+    } else {
+#pragma omp parallel for num_threads(nthreads)
+        for (int ic = 0; ic < nc; ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Perform the iteration loops
+    //     In island mode, islands are iterated independently and processed in parallel.
+    if (m_use_islands && !m_serial && GroupIslands(sysd)) {
+        SolveIslands();
+        return maxviolation;
+    }
+    m_island_blocks.clear();
+    m_island_start.assign(1, 0);
+
+    //     Otherwise, colors are swept one after the other; blocks of the same color do not share variables
+    //     and are processed in parallel.
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        maxviolation = 0;
+        double maxdeltalambda = 0;
+
+#pragma omp parallel num_threads(nthreads)
+        {
+            double t_maxviolation = 0;
+            double t_maxdeltalambda = 0;
+
+            for (int k = 0; k < num_colors; k++) {
+                int start = m_color_start[k];
+                int end = m_color_start[k + 1];
+#pragma omp for schedule(static)
+                for (int i = start; i < end; i++) {
+                    int ib = m_block_order[i];
+                    UpdateBlock(&m_constraints[m_block_start[ib]], m_block_start[ib + 1] - m_block_start[ib],
+                                t_maxviolation, t_maxdeltalambda);
+                }
+            }
+
+#pragma omp critical
+            {
+                maxviolation = ChMax(maxviolation, t_maxviolation);
+                maxdeltalambda = ChMax(maxdeltalambda, t_maxdeltalambda);
+            }
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+
+    }  // end iteration loop
+
+    return maxviolation;
+}
+
+}  // end namespace chrono
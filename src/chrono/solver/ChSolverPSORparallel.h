@@ -0,0 +1,108 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#ifndef CHSOLVER_PSOR_PARALLEL_H
+#define CHSOLVER_PSOR_PARALLEL_H
+
+#include "chrono/solver/ChIterativeSolverVI.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// A parallel iterative solver based on projective fixed point method, with overrelaxation and immediate variable
+/// update as in SOR methods.\n
+/// The constraint graph is colored, such that constraints (or triplets of frictional contact constraints) sharing a
+/// ChVariables object have different colors. At each iteration, colors are swept one after the other, while the
+/// constraints of a given color are processed in parallel (OpenMP).\n
+/// The update of each constraint is the same as in ChSolverPSOR, but the sweep order differs (constraints are ordered
+/// by color), so the results are not identical to those of ChSolverPSOR. Results do not depend on the number of
+/// threads.\n
+/// Optionally, the problem can instead be partitioned in islands (groups of constraints connected through shared
+/// variables, see ChSystemDescriptor::ComputeIslands). Islands are then solved concurrently, each one sweeping its
+/// constraints serially (in the same order as ChSolverPSOR) until its own convergence. This is efficient for systems
+/// made of many independent sub-systems.\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures passed to the
+/// solver.
+
+class ChApi ChSolverPSORparallel : public ChIterativeSolverVI {
+  public:
+    ChSolverPSORparallel();
+
+    ~ChSolverPSORparallel() {}
+
+    virtual Type GetType() const override { return Type::PSOR_PARALLEL; }
+
+    /// Set the number of OpenMP threads (default: number of processors).
+    /// If the solver is created by ChSystem::SetSolverType, this is set to ChSystem::GetNumThreadsChrono.
+    void SetNumThreads(int num_threads);
+
+    /// Get the number of OpenMP threads.
+    int GetNumThreads() const { return m_nthreads; }
+
+    /// Return the number of colors used during the last solve.
+    int GetNumColors() const { return (int)m_color_start.size() - 1; }
+
+    /// Enable/disable solving the islands of the problem concurrently instead of sweeping colors (default: false).
+    /// In island mode, the solver stops iterating on each island as soon as its constraint violation is below the
+    /// tolerance; GetIterations() returns the largest number of iterations over all islands. The violation history is
+    /// not recorded in island mode.
+    void EnableIslands(bool val) { m_use_islands = val; }
+
+    /// Return true if the island mode is enabled.
+    bool UseIslands() const { return m_use_islands; }
+
+    /// Return the number of islands found during the last solve (0 if the island mode was not used).
+    int GetNumIslands() const { return (int)m_island_start.size() - 1; }
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination.
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Return the tolerance error reached during the last solve.
+    /// For the PSOR solver, this is the maximum constraint violation.
+    virtual double GetError() const override { return maxviolation; }
+
+  private:
+    /// Group the constraints in blocks (single constraints or frictional contact triplets) and color the blocks.
+    void ColorBlocks(ChSystemDescriptor& sysd);
+
+    /// Group the blocks by island. Return false if the problem cannot be partitioned in islands.
+    bool GroupIslands(ChSystemDescriptor& sysd);
+
+    /// Perform the PSOR iterations separately on each island, with islands processed concurrently.
+    void SolveIslands();
+
+    /// Perform one projected SOR update of the specified block.
+    void UpdateBlock(ChConstraint** constraints, int num_constraints, double& max_violation, double& max_deltalambda);
+
+    int m_nthreads;                            ///< number of OpenMP threads
+    bool m_serial;                             ///< true if some constraint does not list its variables
+    std::vector<ChConstraint*> m_constraints;  ///< active constraints, grouped in blocks
+    std::vector<int> m_block_start;            ///< first constraint of each block in m_constraints (plus end marker)
+    std::vector<int> m_block_order;            ///< blocks, sorted by color
+    std::vector<int> m_color_start;            ///< first block of each color in m_block_order (plus end marker)
+    bool m_use_islands;                        ///< if true, solve the islands concurrently
+    std::vector<int> m_island_blocks;          ///< blocks, grouped by island (original order within an island)
+    std::vector<int> m_island_start;           ///< first block of each island in m_island_blocks (plus end marker)
+    double maxviolation;
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
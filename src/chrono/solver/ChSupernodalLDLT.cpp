@@ -0,0 +1,521 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/solver/ChSupernodalLDLT.h"
+#include "chrono/utils/ChOpenMP.h"
+
+#include <Eigen/OrderingMethods>
+
+namespace chrono {
+
+static const size_t NPOS = static_cast<size_t>(-1);
+
+// Maximum number of columns of a supernode for which relaxed amalgamation is allowed and maximum number of explicit
+// zeros introduced in each amalgamated column.
+static const int RELAX_MAX_COLS = 32;
+static const int RELAX_MAX_ZEROS = 4;
+
+// Column block size in the dense factorization of a supernode.
+static const int PANEL_SIZE = 64;
+
+ChSupernodalLDLT::ChSupernodalLDLT()
+    : m_analyzed(false),
+      m_n(0),
+      m_nnz(0),
+      m_num_threads(ChOMP::GetNumProcs()),
+      m_pivot_tol(1e-12),
+      m_pivot_min(0),
+      m_num_perturbed(0) {}
+
+void ChSupernodalLDLT::SetNumThreads(int num_threads) {
+    m_num_threads = std::max(num_threads, 1);
+}
+
+// Build the column-wise patterns of the lower and strictly upper triangles of P*A*P^T.
+// For each lower entry, record the index of the corresponding nonzero in A.
+void ChSupernodalLDLT::BuildPattern(const ChSparseMatrix& A, const std::vector<int>& perm) {
+    int n = m_n;
+    const int* Ap = A.outerIndexPtr();
+    const int* Ai = A.innerIndexPtr();
+
+    m_Lp.assign(n + 1, 0);
+    m_Up.assign(n + 1, 0);
+    for (int r = 0; r < n; r++) {
+        for (int k = Ap[r]; k < Ap[r + 1]; k++) {
+            int pr = perm[r];
+            int pc = perm[Ai[k]];
+            if (pr >= pc)
+                m_Lp[pc + 1]++;
+            if (pr > pc)
+                m_Up[pr + 1]++;
+        }
+    }
+    for (int j = 0; j < n; j++) {
+        m_Lp[j + 1] += m_Lp[j];
+        m_Up[j + 1] += m_Up[j];
+    }
+
+    m_Li.resize(m_Lp[n]);
+    m_Lsrc.resize(m_Lp[n]);
+    m_Ui.resize(m_Up[n]);
+    std::vector<int> lnext(m_Lp.begin(), m_Lp.end() - 1);
+    std::vector<int> unext(m_Up.begin(), m_Up.end() - 1);
+    for (int r = 0; r < n; r++) {
+        for (int k = Ap[r]; k < Ap[r + 1]; k++) {
+            int pr = perm[r];
+            int pc = perm[Ai[k]];
+            if (pr >= pc) {
+                m_Li[lnext[pc]] = pr;
+                m_Lsrc[lnext[pc]++] = k;
+            }
+            if (pr > pc)
+                m_Ui[unext[pr]++] = pc;
+        }
+    }
+
+    // Elimination tree
+    m_parent.assign(n, -1);
+    std::vector<int> ancestor(n, -1);
+    for (int k = 0; k < n; k++) {
+        for (int p = m_Up[k]; p < m_Up[k + 1]; p++) {
+            int inext;
+            for (int i = m_Ui[p]; i != -1 && i < k; i = inext) {
+                inext = ancestor[i];
+                ancestor[i] = k;
+                if (inext == -1)
+                    m_parent[i] = k;
+            }
+        }
+    }
+}
+
+void ChSupernodalLDLT::Analyze(const ChSparseMatrix& A, int num_positive) {
+    m_n = (int)A.rows();
+    m_nnz = (int)A.nonZeros();
+    int n = m_n;
+    if (num_positive < 0 || num_positive > n)
+        num_positive = n;
+
+    const int* Ap = A.outerIndexPtr();
+    const int* Ai = A.innerIndexPtr();
+
+    // Fill-reducing ordering (approximate minimum degree).
+    // The ordering returns the original index of the k-th eliminated row.
+    Eigen::SparseMatrix<double, Eigen::ColMajor, int> C = A;
+    Eigen::AMDOrdering<int> amd;
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> order;
+    amd(C, order);
+
+    std::vector<int> pos(n);
+    for (int k = 0; k < n; k++)
+        pos[order.indices()[k]] = k;
+
+    // Eliminate each negative row after the last of the positive rows it couples to, so that its pivot includes the
+    // (negative) Schur complement contributions. This avoids zero pivots for ideal constraints.
+    if (num_positive < n) {
+        std::vector<std::pair<long long, int>> key(n);
+        for (int i = 0; i < n; i++) {
+            long long k = 2 * (long long)pos[i];
+            if (i >= num_positive) {
+                int last = -1;
+                for (int p = Ap[i]; p < Ap[i + 1]; p++) {
+                    if (Ai[p] < num_positive)
+                        last = std::max(last, pos[Ai[p]]);
+                }
+                if (last > pos[i])
+                    k = 2 * (long long)last + 1;
+            }
+            key[i] = std::make_pair(k, i);
+        }
+        std::sort(key.begin(), key.end());
+        for (int k = 0; k < n; k++)
+            pos[key[k].second] = k;
+    }
+
+    // Elimination tree of the reordered matrix and its postorder
+    BuildPattern(A, pos);
+
+    std::vector<int> head(n, -1);
+    std::vector<int> next(n, -1);
+    for (int j = n - 1; j >= 0; j--) {
+        if (m_parent[j] != -1) {
+            next[j] = head[m_parent[j]];
+            head[m_parent[j]] = j;
+        }
+    }
+    std::vector<int> post(n);
+    std::vector<int> stack;
+    int k = 0;
+    for (int j = 0; j < n; j++) {
+        if (m_parent[j] != -1)
+            continue;
+        stack.push_back(j);
+        while (!stack.empty()) {
+            int p = stack.back();
+            int i = head[p];
+            if (i == -1) {
+                stack.pop_back();
+                post[p] = k++;
+            } else {
+                head[p] = next[i];
+                stack.push_back(i);
+            }
+        }
+    }
+
+    // Final permutation (ordering followed by postorder). Rebuild patterns and elimination tree.
+    m_perm.resize(n);
+    m_sign.resize(n);
+    for (int i = 0; i < n; i++) {
+        m_perm[i] = post[pos[i]];
+        m_sign[m_perm[i]] = (i < num_positive) ? 1 : -1;
+    }
+    BuildPattern(A, m_perm);
+
+    // Column counts of L (including the diagonal), traversing the row subtrees
+    std::vector<int> cc(n, 1);
+    std::vector<int> mark(n, -1);
+    for (int j = 0; j < n; j++) {
+        mark[j] = j;
+        for (int p = m_Up[j]; p < m_Up[j + 1]; p++) {
+            for (int i = m_Ui[p]; mark[i] != j; i = m_parent[i]) {
+                mark[i] = j;
+                cc[i]++;
+            }
+        }
+    }
+
+    // Relaxed supernodes: merge column j-1 and its parent j in the same supernode if this does not introduce (too many)
+    // explicit zeros.
+    m_sfirst.clear();
+    m_sfirst.push_back(0);
+    for (int j = 1; j < n; j++) {
+        int size = j - m_sfirst.back();
+        bool merge = (m_parent[j - 1] == j);
+        if (merge) {
+            int zeros = cc[j] - (cc[j - 1] - 1);
+            merge = (zeros == 0) || (size < RELAX_MAX_COLS && zeros <= RELAX_MAX_ZEROS);
+        }
+        if (!merge)
+            m_sfirst.push_back(j);
+    }
+    m_sfirst.push_back(n);
+    int ns = (int)m_sfirst.size() - 1;
+
+    std::vector<int> snode(n);
+    for (int s = 0; s < ns; s++) {
+        for (int j = m_sfirst[s]; j < m_sfirst[s + 1]; j++)
+            snode[j] = s;
+    }
+
+    // Supernodal elimination tree (children have lower indices than their parents)
+    std::vector<int> sparent(ns, -1);
+    m_childptr.assign(ns + 1, 0);
+    for (int s = 0; s < ns; s++) {
+        int p = m_parent[m_sfirst[s + 1] - 1];
+        if (p != -1) {
+            sparent[s] = snode[p];
+            m_childptr[sparent[s] + 1]++;
+        }
+    }
+    for (int s = 0; s < ns; s++)
+        m_childptr[s + 1] += m_childptr[s];
+    m_children.resize(m_childptr[ns]);
+    std::vector<int> cnext(m_childptr.begin(), m_childptr.end() - 1);
+    for (int s = 0; s < ns; s++) {
+        if (sparent[s] != -1)
+            m_children[cnext[sparent[s]]++] = s;
+    }
+
+    // Row structures of the supernodes: own columns, followed by the rows (in increasing order) from the original
+    // entries and from the update rows of the children.
+    m_rowptr.assign(ns + 1, 0);
+    m_rows.clear();
+    mark.assign(n, -1);
+    std::vector<int> extra;
+    for (int s = 0; s < ns; s++) {
+        int f = m_sfirst[s];
+        int l = m_sfirst[s + 1];
+        for (int j = f; j < l; j++) {
+            m_rows.push_back(j);
+            mark[j] = s;
+        }
+        extra.clear();
+        for (int j = f; j < l; j++) {
+            for (int p = m_Lp[j]; p < m_Lp[j + 1]; p++) {
+                int i = m_Li[p];
+                if (mark[i] != s) {
+                    mark[i] = s;
+                    extra.push_back(i);
+                }
+            }
+        }
+        for (int c = m_childptr[s]; c < m_childptr[s + 1]; c++) {
+            int child = m_children[c];
+            int nc = m_sfirst[child + 1] - m_sfirst[child];
+            for (int p = m_rowptr[child] + nc; p < m_rowptr[child + 1]; p++) {
+                int i = m_rows[p];
+                if (mark[i] != s) {
+                    mark[i] = s;
+                    extra.push_back(i);
+                }
+            }
+        }
+        std::sort(extra.begin(), extra.end());
+        m_rows.insert(m_rows.end(), extra.begin(), extra.end());
+        m_rowptr[s + 1] = (int)m_rows.size();
+    }
+
+    // Layout of the dense supernode blocks, positions of the original entries in the factor, and relative positions
+    // of the update rows of each supernode within the row structure of its parent.
+    m_Lptr.assign(ns + 1, 0);
+    m_amap.assign(m_nnz, NPOS);
+    m_relmap.assign(m_rows.size(), -1);
+    std::vector<int>& local = mark;
+    for (int s = 0; s < ns; s++) {
+        int f = m_sfirst[s];
+        int l = m_sfirst[s + 1];
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        m_Lptr[s + 1] = m_Lptr[s] + (size_t)nr * (l - f);
+        for (int p = m_rowptr[s]; p < m_rowptr[s + 1]; p++)
+            local[m_rows[p]] = p - m_rowptr[s];
+        for (int j = f; j < l; j++) {
+            for (int p = m_Lp[j]; p < m_Lp[j + 1]; p++)
+                m_amap[m_Lsrc[p]] = m_Lptr[s] + (size_t)(j - f) * nr + local[m_Li[p]];
+        }
+        for (int c = m_childptr[s]; c < m_childptr[s + 1]; c++) {
+            int child = m_children[c];
+            int nc = m_sfirst[child + 1] - m_sfirst[child];
+            for (int p = m_rowptr[child] + nc; p < m_rowptr[child + 1]; p++)
+                m_relmap[p] = local[m_rows[p]];
+        }
+    }
+
+    // Levels of the supernodal elimination tree (leaves at level 0)
+    std::vector<int> level(ns, 0);
+    int num_levels = 0;
+    for (int s = 0; s < ns; s++) {
+        for (int c = m_childptr[s]; c < m_childptr[s + 1]; c++)
+            level[s] = std::max(level[s], level[m_children[c]] + 1);
+        num_levels = std::max(num_levels, level[s] + 1);
+    }
+    m_levelptr.assign(num_levels + 1, 0);
+    for (int s = 0; s < ns; s++)
+        m_levelptr[level[s] + 1]++;
+    for (int i = 0; i < num_levels; i++)
+        m_levelptr[i + 1] += m_levelptr[i];
+    m_levels.resize(ns);
+    std::vector<int> lnext(m_levelptr.begin(), m_levelptr.end() - 1);
+    for (int s = 0; s < ns; s++)
+        m_levels[lnext[level[s]]++] = s;
+
+    // Allocate the numeric factor
+    m_Lx.resize(m_Lptr[ns]);
+    m_update.clear();
+    m_update.resize(ns);
+    m_snum_perturbed.assign(ns, 0);
+
+    m_analyzed = true;
+}
+
+bool ChSupernodalLDLT::Factorize(const ChSparseMatrix& A) {
+    if (!m_analyzed || A.rows() != m_n || A.nonZeros() != m_nnz)
+        return false;
+
+    // Load the original entries in the dense supernode blocks
+    std::fill(m_Lx.begin(), m_Lx.end(), 0.0);
+    const double* Ax = A.valuePtr();
+    for (int k = 0; k < m_nnz; k++) {
+        if (m_amap[k] != NPOS)
+            m_Lx[m_amap[k]] += Ax[k];
+    }
+
+    // Pivot perturbation threshold, relative to the largest diagonal entry
+    int ns = GetNumSupernodes();
+    double max_diag = 0;
+    for (int s = 0; s < ns; s++) {
+        int nc = m_sfirst[s + 1] - m_sfirst[s];
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        for (int j = 0; j < nc; j++)
+            max_diag = std::max(max_diag, std::abs(m_Lx[m_Lptr[s] + (size_t)j * nr + j]));
+    }
+    m_pivot_min = m_pivot_tol * (max_diag > 0 ? max_diag : 1.0);
+
+    // Factorize the supernodes, level by level. Supernodes in the same level are independent.
+    // A level with a single supernode is processed outside a parallel region, so that the dense kernels can use
+    // multiple threads.
+    int num_levels = (int)m_levelptr.size() - 1;
+    for (int il = 0; il < num_levels; il++) {
+        int start = m_levelptr[il];
+        int count = m_levelptr[il + 1] - start;
+        if (count == 1 || m_num_threads == 1) {
+            for (int i = 0; i < count; i++)
+                FactorizeSupernode(m_levels[start + i]);
+        } else {
+#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+            for (int i = 0; i < count; i++)
+                FactorizeSupernode(m_levels[start + i]);
+        }
+    }
+
+    // Check the pivots
+    m_num_perturbed = 0;
+    bool finite = true;
+    for (int s = 0; s < ns; s++) {
+        m_num_perturbed += m_snum_perturbed[s];
+        int nc = m_sfirst[s + 1] - m_sfirst[s];
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        for (int j = 0; j < nc; j++)
+            finite = finite && std::isfinite(m_Lx[m_Lptr[s] + (size_t)j * nr + j]);
+    }
+
+    return finite;
+}
+
+void ChSupernodalLDLT::FactorizeSupernode(int s) {
+    int f = m_sfirst[s];
+    int nc = m_sfirst[s + 1] - f;
+    int nr = m_rowptr[s + 1] - m_rowptr[s];
+    int m = nr - nc;
+
+    // Frontal matrix: the first nc columns are stored in the dense supernode block (already loaded with the original
+    // entries), the trailing lower part in the supernode's update matrix.
+    Eigen::Map<Eigen::MatrixXd> F(m_Lx.data() + m_Lptr[s], nr, nc);
+    Eigen::MatrixXd& U = m_update[s];
+    U.setZero(m, m);
+
+    // Extend-add the update matrices of the children, then release them
+    for (int c = m_childptr[s]; c < m_childptr[s + 1]; c++) {
+        int child = m_children[c];
+        Eigen::MatrixXd& Uc = m_update[child];
+        int mc = (int)Uc.rows();
+        const int* rel = m_relmap.data() + m_rowptr[child + 1] - mc;
+        for (int jj = 0; jj < mc; jj++) {
+            int j = rel[jj];
+            if (j < nc) {
+                for (int ii = jj; ii < mc; ii++)
+                    F(rel[ii], j) += Uc(ii, jj);
+            } else {
+                for (int ii = jj; ii < mc; ii++)
+                    U(rel[ii] - nc, j - nc) += Uc(ii, jj);
+            }
+        }
+        Uc.resize(0, 0);
+    }
+
+    // Blocked LDL^T factorization of the supernode columns, without pivoting.
+    // W holds the panel columns scaled by D (i.e., the columns before division by the pivot).
+    int num_perturbed = 0;
+    Eigen::MatrixXd W;
+    for (int k0 = 0; k0 < nc; k0 += PANEL_SIZE) {
+        int k1 = std::min(k0 + PANEL_SIZE, nc);
+        int b = k1 - k0;
+        W.resize(nr - k0, b);
+
+        // Unblocked factorization of the panel
+        for (int k = k0; k < k1; k++) {
+            double d = F(k, k);
+            if (std::abs(d) < m_pivot_min) {
+                d = m_sign[f + k] * m_pivot_min;
+                num_perturbed++;
+            }
+            F(k, k) = d;
+            for (int i = k + 1; i < nr; i++) {
+                W(i - k0, k - k0) = F(i, k);
+                F(i, k) /= d;
+            }
+            for (int j = k + 1; j < k1; j++) {
+                double w = W(j - k0, k - k0);
+                for (int i = j; i < nr; i++)
+                    F(i, j) -= F(i, k) * w;
+            }
+        }
+
+        // Update the remaining supernode columns
+        if (k1 < nc) {
+            F.block(k1, k1, nr - k1, nc - k1).noalias() -=
+                F.block(k1, k0, nr - k1, b) * W.block(k1 - k0, 0, nc - k1, b).transpose();
+        }
+
+        // Update the trailing part of the frontal matrix
+        if (m > 0) {
+            U.triangularView<Eigen::Lower>() -= F.block(nc, k0, m, b) * W.block(nc - k0, 0, m, b).transpose();
+        }
+    }
+
+    m_snum_perturbed[s] = num_perturbed;
+}
+
+void ChSupernodalLDLT::Solve(ChVectorDynamic<>& x) const {
+    int n = m_n;
+    int ns = GetNumSupernodes();
+
+    ChVectorDynamic<> y(n);
+    for (int i = 0; i < n; i++)
+        y(m_perm[i]) = x(i);
+
+    ChVectorDynamic<> tmp;
+
+    // Forward substitution with L
+    for (int s = 0; s < ns; s++) {
+        int f = m_sfirst[s];
+        int nc = m_sfirst[s + 1] - f;
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        int m = nr - nc;
+        Eigen::Map<const Eigen::MatrixXd> L(m_Lx.data() + m_Lptr[s], nr, nc);
+        auto y1 = y.segment(f, nc);
+        L.topRows(nc).triangularView<Eigen::UnitLower>().solveInPlace(y1);
+        if (m > 0) {
+            tmp.noalias() = L.bottomRows(m) * y1;
+            const int* rows = m_rows.data() + m_rowptr[s] + nc;
+            for (int i = 0; i < m; i++)
+                y(rows[i]) -= tmp(i);
+        }
+    }
+
+    // Diagonal
+    for (int s = 0; s < ns; s++) {
+        int f = m_sfirst[s];
+        int nc = m_sfirst[s + 1] - f;
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        for (int j = 0; j < nc; j++)
+            y(f + j) /= m_Lx[m_Lptr[s] + (size_t)j * nr + j];
+    }
+
+    // Backward substitution with L^T
+    for (int s = ns - 1; s >= 0; s--) {
+        int f = m_sfirst[s];
+        int nc = m_sfirst[s + 1] - f;
+        int nr = m_rowptr[s + 1] - m_rowptr[s];
+        int m = nr - nc;
+        Eigen::Map<const Eigen::MatrixXd> L(m_Lx.data() + m_Lptr[s], nr, nc);
+        auto y1 = y.segment(f, nc);
+        if (m > 0) {
+            tmp.resize(m);
+            const int* rows = m_rows.data() + m_rowptr[s] + nc;
+            for (int i = 0; i < m; i++)
+                tmp(i) = y(rows[i]);
+            y1.noalias() -= L.bottomRows(m).transpose() * tmp;
+        }
+        L.topRows(nc).transpose().triangularView<Eigen::UnitUpper>().solveInPlace(y1);
+    }
+
+    for (int i = 0; i < n; i++)
+        x(i) = y(m_perm[i]);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CH_SUPERNODAL_LDLT_H
+#define CH_SUPERNODAL_LDLT_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChMatrix.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Supernodal multifrontal LDL^T factorization of sparse symmetric matrices.
+///
+/// The symbolic analysis (#Analyze) computes an approximate minimum degree ordering, the elimination tree (in
+/// postorder), the relaxed supernodes and the layout of the dense supernode blocks. It only depends on the sparsity
+/// pattern and can be reused by any number of numeric factorizations (#Factorize) of matrices with the same pattern.
+///
+/// The numeric factorization processes the supernodal elimination tree level by level, with the supernodes in each
+/// level factorized concurrently (OpenMP). Each supernode assembles its frontal matrix from the original entries and
+/// the update matrices of its children, factorizes its diagonal block without pivoting and computes its own update
+/// matrix with dense (Eigen) kernels.
+///
+/// No dynamic pivoting is performed. This is suitable for symmetric positive definite matrices and for
+/// (quasi-definite) KKT matrices. Rows expected to have negative pivots (e.g., constraint rows with zero diagonal) are
+/// ordered after the positive rows they couple to and any remaining tiny pivot is statically perturbed.
+class ChApi ChSupernodalLDLT {
+  public:
+    ChSupernodalLDLT();
+
+    /// Set the number of OpenMP threads used in the numeric factorization (default: number of processors).
+    void SetNumThreads(int num_threads);
+
+    /// Set the relative threshold for static pivot perturbation (default: 1e-12).
+    /// Pivots smaller in magnitude than this value times the largest diagonal entry are replaced by this
+    /// threshold, with the sign expected for the corresponding row.
+    void SetPivotTolerance(double tol) { m_pivot_tol = tol; }
+
+    /// Perform the symbolic analysis of the given symmetric matrix.
+    /// The matrix must be stored in full (both triangles, with symmetric sparsity pattern), since the fill-reducing
+    /// permutation can move any entry of A to the lower triangle of the permuted matrix.
+    /// The first num_positive rows are expected to have positive pivots and the remaining ones negative pivots, as for
+    /// the constraint block of a KKT matrix. A negative value indicates that all pivots are expected to be positive.
+    void Analyze(const ChSparseMatrix& A, int num_positive = -1);
+
+    /// Perform the numeric factorization of the given matrix, reusing the last symbolic analysis.
+    /// The matrix must have the same sparsity pattern as the one passed to #Analyze.
+    /// Return false if the matrix does not match the analysis or if the factorization is not finite.
+    bool Factorize(const ChSparseMatrix& A);
+
+    /// Solve A*x = b using the current factorization, with x containing b on input.
+    void Solve(ChVectorDynamic<>& x) const;
+
+    /// Return true if a symbolic analysis is available.
+    bool IsAnalyzed() const { return m_analyzed; }
+
+    /// Return the number of supernodes.
+    int GetNumSupernodes() const { return (int)m_sfirst.size() - 1; }
+
+    /// Return the number of entries stored in the dense supernode blocks of the factor.
+    size_t GetFactorSize() const { return m_Lx.size(); }
+
+    /// Return the number of pivots perturbed during the last factorization.
+    int GetNumPerturbedPivots() const { return m_num_perturbed; }
+
+  private:
+    void BuildPattern(const ChSparseMatrix& A, const std::vector<int>& perm);
+    void FactorizeSupernode(int s);
+
+    bool m_analyzed;
+    int m_n;             ///< problem size
+    int m_nnz;           ///< number of nonzeros of the analyzed matrix
+    int m_num_threads;   ///< number of OpenMP threads
+    double m_pivot_tol;  ///< relative pivot perturbation threshold
+    double m_pivot_min;  ///< absolute pivot perturbation threshold for the current factorization
+
+    std::vector<int> m_perm;  ///< fill-reducing permutation (new index of each original row)
+    std::vector<int> m_sign;  ///< expected pivot sign of each (permuted) row
+
+    // Pattern of the permuted matrix (lower and strictly upper triangles, column-wise)
+    std::vector<int> m_Lp, m_Li, m_Lsrc;  ///< lower triangle (with index of the source nonzero in A)
+    std::vector<int> m_Up, m_Ui;          ///< strictly upper triangle
+    std::vector<int> m_parent;            ///< elimination tree
+
+    // Supernodes
+    std::vector<int> m_sfirst;          ///< first column of each supernode (plus end marker)
+    std::vector<int> m_childptr;        ///< offsets of the child lists of each supernode
+    std::vector<int> m_children;        ///< children of the supernodes in the supernodal elimination tree
+    std::vector<int> m_rowptr;          ///< offsets of the supernode row structures
+    std::vector<int> m_rows;            ///< row structure of each supernode (own columns first)
+    std::vector<int> m_relmap;          ///< position of each update row within the parent's row structure
+    std::vector<size_t> m_Lptr;         ///< offsets of the dense supernode blocks in m_Lx
+    std::vector<int> m_levelptr;        ///< offsets of the levels in m_levels
+    std::vector<int> m_levels;          ///< supernodes grouped by level (leaves first)
+    std::vector<size_t> m_amap;         ///< position in m_Lx of each nonzero of A (npos for upper entries)
+    std::vector<int> m_snum_perturbed;  ///< number of perturbed pivots in each supernode
+
+    // Numeric factor
+    std::vector<double> m_Lx;               ///< dense supernode blocks (column-major, D on the diagonal)
+    std::vector<Eigen::MatrixXd> m_update;  ///< update matrices of the supernodes (released once used by the parent)
+    int m_num_perturbed;                    ///< number of perturbed pivots in the last factorization
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -12,10 +12,15 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/core/ChMatrix.h"
+#include "chrono/utils/ChUnionFind.h"
 
 namespace chrono {
 
@@ -25,7 +30,16 @@ CH_FACTORY_REGISTER(ChSystemDescriptor)
 
 #define CH_SPINLOCK_HASHSIZE 203
 
-ChSystemDescriptor::ChSystemDescriptor() : n_q(0), n_c(0), c_a(1.0), freeze_count(false) {
+ChSystemDescriptor::ChSystemDescriptor()
+    : n_q(0),
+      n_c(0),
+      c_a(1.0),
+      freeze_count(false),
+      nthreads(1),
+      par_threshold(1000),
+      deterministic(true),
+      sched_valid(false),
+      sched_serial(false) {
     vconstraints.clear();
     vvariables.clear();
     vstiffness.clear();
@@ -93,12 +107,193 @@ int ChSystemDescriptor::CountActiveConstraints() {
 }
 
 void ChSystemDescriptor::UpdateCountsAndOffsets() {
+    sched_valid = false;
     freeze_count = false;
     CountActiveVariables();
     CountActiveConstraints();
     freeze_count = true;
 }
 
+// -----------------------------------------------------------------------------
+
+void ChSystemDescriptor::SetNumThreads(int num_threads) {
+    nthreads = std::max(1, num_threads);
+}
+
+void ChSystemDescriptor::SetParallelThreshold(int min_constraints) {
+    par_threshold = std::max(0, min_constraints);
+}
+
+void ChSystemDescriptor::EnableDeterministic(bool val) {
+    if (val != deterministic) {
+        // force a new partition, even if the constraint topology did not change
+        sched_valid = false;
+        sched_color_start.clear();
+    }
+    deterministic = val;
+}
+
+bool ChSystemDescriptor::UseParallel() {
+    if (nthreads <= 1 || (int)vconstraints.size() < par_threshold)
+        return false;
+    if (!sched_valid)
+        UpdateSchedule();
+    return !sched_serial;
+}
+
+void ChSystemDescriptor::UpdateSchedule() {
+    sched_valid = true;
+
+    // Collect the active variables of each constraint (each list terminated by a nullptr).
+    // Note that inactive variables (e.g., of fixed bodies) are never updated and are therefore ignored.
+    auto vc_size = vconstraints.size();
+    std::vector<ChVariables*> key_vars;
+    key_vars.reserve(4 * vc_size);
+    std::vector<ChVariables*> vars;
+    for (size_t ic = 0; ic < vc_size; ic++) {
+        vars.clear();
+        if (!vconstraints[ic]->ListVariables(vars)) {
+            // cannot schedule this constraint; use the serial implementation
+            sched_serial = true;
+            sched_constraints.clear();
+            sched_color_start.clear();
+            sched_key_constraints.clear();
+            sched_key_vars.clear();
+            return;
+        }
+        for (auto var : vars) {
+            if (var && var->IsActive())
+                key_vars.push_back(var);
+        }
+        key_vars.push_back(nullptr);
+    }
+
+    // Reuse the current schedule if the constraint topology did not change
+    if (!sched_serial && !sched_color_start.empty() && key_vars == sched_key_vars &&
+        vconstraints == sched_key_constraints)
+        return;
+
+    sched_serial = false;
+    sched_constraints.clear();
+    sched_color_start.clear();
+    sched_key_constraints = vconstraints;
+    sched_key_vars.swap(key_vars);
+
+    // Colors already used by the constraints processed so far, for each variable:
+    // a bit mask of the first 64 colors and the highest color.
+    struct VarColors {
+        std::uint64_t mask = 0;
+        int last = -1;
+    };
+    std::unordered_map<ChVariables*, VarColors> var_colors;
+    var_colors.reserve(vvariables.size());
+
+    std::vector<int> color(vc_size);
+    int num_colors = 0;
+
+    size_t iv_start = 0;
+    for (size_t ic = 0; ic < vc_size; ic++) {
+        size_t iv_end = iv_start;
+        while (sched_key_vars[iv_end])
+            iv_end++;
+
+        std::uint64_t used = 0;
+        int last = -1;
+        for (size_t iv = iv_start; iv < iv_end; iv++) {
+            const auto& vc = var_colors[sched_key_vars[iv]];
+            used |= vc.mask;
+            last = std::max(last, vc.last);
+        }
+
+        // In deterministic mode, a constraint is placed after all the constraints it shares variables with, so
+        // that each variable is updated in the same order as in the serial implementation. Otherwise, pick the
+        // smallest color not used by any of the variables.
+        int c = last + 1;
+        if (!deterministic && ~used != 0) {
+            c = 0;
+            while (used & (std::uint64_t(1) << c))
+                c++;
+        }
+
+        for (size_t iv = iv_start; iv < iv_end; iv++) {
+            auto& vc = var_colors[sched_key_vars[iv]];
+            if (c < 64)
+                vc.mask |= std::uint64_t(1) << c;
+            vc.last = std::max(vc.last, c);
+        }
+
+        color[ic] = c;
+        num_colors = std::max(num_colors, c + 1);
+        iv_start = iv_end + 1;
+    }
+
+    // Sort constraints by color (stable, so that constraints of the same color keep their insertion order)
+    sched_color_start.assign(num_colors + 1, 0);
+    for (size_t ic = 0; ic < vc_size; ic++)
+        sched_color_start[color[ic] + 1]++;
+    for (int k = 0; k < num_colors; k++)
+        sched_color_start[k + 1] += sched_color_start[k];
+
+    std::vector<size_t> pos(sched_color_start.begin(), sched_color_start.end() - 1);
+    sched_constraints.resize(vc_size);
+    for (size_t ic = 0; ic < vc_size; ic++)
+        sched_constraints[pos[color[ic]]++] = vconstraints[ic];
+}
+
+int ChSystemDescriptor::ComputeIslands(std::vector<int>& island) {
+    // Index the active variables (inactive variables, e.g. of fixed bodies, do not connect constraints)
+    std::unordered_map<ChVariables*, int> var_index;
+    var_index.reserve(vvariables.size());
+    for (auto var : vvariables) {
+        if (var->IsActive())
+            var_index.emplace(var, (int)var_index.size());
+    }
+
+    // Merge the variables referenced by each active constraint
+    auto vc_size = vconstraints.size();
+    std::vector<int> first_var(vc_size, -1);
+    std::vector<ChVariables*> vars;
+    utils::ChUnionFind sets((int)var_index.size());
+
+    for (size_t ic = 0; ic < vc_size; ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        vars.clear();
+        if (!vconstraints[ic]->ListVariables(vars)) {
+            island.assign(vc_size, -1);
+            return 0;
+        }
+        for (auto var : vars) {
+            auto it = var ? var_index.find(var) : var_index.end();
+            if (it == var_index.end())
+                continue;
+            if (first_var[ic] < 0)
+                first_var[ic] = it->second;
+            else
+                sets.Union(first_var[ic], it->second);
+        }
+    }
+
+    // Number the islands in the order of their first constraint
+    std::vector<int> set_island(var_index.size(), -1);
+    int num_islands = 0;
+    island.assign(vc_size, -1);
+    for (size_t ic = 0; ic < vc_size; ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        if (first_var[ic] < 0) {
+            island[ic] = num_islands++;
+            continue;
+        }
+        int root = sets.Find(first_var[ic]);
+        if (set_island[root] < 0)
+            set_island[root] = num_islands++;
+        island[ic] = set_island[root];
+    }
+
+    return num_islands;
+}
+
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
                                              ChSparseMatrix* H,
                                              ChSparseMatrix* E,
@@ -498,20 +693,18 @@ void ChSystemDescriptor::ShurComplementProduct(ChVectorDynamic<>& result,
 
     // 1 - set the qb vector (aka speeds, in each ChVariable sparse data) as zero
 
-    for (size_t iv = 0; iv < vv_size; iv++) {
-        if (vvariables[iv]->IsActive())
-            vvariables[iv]->Get_qb().setZero();
-    }
+    auto reset_qb = [&](ChVariables* var) {
+        if (var->IsActive())
+            var->Get_qb().setZero();
+    };
 
     // 2 - performs    qb=[M^(-1)][Cq']*l  by
-    //     iterating over all constraints (when implemented in parallel this
-    //     could be non-trivial because race conditions might occur -> reduction buffer etc.)
+    //     iterating over all constraints.
     //     Also, begin to add the cfm term ( -[E]*l ) to the result.
 
-    // ATTENTION:  this loop cannot be parallelized! Concurrent write to some q may happen
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            int s_c = vconstraints[ic]->GetOffset();
+    auto increment_qb = [&](ChConstraint* constr) {
+        if (constr->IsActive()) {
+            int s_c = constr->GetOffset();
 
             bool process = (!enabled) || (*enabled)[s_c];
 
@@ -520,26 +713,63 @@ void ChSystemDescriptor::ShurComplementProduct(ChVectorDynamic<>& result,
 
                 // Compute qb += [M^(-1)][Cq']*l_i
                 //  NOTE! concurrent update to same q data, risk of collision if parallel.
-                vconstraints[ic]->Increment_q(li);  // computationally intensive
+                constr->Increment_q(li);  // computationally intensive
 
                 // Add constraint force mixing term  result = cfm * l_i = [E]*l_i
-                result(s_c) = vconstraints[ic]->Get_cfm_i() * li;
+                result(s_c) = constr->Get_cfm_i() * li;
             }
         }
-    }
+    };
 
     // 3 - performs    result=[Cq']*qb    by
     //     iterating over all constraints
 
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            bool process = (!enabled) || (*enabled)[vconstraints[ic]->GetOffset()];
+    auto add_Cq_qb = [&](ChConstraint* constr) {
+        if (constr->IsActive()) {
+            bool process = (!enabled) || (*enabled)[constr->GetOffset()];
 
             if (process)
-                result(vconstraints[ic]->GetOffset()) += vconstraints[ic]->Compute_Cq_q();  // computationally intensive
+                result(constr->GetOffset()) += constr->Compute_Cq_q();  // computationally intensive
             else
-                result(vconstraints[ic]->GetOffset()) = 0;  // not enabled constraints, just set to 0 result
+                result(constr->GetOffset()) = 0;  // not enabled constraints, just set to 0 result
         }
+    };
+
+    if (!UseParallel()) {
+        for (size_t iv = 0; iv < vv_size; iv++)
+            reset_qb(vvariables[iv]);
+
+        // ATTENTION:  this loop cannot be parallelized! Concurrent write to some q may happen
+        for (size_t ic = 0; ic < vc_size; ic++)
+            increment_qb(vconstraints[ic]);
+
+        for (size_t ic = 0; ic < vc_size; ic++)
+            add_Cq_qb(vconstraints[ic]);
+
+        return;
+    }
+
+    // Parallel version: in phase 2, constraints of the same color do not share variables,
+    // so that they can update the qb vectors concurrently.
+    auto num_colors = GetNumColors();
+
+#pragma omp parallel num_threads(nthreads)
+    {
+#pragma omp for
+        for (int iv = 0; iv < (int)vv_size; iv++)
+            reset_qb(vvariables[iv]);
+
+        for (size_t k = 0; k < num_colors; k++) {
+            int start = (int)sched_color_start[k];
+            int end = (int)sched_color_start[k + 1];
+#pragma omp for
+            for (int i = start; i < end; i++)
+                increment_qb(sched_constraints[i]);
+        }
+
+#pragma omp for
+        for (int ic = 0; ic < (int)vc_size; ic++)
+            add_Cq_qb(vconstraints[ic]);
     }
 }
 
@@ -556,31 +786,73 @@ void ChSystemDescriptor::SystemProduct(ChVectorDynamic<>& result, const ChVector
     // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
 
     // 1.1)  do  M*x.q
-    for (size_t iv = 0; iv < vv_size; iv++) {
-        if (vvariables[iv]->IsActive()) {
-            vvariables[iv]->MultiplyAndAdd(result, x, c_a);
-        }
-    }
+    auto add_Mx = [&](ChVariables* var) {
+        if (var->IsActive())
+            var->MultiplyAndAdd(result, x, c_a);
+    };
 
     // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
-    for (size_t ik = 0; ik < vs_size; ik++) {
-        vstiffness[ik]->MultiplyAndAdd(result, x);
-    }
+    auto add_Kx = [&]() {
+        for (size_t ik = 0; ik < vs_size; ik++) {
+            vstiffness[ik]->MultiplyAndAdd(result, x);
+        }
+    };
 
     // 1.3)  add also [Cq]'*x.l  (NON straight parallelizable - risk of concurrency in writing)
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            vconstraints[ic]->MultiplyTandAdd(result, x(vconstraints[ic]->GetOffset() + n_q));
+    auto add_CqTx = [&](ChConstraint* constr) {
+        if (constr->IsActive())
+            constr->MultiplyTandAdd(result, x(constr->GetOffset() + n_q));
+    };
+
+    // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l
+    auto add_Cqx = [&](ChConstraint* constr) {
+        if (constr->IsActive()) {
+            int s_c = constr->GetOffset() + n_q;
+            constr->MultiplyAndAdd(result(s_c), x);       // result.l_i += [C_q_i]*x.q
+            result(s_c) += constr->Get_cfm_i() * x(s_c);  // result.l_i += [E]*x.l_i
         }
+    };
+
+    if (!UseParallel()) {
+        for (size_t iv = 0; iv < vv_size; iv++)
+            add_Mx(vvariables[iv]);
+
+        add_Kx();
+
+        for (size_t ic = 0; ic < vc_size; ic++)
+            add_CqTx(vconstraints[ic]);
+
+        for (size_t ic = 0; ic < vc_size; ic++)
+            add_Cqx(vconstraints[ic]);
+
+        return;
     }
 
-    // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            int s_c = vconstraints[ic]->GetOffset() + n_q;
-            vconstraints[ic]->MultiplyAndAdd(result(s_c), x);       // result.l_i += [C_q_i]*x.q
-            result(s_c) += vconstraints[ic]->Get_cfm_i() * x(s_c);  // result.l_i += [E]*x.l_i
+    // Parallel version: in 1.3, constraints of the same color do not share variables,
+    // so that they can update the result vector concurrently. The K blocks are processed outside of the parallel
+    // regions, so that K blocks which are themselves parallelized (e.g., the matrix-free K block of a ChMesh) can use
+    // their own threads.
+    auto num_colors = GetNumColors();
+
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < (int)vv_size; iv++)
+        add_Mx(vvariables[iv]);
+
+    add_Kx();
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        for (size_t k = 0; k < num_colors; k++) {
+            int start = (int)sched_color_start[k];
+            int end = (int)sched_color_start[k + 1];
+#pragma omp for
+            for (int i = start; i < end; i++)
+                add_CqTx(sched_constraints[i]);
         }
+
+#pragma omp for
+        for (int ic = 0; ic < (int)vc_size; ic++)
+            add_Cqx(vconstraints[ic]);
     }
 }
 
@@ -589,7 +861,10 @@ void ChSystemDescriptor::ConstraintsProject(ChVectorDynamic<>& multipliers) {
 
     auto vc_size = vconstraints.size();
 
-    for (size_t ic = 0; ic < vc_size; ic++) {
+    // Note: projection of a constraint only modifies its own multipliers (or those of the
+    // tangential components of a frictional contact, which do not have a projection of their own).
+#pragma omp parallel for num_threads(nthreads) if ((int)vc_size >= par_threshold)
+    for (int ic = 0; ic < (int)vc_size; ic++) {
         if (vconstraints[ic]->IsActive())
             vconstraints[ic]->Project();
     }
@@ -602,25 +877,31 @@ void ChSystemDescriptor::UnknownsProject(ChVectorDynamic<>& mx) {
 
     auto vc_size = vconstraints.size();
 
-    // vector -> constraints
-    // Fetch from the second part of vector (x.l = -l), with flipped sign!
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            vconstraints[ic]->Set_l_i(-mx(vconstraints[ic]->GetOffset() + n_q));
+#pragma omp parallel num_threads(nthreads) if ((int)vc_size >= par_threshold)
+    {
+        // vector -> constraints
+        // Fetch from the second part of vector (x.l = -l), with flipped sign!
+#pragma omp for
+        for (int ic = 0; ic < (int)vc_size; ic++) {
+            if (vconstraints[ic]->IsActive()) {
+                vconstraints[ic]->Set_l_i(-mx(vconstraints[ic]->GetOffset() + n_q));
+            }
         }
-    }
 
-    // constraint projection!
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive())
-            vconstraints[ic]->Project();
-    }
+        // constraint projection!
+#pragma omp for
+        for (int ic = 0; ic < (int)vc_size; ic++) {
+            if (vconstraints[ic]->IsActive())
+                vconstraints[ic]->Project();
+        }
 
-    // constraints -> vector
-    // Fill the second part of vector, x.l, with constraint multipliers -l (with flipped sign!)
-    for (size_t ic = 0; ic < vc_size; ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            mx(vconstraints[ic]->GetOffset() + n_q) = -vconstraints[ic]->Get_l_i();
+        // constraints -> vector
+        // Fill the second part of vector, x.l, with constraint multipliers -l (with flipped sign!)
+#pragma omp for
+        for (int ic = 0; ic < (int)vc_size; ic++) {
+            if (vconstraints[ic]->IsActive()) {
+                mx(vconstraints[ic]->GetOffset() + n_q) = -vconstraints[ic]->Get_l_i();
+            }
         }
     }
 }
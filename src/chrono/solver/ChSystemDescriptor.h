@@ -82,6 +82,24 @@ class ChApi ChSystemDescriptor {
     int n_c;            ///< number of active constraints
     bool freeze_count;  ///< for optimization: avoid to re-count the number of active variables and constraints
 
+    int nthreads;        ///< number of threads used in the parallel products and projections
+    int par_threshold;   ///< minimum number of constraints for using the parallel implementation
+    bool deterministic;  ///< if true, parallel products are bit-compatible with the serial ones
+
+    bool sched_valid;                                  ///< true if the schedule was checked after the last insertion
+    bool sched_serial;                                 ///< true if some constraint does not list its variables
+    std::vector<ChConstraint*> sched_constraints;      ///< constraints, sorted by color
+    std::vector<size_t> sched_color_start;             ///< start of each color in sched_constraints (plus end marker)
+    std::vector<ChConstraint*> sched_key_constraints;  ///< constraints for which the schedule was computed
+    std::vector<ChVariables*> sched_key_vars;          ///< their active variables (nullptr-terminated lists)
+
+    /// Partition the constraints in colors, such that constraints of the same color do not share variables.
+    /// The current partition is reused if the constraints and their active variables did not change.
+    void UpdateSchedule();
+
+    /// Return true if the parallel implementation should be used.
+    bool UseParallel();
+
   public:
     /// Constructor
     ChSystemDescriptor();
@@ -105,13 +123,20 @@ class ChApi ChSystemDescriptor {
         vconstraints.clear();
         vvariables.clear();
         vstiffness.clear();
+        sched_valid = false;
     }
 
     /// Insert reference to a ChConstraint object
-    virtual void InsertConstraint(ChConstraint* mc) { vconstraints.push_back(mc); }
+    virtual void InsertConstraint(ChConstraint* mc) {
+        vconstraints.push_back(mc);
+        sched_valid = false;
+    }
 
     /// Insert reference to a ChVariables object
-    virtual void InsertVariables(ChVariables* mv) { vvariables.push_back(mv); }
+    virtual void InsertVariables(ChVariables* mv) {
+        vvariables.push_back(mv);
+        sched_valid = false;
+    }
 
     /// Insert reference to a ChKblock object (a piece of matrix)
     virtual void InsertKblock(ChKblock* mk) { vstiffness.push_back(mk); }
@@ -146,6 +171,50 @@ class ChApi ChSystemDescriptor {
     /// when performing ShurComplementProduct(), SystemProduct(), ConvertToMatrixForm(),
     virtual double GetMassFactor() { return c_a; }
 
+    /// Set the number of OpenMP threads used in ShurComplementProduct(), SystemProduct(),
+    /// ConstraintsProject() and UnknownsProject() (default: 1, i.e. serial execution).
+    /// Concurrent updates of the variables are avoided by partitioning the constraints in colors,
+    /// such that constraints of the same color do not share any ChVariables; colors are then processed
+    /// one after the other, with the constraints of each color processed in parallel.
+    /// After items are inserted or UpdateCountsAndOffsets() is called (as done at each step by ChSystem),
+    /// the partition is recomputed only if the constraints or their active variables changed.
+    /// Note that ChSystem does not change this setting; parallel execution must be explicitly enabled with
+    /// sys.GetSystemDescriptor()->SetNumThreads().
+    void SetNumThreads(int num_threads);
+
+    /// Set the minimum number of constraints for which the parallel implementation is used (default: 1000).
+    /// Smaller problems are processed serially, as the cost of the parallel region would exceed the gain.
+    void SetParallelThreshold(int min_constraints);
+
+    /// Get the minimum number of constraints for which the parallel implementation is used.
+    int GetParallelThreshold() const { return par_threshold; }
+
+    /// Get the number of threads used in the parallel products and projections.
+    int GetNumThreads() const { return nthreads; }
+
+    /// Enable/disable deterministic mode for the parallel products (default: true).
+    /// In deterministic mode, the constraints are partitioned in levels which preserve, for each variable,
+    /// the order in which it is updated by the serial implementation, so that results are bit-compatible
+    /// with the serial ones, regardless of the number of threads. Otherwise, a greedy coloring is used,
+    /// which usually results in fewer (larger) colors; results are then reproducible for a given set of
+    /// constraints, but may differ from the serial ones because of floating point round-off.
+    void EnableDeterministic(bool val);
+
+    /// Return true if the deterministic mode is enabled.
+    bool IsDeterministic() const { return deterministic; }
+
+    /// Return the number of colors used in the parallel products (0 if not yet computed).
+    size_t GetNumColors() const { return sched_color_start.empty() ? 0 : sched_color_start.size() - 1; }
+
+    /// Partition the active constraints in islands, i.e. groups of constraints connected through shared active
+    /// variables (union-find over the variables). Constraints of different islands do not interact, so that the
+    /// corresponding sub-problems can be solved independently and concurrently. A constraint without active variables
+    /// forms an island of its own. Islands are numbered in the order of their first constraint.
+    /// On output, 'island' holds the island index of each constraint in the constraint list (-1 if inactive).
+    /// Returns the number of islands, or 0 if some constraint does not list its variables (see
+    /// ChConstraint::ListVariables), in which case the problem cannot be partitioned.
+    int ComputeIslands(std::vector<int>& island);
+
     // DATA <-> MATH.VECTORS FUNCTIONS
 
     /// Get a vector with all the 'fb' known terms ('forces'etc.) associated to all variables,
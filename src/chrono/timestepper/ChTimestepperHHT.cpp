@@ -34,7 +34,13 @@ ChTimestepperHHT::ChTimestepperHHT(ChIntegrableIIorder* intgr)
       h_min(1e-10),
       h(1e6),
       num_successful_steps(0),
-      modified_Newton(true) {
+      modified_Newton(true),
+      jacobian_reuse(false),
+      reuse_maxiters(3),
+      reuse_max_rate(0.5),
+      matrix_reusable(false),
+      matrix_h(0),
+      matrix_size(0) {
     SetAlpha(-0.2);  // default: some dissipation
 }
 
@@ -103,12 +109,13 @@ void ChTimestepperHHT::Advance(const double dt) {
 
     // Monitor flags controlling whther or not the Newton matrix must be updated.
     // If using modified Newton, a matrix update occurs:
-    //   - at the beginning of a step
+    //   - at the beginning of a step (unless reusing the matrix from the previous step)
     //   - on a stepsize decrease
     //   - if the Newton iteration does not converge with an out-of-date matrix
     // Otherwise, the matrix is updated at each iteration.
+    int size = mintegrable->GetNcoords_v() + mintegrable->GetNconstr();
     matrix_is_current = false;
-    call_setup = true;
+    call_setup = !(modified_Newton && jacobian_reuse && matrix_reusable && h == matrix_h && size == matrix_size);
 
     // Loop until reaching final time
     while (true) {
@@ -118,6 +125,8 @@ void ChTimestepperHHT::Advance(const double dt) {
         // Newton-Raphson for state at T+h
         bool converged = false;
         int it;
+        double D_nrm_old = 0;
+        double rate = 0;
 
         for (it = 0; it < maxiters; it++) {
             if (verbose && modified_Newton && call_setup)
@@ -131,8 +140,16 @@ void ChTimestepperHHT::Advance(const double dt) {
             numsolves++;
             if (call_setup) {
                 numsetups++;
+                matrix_h = h;
+                matrix_size = size;
             }
 
+            // Track the contraction rate of the NR corrections
+            double D_nrm = Da.wrmsNorm(ewtS);
+            if (it > 0 && D_nrm_old > 0)
+                rate = ChMax(rate, D_nrm / D_nrm_old);
+            D_nrm_old = D_nrm;
+
             // If using modified Newton, do not call Setup again
             call_setup = !modified_Newton;
 
@@ -165,6 +182,11 @@ void ChTimestepperHHT::Advance(const double dt) {
             else
                 num_successful_steps = 0;
 
+            // keep the Newton matrix for the next step only if convergence did not degrade
+            matrix_reusable = (it < reuse_maxiters) && (rate <= reuse_max_rate);
+            if (jacobian_reuse)
+                matrix_is_current = false;
+
             if (verbose) {
                 GetLog() << " HHT NR converged (" << num_successful_steps << ").";
                 GetLog() << "  T = " << T + h << "  h = " << h << "\n";
@@ -182,26 +204,25 @@ void ChTimestepperHHT::Advance(const double dt) {
             A = Anew;
             L = Lnew;
 
-            /*
-            } else if (!matrix_is_current) {
-                // ------ NR did not converge but the matrix was out-of-date
+        } else if (!matrix_is_current) {
+            // ------ NR did not converge but the matrix was out-of-date
 
-                // reset the count of successive successful steps
-                num_successful_steps = 0;
+            // reset the count of successive successful steps
+            num_successful_steps = 0;
 
-                // re-attempt step with updated matrix
-                if (verbose) {
-                    GetLog() << " HHT re-attempt step with updated matrix.\n";
-                }
+            // re-attempt step with updated matrix
+            if (verbose) {
+                GetLog() << " HHT re-attempt step with updated matrix.\n";
+            }
 
-                call_setup = true;
-            */
+            call_setup = true;
 
         } else if (!step_control) {
             // ------ NR did not converge and we do not control stepsize
 
             // reset the count of successive successful steps
             num_successful_steps = 0;
+            matrix_reusable = false;
 
             // accept solution as is and complete step
             if (verbose) {
@@ -242,6 +263,10 @@ void ChTimestepperHHT::Advance(const double dt) {
             break;
         }
 
+        // If reusing the Newton matrix, re-evaluate it at the next internal step only if convergence degraded
+        if (jacobian_reuse && !matrix_reusable)
+            call_setup = true;
+
         // Go back in the loop: scatter state and reset temporary vector
         // Scatter state -> system
         mintegrable->StateScatter(X, V, T, false);
@@ -255,6 +280,11 @@ void ChTimestepperHHT::Advance(const double dt) {
     // Scatter auxiliary data (A and L) -> system
     mintegrable->StateScatterAcceleration(A);
     mintegrable->StateScatterReactions(L);
+
+    if (verbose) {
+        GetLog() << " HHT step: iterations = " << numiters << "  Jacobian evaluations/factorizations = " << numsetups
+                 << "  solves = " << numsolves << "\n";
+    }
 }
 
 // Prepare attempting a step of size h (assuming a converged state at the current time t):
@@ -369,8 +399,9 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
             break;
     }
 
-    // If Setup was called at this iteration, mark the Newton matrix as up-to-date
-    matrix_is_current = call_setup;
+    // If Setup was called at this iteration, mark the Newton matrix as up-to-date for the current step
+    if (call_setup)
+        matrix_is_current = true;
 }
 
 // Convergence test
@@ -65,6 +65,13 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     bool matrix_is_current;  ///< is the Newton matrix up-to-date?
     bool call_setup;         ///< should the solver's Setup function be called?
 
+    bool jacobian_reuse;     ///< reuse the Newton matrix across steps?
+    int reuse_maxiters;      ///< maximum number of NR iterations for keeping the Newton matrix in the next step
+    double reuse_max_rate;   ///< maximum NR contraction rate for keeping the Newton matrix in the next step
+    bool matrix_reusable;    ///< can the current Newton matrix be used in the next step?
+    double matrix_h;         ///< stepsize used in evaluating the current Newton matrix
+    int matrix_size;         ///< problem size when the current Newton matrix was evaluated
+
     ChVectorDynamic<> ewtS;  ///< vector of error weights (states)
     ChVectorDynamic<> ewtL;  ///< vector of error weights (Lagrange multipliers)
 
@@ -121,6 +128,25 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// Modified Newton iteration is enabled by default.
     void SetModifiedNewton(bool val) { modified_Newton = val; }
 
+    /// Enable/disable reuse of the Newton matrix across steps (default: false).
+    /// Only used with modified Newton. If enabled, the Newton matrix (and its factorization, for a direct solver)
+    /// is kept from one step to the next until convergence degrades, i.e. a step requires more NR iterations or
+    /// shows a larger contraction rate than the thresholds set with SetJacobianReuseThresholds. The matrix is
+    /// also re-evaluated on a stepsize change, on a change in problem size, and if the NR iteration fails with an
+    /// out-of-date matrix. For best performance, combine with a direct solver with locked sparsity pattern.
+    void SetJacobianReuse(bool val) { jacobian_reuse = val; }
+
+    /// Set the thresholds for keeping the Newton matrix in the next step (default: 3 iterations, rate 0.5).
+    /// The contraction rate is the largest ratio of successive NR correction norms in a step.
+    void SetJacobianReuseThresholds(int max_iters, double max_rate) {
+        reuse_maxiters = max_iters;
+        reuse_max_rate = max_rate;
+    }
+
+    /// Force a re-evaluation of the Newton matrix at the next step.
+    /// Must be called if the solver was used by some other analysis (e.g., assembly) between steps.
+    void ForceJacobianUpdate() { matrix_reusable = false; }
+
     /// Perform an integration timestep.
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
@@ -0,0 +1,71 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CH_UNION_FIND_H
+#define CH_UNION_FIND_H
+
+#include <utility>
+#include <vector>
+
+namespace chrono {
+namespace utils {
+
+/// Disjoint-set forest (union-find) over the integers 0...n-1, with path halving and union by size.
+/// Used to find connected components, e.g. islands of bodies connected by links and contacts.
+class ChUnionFind {
+  public:
+    ChUnionFind(int n = 0) { Reset(n); }
+
+    /// Reset to n singleton sets.
+    void Reset(int n) {
+        m_parent.resize(n);
+        m_size.assign(n, 1);
+        for (int i = 0; i < n; i++)
+            m_parent[i] = i;
+    }
+
+    /// Return the representative of the set containing i.
+    int Find(int i) {
+        while (m_parent[i] != i) {
+            m_parent[i] = m_parent[m_parent[i]];
+            i = m_parent[i];
+        }
+        return i;
+    }
+
+    /// Merge the sets containing i and j. Return the representative of the merged set.
+    int Union(int i, int j) {
+        i = Find(i);
+        j = Find(j);
+        if (i == j)
+            return i;
+        if (m_size[i] < m_size[j])
+            std::swap(i, j);
+        m_parent[j] = i;
+        m_size[i] += m_size[j];
+        return i;
+    }
+
+    /// Return the number of elements in the set containing i.
+    int GetSize(int i) { return m_size[Find(i)]; }
+
+  private:
+    std::vector<int> m_parent;
+    std::vector<int> m_size;
+};
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
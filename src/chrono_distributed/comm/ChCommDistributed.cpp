@@ -268,31 +268,40 @@ void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
 
 // Handle all necessary communication
 void ChCommDistributed::Exchange() {
+    ExchangeBegin();
+    ExchangeEnd();
+}
+
+// Classify and pack the bodies and post the sends to the neighbor ranks
+void ChCommDistributed::ExchangeBegin() {
     int my_rank = my_sys->my_rank;
     int num_ranks = my_sys->num_ranks;
-    std::forward_list<int> exchanges_up;
-    std::forward_list<int> exchanges_down;
+
+    data_manager->system_timer.start("ExchangePack");
+
+    exchanges_up.clear();
+    exchanges_down.clear();
 
     // Saves a reference copy for consistency in the threads.
     ddm->curr_status = ddm->comm_status;
-    std::vector<BodyExchange> exchange_up_buf;
-    std::vector<BodyExchange> exchange_down_buf;
-    std::vector<BodyUpdate> update_up_buf;
-    std::vector<BodyUpdate> update_down_buf;
-    std::vector<Shape> shapes_up;
-    std::vector<Shape> shapes_down;
-    std::vector<uint> update_take_up;
-    std::vector<uint> update_take_down;
+    exchange_up_buf.clear();
+    exchange_down_buf.clear();
+    update_up_buf.clear();
+    update_down_buf.clear();
+    shapes_up.clear();
+    shapes_down.clear();
+    update_take_up.clear();
+    update_take_down.clear();
 
     // Send Counts
-    int num_exchange_up = 0;
-    int num_exchange_down = 0;
-    int num_update_up = 0;
-    int num_update_down = 0;
-    int num_shapes_up = 0;
-    int num_shapes_down = 0;
-    int num_take_up = 0;
-    int num_take_down = 0;
+    num_exchange_up = 0;
+    num_exchange_down = 0;
+    num_update_up = 0;
+    num_update_down = 0;
+    num_shapes_up = 0;
+    num_shapes_down = 0;
+    num_take_up = 0;
+    num_take_down = 0;
 
 #pragma omp parallel sections
     {
@@ -442,183 +451,64 @@ void ChCommDistributed::Exchange() {
         }      // End of update take loop
     }          // End of parallel sections
 
-    // MPI_Status status_exchange_up;
-    // MPI_Status status_exchange_down;
-    // MPI_Status status_update_up;
-    // MPI_Status status_update_down;
-    // MPI_Status status_take_up;
-    // MPI_Status status_take_down;
-    // MPI_Status status_shapes_up;
-    // MPI_Status status_shapes_down;
-
-    MPI_Request rq_exchange_up;
-    MPI_Request rq_exchange_down;
-    MPI_Request rq_update_up;
-    MPI_Request rq_update_down;
-    MPI_Request rq_take_up;
-    MPI_Request rq_take_down;
-    MPI_Request rq_shapes_up;
-    MPI_Request rq_shapes_down;
+    // Send empty message if there is nothing to send
+    if (num_exchange_up == 0) {
+        BodyExchange b_e = {};
+        b_e.gid = UINT_MAX;
+        exchange_up_buf.push_back(b_e);
+        num_exchange_up = 1;
+    }
+    if (num_exchange_down == 0) {
+        BodyExchange b_e = {};
+        b_e.gid = UINT_MAX;
+        exchange_down_buf.push_back(b_e);
+        num_exchange_down = 1;
+    }
+    if (num_update_up == 0) {
+        BodyUpdate b_u = {};
+        b_u.gid = UINT_MAX;
+        update_up_buf.push_back(b_u);
+        num_update_up = 1;
+    }
+    if (num_update_down == 0) {
+        BodyUpdate b_u = {};
+        b_u.gid = UINT_MAX;
+        update_down_buf.push_back(b_u);
+        num_update_down = 1;
+    }
+    if (num_take_up == 0) {
+        update_take_up.push_back(UINT_MAX);
+        num_take_up = 1;
+    }
+    if (num_take_down == 0) {
+        update_take_down.push_back(UINT_MAX);
+        num_take_down = 1;
+    }
 
-    MPI_Status recv_status_exchange_up;
-    MPI_Status recv_status_exchange_down;
-    MPI_Status recv_status_update_up;
-    MPI_Status recv_status_update_down;
-    MPI_Status recv_status_take_up;
-    MPI_Status recv_status_take_down;
-    MPI_Status recv_status_shapes_up;
-    MPI_Status recv_status_shapes_down;
+    data_manager->system_timer.stop("ExchangePack");
+    data_manager->system_timer.start("ExchangeWire");
 
-    int num_recv_exchange_up;
-    int num_recv_exchange_down;
-    int num_recv_update_up;
-    int num_recv_update_down;
-    int num_recv_take_up;
-    int num_recv_take_down;
-    int num_recv_shapes_up = 0;
-    int num_recv_shapes_down = 0;
+    // Post all sends at once, so that the messages are in flight while the caller does local work
+    if (my_rank != num_ranks - 1) {
+        MPI_Isend(&(exchange_up_buf[0]), num_exchange_up, BodyExchangeType, my_rank + 1, 1, my_sys->world,
+                  &rq_exchange_up);
+        MPI_Isend(&(update_up_buf[0]), num_update_up, BodyUpdateType, my_rank + 1, 3, my_sys->world, &rq_update_up);
+        MPI_Isend(&(update_take_up[0]), num_take_up, MPI_UNSIGNED, my_rank + 1, 5, my_sys->world, &rq_take_up);
+    }
+    if (my_rank != 0) {
+        MPI_Isend(&(exchange_down_buf[0]), num_exchange_down, BodyExchangeType, my_rank - 1, 2, my_sys->world,
+                  &rq_exchange_down);
+        MPI_Isend(&(update_down_buf[0]), num_update_down, BodyUpdateType, my_rank - 1, 4, my_sys->world,
+                  &rq_update_down);
+        MPI_Isend(&(update_take_down[0]), num_take_down, MPI_UNSIGNED, my_rank - 1, 6, my_sys->world,
+                  &rq_take_down);
+    }
 
-    BodyExchange* recv_exchange_down = NULL;
-    BodyExchange* recv_exchange_up = NULL;
-    BodyUpdate* recv_update_down = NULL;
-    BodyUpdate* recv_update_up = NULL;
-    uint* recv_take_down = NULL;
-    uint* recv_take_up = NULL;
-    Shape* recv_shapes_down = NULL;
-    Shape* recv_shapes_up = NULL;
+    data_manager->system_timer.start("ExchangePack");
 
+    // TODO could do in parallel if counting the spaces in the buffers in the first pass
 #pragma omp parallel sections
     {
-// Send/Recv
-#pragma omp section
-        {
-            // SENDING - TODO sequential for now
-
-            // Send empty message if there is nothing to send
-            if (num_exchange_up == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_up_buf.push_back(b_e);
-                num_exchange_up = 1;
-            }
-            if (num_exchange_down == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_down_buf.push_back(b_e);
-                num_exchange_down = 1;
-            }
-            if (num_update_up == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_up_buf.push_back(b_u);
-                num_update_up = 1;
-            }
-            if (num_update_down == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_down_buf.push_back(b_u);
-                num_update_down = 1;
-            }
-            if (num_take_up == 0) {
-                update_take_up.push_back(UINT_MAX);
-                num_take_up = 1;
-            }
-            if (num_take_down == 0) {
-                update_take_down.push_back(UINT_MAX);
-                num_take_down = 1;
-            }
-
-            // Send Exchanges
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(exchange_up_buf[0]), num_exchange_up, BodyExchangeType, my_rank + 1, 1, my_sys->world,
-                          &rq_exchange_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(exchange_down_buf[0]), num_exchange_down, BodyExchangeType, my_rank - 1, 2, my_sys->world,
-                          &rq_exchange_down);
-            }
-
-            // Recv Exchanges
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 1, my_sys->world, &recv_status_exchange_down);
-                MPI_Get_count(&recv_status_exchange_down, BodyExchangeType, &num_recv_exchange_down);
-                recv_exchange_down = new BodyExchange[num_recv_exchange_down];
-                MPI_Recv(recv_exchange_down, num_recv_exchange_down, BodyExchangeType, my_rank - 1, 1, my_sys->world,
-                         &recv_status_exchange_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 2, my_sys->world, &recv_status_exchange_up);
-                MPI_Get_count(&recv_status_exchange_up, BodyExchangeType, &num_recv_exchange_up);
-                recv_exchange_up = new BodyExchange[num_recv_exchange_up];
-                MPI_Recv(recv_exchange_up, num_recv_exchange_up, BodyExchangeType, my_rank + 1, 2, my_sys->world,
-                         &recv_status_exchange_up);
-            }
-
-            // Send Updates
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_up_buf[0]), num_update_up, BodyUpdateType, my_rank + 1, 3, my_sys->world,
-                          &rq_update_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_down_buf[0]), num_update_down, BodyUpdateType, my_rank - 1, 4, my_sys->world,
-                          &rq_update_down);
-            }
-
-            // Recv Updates
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 3, my_sys->world, &recv_status_update_down);
-                MPI_Get_count(&recv_status_update_down, BodyUpdateType, &num_recv_update_down);
-                recv_update_down = new BodyUpdate[num_recv_update_down];
-                MPI_Recv(recv_update_down, num_recv_update_down, BodyUpdateType, my_rank - 1, 3, my_sys->world,
-                         &recv_status_update_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 4, my_sys->world, &recv_status_update_up);
-                MPI_Get_count(&recv_status_update_up, BodyUpdateType, &num_recv_update_up);
-                recv_update_up = new BodyUpdate[num_recv_update_up];
-                MPI_Recv(recv_update_up, num_recv_update_up, BodyUpdateType, my_rank + 1, 4, my_sys->world,
-                         &recv_status_update_up);
-            }
-
-            // Send Takes
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_take_up[0]), num_take_up, MPI_UNSIGNED, my_rank + 1, 5, my_sys->world, &rq_take_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_take_down[0]), num_take_down, MPI_UNSIGNED, my_rank - 1, 6, my_sys->world,
-                          &rq_take_down);
-            }
-
-            // Recv Takes
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 5, my_sys->world, &recv_status_take_down);
-                MPI_Get_count(&recv_status_take_down, MPI_UNSIGNED, &num_recv_take_down);
-                recv_take_down = new uint[num_recv_take_down];
-                MPI_Recv(recv_take_down, num_recv_take_down, MPI_UNSIGNED, my_rank - 1, 5, my_sys->world,
-                         &recv_status_take_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 6, my_sys->world, &recv_status_take_up);
-                MPI_Get_count(&recv_status_take_up, MPI_UNSIGNED, &num_recv_take_up);
-                recv_take_up = new uint[num_recv_take_up];
-                MPI_Recv(recv_take_up, num_recv_take_up, MPI_UNSIGNED, my_rank + 1, 6, my_sys->world,
-                         &recv_status_take_up);
-            }
-
-            // Make sure all non-blocking communications are done.
-            if (my_rank != num_ranks - 1) {
-                MPI_Wait(&rq_exchange_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_up, MPI_STATUS_IGNORE);
-            }
-            if (my_rank != 0) {
-                MPI_Wait(&rq_exchange_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_down, MPI_STATUS_IGNORE);
-            }
-        }  // End of send/recv section
-
-// TODO could do in parallel if counting the spaces in the buffers in the first pass
 // Pack Shapes Up
 #pragma omp section
         {
@@ -649,6 +539,96 @@ void ChCommDistributed::Exchange() {
         }  // End of pack shapes down section
     }      // End of parallel sections
 
+    data_manager->system_timer.stop("ExchangePack");
+}
+
+// Receive and process the messages from the neighbor ranks, then exchange the shapes of the new ghost bodies
+void ChCommDistributed::ExchangeEnd() {
+    int my_rank = my_sys->my_rank;
+    int num_ranks = my_sys->num_ranks;
+
+    MPI_Request rq_shapes_up;
+    MPI_Request rq_shapes_down;
+
+    MPI_Status recv_status_exchange_up;
+    MPI_Status recv_status_exchange_down;
+    MPI_Status recv_status_update_up;
+    MPI_Status recv_status_update_down;
+    MPI_Status recv_status_take_up;
+    MPI_Status recv_status_take_down;
+    MPI_Status recv_status_shapes_up;
+    MPI_Status recv_status_shapes_down;
+
+    int num_recv_exchange_up;
+    int num_recv_exchange_down;
+    int num_recv_update_up;
+    int num_recv_update_down;
+    int num_recv_take_up;
+    int num_recv_take_down;
+    int num_recv_shapes_up = 0;
+    int num_recv_shapes_down = 0;
+
+    BodyExchange* recv_exchange_down = NULL;
+    BodyExchange* recv_exchange_up = NULL;
+    BodyUpdate* recv_update_down = NULL;
+    BodyUpdate* recv_update_up = NULL;
+    uint* recv_take_down = NULL;
+    uint* recv_take_up = NULL;
+    Shape* recv_shapes_down = NULL;
+    Shape* recv_shapes_up = NULL;
+
+    data_manager->system_timer.start("ExchangeWait");
+
+    // Recv Exchanges
+    if (my_rank != 0) {
+        MPI_Probe(my_rank - 1, 1, my_sys->world, &recv_status_exchange_down);
+        MPI_Get_count(&recv_status_exchange_down, BodyExchangeType, &num_recv_exchange_down);
+        recv_exchange_down = new BodyExchange[num_recv_exchange_down];
+        MPI_Recv(recv_exchange_down, num_recv_exchange_down, BodyExchangeType, my_rank - 1, 1, my_sys->world,
+                 &recv_status_exchange_down);
+    }
+    if (my_rank != num_ranks - 1) {
+        MPI_Probe(my_rank + 1, 2, my_sys->world, &recv_status_exchange_up);
+        MPI_Get_count(&recv_status_exchange_up, BodyExchangeType, &num_recv_exchange_up);
+        recv_exchange_up = new BodyExchange[num_recv_exchange_up];
+        MPI_Recv(recv_exchange_up, num_recv_exchange_up, BodyExchangeType, my_rank + 1, 2, my_sys->world,
+                 &recv_status_exchange_up);
+    }
+
+    // Recv Updates
+    if (my_rank != 0) {
+        MPI_Probe(my_rank - 1, 3, my_sys->world, &recv_status_update_down);
+        MPI_Get_count(&recv_status_update_down, BodyUpdateType, &num_recv_update_down);
+        recv_update_down = new BodyUpdate[num_recv_update_down];
+        MPI_Recv(recv_update_down, num_recv_update_down, BodyUpdateType, my_rank - 1, 3, my_sys->world,
+                 &recv_status_update_down);
+    }
+    if (my_rank != num_ranks - 1) {
+        MPI_Probe(my_rank + 1, 4, my_sys->world, &recv_status_update_up);
+        MPI_Get_count(&recv_status_update_up, BodyUpdateType, &num_recv_update_up);
+        recv_update_up = new BodyUpdate[num_recv_update_up];
+        MPI_Recv(recv_update_up, num_recv_update_up, BodyUpdateType, my_rank + 1, 4, my_sys->world,
+                 &recv_status_update_up);
+    }
+
+    // Recv Takes
+    if (my_rank != 0) {
+        MPI_Probe(my_rank - 1, 5, my_sys->world, &recv_status_take_down);
+        MPI_Get_count(&recv_status_take_down, MPI_UNSIGNED, &num_recv_take_down);
+        recv_take_down = new uint[num_recv_take_down];
+        MPI_Recv(recv_take_down, num_recv_take_down, MPI_UNSIGNED, my_rank - 1, 5, my_sys->world,
+                 &recv_status_take_down);
+    }
+    if (my_rank != num_ranks - 1) {
+        MPI_Probe(my_rank + 1, 6, my_sys->world, &recv_status_take_up);
+        MPI_Get_count(&recv_status_take_up, MPI_UNSIGNED, &num_recv_take_up);
+        recv_take_up = new uint[num_recv_take_up];
+        MPI_Recv(recv_take_up, num_recv_take_up, MPI_UNSIGNED, my_rank + 1, 6, my_sys->world, &recv_status_take_up);
+    }
+
+    data_manager->system_timer.stop("ExchangeWire");
+    data_manager->system_timer.stop("ExchangeWait");
+
     // TODO sections?
     if (my_rank != 0)
         ProcessExchanges(num_recv_exchange_down, recv_exchange_down, 0);
@@ -673,6 +653,8 @@ void ChCommDistributed::Exchange() {
         MPI_Isend(&(shapes_down[0]), num_shapes_down, ShapeType, my_rank - 1, 8, my_sys->world, &rq_shapes_down);
     }
 
+    data_manager->system_timer.start("ExchangeWait");
+
     // Recv Shapes
     if (my_rank != 0) {
         MPI_Probe(my_rank - 1, 7, my_sys->world, &recv_status_shapes_down);
@@ -689,17 +671,28 @@ void ChCommDistributed::Exchange() {
         MPI_Recv(recv_shapes_up, num_recv_shapes_up, ShapeType, my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
     }
 
+    data_manager->system_timer.stop("ExchangeWait");
+
     if (my_rank != 0)
         ProcessShapes(num_recv_shapes_down, recv_shapes_down);
     if (my_rank != num_ranks - 1)
         ProcessShapes(num_recv_shapes_up, recv_shapes_up);
 
+    // Make sure all non-blocking communications are done.
+    data_manager->system_timer.start("ExchangeWait");
     if (my_rank != num_ranks - 1) {
+        MPI_Wait(&rq_exchange_up, MPI_STATUS_IGNORE);
+        MPI_Wait(&rq_update_up, MPI_STATUS_IGNORE);
+        MPI_Wait(&rq_take_up, MPI_STATUS_IGNORE);
         MPI_Wait(&rq_shapes_up, MPI_STATUS_IGNORE);
     }
     if (my_rank != 0) {
+        MPI_Wait(&rq_exchange_down, MPI_STATUS_IGNORE);
+        MPI_Wait(&rq_update_down, MPI_STATUS_IGNORE);
+        MPI_Wait(&rq_take_down, MPI_STATUS_IGNORE);
         MPI_Wait(&rq_shapes_down, MPI_STATUS_IGNORE);
     }
+    data_manager->system_timer.stop("ExchangeWait");
 
     // Free all dynamic memory used for recving
     delete[] recv_exchange_down;
@@ -710,8 +703,6 @@ void ChCommDistributed::Exchange() {
     delete[] recv_take_up;
     delete[] recv_shapes_down;
     delete[] recv_shapes_up;
-
-    MPI_Barrier(my_sys->world);
 }
 
 void ChCommDistributed::PackExchange(BodyExchange* buf, int index) {
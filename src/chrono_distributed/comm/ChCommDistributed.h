@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <forward_list>
 #include <memory>
+#include <vector>
 
 #include "chrono/physics/ChBody.h"
 
@@ -113,8 +115,18 @@ class CH_DISTR_API ChCommDistributed {
     ///	- need to update their comm_status
     /// Sends updates via mpi to the appropriate rank
     /// Processes incoming updates from other ranks
+    /// Equivalent to ExchangeBegin followed by ExchangeEnd.
     void Exchange();
 
+    /// First half of Exchange: classifies and packs the bodies and posts the non-blocking sends to the neighbor
+    /// ranks. Only the bodies near the sub-domain boundaries need to be up to date. Local work which does not affect
+    /// the shared and ghost bodies can be carried out while the messages are in flight, before calling ExchangeEnd.
+    void ExchangeBegin();
+
+    /// Second half of Exchange: receives and processes the messages posted by the neighbor ranks in ExchangeBegin,
+    /// then exchanges the collision shapes of the new ghost bodies.
+    void ExchangeEnd();
+
   protected:
     ChSystemDistributed* my_sys;
 
@@ -130,6 +142,34 @@ class CH_DISTR_API ChCommDistributed {
     ChDistributedDataManager* ddm;
 
   private:
+    // Send buffers and requests, kept between ExchangeBegin and ExchangeEnd
+    std::forward_list<int> exchanges_up;
+    std::forward_list<int> exchanges_down;
+    std::vector<BodyExchange> exchange_up_buf;
+    std::vector<BodyExchange> exchange_down_buf;
+    std::vector<BodyUpdate> update_up_buf;
+    std::vector<BodyUpdate> update_down_buf;
+    std::vector<Shape> shapes_up;
+    std::vector<Shape> shapes_down;
+    std::vector<uint> update_take_up;
+    std::vector<uint> update_take_down;
+
+    int num_exchange_up;
+    int num_exchange_down;
+    int num_update_up;
+    int num_update_down;
+    int num_shapes_up;
+    int num_shapes_down;
+    int num_take_up;
+    int num_take_down;
+
+    MPI_Request rq_exchange_up;
+    MPI_Request rq_exchange_down;
+    MPI_Request rq_update_up;
+    MPI_Request rq_update_down;
+    MPI_Request rq_take_up;
+    MPI_Request rq_take_down;
+
     /// Helper function for processing incoming exchange messages.
     void ProcessExchanges(int num_recv, BodyExchange* buf, int updown);
 
@@ -17,11 +17,14 @@
 
 #include "chrono_multicore/ChDataManager.h"
 
+#include "chrono/core/ChMathematics.h"
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 
@@ -69,13 +72,20 @@ void ChDomainDistributed::SetSimDomain(const ChVector<>& lo, const ChVector<>& h
 }
 
 void ChDomainDistributed::SplitDomain() {
-    // Length of this subdomain along the long axis
-    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / my_sys->num_ranks;
+    int num_ranks = my_sys->num_ranks;
+
+    // Length of each subdomain along the long axis
+    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / num_ranks;
+
+    split_pos.resize(num_ranks + 1);
+    for (int r = 0; r < num_ranks; r++)
+        split_pos[r] = boxlo[split_axis] + r * sub_len;
+    split_pos[num_ranks] = boxhi[split_axis];
 
     for (int i = 0; i < 3; i++) {
         if (split_axis == i) {
-            sublo[i] = boxlo[i] + my_sys->my_rank * sub_len;
-            subhi[i] = sublo[i] + sub_len;
+            sublo[i] = split_pos[my_sys->my_rank];
+            subhi[i] = split_pos[my_sys->my_rank + 1];
         } else {
             sublo[i] = boxlo[i];
             subhi[i] = boxhi[i];
@@ -85,10 +95,74 @@ void ChDomainDistributed::SplitDomain() {
 }
 
 int ChDomainDistributed::GetRank(const ChVector<double>& pos) const {
-    double sub_len = subhi[split_axis] - sublo[split_axis];
-    double pt = pos[split_axis] - boxlo[split_axis];
+    // First interior boundary above the position (positions outside the domain map to the first or last rank)
+    auto it = std::upper_bound(split_pos.begin() + 1, split_pos.end() - 1, pos[split_axis]);
+    return (int)(it - split_pos.begin()) - 1;
+}
+
+bool ChDomainDistributed::Rebalance(double body_weight, double max_shift) {
+    assert(split);
+    int num_ranks = my_sys->num_ranks;
+    if (num_ranks == 1)
+        return false;
+
+    double lo = boxlo[split_axis];
+    int num_bins = 64 * num_ranks;
+    double bin_len = (boxhi[split_axis] - lo) / num_bins;
+
+    // Global load distribution along the split axis
+    std::vector<double> load(num_bins, 0.0);
+    const auto& pos = my_sys->data_manager->host_data.pos_rigid;
+    const auto& status = my_sys->ddm->comm_status;
+    for (uint i = 0; i < my_sys->data_manager->num_rigid_bodies; i++) {
+        if (status[i] != distributed::OWNED && status[i] != distributed::SHARED_UP &&
+            status[i] != distributed::SHARED_DOWN)
+            continue;
+        int bin = (int)std::floor((pos[i][split_axis] - lo) / bin_len);
+        load[ChClamp(bin, 0, num_bins - 1)] += body_weight;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, load.data(), num_bins, MPI_DOUBLE, MPI_SUM, my_sys->world);
+
+    double total = 0;
+    for (int b = 0; b < num_bins; b++)
+        total += load[b];
+    if (total <= 0)
+        return false;
+
+    // Place the interior boundaries at the quantiles of the load, limiting the shift of each boundary
+    std::vector<double> new_pos(split_pos);
+    double cumul = 0;
+    int b = 0;
+    for (int r = 1; r < num_ranks; r++) {
+        double target = total * r / num_ranks;
+        while (b < num_bins - 1 && cumul + load[b] < target)
+            cumul += load[b++];
+        double frac = (load[b] > 0) ? ChClamp((target - cumul) / load[b], 0.0, 1.0) : 0.0;
+        double quantile = lo + (b + frac) * bin_len;
+        new_pos[r] = ChClamp(quantile, split_pos[r] - max_shift, split_pos[r] + max_shift);
+    }
+
+    // Keep each slab at least two ghost layers wide, so that shared and ghost regions only involve direct neighbors
+    double min_len = 2 * my_sys->GetGhostLayer();
+    for (int r = 1; r < num_ranks; r++)
+        new_pos[r] = std::max(new_pos[r], new_pos[r - 1] + min_len);
+    for (int r = num_ranks - 1; r > 0; r--)
+        new_pos[r] = std::min(new_pos[r], new_pos[r + 1] - min_len);
+    for (int r = 0; r < num_ranks; r++) {
+        if (new_pos[r + 1] - new_pos[r] < min_len)
+            return false;
+    }
+
+    // All ranks compute identical boundaries from the reduced load
+    bool moved = false;
+    for (int r = 1; r < num_ranks; r++)
+        moved = moved || (new_pos[r] != split_pos[r]);
+
+    split_pos = new_pos;
+    sublo[split_axis] = split_pos[my_sys->my_rank];
+    subhi[split_axis] = split_pos[my_sys->my_rank + 1];
 
-    return (int)(pt / sub_len);
+    return moved;
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetRegion(double pos) const {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
@@ -31,7 +32,10 @@ class ChSystemDistributed;
 /// @{
 
 /// This class maps sub-domains of the global simulation domain to each MPI rank.
-/// The global domain is split along the longest axis.
+/// The global domain is split in slabs along the longest axis. The slabs initially have equal widths; their boundaries
+/// can be moved during the simulation to balance the load between ranks (see Rebalance).
+/// Only this one-dimensional (slab) decomposition is supported: each rank exchanges ghost bodies with its "up" and
+/// "down" neighbors only, so there is no 2D/3D decomposition with edge and corner neighbors.
 /// Within each sub-domain, there are layers of ownership:
 ///
 ///
@@ -139,6 +143,19 @@ class CH_DISTR_API ChDomainDistributed {
     /// Returns the rank which has ownership of a body with the given position
     int GetRank(const ChVector<double>& pos) const;
 
+    /// Returns the coordinates, along the split axis, of the sub-domain boundaries of all ranks.
+    /// Rank i owns the slab between entries i and i+1.
+    const std::vector<double>& GetSplitBoundaries() const { return split_pos; }
+
+    /// Moves the sub-domain boundaries along the split axis towards an equal split of the load.
+    /// The load is the number of bodies each rank is responsible for (OWNED or SHARED), each weighted by body_weight.
+    /// The new boundaries are the quantiles of the global load distribution along the split axis (equivalent to a
+    /// recursive bisection in one dimension). Each boundary moves by at most max_shift, which should be small compared
+    /// to the ghost layer so that the resulting ownership changes are carried out by the regular exchange.
+    /// Only the slab boundaries along the split axis are moved; the number of slabs and the split axis do not change.
+    /// Must be called on all ranks. Returns true if the boundaries were moved.
+    virtual bool Rebalance(double body_weight, double max_shift);
+
     /// Returns true if the domain has been set.
     bool IsSplit() const { return split; }
 
@@ -156,6 +173,8 @@ class CH_DISTR_API ChDomainDistributed {
 
     int split_axis;  ///< Index of the dimension of the longest edge of the global domain
 
+    std::vector<double> split_pos;  ///< Sub-domain boundaries along the split axis (num_ranks + 1 entries)
+
     /// Divides the domain into equal-volume, orthogonal, axis-aligned regions along
     /// the longest axis. Needs to be called right after the system is created so that
     /// bodies are added correctly.
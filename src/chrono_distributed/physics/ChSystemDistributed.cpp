@@ -15,6 +15,7 @@
 #include <cstdlib>
 
 #include <mpi.h>
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cmath>
@@ -53,7 +54,13 @@ static void PrintNode(LocalShapeNode* node) {
 }
 
 ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlayer, unsigned int maxobjects)
-    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0) {
+    : ghost_layer(ghostlayer),
+      master_rank(0),
+      num_bodies_global(0),
+      num_steps(0),
+      lb_interval(0),
+      lb_step_time(false),
+      lb_report_interval(0) {
     MPI_Comm_dup(communicator, &world);
     MPI_Comm_size(world, &num_ranks);
     MPI_Comm_rank(world, &my_rank);
@@ -65,6 +72,10 @@ ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlaye
     comm = new ChCommDistributed(this);
 
     data_manager->system_timer.AddTimer("Exchange");
+    data_manager->system_timer.AddTimer("ExchangePack");
+    data_manager->system_timer.AddTimer("ExchangeWire");
+    data_manager->system_timer.AddTimer("ExchangeWait");
+    step_timer.reset();
 
     // Reserve starting space
     int init = maxobjects;  // / num_ranks;
@@ -120,22 +131,117 @@ bool ChSystemDistributed::InSub(const ChVector<double>& pos) const {
     return (pos_axis >= lo - this->ghost_layer) && (pos_axis <= hi + this->ghost_layer);
 }
 
+void ChSystemDistributed::SetLoadBalancing(int interval, bool use_step_time) {
+    lb_interval = interval;
+    lb_step_time = use_step_time;
+}
+
+int ChSystemDistributed::GetNumBodiesOwned() const {
+    int count = 0;
+    for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
+        auto status = ddm->comm_status[i];
+        if (status == distributed::OWNED || status == distributed::SHARED_UP || status == distributed::SHARED_DOWN)
+            count++;
+    }
+    return count;
+}
+
+double ChSystemDistributed::GetLoadImbalance() const {
+    int count = GetNumBodiesOwned();
+    int max_count;
+    int sum_count;
+    MPI_Allreduce(&count, &max_count, 1, MPI_INT, MPI_MAX, world);
+    MPI_Allreduce(&count, &sum_count, 1, MPI_INT, MPI_SUM, world);
+    return (sum_count > 0) ? (double)max_count * num_ranks / sum_count : 1.0;
+}
+
+double ChSystemDistributed::GetTimerExchangePack() const {
+    return data_manager->system_timer.GetTime("ExchangePack");
+}
+
+double ChSystemDistributed::GetTimerExchangeWire() const {
+    return data_manager->system_timer.GetTime("ExchangeWire");
+}
+
+double ChSystemDistributed::GetTimerExchangeWait() const {
+    return data_manager->system_timer.GetTime("ExchangeWait");
+}
+
+void ChSystemDistributed::Rebalance() {
+    // Weight each body with the per-body step time of this rank, so that the load of a rank is its step time
+    double weight = 1;
+    if (lb_step_time) {
+        int count = GetNumBodiesOwned();
+        weight = (count > 0) ? step_timer.GetTimeSeconds() / count : 0;
+    }
+    step_timer.reset();
+
+    domain->Rebalance(weight, 0.5 * ghost_layer);
+}
+
 bool ChSystemDistributed::Integrate_Y() {
     assert(domain->IsSplit());
     ddm->initial_add = false;
 
+    // The exchange is started at the end of the step, in ScatterRigidBodyStates
+    step_timer.start();
     bool ret = ChSystemMulticoreSMC::Integrate_Y();
+    step_timer.stop();
     if (num_ranks != 1) {
         data_manager->system_timer.start("Exchange");
-        comm->Exchange();
+        comm->ExchangeEnd();
         data_manager->system_timer.stop("Exchange");
     }
+
+    num_steps++;
+    if (lb_interval > 0 && num_ranks != 1 && num_steps % lb_interval == 0)
+        Rebalance();
+    if (lb_report_interval > 0 && num_steps % lb_report_interval == 0)
+        PrintLoadBalance();
 #ifdef DistrProfile
     PrintEfficiency();
 #endif
     return ret;
 }
 
+void ChSystemDistributed::ScatterRigidBodyStates() {
+    if (num_ranks == 1) {
+        ChSystemMulticore::ScatterRigidBodyStates();
+        return;
+    }
+
+    // Bodies which are OWNED and at least two ghost layers away from the sub-domain boundaries at the beginning of the
+    // step remain OWNED (bodies move less than a ghost layer per step) and are not involved in the exchange.
+    int split_axis = domain->GetSplitAxis();
+    double lo = domain->sublo[split_axis] + 2 * ghost_layer;
+    double hi = domain->subhi[split_axis] - 2 * ghost_layer;
+
+    std::vector<int> boundary;
+    std::vector<int> interior;
+    for (int i = 0; i < assembly.bodylist.size(); i++) {
+        double pos = data_manager->host_data.pos_rigid[i][split_axis];
+        if (ddm->comm_status[i] == distributed::OWNED && pos >= lo && pos < hi)
+            interior.push_back(i);
+        else
+            boundary.push_back(i);
+    }
+
+#pragma omp parallel for
+    for (int k = 0; k < boundary.size(); k++) {
+        ScatterRigidBodyState(boundary[k]);
+    }
+
+    // Post the messages to the neighbor ranks and process the interior bodies while they are in flight
+    data_manager->system_timer.start("Exchange");
+    comm->ExchangeBegin();
+    data_manager->system_timer.stop("Exchange");
+
+#pragma omp parallel for
+    for (int k = 0; k < interior.size(); k++) {
+        ScatterRigidBodyState(interior[k]);
+    }
+}
+
 void ChSystemDistributed::UpdateRigidBodies() {
     this->ChSystemMulticore::UpdateRigidBodies();
 
@@ -190,15 +296,20 @@ void ChSystemDistributed::AddBody(std::shared_ptr<ChBody> newbody) {
     // Increment global body ID counter.
     num_bodies_global++;
 
+    // With load balancing, the sub-domains change during the simulation and fixed bodies are kept on all ranks.
+    bool keep_fixed = lb_interval > 0 && newbody->GetBodyFixed();
+
     // Add body on the rank whose sub-domain contains the current body position.
-    if (!InSub(newbody->GetPos())) {
+    if (!InSub(newbody->GetPos()) && !keep_fixed) {
         return;
     }
 
     distributed::COMM_STATUS status = domain->GetBodyRegion(newbody);
 
     // Check for collision with this sub-domain
-    if (newbody->GetBodyFixed()) {
+    if (keep_fixed) {
+        status = distributed::GLOBAL;
+    } else if (newbody->GetBodyFixed()) {
         ChVector<double> body_min;
         ChVector<double> body_max;
         ChVector<double> sublo(domain->GetSubLo());
@@ -383,6 +494,27 @@ void ChSystemDistributed::PrintShapeData() {
            ddm->data_manager->num_rigid_bodies);
 }
 
+void ChSystemDistributed::PrintLoadBalance() const {
+    int count = GetNumBodiesOwned();
+    std::vector<int> counts(num_ranks);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, master_rank, world);
+
+    if (my_rank != master_rank)
+        return;
+
+    int max_count = *std::max_element(counts.begin(), counts.end());
+    int sum_count = std::accumulate(counts.begin(), counts.end(), 0);
+    double imbalance = (sum_count > 0) ? (double)max_count * num_ranks / sum_count : 1.0;
+
+    const auto& split_pos = domain->GetSplitBoundaries();
+    std::cout << "Step " << num_steps << " load balance (imbalance factor " << imbalance << ")\n";
+    for (int r = 0; r < num_ranks; r++) {
+        std::cout << "\tRank " << r << ": " << counts[r] << " bodies in [" << split_pos[r] << ", " << split_pos[r + 1]
+                  << ")\n";
+    }
+    std::cout << std::flush;
+}
+
 void ChSystemDistributed::PrintEfficiency() {
     const auto& shape_data = data_manager->cd_data->shape_data;
 
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 
+#include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChBody.h"
 
 #include "chrono_distributed/ChApiDistributed.h"
@@ -83,6 +84,37 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Return true if pos is within this rank's sub-domain.
     bool InSub(const ChVector<double>& pos) const;
 
+    /// Enable dynamic load balancing of the sub-domains (default: disabled).
+    /// Every 'interval' steps, the sub-domain boundaries along the split axis are moved, by at most half the ghost
+    /// layer, towards an equal split of the load. The load of a rank is the number of bodies it is responsible for or,
+    /// if use_step_time = true, its step time measured since the previous rebalancing.
+    /// Must be set on all ranks, before adding bodies. With load balancing, fixed bodies are kept on all ranks.
+    /// Balancing is limited to the one-dimensional slab decomposition (see ChDomainDistributed).
+    void SetLoadBalancing(int interval, bool use_step_time = false);
+
+    /// Report, on the master rank, the per-rank body counts and the load imbalance factor every 'interval' steps
+    /// (default: 0, no report). Must be set on all ranks.
+    void SetLoadReport(int interval) { lb_report_interval = interval; }
+
+    /// Return the number of bodies this rank is responsible for (OWNED or SHARED).
+    int GetNumBodiesOwned() const;
+
+    /// Return the load imbalance factor, i.e. the ratio of the maximum to the mean per-rank body count.
+    /// Must be called on all ranks.
+    double GetLoadImbalance() const;
+
+    /// Return the time spent during the last step classifying and packing bodies for the exchange with neighbor ranks.
+    double GetTimerExchangePack() const;
+
+    /// Return the time during which the exchange messages of the last step were in flight, from posting the sends to
+    /// receiving the last message. Only the end-of-step work (interior body scatter, constraint reaction fetch, and
+    /// state updates of the other physics items) overlaps with this interval.
+    double GetTimerExchangeWire() const;
+
+    /// Return the time spent during the last step blocked on messages from neighbor ranks.
+    /// The achieved overlap is the difference between the wire and wait times.
+    double GetTimerExchangeWait() const;
+
     /// Create a new body, consistent with the contact method and collision model used by this system.
     /// The returned body is not added to the system.
     virtual ChBody* NewBody() override;
@@ -108,6 +140,8 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
 
     /// Wraps the super-class Integrate_Y call and introduces a call that carries
     /// out all inter-rank communication.
+    /// The exchange overlaps only with the end-of-step state scatter, reaction fetch, and updates: collision detection
+    /// and the contact solve of the next step run on all bodies of the rank and start after the exchange has completed.
     virtual bool Integrate_Y() override;
 
     /// Wraps super-class UpdateRigidBodies and adds a gid update.
@@ -135,6 +169,10 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Prints measures for computing efficiency.
     void PrintEfficiency();
 
+    /// Prints, on the master rank, the per-rank body counts and the load imbalance factor.
+    /// Must be called on all ranks.
+    void PrintLoadBalance() const;
+
     /// Central data storages for chrono_distributed. Adds scaffolding data
     /// around ChDataManager used by Chrono::Multicore in order to maintain
     /// a consistent and correct view of all valid data.
@@ -239,6 +277,20 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemMulticoreSMC {
     /// Class for MPI communication
     ChCommDistributed* comm;
 
+    int num_steps;               ///< number of steps taken
+    int lb_interval;             ///< number of steps between load rebalancings (0: disabled)
+    bool lb_step_time;           ///< if true, balance the measured step times instead of the body counts
+    int lb_report_interval;      ///< number of steps between load reports (0: disabled)
+    ChTimer<double> step_timer;  ///< step time accumulated since the last rebalancing
+
+    /// Move the sub-domain boundaries to balance the load between ranks.
+    void Rebalance();
+
+    /// Load the new rigid body states at the end of a step. The bodies near the sub-domain boundaries are processed
+    /// first and their messages posted to the neighbor ranks; the interior bodies are processed while these messages
+    /// are in flight.
+    virtual void ScatterRigidBodyStates() override;
+
     /// Internal function for adding a body from communication. Should not be
     /// called by the user.
     void AddBodyExchange(std::shared_ptr<ChBody> newbody, distributed::COMM_STATUS status);
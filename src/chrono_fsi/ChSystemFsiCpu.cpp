@@ -0,0 +1,1138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Radu Serban
+// =============================================================================
+//
+// Multithreaded CPU implementation of the explicit WCSPH fluid-solid
+// interaction solver.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/fea/ChNodeFEAxyz.h"
+#include "chrono/utils/ChOpenMP.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChSystemFsiCpu.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+using namespace rapidjson;
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace chrono {
+namespace fsi {
+
+// Kernel support radius, as a multiple of the kernel length
+static const double RESOLUTION_LENGTH_MULT = 2.0;
+
+// Threshold below which the kernel gradient is set to zero
+static const double EPSILON = 1e-8;
+
+ChSystemFsiCpu::ChSystemFsiCpu(ChSystem* sysMBS)
+    : m_sysMBS(sysMBS),
+      m_verbose(true),
+      m_num_threads(ChOMP::GetNumProcs()),
+      m_is_initialized(false),
+      m_rho0(1000),
+      m_mu0(0.001),
+      m_gravity(0, 0, 0),
+      m_body_force(0, 0, 0),
+      m_h(0.01),
+      m_spacing(0.01),
+      m_v_max(1),
+      m_eps_xsph(0.5),
+      m_eps_min_dist(0.01),
+      m_ar_vis_alpha(0.5),
+      m_density_reinit(INT_MAX),
+      m_num_bce_layers(3),
+      m_bce_wall(BceVersion::ADAMI),
+      m_bce_body(BceVersion::ADAMI),
+      m_dT(1e-4),
+      m_dT_Flex(1e-4),
+      m_beta(0),
+      m_time(0),
+      m_box_dim(1, 1, 1),
+      m_use_default_limits(true),
+      m_num_fluid(0),
+      m_num_boundary(0),
+      m_num_rigid(0),
+      m_num_flex(0),
+      m_density_counter(0),
+      m_timer_total(0),
+      m_num_steps(0),
+      m_out_frame(-1) {
+    UpdateDependentParams();
+}
+
+ChSystemFsiCpu::~ChSystemFsiCpu() {}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static ChVector<> LoadVectorJSON(const Value& a) {
+    assert(a.IsArray());
+    assert(a.Size() == 3);
+    return ChVector<>(a[0u].GetDouble(), a[1u].GetDouble(), a[2u].GetDouble());
+}
+
+void ChSystemFsiCpu::ReadParametersFromFile(const std::string& json_file) {
+    if (m_verbose)
+        cout << "Reading parameters from: " << json_file << endl;
+
+    FILE* fp = fopen(json_file.c_str(), "r");
+    if (!fp) {
+        cerr << "Invalid JSON file!" << endl;
+        return;
+    }
+
+    char readBuffer[32768];
+    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    fclose(fp);
+
+    Document doc;
+
+    doc.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    if (!doc.IsObject()) {
+        cerr << "Invalid JSON file!!" << endl;
+        return;
+    }
+
+    if (doc.HasMember("Physical Properties of Fluid")) {
+        if (doc["Physical Properties of Fluid"].HasMember("Density"))
+            m_rho0 = doc["Physical Properties of Fluid"]["Density"].GetDouble();
+
+        if (doc["Physical Properties of Fluid"].HasMember("Viscosity"))
+            m_mu0 = doc["Physical Properties of Fluid"]["Viscosity"].GetDouble();
+
+        if (doc["Physical Properties of Fluid"].HasMember("Body Force"))
+            m_body_force = LoadVectorJSON(doc["Physical Properties of Fluid"]["Body Force"]);
+
+        if (doc["Physical Properties of Fluid"].HasMember("Gravity"))
+            m_gravity = LoadVectorJSON(doc["Physical Properties of Fluid"]["Gravity"]);
+    }
+
+    if (doc.HasMember("SPH Parameters")) {
+        if (doc["SPH Parameters"].HasMember("Method")) {
+            std::string SPH = doc["SPH Parameters"]["Method"].GetString();
+            if (m_verbose)
+                cout << "Modeling method is: " << SPH << endl;
+            if (SPH != "WCSPH") {
+                cerr << "The CPU FSI solver only implements WCSPH; ignoring SPH method " << SPH << endl;
+            }
+        }
+
+        if (doc["SPH Parameters"].HasMember("Kernel h"))
+            m_h = doc["SPH Parameters"]["Kernel h"].GetDouble();
+
+        if (doc["SPH Parameters"].HasMember("Initial Spacing"))
+            m_spacing = doc["SPH Parameters"]["Initial Spacing"].GetDouble();
+
+        if (doc["SPH Parameters"].HasMember("Epsilon"))
+            m_eps_min_dist = doc["SPH Parameters"]["Epsilon"].GetDouble();
+        else
+            m_eps_min_dist = 0.01;
+
+        if (doc["SPH Parameters"].HasMember("Maximum Velocity"))
+            m_v_max = doc["SPH Parameters"]["Maximum Velocity"].GetDouble();
+
+        if (doc["SPH Parameters"].HasMember("XSPH Coefficient"))
+            m_eps_xsph = doc["SPH Parameters"]["XSPH Coefficient"].GetDouble();
+
+        if (doc["SPH Parameters"].HasMember("Density Reinitialization"))
+            m_density_reinit = doc["SPH Parameters"]["Density Reinitialization"].GetInt();
+    }
+
+    if (doc.HasMember("Time Stepping")) {
+        if (doc["Time Stepping"].HasMember("Beta"))
+            m_beta = doc["Time Stepping"]["Beta"].GetDouble();
+
+        if (doc["Time Stepping"].HasMember("Fluid time step"))
+            m_dT = doc["Time Stepping"]["Fluid time step"].GetDouble();
+
+        if (doc["Time Stepping"].HasMember("Solid time step"))
+            m_dT_Flex = doc["Time Stepping"]["Solid time step"].GetDouble();
+        else
+            m_dT_Flex = m_dT;
+    }
+
+    if (doc.HasMember("Pressure Equation")) {
+        if (doc["Pressure Equation"].HasMember("Boundary Conditions")) {
+            std::string BC = doc["Pressure Equation"]["Boundary Conditions"].GetString();
+            if (BC == "Generalized Wall BC")
+                m_bce_body = BceVersion::ADAMI;
+            else
+                m_bce_body = BceVersion::ORIGINAL;
+        }
+    }
+
+    if (doc.HasMember("Elastic SPH")) {
+        cerr << "The CPU FSI solver does not support elastic SPH; ignoring granular material parameters" << endl;
+        if (doc["Elastic SPH"].HasMember("Artificial viscosity alpha"))
+            m_ar_vis_alpha = doc["Elastic SPH"]["Artificial viscosity alpha"].GetDouble();
+    }
+
+    if (doc.HasMember("Geometry Inf")) {
+        if (doc["Geometry Inf"].HasMember("BoxDimensionX"))
+            m_box_dim.x() = doc["Geometry Inf"]["BoxDimensionX"].GetDouble();
+
+        if (doc["Geometry Inf"].HasMember("BoxDimensionY"))
+            m_box_dim.y() = doc["Geometry Inf"]["BoxDimensionY"].GetDouble();
+
+        if (doc["Geometry Inf"].HasMember("BoxDimensionZ"))
+            m_box_dim.z() = doc["Geometry Inf"]["BoxDimensionZ"].GetDouble();
+    }
+
+    UpdateDependentParams();
+}
+
+void ChSystemFsiCpu::UpdateDependentParams() {
+    m_invh = 1 / m_h;
+    m_volume0 = m_spacing * m_spacing * m_spacing;
+    m_marker_mass = m_volume0 * m_rho0;
+    m_Cs = 10 * m_v_max;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::SetNumThreads(int num_threads) {
+    m_num_threads = std::max(1, num_threads);
+}
+
+void ChSystemFsiCpu::SetInitialSpacing(double spacing) {
+    m_spacing = spacing;
+    UpdateDependentParams();
+}
+
+void ChSystemFsiCpu::SetKernelLength(double length) {
+    m_h = length;
+    UpdateDependentParams();
+}
+
+void ChSystemFsiCpu::SetBoundaries(const ChVector<>& cMin, const ChVector<>& cMax) {
+    m_cMin = cMin;
+    m_cMax = cMax;
+    m_use_default_limits = false;
+}
+
+void ChSystemFsiCpu::SetDensity(double rho0) {
+    m_rho0 = rho0;
+    UpdateDependentParams();
+}
+
+void ChSystemFsiCpu::SetMaxVelocity(double v_max) {
+    m_v_max = v_max;
+    UpdateDependentParams();
+}
+
+void ChSystemFsiCpu::SetStepSize(double dT, double dT_Flex) {
+    m_dT = dT;
+    m_dT_Flex = (dT_Flex == 0) ? m_dT : dT_Flex;
+}
+
+std::vector<ChVector<>> ChSystemFsiCpu::GetParticleFluidProperties() const {
+    std::vector<ChVector<>> props(m_pos.size());
+    for (size_t i = 0; i < m_pos.size(); i++)
+        props[i] = ChVector<>(m_rho[i], m_pres[i], m_mu[i]);
+    return props;
+}
+
+double ChSystemFsiCpu::GetParticleUpdatesPerSecond() const {
+    if (m_timer_total <= 0)
+        return 0;
+    return (double)m_num_fluid * (double)m_num_steps / m_timer_total;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::AddFsiBody(std::shared_ptr<ChBody> body) {
+    m_fsi_bodies.push_back(body);
+}
+
+void ChSystemFsiCpu::AddFsiMesh(std::shared_ptr<fea::ChMesh> mesh) {
+    m_fsi_meshes.push_back(mesh);
+}
+
+void ChSystemFsiCpu::AddSPHParticle(const ChVector<>& point,
+                                    double rho0,
+                                    double pres0,
+                                    double mu0,
+                                    const ChVector<>& velocity) {
+    if (m_is_initialized)
+        throw std::runtime_error("Cannot add SPH particles after initialization of the FSI system!");
+
+    m_pos.push_back(point);
+    m_vel.push_back(velocity);
+    m_rho.push_back(rho0);
+    m_pres.push_back(pres0);
+    m_mu.push_back(mu0);
+    m_num_fluid++;
+}
+
+void ChSystemFsiCpu::AddSPHParticle(const ChVector<>& point, const ChVector<>& velocity) {
+    AddSPHParticle(point, m_rho0, 0, m_mu0, velocity);
+}
+
+void ChSystemFsiCpu::AddBoxSPH(const ChVector<>& boxCenter, const ChVector<>& boxHalfDim) {
+    // Use a chrono sampler to create a bucket of points
+    chrono::utils::GridSampler<> sampler(m_spacing);
+    std::vector<ChVector<>> points = sampler.SampleBox(boxCenter, boxHalfDim);
+
+    // Add fluid particles from the sampler points to the FSI system
+    for (const auto& p : points)
+        AddSPHParticle(p, m_rho0, 0, m_mu0, ChVector<>(0));
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::AddWallBCE(std::shared_ptr<ChBody> body, const ChFrame<>& frame, const ChVector2<> size) {
+    std::vector<ChVector<>> bce;
+    CreateBCE_wall(size, bce);
+    AddBCE(body, bce, frame, false);
+}
+
+void ChSystemFsiCpu::AddContainerBCE(std::shared_ptr<ChBody> body,
+                                     const ChFrame<>& frame,
+                                     const ChVector<>& size,
+                                     const ChVector<int> faces) {
+    double spacing = m_spacing;
+    double buffer = 2 * m_num_bce_layers * spacing;
+
+    // Wall center positions
+    ChVector<> zn(0, 0, -spacing);
+    ChVector<> zp(0, 0, size.z() + spacing);
+    ChVector<> xn(-size.x() / 2 - spacing, 0, size.z() / 2);
+    ChVector<> xp(+size.x() / 2 + spacing, 0, size.z() / 2);
+    ChVector<> yn(0, -size.y() / 2 - spacing, size.z() / 2);
+    ChVector<> yp(0, +size.y() / 2 + spacing, size.z() / 2);
+
+    // Z- wall
+    if (faces.z() == -1 || faces.z() == 2)
+        AddWallBCE(body, frame * ChFrame<>(zn, QUNIT), {size.x(), size.y()});
+    // Z+ wall
+    if (faces.z() == +1 || faces.z() == 2)
+        AddWallBCE(body, frame * ChFrame<>(zp, Q_from_AngX(CH_C_PI)), {size.x(), size.y()});
+
+    // X- wall
+    if (faces.x() == -1 || faces.x() == 2)
+        AddWallBCE(body, frame * ChFrame<>(xn, Q_from_AngY(+CH_C_PI_2)), {size.z() + buffer, size.y()});
+    // X+ wall
+    if (faces.x() == +1 || faces.x() == 2)
+        AddWallBCE(body, frame * ChFrame<>(xp, Q_from_AngY(-CH_C_PI_2)), {size.z() + buffer, size.y()});
+
+    // Y- wall
+    if (faces.y() == -1 || faces.y() == 2)
+        AddWallBCE(body, frame * ChFrame<>(yn, Q_from_AngX(-CH_C_PI_2)), {size.x() + buffer, size.z() + buffer});
+    // Y+ wall
+    if (faces.y() == +1 || faces.y() == 2)
+        AddWallBCE(body, frame * ChFrame<>(yp, Q_from_AngX(+CH_C_PI_2)), {size.x() + buffer, size.z() + buffer});
+}
+
+void ChSystemFsiCpu::AddBoxBCE(std::shared_ptr<ChBody> body,
+                               const ChFrame<>& frame,
+                               const ChVector<>& size,
+                               bool solid) {
+    std::vector<ChVector<>> bce;
+    CreateBCE_box(size, solid, bce);
+    AddBCE(body, bce, frame, solid);
+}
+
+void ChSystemFsiCpu::AddSphereBCE(std::shared_ptr<ChBody> body, const ChFrame<>& frame, double radius, bool solid) {
+    std::vector<ChVector<>> bce;
+    CreateBCE_sphere(radius, solid, bce);
+    AddBCE(body, bce, frame, solid);
+}
+
+void ChSystemFsiCpu::AddPointsBCE(std::shared_ptr<ChBody> body,
+                                  const std::vector<ChVector<>>& points,
+                                  const ChFrame<>& frame,
+                                  bool solid) {
+    AddBCE(body, points, frame, solid);
+}
+
+void ChSystemFsiCpu::AddNodeBCE(std::shared_ptr<fea::ChNodeFEAxyz> node, const std::vector<ChVector<>>& offsets) {
+    if (m_is_initialized)
+        throw std::runtime_error("Cannot add BCE markers after initialization of the FSI system!");
+
+    for (const auto& p : offsets)
+        m_bce_markers.push_back({p, FLEX, nullptr, node});
+}
+
+void ChSystemFsiCpu::AddBCE(std::shared_ptr<ChBody> body,
+                            const std::vector<ChVector<>>& bce,
+                            const ChFrame<>& rel_frame,
+                            bool solid) {
+    if (m_is_initialized)
+        throw std::runtime_error("Cannot add BCE markers after initialization of the FSI system!");
+
+    int type = solid ? RIGID : BOUNDARY;
+    for (const auto& p : bce)
+        m_bce_markers.push_back({rel_frame.TransformPointLocalToParent(p), type, body, nullptr});
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::CreateBCE_wall(const ChVector2<>& size, std::vector<ChVector<>>& bce) const {
+    double spacing = m_spacing;
+
+    // Calculate actual spacing in x-y directions
+    ChVector2<> hsize = size / 2;
+    int npx = (int)std::round(hsize.x() / spacing);
+    int npy = (int)std::round(hsize.y() / spacing);
+    double deltax = hsize.x() / npx;
+    double deltay = hsize.y() / npy;
+
+    for (int il = 0; il < m_num_bce_layers; il++) {
+        for (int ix = -npx; ix <= npx; ix++) {
+            for (int iy = -npy; iy <= npy; iy++) {
+                bce.push_back(ChVector<>(ix * deltax, iy * deltay, -il * spacing));
+            }
+        }
+    }
+}
+
+void ChSystemFsiCpu::CreateBCE_box(const ChVector<>& size, bool solid, std::vector<ChVector<>>& bce) const {
+    double spacing = m_spacing;
+    int num_layers = m_num_bce_layers;
+
+    // Calculate actual spacing in all 3 directions
+    ChVector<> hsize = size / 2;
+    ChVector<int> np((int)std::round(hsize.x() / spacing), (int)std::round(hsize.y() / spacing),
+                     (int)std::round(hsize.z() / spacing));
+    ChVector<> delta(hsize.x() / np.x(), hsize.y() / np.y(), hsize.z() / np.z());
+
+    // Inflate box if boundary
+    if (!solid) {
+        np += ChVector<int>(num_layers - 1);
+        hsize += (num_layers - 1.0) * delta;
+    }
+
+    for (int il = 0; il < num_layers; il++) {
+        // faces in Z direction
+        for (int ix = -np.x(); ix <= np.x(); ix++) {
+            for (int iy = -np.y(); iy <= np.y(); iy++) {
+                bce.push_back(ChVector<>(ix * delta.x(), iy * delta.y(), -hsize.z() + il * delta.z()));
+                bce.push_back(ChVector<>(ix * delta.x(), iy * delta.y(), +hsize.z() - il * delta.z()));
+            }
+        }
+
+        // faces in Y direction
+        for (int ix = -np.x(); ix <= np.x(); ix++) {
+            for (int iz = -np.z() + num_layers; iz <= np.z() - num_layers; iz++) {
+                bce.push_back(ChVector<>(ix * delta.x(), -hsize.y() + il * delta.y(), iz * delta.z()));
+                bce.push_back(ChVector<>(ix * delta.x(), +hsize.y() - il * delta.y(), iz * delta.z()));
+            }
+        }
+
+        // faces in X direction
+        for (int iy = -np.y() + num_layers; iy <= np.y() - num_layers; iy++) {
+            for (int iz = -np.z() + num_layers; iz <= np.z() - num_layers; iz++) {
+                bce.push_back(ChVector<>(-hsize.x() + il * delta.x(), iy * delta.y(), iz * delta.z()));
+                bce.push_back(ChVector<>(+hsize.x() - il * delta.x(), iy * delta.y(), iz * delta.z()));
+            }
+        }
+    }
+}
+
+void ChSystemFsiCpu::CreateBCE_sphere(double rad, bool solid, std::vector<ChVector<>>& bce) const {
+    double spacing = m_spacing;
+    int num_layers = m_num_bce_layers;
+
+    // Use a Cartesian grid and accept points within the spherical shell
+    int np = (int)std::ceil((rad + num_layers * spacing) / spacing);
+    double rad_out = solid ? rad : rad + num_layers * spacing;
+    double rad_in = rad_out - num_layers * spacing;
+
+    for (int ix = -np; ix <= np; ix++) {
+        for (int iy = -np; iy <= np; iy++) {
+            for (int iz = -np; iz <= np; iz++) {
+                ChVector<> p(ix * spacing, iy * spacing, iz * spacing);
+                double r = p.Length();
+                if (r <= rad_out && r > rad_in)
+                    bce.push_back(p);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::Initialize() {
+    UpdateDependentParams();
+
+    // Calculate the marker mass so that the kernel summation on a regular lattice recovers the reference density
+    double sum_wij = 0;
+    int IDX = 10;
+    for (int i = -IDX; i <= IDX; i++)
+        for (int j = -IDX; j <= IDX; j++)
+            for (int k = -IDX; k <= IDX; k++)
+                sum_wij += W3h(ChVector<>(i, j, k).Length() * m_spacing);
+    m_marker_mass = m_rho0 / sum_wij;
+
+    if (m_use_default_limits) {
+        m_cMin = -2.0 * m_box_dim - ChVector<>(10 * m_h);
+        m_cMax = +2.0 * m_box_dim + ChVector<>(10 * m_h);
+    }
+    m_box_dims = m_cMax - m_cMin;
+
+    // Collect the FEA nodes of all FSI meshes and attach one BCE marker at each node
+    for (const auto& mesh : m_fsi_meshes) {
+        for (const auto& n : mesh->GetNodes()) {
+            if (auto node = std::dynamic_pointer_cast<fea::ChNodeFEAxyz>(n))
+                m_bce_markers.push_back({VNULL, FLEX, nullptr, node});
+        }
+    }
+
+    // Sort BCE markers by type (boundary, rigid, flex)
+    std::stable_sort(m_bce_markers.begin(), m_bce_markers.end(),
+                     [](const BceMarker& a, const BceMarker& b) { return a.type < b.type; });
+
+    std::unordered_map<ChBody*, int> body_index;
+    for (int ib = 0; ib < (int)m_fsi_bodies.size(); ib++)
+        body_index[m_fsi_bodies[ib].get()] = ib;
+    std::unordered_map<fea::ChNodeFEAxyz*, int> node_index;
+
+    m_num_boundary = 0;
+    m_num_rigid = 0;
+    m_num_flex = 0;
+    m_types.assign(m_num_fluid, FLUID);
+    m_marker_owner.clear();
+    m_marker_local.clear();
+
+    for (const auto& m : m_bce_markers) {
+        ChVector<> pos;
+        ChVector<> vel;
+        switch (m.type) {
+            case BOUNDARY: {
+                const auto& frame = m.body->GetFrame_REF_to_abs();
+                pos = frame.TransformPointLocalToParent(m.pos);
+                vel = frame.PointSpeedLocalToParent(m.pos);
+                m_num_boundary++;
+                break;
+            }
+            case RIGID: {
+                auto it = body_index.find(m.body.get());
+                if (it == body_index.end())
+                    throw std::runtime_error("Solid BCE markers attached to a body which is not an FSI body!");
+                const auto& frame = m.body->GetFrame_REF_to_abs();
+                pos = frame.TransformPointLocalToParent(m.pos);
+                vel = frame.PointSpeedLocalToParent(m.pos);
+                m_marker_owner.push_back(it->second);
+                m_marker_local.push_back(m.pos);
+                m_num_rigid++;
+                break;
+            }
+            case FLEX: {
+                auto it = node_index.find(m.node.get());
+                if (it == node_index.end()) {
+                    it = node_index.insert({m.node.get(), (int)m_fsi_nodes.size()}).first;
+                    m_fsi_nodes.push_back(m.node);
+                }
+                pos = m.node->GetPos() + m.pos;
+                vel = m.node->GetPos_dt();
+                m_marker_owner.push_back(it->second);
+                m_marker_local.push_back(m.pos);
+                m_num_flex++;
+                break;
+            }
+        }
+        m_pos.push_back(pos);
+        m_vel.push_back(vel);
+        m_rho.push_back(m_rho0);
+        m_pres.push_back(0);
+        m_mu.push_back(m_mu0);
+        m_types.push_back(m.type);
+    }
+    m_bce_markers.clear();
+
+    size_t num_markers = m_pos.size();
+    m_pos1 = m_pos;
+    m_vel1 = m_vel;
+    m_rho1 = m_rho;
+    m_pres1 = m_pres;
+    m_derivVel.assign(num_markers, VNULL);
+    m_derivVel_old.assign(num_markers, VNULL);
+    m_derivRho.assign(num_markers, 0);
+    m_vel_xsph.assign(num_markers, VNULL);
+    m_vel_mod.assign(num_markers, VNULL);
+    m_rho_mod.assign(num_markers, m_rho0);
+    m_pres_mod.assign(num_markers, 0);
+    m_acc_bce.assign(num_markers, VNULL);
+
+    m_body_forces.assign(m_fsi_bodies.size(), VNULL);
+    m_body_torques.assign(m_fsi_bodies.size(), VNULL);
+    m_node_forces.assign(m_fsi_nodes.size(), VNULL);
+
+    // Set up the neighbor search grid.
+    // Use at least one cell of size larger than the kernel support radius in each direction.
+    double support = RESOLUTION_LENGTH_MULT * m_h;
+    m_grid.origin = m_cMin;
+    m_grid.size = ChVector<int>(std::max(1, (int)std::floor(m_box_dims.x() / support)),
+                                std::max(1, (int)std::floor(m_box_dims.y() / support)),
+                                std::max(1, (int)std::floor(m_box_dims.z() / support)));
+    m_grid.cell_size = ChVector<>(m_box_dims.x() / m_grid.size.x(), m_box_dims.y() / m_grid.size.y(),
+                                  m_box_dims.z() / m_grid.size.z());
+    m_grid.cell_start.resize((size_t)m_grid.size.x() * m_grid.size.y() * m_grid.size.z() + 1);
+
+    // Collect the distinct neighbor cell offsets (with fewer than 3 cells in one direction, the offsets -1 and +1
+    // wrap around to the same cell and must only be visited once)
+    auto offsets = [](int n) {
+        if (n >= 3)
+            return std::vector<int>{-1, 0, 1};
+        if (n == 2)
+            return std::vector<int>{0, 1};
+        return std::vector<int>{0};
+    };
+    m_grid.nbr.clear();
+    for (int z : offsets(m_grid.size.z()))
+        for (int y : offsets(m_grid.size.y()))
+            for (int x : offsets(m_grid.size.x()))
+                m_grid.nbr.push_back(ChVector<int>(x, y, z));
+
+    UpdateBceMarkers();
+
+    if (m_verbose) {
+        cout << "CPU FSI system" << endl;
+        cout << "  num threads: " << m_num_threads << endl;
+        cout << "  rho0: " << m_rho0 << endl;
+        cout << "  mu0: " << m_mu0 << endl;
+        cout << "  gravity: " << m_gravity.x() << " " << m_gravity.y() << " " << m_gravity.z() << endl;
+        cout << "  HSML: " << m_h << endl;
+        cout << "  INITSPACE: " << m_spacing << endl;
+        cout << "  markerMass: " << m_marker_mass << endl;
+        cout << "  Cs: " << m_Cs << endl;
+        cout << "  dT: " << m_dT << "  dT_Flex: " << m_dT_Flex << endl;
+        cout << "  cMin: " << m_cMin.x() << " " << m_cMin.y() << " " << m_cMin.z() << endl;
+        cout << "  cMax: " << m_cMax.x() << " " << m_cMax.y() << " " << m_cMax.z() << endl;
+        cout << "  gridSize: " << m_grid.size.x() << " " << m_grid.size.y() << " " << m_grid.size.z() << endl;
+        cout << "Counters" << endl;
+        cout << "  numFluidMarkers: " << m_num_fluid << endl;
+        cout << "  numBoundaryMarkers: " << m_num_boundary << endl;
+        cout << "  numRigidMarkers: " << m_num_rigid << endl;
+        cout << "  numFlexMarkers: " << m_num_flex << endl;
+        cout << "  numFsiBodies: " << m_fsi_bodies.size() << endl;
+        cout << "  numFsiNodes: " << m_fsi_nodes.size() << endl;
+    }
+
+    m_is_initialized = true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+// Cubic spline kernel (support radius 2h)
+double ChSystemFsiCpu::W3h(double d) const {
+    double q = std::abs(d) * m_invh;
+    double c = 0.25 * CH_C_1_PI * m_invh * m_invh * m_invh;
+    if (q < 1)
+        return c * ((2 - q) * (2 - q) * (2 - q) - 4 * (1 - q) * (1 - q) * (1 - q));
+    if (q < 2)
+        return c * (2 - q) * (2 - q) * (2 - q);
+    return 0;
+}
+
+// Gradient of the cubic spline kernel
+ChVector<> ChSystemFsiCpu::GradW3h(const ChVector<>& d) const {
+    double q = d.Length() * m_invh;
+    if (q < EPSILON)
+        return VNULL;
+    double invh2 = m_invh * m_invh;
+    double c = 0.75 * CH_C_1_PI * invh2 * invh2 * m_invh;
+    if (q < 1)
+        return (c * (3 * q - 4)) * d;
+    if (q < 2)
+        return (c * (-q + 4 - 4 / q)) * d;
+    return VNULL;
+}
+
+// Distance vector between two markers, accounting for periodicity and preventing perfect overlap
+ChVector<> ChSystemFsiCpu::Distance(const ChVector<>& a, const ChVector<>& b) const {
+    ChVector<> dist = a - b;
+    for (int k = 0; k < 3; k++) {
+        if (dist[k] > 0.5 * m_box_dims[k])
+            dist[k] -= m_box_dims[k];
+        else if (dist[k] < -0.5 * m_box_dims[k])
+            dist[k] += m_box_dims[k];
+    }
+    double min_dist = m_eps_min_dist * m_h;
+    if (dist.Length2() < min_dist * min_dist)
+        dist = ChVector<>(min_dist, 0, 0);
+    return dist;
+}
+
+int ChSystemFsiCpu::CellIndex(const ChVector<>& pos) const {
+    int c[3];
+    for (int k = 0; k < 3; k++) {
+        int n = m_grid.size[k];
+        c[k] = (int)std::floor((pos[k] - m_grid.origin[k]) / m_grid.cell_size[k]);
+        c[k] = ((c[k] % n) + n) % n;
+    }
+    return (c[2] * m_grid.size.y() + c[1]) * m_grid.size.x() + c[0];
+}
+
+void ChSystemFsiCpu::BuildGrid(const std::vector<ChVector<>>& pos) {
+    int num_markers = (int)pos.size();
+    size_t num_cells = m_grid.cell_start.size() - 1;
+
+    m_grid.marker_cell.resize(num_markers);
+    m_grid.sorted.resize(num_markers);
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_markers; i++)
+        m_grid.marker_cell[i] = CellIndex(pos[i]);
+
+    // Counting sort of markers by cell index
+    std::fill(m_grid.cell_start.begin(), m_grid.cell_start.end(), 0);
+    for (int i = 0; i < num_markers; i++)
+        m_grid.cell_start[m_grid.marker_cell[i] + 1]++;
+    for (size_t c = 0; c < num_cells; c++)
+        m_grid.cell_start[c + 1] += m_grid.cell_start[c];
+
+    std::vector<int> offset(m_grid.cell_start.begin(), m_grid.cell_start.end() - 1);
+    for (int i = 0; i < num_markers; i++)
+        m_grid.sorted[offset[m_grid.marker_cell[i]]++] = i;
+}
+
+template <typename Op>
+void ChSystemFsiCpu::ForEachNeighbor(const std::vector<ChVector<>>& pos, size_t i, Op op) const {
+    double support = RESOLUTION_LENGTH_MULT * m_h;
+    double support2 = support * support;
+
+    int c[3];
+    for (int k = 0; k < 3; k++)
+        c[k] = (int)std::floor((pos[i][k] - m_grid.origin[k]) / m_grid.cell_size[k]);
+
+    for (const auto& o : m_grid.nbr) {
+        int n[3];
+        for (int k = 0; k < 3; k++) {
+            int nk = m_grid.size[k];
+            n[k] = (((c[k] + o[k]) % nk) + nk) % nk;
+        }
+        int cell = (n[2] * m_grid.size.y() + n[1]) * m_grid.size.x() + n[0];
+        for (int s = m_grid.cell_start[cell]; s < m_grid.cell_start[cell + 1]; s++) {
+            int j = m_grid.sorted[s];
+            if (j == (int)i)
+                continue;
+            ChVector<> dist = Distance(pos[i], pos[j]);
+            double dd = dist.Length2();
+            if (dd > support2)
+                continue;
+            op(j, dist, std::sqrt(dd));
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+// Re-initialize the density of fluid markers with a Shepard filter
+void ChSystemFsiCpu::DensityReinitialization(const std::vector<ChVector<>>& pos,
+                                             std::vector<double>& rho,
+                                             std::vector<double>& pres) {
+    int num_fluid = (int)m_num_fluid;
+    std::vector<double> rho_new(num_fluid);
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_fluid; i++) {
+        double sum_mW = m_marker_mass * W3h(0);
+        double sum_mW_rho = 1e-7 + m_marker_mass * W3h(0) / rho[i];
+        ForEachNeighbor(pos, i, [&](int j, const ChVector<>& dist, double d) {
+            if (m_types[j] != FLUID)
+                return;
+            double mW = m_marker_mass * W3h(d);
+            sum_mW += mW;
+            sum_mW_rho += mW / rho[j];
+        });
+        rho_new[i] = sum_mW / sum_mW_rho;
+    }
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_fluid; i++) {
+        rho[i] = rho_new[i];
+        pres[i] = Eos(rho[i]);
+    }
+}
+
+// Set the velocity, density, and pressure used for each marker in the force calculation.
+// For BCE markers using the Adami boundary condition, these are extrapolated from the neighboring fluid markers.
+void ChSystemFsiCpu::ModifyBceVelocityPressure(const std::vector<ChVector<>>& pos,
+                                               const std::vector<ChVector<>>& vel,
+                                               const std::vector<double>& rho,
+                                               const std::vector<double>& pres) {
+    int num_markers = (int)pos.size();
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_markers; i++) {
+        int type = m_types[i];
+        bool adami = (type == BOUNDARY && m_bce_wall == BceVersion::ADAMI) ||
+                     (type > BOUNDARY && m_bce_body == BceVersion::ADAMI);
+        if (!adami) {
+            m_vel_mod[i] = vel[i];
+            m_rho_mod[i] = rho[i];
+            m_pres_mod[i] = pres[i];
+            continue;
+        }
+
+        ChVector<> sumVW = VNULL;
+        ChVector<> sumRhoRW = VNULL;
+        double sumPW = 0;
+        double sumWFluid = 0;
+        ForEachNeighbor(pos, i, [&](int j, const ChVector<>& dist, double d) {
+            if (m_types[j] != FLUID)
+                return;
+            double Wd = W3h(d);
+            sumVW += vel[j] * Wd;
+            sumRhoRW += (rho[j] * Wd) * dist;
+            sumPW += pres[j] * Wd;
+            sumWFluid += Wd;
+        });
+
+        if (std::abs(sumWFluid) > EPSILON) {
+            m_vel_mod[i] = 2.0 * vel[i] - sumVW / sumWFluid;
+            m_pres_mod[i] = (sumPW + ((m_gravity - m_acc_bce[i]) ^ sumRhoRW)) / sumWFluid;
+            m_rho_mod[i] = InvEos(m_pres_mod[i]);
+        } else {
+            m_vel_mod[i] = VNULL;
+            m_rho_mod[i] = m_rho0;
+            m_pres_mod[i] = 0;
+        }
+    }
+}
+
+// Calculate the marker accelerations and density rates, as well as the XSPH velocity correction
+void ChSystemFsiCpu::ForceSPH(const std::vector<ChVector<>>& pos,
+                              const std::vector<ChVector<>>& vel,
+                              std::vector<double>& rho,
+                              std::vector<double>& pres) {
+    BuildGrid(pos);
+    ModifyBceVelocityPressure(pos, vel, rho, pres);
+
+    // Re-initialize the density after several force evaluations
+    if (m_density_counter >= m_density_reinit) {
+        if (m_verbose)
+            cout << "Re-initializing density after " << m_density_reinit << " steps." << endl;
+        DensityReinitialization(pos, rho, pres);
+        for (size_t i = 0; i < m_num_fluid; i++) {
+            m_rho_mod[i] = rho[i];
+            m_pres_mod[i] = pres[i];
+        }
+        m_density_counter = 0;
+    }
+    m_density_counter++;
+
+    int num_markers = (int)pos.size();
+    double m = m_marker_mass;
+    double eps_h2 = m_eps_min_dist * m_h * m_h;
+    double nu0 = m_mu0 / m_rho0;
+    ChVector<> fluid_acc = m_gravity + m_body_force;
+    bool error = false;
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_markers; i++) {
+        int typeA = m_types[i];
+
+        // Do nothing for fixed wall BCE markers
+        if (typeA == BOUNDARY) {
+            m_derivVel[i] = VNULL;
+            m_derivRho[i] = 0;
+            m_vel_xsph[i] = VNULL;
+            continue;
+        }
+
+        const ChVector<>& velA = m_vel_mod[i];
+        double rhoA = m_rho_mod[i];
+        double presA = m_pres_mod[i];
+
+        ChVector<> derivV = VNULL;
+        double derivRho = 0;
+        ChVector<> deltaV = VNULL;
+
+        ChVector<> preGra = VNULL;
+        ChVector<> velGra[3] = {VNULL, VNULL, VNULL};
+        ChVector<> velLap = VNULL;
+        ChVector<> lapGra = VNULL;
+        double sum_w_i = W3h(0) * m_volume0;
+
+        ForEachNeighbor(pos, i, [&](int j, const ChVector<>& dist, double d) {
+            int typeB = m_types[j];
+
+            // No rigid-rigid force
+            if (typeA != FLUID && typeB != FLUID)
+                return;
+
+            const ChVector<>& velB = m_vel_mod[j];
+            double rhoB = m_rho_mod[j];
+            double presB = m_pres_mod[j];
+            ChVector<> gradW = GradW3h(dist);
+            ChVector<> velAB = velA - velB;
+            double d2_eps = d * d + eps_h2;
+
+            // Continuity equation
+            derivRho += m * (velAB ^ gradW);
+
+            // Momentum equation (pressure and viscous terms)
+            derivV += (-m * (presA / (rhoA * rhoA) + presB / (rhoB * rhoB))) * gradW +
+                      (m * 8.0 * m_mu0 * (dist ^ gradW) / d2_eps / ((rhoA + rhoB) * (rhoA + rhoB))) * velAB;
+
+            // Artificial viscosity
+            double vAB_Dot_rAB = velAB ^ dist;
+            if (vAB_Dot_rAB < 0) {
+                double nu = -m_ar_vis_alpha * m_h * m_Cs / (0.5 * (rhoA * rhoB));
+                derivV += (-m * nu * vAB_Dot_rAB / d2_eps) * gradW;
+            }
+
+            // Gradient and Laplacian operators
+            double Vol = m / rhoB;
+            preGra += ((presB + presA) * Vol) * gradW;
+            for (int k = 0; k < 3; k++)
+                velGra[k] += ((velB[k] - velA[k]) * Vol) * gradW;
+            ChVector<> eij = dist / d;
+            double eij_Dot_GradW = eij ^ gradW;
+            velLap += (2.0 * eij_Dot_GradW * Vol / d) * velAB;
+            lapGra += (-2.0 * eij_Dot_GradW * Vol) * eij;
+
+            if (d > m_h * 1.0e-9)
+                sum_w_i += W3h(d) * m_volume0;
+
+            // XSPH velocity correction
+            if (typeA == FLUID && typeB == FLUID)
+                deltaV += (m * W3h(d) / (0.5 * (rhoA + rhoB))) * (vel[j] - vel[i]);
+        });
+
+        if (typeA == FLUID) {
+            if (sum_w_i > 0.9) {
+                ChVector<> dvdt;
+                for (int k = 0; k < 3; k++)
+                    dvdt[k] = -preGra[k] / rhoA + (velLap[k] + (velGra[k] ^ lapGra)) * nu0;
+                derivV = dvdt;
+                derivRho = -m_rho0 * (velGra[0].x() + velGra[1].y() + velGra[2].z());
+            }
+
+            // Add gravity and other body force to fluid markers
+            derivV += fluid_acc;
+        }
+
+        if (!(std::isfinite(derivV.x()) && std::isfinite(derivV.y()) && std::isfinite(derivV.z()) &&
+              std::isfinite(derivRho)))
+            error = true;
+
+        m_derivVel[i] = derivV;
+        m_derivRho[i] = derivRho;
+        m_vel_xsph[i] = m_eps_xsph * deltaV;
+    }
+
+    if (error)
+        throw std::runtime_error("Error! particle derivVel is NAN: thrown from ChSystemFsiCpu::ForceSPH!");
+}
+
+// Advance the fluid markers using the current accelerations, density rates, and XSPH corrections
+void ChSystemFsiCpu::UpdateFluid(std::vector<ChVector<>>& pos,
+                                 std::vector<ChVector<>>& vel,
+                                 std::vector<double>& rho,
+                                 std::vector<double>& pres,
+                                 double dT) {
+    int num_fluid = (int)m_num_fluid;
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_fluid; i++) {
+        pos[i] += (vel[i] + m_vel_xsph[i]) * dT;
+        vel[i] += m_derivVel[i] * dT;
+        rho[i] += m_derivRho[i] * dT;
+        pres[i] = Eos(rho[i]);
+    }
+}
+
+// Apply periodic boundary conditions in x, y, and z directions
+void ChSystemFsiCpu::ApplyPeriodicBoundary(std::vector<ChVector<>>& pos) {
+    int num_fluid = (int)m_num_fluid;
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_fluid; i++) {
+        for (int k = 0; k < 3; k++) {
+            if (pos[i][k] > m_cMax[k])
+                pos[i][k] -= m_box_dims[k];
+            else if (pos[i][k] < m_cMin[k])
+                pos[i][k] += m_box_dims[k];
+        }
+    }
+}
+
+void ChSystemFsiCpu::IntegrateSPH(std::vector<ChVector<>>& pos_f,
+                                  std::vector<ChVector<>>& vel_f,
+                                  std::vector<double>& rho_f,
+                                  std::vector<double>& pres_f,
+                                  std::vector<ChVector<>>& pos_u,
+                                  std::vector<ChVector<>>& vel_u,
+                                  std::vector<double>& rho_u,
+                                  std::vector<double>& pres_u,
+                                  double dT) {
+    ForceSPH(pos_f, vel_f, rho_f, pres_f);
+    UpdateFluid(pos_u, vel_u, rho_u, pres_u, dT);
+    ApplyPeriodicBoundary(pos_u);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+// Accumulate the fluid forces on the solid BCE markers into forces and torques on the FSI bodies and nodes
+void ChSystemFsiCpu::CalculateFsiForces() {
+    std::fill(m_body_forces.begin(), m_body_forces.end(), VNULL);
+    std::fill(m_body_torques.begin(), m_body_torques.end(), VNULL);
+    std::fill(m_node_forces.begin(), m_node_forces.end(), VNULL);
+
+    size_t start_rigid = m_num_fluid + m_num_boundary;
+    for (size_t k = 0; k < m_num_rigid; k++) {
+        size_t i = start_rigid + k;
+        int ib = m_marker_owner[k];
+        ChVector<> force = (m_derivVel[i] * m_beta + m_derivVel_old[i] * (1 - m_beta)) * m_marker_mass;
+        m_body_forces[ib] += force;
+        m_body_torques[ib] += (m_pos[i] - m_fsi_bodies[ib]->GetPos()) % force;
+    }
+
+    size_t start_flex = start_rigid + m_num_rigid;
+    for (size_t k = 0; k < m_num_flex; k++) {
+        size_t i = start_flex + k;
+        int in = m_marker_owner[m_num_rigid + k];
+        ChVector<> force = (m_derivVel[i] * m_beta + m_derivVel_old[i] * (1 - m_beta)) * m_marker_mass;
+        m_node_forces[in] += force;
+    }
+}
+
+// Update positions, velocities, and accelerations of the solid BCE markers from the states of bodies and nodes
+void ChSystemFsiCpu::UpdateBceMarkers() {
+    int start_rigid = (int)(m_num_fluid + m_num_boundary);
+    int num_solid = (int)(m_num_rigid + m_num_flex);
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int k = 0; k < num_solid; k++) {
+        int i = start_rigid + k;
+        if (k < (int)m_num_rigid) {
+            const auto& frame = m_fsi_bodies[m_marker_owner[k]]->GetFrame_REF_to_abs();
+            m_pos[i] = frame.TransformPointLocalToParent(m_marker_local[k]);
+            m_vel[i] = frame.PointSpeedLocalToParent(m_marker_local[k]);
+            m_acc_bce[i] = frame.PointAccelerationLocalToParent(m_marker_local[k]);
+        } else {
+            const auto& node = m_fsi_nodes[m_marker_owner[k]];
+            m_pos[i] = node->GetPos() + m_marker_local[k];
+            m_vel[i] = node->GetPos_dt();
+            m_acc_bce[i] = node->GetPos_dtdt();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::DoStepDynamics_FSI() {
+    if (!m_is_initialized) {
+        cout << "ERROR: FSI system not initialized!\n" << endl;
+        throw std::runtime_error("FSI system not initialized!\n");
+    }
+
+    m_timer_step.reset();
+    m_timer_step.start();
+
+    // Midpoint integration of the fluid phase: the half-step state is evaluated with the forces at the beginning
+    // of the step, and the full-step state is then advanced with the forces at the half step.
+    m_pos1 = m_pos;
+    m_vel1 = m_vel;
+    m_rho1 = m_rho;
+    m_pres1 = m_pres;
+    m_derivVel_old = m_derivVel;
+
+    IntegrateSPH(m_pos, m_vel, m_rho, m_pres, m_pos1, m_vel1, m_rho1, m_pres1, 0.5 * m_dT);
+    IntegrateSPH(m_pos1, m_vel1, m_rho1, m_pres1, m_pos, m_vel, m_rho, m_pres, 1.0 * m_dT);
+
+    CalculateFsiForces();
+
+    m_timer_step.stop();
+    m_timer_total += m_timer_step();
+    m_num_steps++;
+
+    // Advance dynamics of the associated MBS system (if provided)
+    if (m_sysMBS) {
+        for (size_t ib = 0; ib < m_fsi_bodies.size(); ib++) {
+            // Note: when this FSI body goes back to Chrono system, the gravity will be automatically added.
+            // Here only accumulate force from fluid.
+            auto& body = m_fsi_bodies[ib];
+            body->Empty_forces_accumulators();
+            body->Accumulate_force(m_body_forces[ib], body->GetPos(), false);
+            body->Accumulate_torque(m_body_torques[ib], false);
+        }
+        for (size_t in = 0; in < m_fsi_nodes.size(); in++)
+            m_fsi_nodes[in]->SetForce(m_node_forces[in]);
+
+        double dT_Flex = (m_dT_Flex == 0) ? m_dT : m_dT_Flex;
+        int sync = std::max(1, int(m_dT / dT_Flex));
+        for (int t = 0; t < sync; t++) {
+            m_sysMBS->DoStepDynamics(m_dT / sync);
+        }
+    }
+
+    UpdateBceMarkers();
+
+    m_time += m_dT;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChSystemFsiCpu::WriteMarkers(const std::string& filename, size_t start, size_t end) const {
+    double eps = 1e-20;
+
+    std::ofstream file(filename);
+    std::stringstream ss;
+    ss << "x,y,z,v_x,v_y,v_z,|U|,acc,rho,pressure\n";
+    for (size_t i = start; i < end; i++) {
+        const ChVector<>& pos = m_pos[i];
+        const ChVector<>& vel = m_vel[i];
+        ss << pos.x() << ", " << pos.y() << ", " << pos.z() << ", " << vel.x() + eps << ", " << vel.y() + eps << ", "
+           << vel.z() + eps << ", " << vel.Length() + eps << ", " << m_derivVel[i].Length() << ", " << m_rho[i] << ", "
+           << m_pres[i] + eps << std::endl;
+    }
+    file << ss.str();
+    file.close();
+}
+
+void ChSystemFsiCpu::PrintParticleToFile(const std::string& dir) const {
+    // Current frame number
+    m_out_frame++;
+    std::string frame = std::to_string(m_out_frame);
+
+    size_t start_boundary = m_num_fluid;
+    size_t start_rigid = start_boundary + m_num_boundary;
+    size_t start_flex = start_rigid + m_num_rigid;
+
+    // Save fluid SPH particles to files
+    WriteMarkers(dir + "/fluid" + frame + ".csv", 0, m_num_fluid);
+
+    // Save boundary BCE particles to files (these do not move)
+    if (m_out_frame == 0)
+        WriteMarkers(dir + "/boundary" + frame + ".csv", start_boundary, start_rigid);
+
+    // Save rigid and flexible BCE particles to files
+    if (m_num_rigid > 0)
+        WriteMarkers(dir + "/BCE_Rigid" + frame + ".csv", start_rigid, start_flex);
+    if (m_num_flex > 0)
+        WriteMarkers(dir + "/BCE_Flex" + frame + ".csv", start_flex, start_flex + m_num_flex);
+}
+
+}  // end namespace fsi
+}  // end namespace chrono
@@ -0,0 +1,413 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Radu Serban
+// =============================================================================
+//
+// Multithreaded CPU implementation of the explicit WCSPH fluid-solid
+// interaction solver.
+//
+// =============================================================================
+
+#ifndef CH_SYSTEM_FSI_CPU_H
+#define CH_SYSTEM_FSI_CPU_H
+
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_fsi/ChApiFsi.h"
+#include "chrono_fsi/ChDefinitionsFsi.h"
+
+namespace chrono {
+
+// Forward declarations
+namespace fea {
+class ChNodeFEAxyz;
+class ChMesh;
+}  // namespace fea
+
+namespace fsi {
+
+/// @addtogroup fsi_physics
+/// @{
+
+/// @brief CPU physical system for fluid-solid interaction problems.
+///
+/// This class provides a multithreaded (OpenMP) implementation of the explicit weakly-compressible SPH (WCSPH)
+/// formulation used by ChSystemFsi and is available whether or not the FSI module was built with CUDA support. It
+/// uses the same cubic spline kernel, equation of state, Adami boundary conditions, XSPH correction, and midpoint
+/// time integration scheme as the GPU explicit solver, and reads the same JSON parameter files. Neighbor search uses
+/// a cell list rebuilt with a counting sort at each force evaluation. BCE markers can be attached to rigid bodies
+/// (with the resulting fluid forces and torques applied to the ChBody) and to FEA nodes (with the resulting fluid
+/// forces applied as nodal forces).
+class CH_FSI_API ChSystemFsiCpu {
+  public:
+    /// Constructor for the CPU FSI system.
+    ChSystemFsiCpu(ChSystem* sysMBS = nullptr);
+
+    /// Destructor for the CPU FSI system.
+    ~ChSystemFsiCpu();
+
+    /// Function to integrate the FSI system in time.
+    /// The fluid state is advanced with a 2nd order midpoint scheme; the fluid forces on the FSI bodies and FEA nodes
+    /// are then applied to the associated MBS system (if provided), which is advanced over the same step.
+    void DoStepDynamics_FSI();
+
+    /// Enable/disable verbose terminal output.
+    void SetVerbose(bool verbose) { m_verbose = verbose; }
+
+    /// Set the number of OpenMP threads used by the SPH kernels (default: number of available processors).
+    void SetNumThreads(int num_threads);
+
+    /// Read Chrono::FSI parameters from the specified JSON file.
+    /// Only the parameters relevant to the explicit WCSPH formulation are used.
+    void ReadParametersFromFile(const std::string& json_file);
+
+    /// Set initial spacing.
+    void SetInitialSpacing(double spacing);
+
+    /// Set SPH kernel length.
+    void SetKernelLength(double length);
+
+    /// Set the fluid container dimension (used to set default computational domain limits).
+    void SetContainerDim(const ChVector<>& boxDim) { m_box_dim = boxDim; }
+
+    /// Set periodic boundary condition for fluid.
+    void SetBoundaries(const ChVector<>& cMin, const ChVector<>& cMax);
+
+    /// Set fluid density.
+    void SetDensity(double rho0);
+
+    /// Set fluid dynamic viscosity.
+    void SetViscosity(double mu0) { m_mu0 = mu0; }
+
+    /// Set the maximum expected fluid velocity (used to set the artificial speed of sound).
+    void SetMaxVelocity(double v_max);
+
+    /// Set gravity for the FSI syatem.
+    void Set_G_acc(const ChVector<>& gravity) { m_gravity = gravity; }
+
+    /// Set a constant force applied to the fluid.
+    void SetBodyForce(const ChVector<>& force) { m_body_force = force; }
+
+    /// Set FSI integration step size.
+    void SetStepSize(double dT, double dT_Flex = 0);
+
+    /// Set the number of steps between density re-initializations (Shepard filter).
+    void SetDensityReinitSteps(int steps) { m_density_reinit = steps; }
+
+    /// Set the BCE approach for fixed walls.
+    void SetWallBC(BceVersion wallBC) { m_bce_wall = wallBC; }
+
+    /// Set the BCE approach for rigid bodies and FEA nodes.
+    void SetRigidBodyBC(BceVersion rigidBodyBC) { m_bce_body = rigidBodyBC; }
+
+    /// Return the SPH kernel length of kernel function.
+    double GetKernelLength() const { return m_h; }
+
+    /// Return the initial spacing of the SPH particles.
+    double GetInitialSpacing() const { return m_spacing; }
+
+    /// Return density.
+    double GetDensity() const { return m_rho0; }
+
+    /// Return viscosity.
+    double GetViscosity() const { return m_mu0; }
+
+    /// Return SPH particle mass.
+    double GetParticleMass() const { return m_marker_mass; }
+
+    /// Return gravitational acceleration.
+    ChVector<> Get_G_acc() const { return m_gravity; }
+
+    /// Return the speed of sound in the fluid phase.
+    double GetSoundSpeed() const { return m_Cs; }
+
+    /// Return the constant force applied to the fluid (if any).
+    ChVector<> GetBodyForce() const { return m_body_force; }
+
+    /// Return the FSI integration step size.
+    double GetStepSize() const { return m_dT; }
+
+    /// Return the current simulation time.
+    double GetSimTime() const { return m_time; }
+
+    /// Return the number of fluid markers.
+    size_t GetNumFluidMarkers() const { return m_num_fluid; }
+
+    /// Return the number of boundary markers.
+    size_t GetNumBoundaryMarkers() const { return m_num_boundary; }
+
+    /// Return the number of rigid body markers.
+    size_t GetNumRigidBodyMarkers() const { return m_num_rigid; }
+
+    /// Return the number of flexible body markers.
+    size_t GetNumFlexBodyMarkers() const { return m_num_flex; }
+
+    /// Return the SPH particle positions.
+    const std::vector<ChVector<>>& GetParticlePositions() const { return m_pos; }
+
+    /// Return the SPH particle velocities.
+    const std::vector<ChVector<>>& GetParticleVelocities() const { return m_vel; }
+
+    /// Return the SPH particle accelerations.
+    const std::vector<ChVector<>>& GetParticleAccelerations() const { return m_derivVel; }
+
+    /// Return the SPH particle fluid properties.
+    /// For each SPH particle, the 3-dimensional vector contains density, pressure, and viscosity.
+    std::vector<ChVector<>> GetParticleFluidProperties() const;
+
+    /// Return the FSI bodies.
+    const std::vector<std::shared_ptr<ChBody>>& GetFsiBodies() const { return m_fsi_bodies; }
+
+    /// Return the FEA nodes with attached BCE markers.
+    const std::vector<std::shared_ptr<fea::ChNodeFEAxyz>>& GetFsiNodes() const { return m_fsi_nodes; }
+
+    /// Return the fluid force on the i-th FSI body (as applied at the last step).
+    const ChVector<>& GetFsiBodyForce(size_t i) const { return m_body_forces[i]; }
+
+    /// Return the fluid torque on the i-th FSI body (as applied at the last step).
+    const ChVector<>& GetFsiBodyTorque(size_t i) const { return m_body_torques[i]; }
+
+    /// Add a rigid body to the FSI system.
+    /// Solid BCE markers attached to this body are used to calculate the fluid force and torque on the body.
+    void AddFsiBody(std::shared_ptr<ChBody> body);
+
+    /// Add an FEA mesh to the FSI system.
+    /// One BCE marker is attached to each ChNodeFEAxyz node of the mesh; fluid forces are applied as nodal forces.
+    void AddFsiMesh(std::shared_ptr<fea::ChMesh> mesh);
+
+    /// Complete construction of the FSI system (fluid and BCE markers).
+    void Initialize();
+
+    /// Save the SPH particle information into files.
+    /// This function creates two CSV files into the specified directory with fluid and BCE marker information.
+    void PrintParticleToFile(const std::string& dir) const;
+
+    /// Add an SPH particle with given properties to the FSI system.
+    void AddSPHParticle(const ChVector<>& point,
+                        double rho0,
+                        double pres0,
+                        double mu0,
+                        const ChVector<>& velocity = ChVector<>(0));
+
+    /// Add an SPH particle with current properties to the SPH system.
+    void AddSPHParticle(const ChVector<>& point, const ChVector<>& velocity = ChVector<>(0));
+
+    /// Create SPH particles in the specified box volume.
+    /// The SPH particles are created on a uniform grid with resolution equal to the FSI initial separation.
+    void AddBoxSPH(const ChVector<>& boxCenter, const ChVector<>& boxHalfDim);
+
+    /// Add BCE markers for a rectangular plate of specified X-Y dimensions and associate them with the given body.
+    /// BCE markers are created in a number of layers corresponding to system parameters.
+    void AddWallBCE(std::shared_ptr<ChBody> body, const ChFrame<>& frame, const ChVector2<> size);
+
+    /// Add BCE markers for a box container of specified dimensions and associate them with the given body.
+    /// The center of the box volume is at the origin of the given frame and the the container is aligned with the
+    /// frame axes. Such a container is assumed to be fixed to the ground (see ChSystemFsi::AddContainerBCE).
+    void AddContainerBCE(std::shared_ptr<ChBody> body,
+                         const ChFrame<>& frame,
+                         const ChVector<>& size,
+                         const ChVector<int> faces);
+
+    /// Add BCE markers for a box of specified dimensions and associate them with the given body.
+    /// If solid = true, the markers are interior to the box and the body must be an FSI body.
+    void AddBoxBCE(std::shared_ptr<ChBody> body, const ChFrame<>& frame, const ChVector<>& size, bool solid);
+
+    /// Add BCE markers for a sphere of specified radius and associate them with the given body.
+    /// If solid = true, the markers are interior to the sphere and the body must be an FSI body.
+    void AddSphereBCE(std::shared_ptr<ChBody> body, const ChFrame<>& frame, double radius, bool solid);
+
+    /// Add BCE markers at the specified points (expressed in the given frame) and associate them with the given body.
+    void AddPointsBCE(std::shared_ptr<ChBody> body,
+                      const std::vector<ChVector<>>& points,
+                      const ChFrame<>& frame,
+                      bool solid);
+
+    /// Add BCE markers at the specified offsets from the given FEA node.
+    /// The markers translate with the node and the fluid force on them is applied to the node.
+    void AddNodeBCE(std::shared_ptr<fea::ChNodeFEAxyz> node, const std::vector<ChVector<>>& offsets);
+
+    /// Return the wall-clock time (in seconds) spent in the SPH solver during the last step.
+    double GetTimerStep() const { return m_timer_step(); }
+
+    /// Return the cumulative wall-clock time (in seconds) spent in the SPH solver.
+    double GetTimerTotal() const { return m_timer_total; }
+
+    /// Return the SPH solver throughput, in fluid particle updates per second.
+    /// This is the number of fluid particles times the number of steps, divided by the cumulative SPH solver time.
+    double GetParticleUpdatesPerSecond() const;
+
+  private:
+    /// Marker types (stored in the same convention as the GPU solver).
+    enum MarkerType { FLUID = -1, BOUNDARY = 0, RIGID = 1, FLEX = 2 };
+
+    /// BCE markers added before initialization.
+    struct BceMarker {
+        ChVector<> pos;                            ///< marker position (body/node frame)
+        int type;                                  ///< marker type
+        std::shared_ptr<ChBody> body;              ///< associated body (if any)
+        std::shared_ptr<fea::ChNodeFEAxyz> node;  ///< associated FEA node (if any)
+    };
+
+    /// Cell list used for neighbor search.
+    struct NeighborGrid {
+        ChVector<> origin;              ///< grid origin (lower limits of the computational domain)
+        ChVector<> cell_size;           ///< cell dimensions (at least the kernel support radius)
+        ChVector<int> size;             ///< number of cells in each direction
+        std::vector<int> cell_start;    ///< start index of each cell in the sorted index array
+        std::vector<int> marker_cell;   ///< cell index of each marker
+        std::vector<int> sorted;        ///< marker indices, sorted by cell
+        std::vector<ChVector<int>> nbr;  ///< distinct neighbor cell offsets (accounting for periodicity)
+    };
+
+    void CreateBCE_wall(const ChVector2<>& size, std::vector<ChVector<>>& bce) const;
+    void CreateBCE_box(const ChVector<>& size, bool solid, std::vector<ChVector<>>& bce) const;
+    void CreateBCE_sphere(double rad, bool solid, std::vector<ChVector<>>& bce) const;
+    void AddBCE(std::shared_ptr<ChBody> body, const std::vector<ChVector<>>& bce, const ChFrame<>& rel_frame, bool solid);
+    void WriteMarkers(const std::string& filename, size_t start, size_t end) const;
+
+    void UpdateDependentParams();
+    int CellIndex(const ChVector<>& pos) const;
+    ChVector<> Distance(const ChVector<>& a, const ChVector<>& b) const;
+    double W3h(double d) const;
+    ChVector<> GradW3h(const ChVector<>& d) const;
+    double Eos(double rho) const { return m_Cs * m_Cs * (rho - m_rho0); }
+    double InvEos(double p) const { return p / (m_Cs * m_Cs) + m_rho0; }
+
+    void BuildGrid(const std::vector<ChVector<>>& pos);
+    template <typename Op>
+    void ForEachNeighbor(const std::vector<ChVector<>>& pos, size_t i, Op op) const;
+
+    void DensityReinitialization(const std::vector<ChVector<>>& pos, std::vector<double>& rho, std::vector<double>& pres);
+    void ModifyBceVelocityPressure(const std::vector<ChVector<>>& pos,
+                                   const std::vector<ChVector<>>& vel,
+                                   const std::vector<double>& rho,
+                                   const std::vector<double>& pres);
+    void ForceSPH(const std::vector<ChVector<>>& pos,
+                  const std::vector<ChVector<>>& vel,
+                  std::vector<double>& rho,
+                  std::vector<double>& pres);
+    void UpdateFluid(std::vector<ChVector<>>& pos,
+                     std::vector<ChVector<>>& vel,
+                     std::vector<double>& rho,
+                     std::vector<double>& pres,
+                     double dT);
+    void ApplyPeriodicBoundary(std::vector<ChVector<>>& pos);
+    void IntegrateSPH(std::vector<ChVector<>>& pos_f,
+                      std::vector<ChVector<>>& vel_f,
+                      std::vector<double>& rho_f,
+                      std::vector<double>& pres_f,
+                      std::vector<ChVector<>>& pos_u,
+                      std::vector<ChVector<>>& vel_u,
+                      std::vector<double>& rho_u,
+                      std::vector<double>& pres_u,
+                      double dT);
+    void CalculateFsiForces();
+    void UpdateBceMarkers();
+
+    ChSystem* m_sysMBS;  ///< multibody system
+    bool m_verbose;      ///< enable/disable verbose terminal output (default: true)
+    int m_num_threads;   ///< number of OpenMP threads
+    bool m_is_initialized;
+
+    // Fluid properties
+    double m_rho0;            ///< reference fluid density
+    double m_mu0;             ///< fluid dynamic viscosity
+    ChVector<> m_gravity;     ///< gravitational acceleration
+    ChVector<> m_body_force;  ///< constant body force (per unit mass) applied to fluid
+
+    // SPH parameters
+    double m_h;                 ///< kernel length
+    double m_invh;              ///< inverse of kernel length
+    double m_spacing;           ///< initial marker spacing
+    double m_volume0;           ///< initial marker volume
+    double m_marker_mass;       ///< marker mass
+    double m_v_max;             ///< maximum expected velocity
+    double m_Cs;                ///< artificial speed of sound
+    double m_eps_xsph;          ///< XSPH coefficient
+    double m_eps_min_dist;      ///< minimum marker distance (relative to kernel length)
+    double m_ar_vis_alpha;      ///< artificial viscosity coefficient
+    int m_density_reinit;       ///< number of force evaluations between density re-initializations
+    int m_num_bce_layers;       ///< number of BCE marker layers
+    BceVersion m_bce_wall;      ///< BCE approach for fixed walls
+    BceVersion m_bce_body;      ///< BCE approach for rigid bodies and FEA nodes
+
+    // Time stepping
+    double m_dT;       ///< fluid step size
+    double m_dT_Flex;  ///< MBS step size
+    double m_beta;     ///< weighting of current/previous step marker forces for the solid phase
+    double m_time;     ///< current simulation time
+
+    // Computational domain
+    ChVector<> m_box_dim;     ///< container dimensions (used for default domain limits)
+    bool m_use_default_limits;
+    ChVector<> m_cMin;        ///< lower limits of the computational domain
+    ChVector<> m_cMax;        ///< upper limits of the computational domain
+    ChVector<> m_box_dims;    ///< domain dimensions (for periodic wrapping)
+
+    // Markers are stored in the order: fluid, boundary, rigid, flex
+    size_t m_num_fluid;
+    size_t m_num_boundary;
+    size_t m_num_rigid;
+    size_t m_num_flex;
+    std::vector<BceMarker> m_bce_markers;  ///< BCE markers added before initialization
+    std::vector<int> m_types;              ///< marker types
+
+    std::vector<ChVector<>> m_pos;  ///< marker positions (full step)
+    std::vector<ChVector<>> m_vel;  ///< marker velocities (full step)
+    std::vector<double> m_rho;      ///< marker densities (full step)
+    std::vector<double> m_pres;     ///< marker pressures (full step)
+    std::vector<double> m_mu;       ///< marker viscosities
+
+    std::vector<ChVector<>> m_pos1;  ///< marker positions (half step)
+    std::vector<ChVector<>> m_vel1;  ///< marker velocities (half step)
+    std::vector<double> m_rho1;      ///< marker densities (half step)
+    std::vector<double> m_pres1;     ///< marker pressures (half step)
+
+    std::vector<ChVector<>> m_derivVel;      ///< marker accelerations
+    std::vector<ChVector<>> m_derivVel_old;  ///< marker accelerations at previous step
+    std::vector<double> m_derivRho;          ///< marker density rates
+    std::vector<ChVector<>> m_vel_xsph;      ///< XSPH velocity correction
+
+    std::vector<ChVector<>> m_vel_mod;  ///< marker velocities used in force calculation (modified for BCE)
+    std::vector<double> m_rho_mod;      ///< marker densities used in force calculation (modified for BCE)
+    std::vector<double> m_pres_mod;     ///< marker pressures used in force calculation (modified for BCE)
+    std::vector<ChVector<>> m_acc_bce;  ///< accelerations of BCE markers
+
+    int m_density_counter;  ///< number of force evaluations since last density re-initialization
+    NeighborGrid m_grid;    ///< neighbor search grid
+
+    // Solid phase
+    std::vector<std::shared_ptr<ChBody>> m_fsi_bodies;             ///< FSI rigid bodies
+    std::vector<std::shared_ptr<fea::ChMesh>> m_fsi_meshes;        ///< FSI FEA meshes
+    std::vector<std::shared_ptr<fea::ChNodeFEAxyz>> m_fsi_nodes;  ///< FEA nodes with attached BCE markers
+    std::vector<int> m_marker_owner;                               ///< body or node index of each solid BCE marker
+    std::vector<ChVector<>> m_marker_local;                        ///< local position of each solid BCE marker
+    std::vector<ChVector<>> m_body_forces;                         ///< fluid forces on FSI bodies
+    std::vector<ChVector<>> m_body_torques;                        ///< fluid torques on FSI bodies
+    std::vector<ChVector<>> m_node_forces;                         ///< fluid forces on FSI nodes
+
+    ChTimer<double> m_timer_step;  ///< timer for the SPH solver at current step
+    double m_timer_total;          ///< cumulative SPH solver time
+    size_t m_num_steps;            ///< number of steps taken
+    mutable int m_out_frame;       ///< current output frame number
+};
+
+/// @} fsi_physics
+
+}  // end namespace fsi
+}  // end namespace chrono
+
+#endif
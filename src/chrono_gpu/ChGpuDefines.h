@@ -15,11 +15,18 @@
 #pragma once
 
 #include <climits>
-#include <cuda_runtime.h>
 #include <cstdio>
 #include <cstdlib>
 #include <functional>
 
+#include "chrono_gpu/ChConfigGpu.h"
+
+#ifdef CHRONO_GPU_USE_CUDA
+    #include <cuda_runtime.h>
+#else
+    #include "chrono_gpu/ChGpuHostTypes.h"
+#endif
+
 namespace chrono {
 namespace gpu {
 
@@ -102,6 +109,7 @@ constexpr int warp_size = 32;
 /// href="https://stackoverflow.com/questions/14038589/what-is-the-canonical-way-to-check-for-errors-using-the-cuda-runtime-api">elsewhere</a>.
 ///  Some nice suggestions for how to use the mechanism are provided at the above link.
 ///
+#ifdef CHRONO_GPU_USE_CUDA
 #define gpuErrchk(ans) \
     { gpuAssert((ans), __FILE__, __LINE__); }
 inline void gpuAssert(cudaError_t code, const char* file, int line, bool abort = true) {
@@ -111,6 +119,7 @@ inline void gpuAssert(cudaError_t code, const char* file, int line, bool abort =
             exit(code);
     }
 }
+#endif
 
 // Add verbose checks easily
 #define INFO_PRINTF(...)                                                               \
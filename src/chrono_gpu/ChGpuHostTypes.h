@@ -0,0 +1,52 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Host-only replacements for the CUDA vector types used in the public
+// Chrono::Gpu headers. Only included when the module is built without CUDA.
+//
+// =============================================================================
+
+#pragma once
+
+struct int3 {
+    int x, y, z;
+};
+
+struct longlong3 {
+    long long int x, y, z;
+};
+
+struct float3 {
+    float x, y, z;
+};
+
+struct double3 {
+    double x, y, z;
+};
+
+inline int3 make_int3(int x, int y, int z) {
+    return int3{x, y, z};
+}
+
+inline longlong3 make_longlong3(long long int x, long long int y, long long int z) {
+    return longlong3{x, y, z};
+}
+
+inline float3 make_float3(float x, float y, float z) {
+    return float3{x, y, z};
+}
+
+inline double3 make_double3(double x, double y, double z) {
+    return double3{x, y, z};
+}
@@ -0,0 +1,1630 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Multithreaded CPU implementation of the Chrono::Gpu monodisperse-sphere SMC
+// engine.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/utils/ChOpenMP.h"
+
+#include "chrono_gpu/physics/ChSystemGpuCpu.h"
+#include "chrono_gpu/utils/ChGpuUtilities.h"
+
+namespace chrono {
+namespace gpu {
+
+// Smallest coefficient of restitution used when evaluating the material-based damping
+static const double COR_EPSILON = 1e-8;
+
+// Rolling resistance is not applied below this relative rotational velocity (user units)
+static const double ROLLING_VROT_THRESHOLD = 1e-4;
+
+// Maximum ratio of neighbour search cells to spheres
+static const double MAX_CELLS_PER_SPHERE = 4;
+
+// Damping factor corresponding to a given coefficient of restitution
+static double DampingFactor(double cor) {
+    double loge = (cor < COR_EPSILON) ? std::log(COR_EPSILON) : std::log(cor);
+    return loge / std::sqrt(loge * loge + CH_C_PI * CH_C_PI);
+}
+
+// Closest point on triangle ABC to point P (Ericson, Real-Time Collision Detection).
+// Returns true if the closest point is on an edge or vertex and false if it is in the interior of the face.
+static bool SnapToFace(const ChVector<>& A,
+                       const ChVector<>& B,
+                       const ChVector<>& C,
+                       const ChVector<>& P,
+                       ChVector<>& res) {
+    ChVector<> AB = B - A;
+    ChVector<> AC = C - A;
+
+    // Vertex region outside A
+    ChVector<> AP = P - A;
+    double d1 = Vdot(AB, AP);
+    double d2 = Vdot(AC, AP);
+    if (d1 <= 0 && d2 <= 0) {
+        res = A;
+        return true;
+    }
+
+    // Vertex region outside B
+    ChVector<> BP = P - B;
+    double d3 = Vdot(AB, BP);
+    double d4 = Vdot(AC, BP);
+    if (d3 >= 0 && d4 <= d3) {
+        res = B;
+        return true;
+    }
+
+    // Edge region of AB
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        res = A + (d1 / (d1 - d3)) * AB;
+        return true;
+    }
+
+    // Vertex region outside C
+    ChVector<> CP = P - C;
+    double d5 = Vdot(AB, CP);
+    double d6 = Vdot(AC, CP);
+    if (d6 >= 0 && d5 <= d6) {
+        res = C;
+        return true;
+    }
+
+    // Edge region of AC
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        res = A + (d2 / (d2 - d6)) * AC;
+        return true;
+    }
+
+    // Edge region of BC
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        res = B + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (C - B);
+        return true;
+    }
+
+    // Inside face region
+    double denom = 1 / (va + vb + vc);
+    res = A + (vb * denom) * AB + (vc * denom) * AC;
+    return false;
+}
+
+// Triangle-sphere narrow phase, as in the CUDA implementation.
+// On contact, returns the contact normal (from triangle to sphere), the (negative) depth and the point on the triangle.
+static bool FaceSphereCD(const ChVector<>& A,
+                         const ChVector<>& B,
+                         const ChVector<>& C,
+                         const ChVector<>& sphere_pos,
+                         double radius,
+                         ChVector<>& normal,
+                         double& depth,
+                         ChVector<>& pt1) {
+    ChVector<> face_n = Vcross(B - A, C - A).GetNormalized();
+    double h = Vdot(sphere_pos - A, face_n);
+    if (h >= radius || h <= -radius)
+        return false;
+
+    ChVector<> faceLoc;
+    if (!SnapToFace(A, B, C, sphere_pos, faceLoc)) {
+        depth = h - radius;
+        normal = face_n;
+        pt1 = faceLoc;
+        return true;
+    }
+
+    normal = sphere_pos - faceLoc;
+    double dist = normal.Length();
+    depth = dist - radius;
+    if (depth >= 0)
+        return false;
+    normal /= dist;
+    pt1 = faceLoc;
+    return true;
+}
+
+static double3 ToDouble3(const ChVector<>& v) {
+    return make_double3(v.x(), v.y(), v.z());
+}
+
+static ChVector<> ToChVector(const double3& v) {
+    return ChVector<>(v.x, v.y, v.z);
+}
+
+static ChVector<> ToChVector(const float3& v) {
+    return ChVector<>(v.x, v.y, v.z);
+}
+
+static float3 ToFloat3(const ChVector<>& v) {
+    return make_float3((float)v.x(), (float)v.y(), (float)v.z());
+}
+
+// -----------------------------------------------------------------------------
+
+ChSystemGpuCpu::ChSystemGpuCpu(float sphere_rad, float density, const ChVector<float>& boxDims, ChVector<float> O)
+    : m_radius(sphere_rad),
+      m_density(density),
+      m_box_dims(boxDims),
+      m_BD_center(O),
+      m_BD_fixed(true),
+      m_BD_offset_function(GranPosFunction_default),
+      m_g(0, 0, 0),
+      m_step_size(1e-4f),
+      m_time(0),
+      m_max_safe_vel((float)UINT_MAX),
+      m_num_threads(ChOMP::GetNumProcs()),
+      m_integrator(CHGPU_TIME_INTEGRATOR::EXTENDED_TAYLOR),
+      m_friction_mode(CHGPU_FRICTION_MODE::FRICTIONLESS),
+      m_rolling_mode(CHGPU_ROLLING_MODE::NO_RESISTANCE),
+      verbosity(CHGPU_VERBOSITY::INFO),
+      m_output_mode(CHGPU_OUTPUT_MODE::CSV),
+      output_flags(ABSV),
+      m_use_mat_based(false),
+      m_cohesion_over_gravity(0),
+      m_cell_size(0),
+      m_num_contacts(0),
+      m_bc_histmap_offset(0),
+      m_timer_total(0),
+      m_sphere_updates(0),
+      m_initialized(false) {
+    m_mass = (4.0 / 3.0) * CH_C_PI * m_radius * m_radius * m_radius * m_density;
+    m_inertia_by_r = 0.4 * m_mass * m_radius;
+    m_grid_dim[0] = m_grid_dim[1] = m_grid_dim[2] = 0;
+
+    // Reserve seats for big box domain BCs
+    m_bc_types.resize(NUM_RESERVED_BC_IDS);
+    m_bc_rest.resize(NUM_RESERVED_BC_IDS);
+    m_bc_offset_functions.resize(NUM_RESERVED_BC_IDS, GranPosFunction_default);
+}
+
+void ChSystemGpuCpu::SetNumThreads(int num_threads) {
+    m_num_threads = std::max(num_threads, 1);
+}
+
+void ChSystemGpuCpu::SetGravitationalAcceleration(const ChVector<float>& g) {
+    m_g = ChVector<>(g);
+}
+
+void ChSystemGpuCpu::SetParticles(const std::vector<ChVector<float>>& points,
+                                  const std::vector<ChVector<float>>& vels,
+                                  const std::vector<ChVector<float>>& ang_vels) {
+    size_t n = points.size();
+    if (vels.size() != 0 && vels.size() != n)
+        CHGPU_ERROR("Input velocity array does not match the number of particles!\n");
+    if (ang_vels.size() != 0 && ang_vels.size() != n)
+        CHGPU_ERROR("Input angular velocity array does not match the number of particles!\n");
+
+    m_pos.resize(n);
+    for (size_t i = 0; i < n; i++)
+        m_pos[i] = ChVector<>(points[i]);
+    m_vel = vels.size() ? vels : std::vector<ChVector<float>>(n, ChVector<float>(0));
+    m_omega = ang_vels.size() ? ang_vels : std::vector<ChVector<float>>(n, ChVector<float>(0));
+    if (m_fixed.size() != n)
+        m_fixed.assign(n, 0);
+}
+
+void ChSystemGpuCpu::SetParticleFixed(const std::vector<bool>& fixed) {
+    m_fixed.resize(fixed.size());
+    for (size_t i = 0; i < fixed.size(); i++)
+        m_fixed[i] = fixed[i] ? 1 : 0;
+}
+
+void ChSystemGpuCpu::SetParticleOutputMode(CHGPU_OUTPUT_MODE mode) {
+    if (mode != CHGPU_OUTPUT_MODE::CSV && mode != CHGPU_OUTPUT_MODE::NONE)
+        CHGPU_ERROR("ERROR! Only CSV output is supported by the CPU implementation.\n");
+    m_output_mode = mode;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t ChSystemGpuCpu::CreateBC(BC_type type, const BC_params_t<double, double3>& p) {
+    m_bc_types.push_back(type);
+    m_bc_rest.push_back(p);
+    m_bc_offset_functions.push_back(GranPosFunction_default);
+    if (m_initialized) {
+        m_bc.push_back(p);
+        for (auto& f : m_bc_forces_thread)
+            f.push_back(ChVector<>(0));
+        for (auto& t : m_bc_torques_thread)
+            t.push_back(ChVector<>(0));
+    }
+    return m_bc_types.size() - 1;
+}
+
+size_t ChSystemGpuCpu::CreateBCSphere(const ChVector<float>& center,
+                                      float radius,
+                                      bool outward_normal,
+                                      bool track_forces,
+                                      float mass) {
+    BC_params_t<double, double3> p;
+    p.active = true;
+    p.fixed = false;
+    p.track_forces = track_forces;
+    p.reaction_forces = make_float3(0, 0, 0);
+    p.vel_SU = make_float3(0, 0, 0);
+    p.sphere_params.sphere_center = make_double3(center.x(), center.y(), center.z());
+    p.sphere_params.sphere_velo = make_float3(0, 0, 0);
+    p.sphere_params.sphere_angularVelo = make_float3(0, 0, 0);
+    p.sphere_params.reaction_torques = make_float3(0, 0, 0);
+    p.sphere_params.radius = radius;
+    // particles outside of the BC sphere for an outward normal, inside otherwise
+    p.sphere_params.normal_sign = outward_normal ? 1 : -1;
+    p.sphere_params.mass = mass;
+    return CreateBC(BC_type::SPHERE, p);
+}
+
+size_t ChSystemGpuCpu::CreateBCConeZ(const ChVector<float>& tip,
+                                     float slope,
+                                     float hmax,
+                                     float hmin,
+                                     bool outward_normal,
+                                     bool track_forces) {
+    BC_params_t<double, double3> p;
+    p.active = true;
+    p.fixed = true;
+    p.track_forces = track_forces;
+    p.reaction_forces = make_float3(0, 0, 0);
+    p.vel_SU = make_float3(0, 0, 0);
+    p.cone_params.cone_tip = make_double3(tip.x(), tip.y(), tip.z());
+    p.cone_params.slope = slope;
+    p.cone_params.hmax = hmax;
+    p.cone_params.hmin = hmin;
+    p.cone_params.normal_sign = outward_normal ? -1 : 1;
+    return CreateBC(BC_type::CONE, p);
+}
+
+size_t ChSystemGpuCpu::CreateBCPlane(const ChVector<float>& pos, const ChVector<float>& normal, bool track_forces) {
+    BC_params_t<double, double3> p;
+    p.active = true;
+    p.fixed = true;
+    p.track_forces = track_forces;
+    p.reaction_forces = make_float3(0, 0, 0);
+    p.vel_SU = make_float3(0, 0, 0);
+    p.plane_params.position = make_double3(pos.x(), pos.y(), pos.z());
+    p.plane_params.normal = ToFloat3(ChVector<>(normal).GetNormalized());
+    p.plane_params.rotation_center = make_double3(0, 0, 0);
+    p.plane_params.angular_acc = make_float3(0, 0, 0);
+    return CreateBC(BC_type::PLANE, p);
+}
+
+size_t ChSystemGpuCpu::CreateBCCylinderZ(const ChVector<float>& center,
+                                         float radius,
+                                         bool outward_normal,
+                                         bool track_forces) {
+    BC_params_t<double, double3> p;
+    p.active = true;
+    p.fixed = true;
+    p.track_forces = track_forces;
+    p.reaction_forces = make_float3(0, 0, 0);
+    p.vel_SU = make_float3(0, 0, 0);
+    p.cyl_params.center = make_double3(center.x(), center.y(), center.z());
+    p.cyl_params.radius = radius;
+    p.cyl_params.normal_sign = outward_normal ? -1 : 1;
+    return CreateBC(BC_type::CYLINDER, p);
+}
+
+bool ChSystemGpuCpu::DisableBCbyID(size_t BC_id) {
+    if (BC_id >= m_bc_types.size()) {
+        printf("ERROR: Trying to disable invalid BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (BC_id <= NUM_RESERVED_BC_IDS - 1) {
+        printf("ERROR: Trying to modify reserved BC ID %zu\n", BC_id);
+        return false;
+    }
+    m_bc_rest[BC_id].active = false;
+    if (m_initialized)
+        m_bc[BC_id].active = false;
+    return true;
+}
+
+bool ChSystemGpuCpu::EnableBCbyID(size_t BC_id) {
+    if (BC_id >= m_bc_types.size()) {
+        printf("ERROR: Trying to enable invalid BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (BC_id <= NUM_RESERVED_BC_IDS - 1) {
+        printf("ERROR: Trying to modify reserved BC ID %zu\n", BC_id);
+        return false;
+    }
+    m_bc_rest[BC_id].active = true;
+    if (m_initialized)
+        m_bc[BC_id].active = true;
+    return true;
+}
+
+bool ChSystemGpuCpu::SetBCOffsetFunction(size_t BC_id, const GranPositionFunction& offset_function) {
+    if (BC_id >= m_bc_types.size()) {
+        printf("ERROR: Trying to set offset function for invalid BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (BC_id <= NUM_RESERVED_BC_IDS - 1) {
+        printf("ERROR: Trying to modify reserved BC ID %zu\n", BC_id);
+        return false;
+    }
+    m_bc_offset_functions[BC_id] = offset_function;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+double ChSystemGpuCpu::GetMaxParticleZ() const {
+    double z = -DBL_MAX;
+    for (const auto& p : m_pos)
+        z = std::max(z, p.z());
+    return z;
+}
+
+double ChSystemGpuCpu::GetMinParticleZ() const {
+    double z = DBL_MAX;
+    for (const auto& p : m_pos)
+        z = std::min(z, p.z());
+    return z;
+}
+
+unsigned int ChSystemGpuCpu::GetNumParticleAboveZ(float ZValue) const {
+    return (unsigned int)std::count_if(m_pos.begin(), m_pos.end(),
+                                       [ZValue](const ChVector<>& p) { return p.z() > ZValue; });
+}
+
+unsigned int ChSystemGpuCpu::GetNumParticleAboveX(float XValue) const {
+    return (unsigned int)std::count_if(m_pos.begin(), m_pos.end(),
+                                       [XValue](const ChVector<>& p) { return p.x() > XValue; });
+}
+
+ChVector<float> ChSystemGpuCpu::GetParticlePosition(int nSphere) const {
+    return ChVector<float>(m_pos[nSphere]);
+}
+
+void ChSystemGpuCpu::SetParticlePosition(int nSphere, const ChVector<double> pos) {
+    m_pos[nSphere] = pos;
+}
+
+void ChSystemGpuCpu::SetParticleVelocity(int nSphere, const ChVector<double> velo) {
+    m_vel[nSphere] = ChVector<float>(velo);
+}
+
+ChVector<float> ChSystemGpuCpu::GetParticleAngVelocity(int nSphere) const {
+    if (m_friction_mode == CHGPU_FRICTION_MODE::FRICTIONLESS)
+        return ChVector<float>(0);
+    return m_omega[nSphere];
+}
+
+ChVector<float> ChSystemGpuCpu::GetParticleLinAcc(int nSphere) const {
+    return m_acc[nSphere];
+}
+
+ChVector<float> ChSystemGpuCpu::GetParticleVelocity(int nSphere) const {
+    return m_vel[nSphere];
+}
+
+float ChSystemGpuCpu::GetParticlesKineticEnergy() const {
+    double v2 = 0;
+    double w2 = 0;
+    for (size_t i = 0; i < m_vel.size(); i++) {
+        v2 += m_vel[i].Length2();
+        w2 += m_omega[i].Length2();
+    }
+    // KE = 0.5 * m * sum(v^2) + 0.2 * m * r^2 * sum(w^2)
+    return (float)(0.5 * m_mass * v2 + 0.2 * m_mass * m_radius * m_radius * w2);
+}
+
+ChVector<float> ChSystemGpuCpu::GetBCPlanePosition(size_t plane_id) const {
+    const auto& p = m_initialized ? m_bc[plane_id] : m_bc_rest[plane_id];
+    return ChVector<float>(ToChVector(p.plane_params.position));
+}
+
+ChVector<float> ChSystemGpuCpu::GetBCSpherePosition(size_t sphere_id) const {
+    const auto& p = m_initialized ? m_bc[sphere_id] : m_bc_rest[sphere_id];
+    return ChVector<float>(ToChVector(p.sphere_params.sphere_center));
+}
+
+void ChSystemGpuCpu::SetBCSpherePosition(size_t sphere_bc_id, const ChVector<float>& pos) {
+    auto& p = m_initialized ? m_bc[sphere_bc_id] : m_bc_rest[sphere_bc_id];
+    p.sphere_params.sphere_center = make_double3(pos.x(), pos.y(), pos.z());
+}
+
+ChVector<float> ChSystemGpuCpu::GetBCSphereVelocity(size_t sphere_id) const {
+    const auto& p = m_initialized ? m_bc[sphere_id] : m_bc_rest[sphere_id];
+    return ChVector<float>(ToChVector(p.sphere_params.sphere_velo));
+}
+
+void ChSystemGpuCpu::SetBCSphereVelocity(size_t sphere_bc_id, const ChVector<float>& velo) {
+    auto& p = m_initialized ? m_bc[sphere_bc_id] : m_bc_rest[sphere_bc_id];
+    p.sphere_params.sphere_velo = make_float3(velo.x(), velo.y(), velo.z());
+}
+
+void ChSystemGpuCpu::SetBCPlaneRotation(size_t plane_id, ChVector<double> center, ChVector<double> omega) {
+    for (auto list : {&m_bc_rest, &m_bc}) {
+        if (plane_id < list->size()) {
+            (*list)[plane_id].plane_params.rotation_center = ToDouble3(center);
+            (*list)[plane_id].plane_params.angular_acc = ToFloat3(omega);
+        }
+    }
+}
+
+bool ChSystemGpuCpu::GetBCReactionForces(size_t BC_id, ChVector<float>& force) const {
+    if (BC_id >= m_bc.size()) {
+        printf("ERROR: Trying to get forces for invalid BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (BC_id <= NUM_RESERVED_BC_IDS - 1) {
+        printf("ERROR: Trying to modify reserved BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (!m_bc[BC_id].track_forces) {
+        printf("ERROR: Trying to get forces for non-force-tracking BC ID %zu\n", BC_id);
+        return false;
+    }
+    if (!m_bc[BC_id].active) {
+        printf("ERROR: Trying to get forces for inactive BC ID %zu\n", BC_id);
+        return false;
+    }
+    force = ChVector<float>(ToChVector(m_bc[BC_id].reaction_forces));
+    return true;
+}
+
+double ChSystemGpuCpu::GetSphereUpdatesPerSecond() const {
+    if (m_timer_total <= 0)
+        return 0;
+    return (double)m_sphere_updates / m_timer_total;
+}
+
+size_t ChSystemGpuCpu::EstimateMemUsage() const {
+    size_t bytes = 0;
+    bytes += m_pos.capacity() * sizeof(ChVector<double>);
+    bytes += (m_vel.capacity() + m_omega.capacity() + m_acc.capacity() + m_acc_old.capacity() +
+              m_ang_acc.capacity() + m_ang_acc_old.capacity()) *
+             sizeof(ChVector<float>);
+    bytes += m_fixed.capacity() * sizeof(char);
+    bytes += m_contact_partners.capacity() * sizeof(unsigned int);
+    bytes += m_contact_history.capacity() * sizeof(ChVector<float>);
+    bytes += m_contact_duration.capacity() * sizeof(float);
+    bytes += m_contact_active.capacity() * sizeof(char);
+    bytes += (m_cell_start.capacity() + m_cell_spheres.capacity() + m_sphere_cell.capacity()) * sizeof(unsigned int);
+    return bytes;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSystemGpuCpu::ComputeMaterialParams(ContactParams& cp) const {
+    materialPropertyCombine(m_s2s.E, cp.E, m_s2s.nu, cp.nu, cp.E_eff, cp.G_eff);
+    cp.beta = DampingFactor(std::min(m_s2s.cor, cp.cor));
+}
+
+void ChSystemGpuCpu::Initialize() {
+    size_t n = m_pos.size();
+    if (m_fixed.size() != n)
+        CHGPU_ERROR("ERROR! Particle fixity array does not match the number of particles!\n");
+
+    // Box domain walls, at their reserved seats
+    ChVector<double> O(m_BD_center);
+    ChVector<double> half(0.5 * m_box_dims.x(), 0.5 * m_box_dims.y(), 0.5 * m_box_dims.z());
+    ChVector<double> wall_pos[6] = {O - ChVector<>(half.x(), 0, 0), O + ChVector<>(half.x(), 0, 0),
+                                    O - ChVector<>(0, half.y(), 0), O + ChVector<>(0, half.y(), 0),
+                                    O - ChVector<>(0, 0, half.z()), O + ChVector<>(0, 0, half.z())};
+    ChVector<double> wall_normal[6] = {ChVector<>(1, 0, 0), ChVector<>(-1, 0, 0), ChVector<>(0, 1, 0),
+                                       ChVector<>(0, -1, 0), ChVector<>(0, 0, 1), ChVector<>(0, 0, -1)};
+    for (size_t i = 0; i < NUM_RESERVED_BC_IDS; i++) {
+        BC_params_t<double, double3> p;
+        p.active = true;
+        p.fixed = true;
+        p.track_forces = false;
+        p.reaction_forces = make_float3(0, 0, 0);
+        p.vel_SU = make_float3(0, 0, 0);
+        p.plane_params.position = ToDouble3(wall_pos[i]);
+        p.plane_params.normal = ToFloat3(wall_normal[i]);
+        p.plane_params.rotation_center = make_double3(0, 0, 0);
+        p.plane_params.angular_acc = make_float3(0, 0, 0);
+        m_bc_types[i] = BC_type::PLANE;
+        m_bc_rest[i] = p;
+        m_bc_offset_functions[i] = m_BD_fixed ? GranPosFunction_default : m_BD_offset_function;
+    }
+    m_bc = m_bc_rest;
+
+    // Derived contact parameters
+    if (m_use_mat_based) {
+        materialPropertyCombine(m_s2s.E, m_s2s.E, m_s2s.nu, m_s2s.nu, m_s2s.E_eff, m_s2s.G_eff);
+        m_s2s.beta = DampingFactor(m_s2s.cor);
+        ComputeMaterialParams(m_s2w);
+    }
+
+    // Particle state
+    m_acc.assign(n, ChVector<float>(0));
+    m_acc_old.assign(n, ChVector<float>(0));
+    m_ang_acc.assign(n, ChVector<float>(0));
+    m_ang_acc_old.assign(n, ChVector<float>(0));
+
+    if (m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS) {
+        size_t nslots = n * MAX_SPHERES_TOUCHED_BY_SPHERE;
+        m_contact_partners.assign(nslots, NULL_CHGPU_ID);
+        m_contact_history.assign(nslots, ChVector<float>(0));
+        m_contact_duration.assign(nslots, 0.f);
+        m_contact_active.assign(nslots, 0);
+    }
+
+    // Friction history labels of the boundaries come after the sphere labels. BCs created after initialization take
+    // the next labels, so the BC labels must be the last label range.
+    m_bc_histmap_offset = (unsigned int)n + 1;
+
+    m_initialized = true;
+    BuildCellList();
+
+    INFO_PRINTF("CPU granular system: %zu spheres, %zu BCs, %d threads\n", n, m_bc.size(), m_num_threads);
+    INFO_PRINTF("Approx mem usage is %s\n", pretty_format_bytes(EstimateMemUsage()).c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSystemGpuCpu::UpdateBCPositions() {
+    double dt = m_step_size;
+    for (size_t b = 0; b < m_bc.size(); b++) {
+        const auto& rest = m_bc_rest[b];
+        auto& bc = m_bc[b];
+        ChVector<> offset = ToChVector(m_bc_offset_functions[b](m_time));
+        ChVector<> old_pos;
+        ChVector<> new_pos;
+
+        switch (m_bc_types[b]) {
+            case BC_type::SPHERE: {
+                // Sphere BCs are moving bodies, driven by the reactions from the previous step and gravity
+                if (!bc.active)
+                    continue;
+                auto& sp = bc.sphere_params;
+                old_pos = ToChVector(sp.sphere_center);
+                ChVector<> acc = ToChVector(bc.reaction_forces) / sp.mass + m_g;
+                ChVector<> vel = ToChVector(sp.sphere_velo) + acc * dt;
+                new_pos = old_pos + vel * dt;
+                double inertia = 0.4 * sp.mass * sp.radius * sp.radius;
+                ChVector<> omega = ToChVector(sp.sphere_angularVelo) + ToChVector(sp.reaction_torques) * (dt / inertia);
+                sp.sphere_velo = ToFloat3(vel);
+                sp.sphere_angularVelo = ToFloat3(omega);
+                sp.sphere_center = ToDouble3(new_pos);
+                break;
+            }
+            case BC_type::CONE: {
+                old_pos = ToChVector(bc.cone_params.cone_tip);
+                new_pos = ToChVector(rest.cone_params.cone_tip) + offset;
+                bc.cone_params.cone_tip = ToDouble3(new_pos);
+                bc.cone_params.hmax = rest.cone_params.hmax + offset.z();
+                bc.cone_params.hmin = rest.cone_params.hmin + offset.z();
+                break;
+            }
+            case BC_type::PLANE: {
+                old_pos = ToChVector(bc.plane_params.position);
+                new_pos = ToChVector(rest.plane_params.position) + offset;
+                bc.plane_params.position = ToDouble3(new_pos);
+                break;
+            }
+            case BC_type::CYLINDER: {
+                old_pos = ToChVector(bc.cyl_params.center);
+                new_pos = ToChVector(rest.cyl_params.center) + offset;
+                bc.cyl_params.center = ToDouble3(new_pos);
+                break;
+            }
+            default:
+                CHGPU_ERROR("ERROR: Unsupported BC Type!\n");
+        }
+
+        // Velocity of the BC from its displacement over the step
+        bc.vel_SU = ToFloat3((new_pos - old_pos) / dt);
+    }
+}
+
+void ChSystemGpuCpu::BuildCellList() {
+    unsigned int n = (unsigned int)m_pos.size();
+    m_cell_size = 2 * m_radius;
+
+    if (n == 0) {
+        m_grid_dim[0] = m_grid_dim[1] = m_grid_dim[2] = 1;
+        m_grid_min = ChVector<>(0);
+        m_cell_start.assign(2, 0);
+        m_cell_spheres.clear();
+        m_sphere_cell.clear();
+        return;
+    }
+
+    // Bounding box of the current particle configuration
+    ChVector<> pmin(+DBL_MAX);
+    ChVector<> pmax(-DBL_MAX);
+    for (unsigned int i = 0; i < n; i++) {
+        pmin = Vmin(pmin, m_pos[i]);
+        pmax = Vmax(pmax, m_pos[i]);
+    }
+
+    // Cells no smaller than a sphere diameter, enlarged if the particles are sparse
+    double max_cells = std::max(MAX_CELLS_PER_SPHERE * n, 27.0);
+    ChVector<> ext = pmax - pmin;
+    while (true) {
+        double nx = std::floor(ext.x() / m_cell_size) + 1;
+        double ny = std::floor(ext.y() / m_cell_size) + 1;
+        double nz = std::floor(ext.z() / m_cell_size) + 1;
+        if (nx * ny * nz <= max_cells) {
+            m_grid_dim[0] = (int)nx;
+            m_grid_dim[1] = (int)ny;
+            m_grid_dim[2] = (int)nz;
+            break;
+        }
+        m_cell_size *= 1.25;
+    }
+    m_grid_min = pmin;
+
+    size_t num_cells = (size_t)m_grid_dim[0] * m_grid_dim[1] * m_grid_dim[2];
+    m_sphere_cell.resize(n);
+    m_cell_spheres.resize(n);
+    m_cell_start.assign(num_cells + 1, 0);
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < (int)n; i++) {
+        ChVector<> rel = (m_pos[i] - m_grid_min) / m_cell_size;
+        int cx = std::min((int)rel.x(), m_grid_dim[0] - 1);
+        int cy = std::min((int)rel.y(), m_grid_dim[1] - 1);
+        int cz = std::min((int)rel.z(), m_grid_dim[2] - 1);
+        m_sphere_cell[i] = (unsigned int)((cz * m_grid_dim[1] + cy) * m_grid_dim[0] + cx);
+    }
+
+    // Counting sort of the spheres by cell
+    for (unsigned int i = 0; i < n; i++)
+        m_cell_start[m_sphere_cell[i] + 1]++;
+    for (size_t c = 0; c < num_cells; c++)
+        m_cell_start[c + 1] += m_cell_start[c];
+    std::vector<unsigned int> fill(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (unsigned int i = 0; i < n; i++)
+        m_cell_spheres[fill[m_sphere_cell[i]]++] = i;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned int ChSystemGpuCpu::FindContactSlot(unsigned int i, unsigned int partner) {
+    unsigned int start = i * MAX_SPHERES_TOUCHED_BY_SPHERE;
+    for (unsigned int k = start; k < start + MAX_SPHERES_TOUCHED_BY_SPHERE; k++) {
+        if (m_contact_partners[k] == partner) {
+            m_contact_active[k] = 1;
+            return k;
+        }
+    }
+    for (unsigned int k = start; k < start + MAX_SPHERES_TOUCHED_BY_SPHERE; k++) {
+        if (m_contact_partners[k] == NULL_CHGPU_ID) {
+            m_contact_partners[k] = partner;
+            m_contact_active[k] = 1;
+            return k;
+        }
+    }
+    CHGPU_ERROR("Sphere %u is touching %d bodies already and we just found another!\n", i,
+                MAX_SPHERES_TOUCHED_BY_SPHERE);
+}
+
+ChVector<double> ChSystemGpuCpu::FrictionForce(unsigned int slot,
+                                               float mu,
+                                               double kt,
+                                               double gt,
+                                               double hertz,
+                                               double m_eff,
+                                               const ChVector<double>& normal_force,
+                                               const ChVector<double>& vrel_t,
+                                               const ChVector<double>& normal) {
+    ChVector<> delta_t = vrel_t * m_step_size;
+    if (m_friction_mode == CHGPU_FRICTION_MODE::MULTI_STEP) {
+        // accumulated tangential displacement, projected onto the current tangent plane
+        delta_t += ChVector<>(m_contact_history[slot]);
+        delta_t -= Vdot(delta_t, normal) * normal;
+        m_contact_history[slot] = ChVector<float>(delta_t);
+    }
+
+    ChVector<> tangent_force = hertz * (-kt * delta_t - gt * m_eff * vrel_t);
+
+    // Clamp to the Coulomb limit and make the stored displacement consistent with the clamped force
+    double ft = tangent_force.Length();
+    double ft_max = normal_force.Length() * mu;
+    if (ft > ft_max) {
+        tangent_force *= ft_max / ft;
+        if (m_friction_mode == CHGPU_FRICTION_MODE::MULTI_STEP)
+            m_contact_history[slot] = ChVector<float>(((tangent_force / hertz) + gt * m_eff * vrel_t) / -kt);
+    }
+
+    return tangent_force;
+}
+
+ChVector<double> ChSystemGpuCpu::FrictionForceMatBased(unsigned int slot,
+                                                       float mu,
+                                                       double G_eff,
+                                                       double sqrt_Rd,
+                                                       double beta,
+                                                       double m_eff,
+                                                       const ChVector<double>& normal_force,
+                                                       const ChVector<double>& vrel_t,
+                                                       const ChVector<double>& normal) {
+    ChVector<> delta_t = ChVector<>(m_contact_history[slot]) + vrel_t * m_step_size;
+    delta_t -= Vdot(delta_t, normal) * normal;
+    m_contact_history[slot] = ChVector<float>(delta_t);
+
+    double kt = 8 * G_eff * sqrt_Rd;
+    double gt = -2 * beta * std::sqrt(5.0 / 6.0 * m_eff * kt);
+    ChVector<> tangent_force = -kt * delta_t - gt * vrel_t;
+
+    double ft = tangent_force.Length();
+    double ft_max = normal_force.Length() * mu;
+    if (ft > ft_max) {
+        tangent_force *= ft_max / ft;
+        m_contact_history[slot] = ChVector<float>((tangent_force + gt * vrel_t) / -kt);
+    }
+
+    return tangent_force;
+}
+
+ChVector<double> ChSystemGpuCpu::RollingAngAcc(float mu_r,
+                                               const ChVector<double>& normal_force,
+                                               const ChVector<double>& my_omega,
+                                               const ChVector<double>& their_omega,
+                                               const ChVector<double>& r_contact) const {
+    if (m_rolling_mode != CHGPU_ROLLING_MODE::SCHWARTZ)
+        return ChVector<>(0);
+
+    // As in chrono parallel: v_rot = l_p (w_p x n) - l_n (w_n x n)
+    ChVector<> v_rot = Vcross(their_omega - my_omega, r_contact);
+    double v_rot_mag = v_rot.Length();
+    if (v_rot_mag < ROLLING_VROT_THRESHOLD)
+        return ChVector<>(0);
+
+    ChVector<> torque = (mu_r * normal_force.Length() / v_rot_mag) * Vcross(r_contact, v_rot);
+    return torque / (m_inertia_by_r * m_radius);
+}
+
+bool ChSystemGpuCpu::EvaluateRollingFriction(double E_eff, double R_eff, double beta, double m_eff, float duration)
+    const {
+    double kn_simple = 4.0 / 3.0 * E_eff * std::sqrt(R_eff);
+    double gn_simple = -2 * std::sqrt(5.0 / 3.0 * m_eff * E_eff) * beta * std::pow(R_eff, 0.25);
+    double d_coeff = gn_simple / (2 * std::sqrt(kn_simple * m_eff));
+    if (d_coeff < 1) {
+        double t_collision = CH_C_PI * std::sqrt(m_eff / (kn_simple * (1 - d_coeff * d_coeff)));
+        if (duration <= t_collision)
+            return false;
+    }
+    return true;
+}
+
+ChVector<double> ChSystemGpuCpu::SurfaceContact(unsigned int i,
+                                                unsigned int partner,
+                                                const ContactParams& cp,
+                                                double m_eff,
+                                                double penetration,
+                                                const ChVector<double>& normal,
+                                                const ChVector<double>& surf_vel,
+                                                const ChVector<double>& surf_omega,
+                                                double dist,
+                                                ContactResult& res) {
+    ChVector<> rel_vel = ChVector<>(m_vel[i]) - surf_vel;
+    double projection = Vdot(rel_vel, normal);
+
+    // Normal force, including adhesion
+    ChVector<> force;
+    double hertz = 0;
+    double sqrt_Rd = 0;
+    if (m_use_mat_based) {
+        sqrt_Rd = std::sqrt(penetration * m_radius);
+        double Sn = 2 * cp.E_eff * sqrt_Rd;
+        double kn = (2.0 / 3.0) * Sn;
+        double gn = -2 * std::sqrt(5.0 / 6.0) * cp.beta * std::sqrt(Sn * m_eff);
+        force = (kn * penetration - gn * projection) * normal;
+    } else {
+        hertz = std::sqrt(penetration / m_radius);
+        force = hertz * (cp.kn * penetration - cp.gn * m_eff * projection) * normal;
+    }
+    force -= (m_mass * cp.adhesion_over_gravity * m_g.Length()) * normal;
+
+    if (m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS) {
+        ChVector<> omega(m_omega[i]);
+        ChVector<> vrel_t = rel_vel - projection * normal + Vcross(omega, -dist * normal);
+        unsigned int slot = FindContactSlot(i, partner);
+
+        ChVector<> tangent_force;
+        ChVector<> roll_acc;
+        if (m_use_mat_based) {
+            tangent_force =
+                FrictionForceMatBased(slot, cp.mu_s, cp.G_eff, sqrt_Rd, cp.beta, m_eff, force, vrel_t, normal);
+            m_contact_duration[slot] += m_step_size;
+            if (EvaluateRollingFriction(cp.E_eff, m_radius, cp.beta, m_eff, m_contact_duration[slot]))
+                roll_acc = RollingAngAcc(cp.mu_r, force, omega, surf_omega, dist * normal);
+        } else {
+            tangent_force = FrictionForce(slot, cp.mu_s, cp.kt, cp.gt, hertz, m_eff, force, vrel_t, normal);
+            roll_acc = RollingAngAcc(cp.mu_r, force, omega, surf_omega, dist * normal);
+        }
+
+        res.ang_acc += Vcross(-normal, tangent_force) / m_inertia_by_r + roll_acc;
+        force += tangent_force;
+    }
+
+    res.force += force;
+    return force;
+}
+
+// -----------------------------------------------------------------------------
+
+ChSystemGpuCpu::ContactResult ChSystemGpuCpu::SphereContacts(unsigned int i, unsigned int& num_contacts) {
+    ContactResult res;
+    const ChVector<>& pA = m_pos[i];
+    ChVector<> vA(m_vel[i]);
+    ChVector<> wA(m_omega[i]);
+    bool fixedA = m_fixed[i] != 0;
+    bool friction = m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS;
+
+    double diam2 = 4 * m_radius * m_radius;
+    double m_eff = m_mass / 2;
+    double cohesion = m_mass * m_cohesion_over_gravity * m_g.Length();
+
+    unsigned int cell = m_sphere_cell[i];
+    int cx = cell % m_grid_dim[0];
+    int cy = (cell / m_grid_dim[0]) % m_grid_dim[1];
+    int cz = cell / (m_grid_dim[0] * m_grid_dim[1]);
+
+    for (int z = std::max(cz - 1, 0); z <= std::min(cz + 1, m_grid_dim[2] - 1); z++) {
+        for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, m_grid_dim[1] - 1); y++) {
+            int row = (z * m_grid_dim[1] + y) * m_grid_dim[0];
+            unsigned int start = m_cell_start[row + std::max(cx - 1, 0)];
+            unsigned int end = m_cell_start[row + std::min(cx + 1, m_grid_dim[0] - 1) + 1];
+            for (unsigned int k = start; k < end; k++) {
+                unsigned int j = m_cell_spheres[k];
+                if (j == i || (fixedA && m_fixed[j]))
+                    continue;
+
+                ChVector<> delta = pA - m_pos[j];
+                double d2 = delta.Length2();
+                if (d2 >= diam2)
+                    continue;
+                num_contacts++;
+
+                double d = std::sqrt(d2);
+                ChVector<> normal = delta / d;
+                double penetration = 2 * m_radius - d;
+
+                ChVector<> v_rel = vA - ChVector<>(m_vel[j]);
+                double projection = Vdot(v_rel, normal);
+                ChVector<> vrel_t = v_rel - projection * normal;
+
+                // Normal force, including cohesion
+                ChVector<> force;
+                double hertz = 0;
+                double sqrt_Rd = 0;
+                if (m_use_mat_based) {
+                    sqrt_Rd = std::sqrt(penetration * m_radius / 2);
+                    double Sn = 2 * m_s2s.E_eff * sqrt_Rd;
+                    double kn = (2.0 / 3.0) * Sn;
+                    double gn = -2 * std::sqrt(5.0 / 6.0) * m_s2s.beta * std::sqrt(Sn * m_eff);
+                    force = (kn * penetration - gn * projection) * normal;
+                } else {
+                    hertz = std::sqrt(penetration / m_radius);
+                    force = hertz * (m_s2s.kn * penetration - m_s2s.gn * m_eff * projection) * normal;
+                }
+                force -= cohesion * normal;
+
+                if (friction) {
+                    // vector from the center of sphere A to the contact point
+                    ChVector<> sphA_to_ctP = -0.5 * delta;
+                    ChVector<> wB(m_omega[j]);
+                    vrel_t += Vcross(wA + wB, sphA_to_ctP);
+                    unsigned int slot = FindContactSlot(i, j);
+
+                    ChVector<> tangent_force;
+                    ChVector<> roll_acc;
+                    if (m_use_mat_based) {
+                        tangent_force = FrictionForceMatBased(slot, m_s2s.mu_s, m_s2s.G_eff, sqrt_Rd, m_s2s.beta,
+                                                              m_eff, force, vrel_t, normal);
+                        m_contact_duration[slot] += m_step_size;
+                        if (EvaluateRollingFriction(m_s2s.E_eff, m_radius / 2, m_s2s.beta, m_eff,
+                                                    m_contact_duration[slot]))
+                            roll_acc = RollingAngAcc(m_s2s.mu_r, force, wA, wB, -sphA_to_ctP);
+                    } else {
+                        tangent_force = FrictionForce(slot, m_s2s.mu_s, m_s2s.kt, m_s2s.gt, hertz, m_eff, force,
+                                                      vrel_t, normal);
+                        roll_acc = RollingAngAcc(m_s2s.mu_r, force, wA, wB, -sphA_to_ctP);
+                    }
+
+                    res.ang_acc += Vcross(sphA_to_ctP, tangent_force / m_radius) / m_inertia_by_r + roll_acc;
+                    force += tangent_force;
+                }
+
+                res.force += force;
+            }
+        }
+    }
+
+    return res;
+}
+
+void ChSystemGpuCpu::BoundaryContacts(unsigned int i, int thread, ContactResult& res) {
+    const ChVector<>& pos = m_pos[i];
+    auto& bc_forces = m_bc_forces_thread[thread];
+    auto& bc_torques = m_bc_torques_thread[thread];
+
+    for (unsigned int b = 0; b < (unsigned int)m_bc.size(); b++) {
+        const auto& bc = m_bc[b];
+        if (!bc.active)
+            continue;
+        unsigned int label = m_bc_histmap_offset + b;
+        ChVector<> bc_vel = ToChVector(bc.vel_SU);
+
+        switch (m_bc_types[b]) {
+            case BC_type::PLANE: {
+                const auto& pp = bc.plane_params;
+                ChVector<> normal = ToChVector(pp.normal);
+                double dist = Vdot(normal, pos - ToChVector(pp.position));
+                double penetration = m_radius - dist;
+                if (penetration <= 0)
+                    break;
+                // velocity of the (possibly rotating) plane at the contact point
+                ChVector<> omega = ToChVector(pp.angular_acc);
+                ChVector<> ct_point = pos - normal * m_radius;
+                ChVector<> surf_vel = bc_vel + Vcross(omega, ct_point - ToChVector(pp.rotation_center));
+                ChVector<> force =
+                    SurfaceContact(i, label, m_s2w, m_mass, penetration, normal, surf_vel, omega, dist, res);
+                if (bc.track_forces)
+                    bc_forces[b] -= force;
+                break;
+            }
+            case BC_type::CYLINDER: {
+                const auto& cp = bc.cyl_params;
+                ChVector<> delta_r(cp.center.x - pos.x(), cp.center.y - pos.y(), 0);
+                double dist_delta_r = delta_r.Length();
+                double dist = std::abs(cp.radius - dist_delta_r);
+                double penetration = m_radius - dist;
+                if (penetration <= 0)
+                    break;
+                ChVector<> normal = (cp.normal_sign / dist_delta_r) * delta_r;
+                ChVector<> force =
+                    SurfaceContact(i, label, m_s2w, m_mass, penetration, normal, bc_vel, ChVector<>(0), dist, res);
+                if (bc.track_forces)
+                    bc_forces[b] -= force;
+                break;
+            }
+            case BC_type::CONE: {
+                const auto& cp = bc.cone_params;
+                if (pos.z() >= cp.hmax || pos.z() <= cp.hmin)
+                    break;
+                // point on the cone generator line directly below the sphere
+                ChVector<> rel = pos - ToChVector(cp.cone_tip);
+                ChVector<> l(rel.x(), rel.y(), cp.slope * std::sqrt(rel.x() * rel.x() + rel.y() * rel.y()));
+                ChVector<> contact_vector = rel - l * (Vdot(rel, l) / Vdot(l, l));
+                double dist = contact_vector.Length();
+                double penetration = m_radius - dist;
+                if (penetration <= 0)
+                    break;
+                ChVector<> normal = contact_vector / dist;
+                ChVector<> force =
+                    SurfaceContact(i, label, m_s2w, m_mass, penetration, normal, bc_vel, ChVector<>(0), dist, res);
+                if (bc.track_forces)
+                    bc_forces[b] -= force;
+                break;
+            }
+            case BC_type::SPHERE: {
+                const auto& sp = bc.sphere_params;
+                ChVector<> center = ToChVector(sp.sphere_center);
+                ChVector<> delta = pos - center;
+                double center_dist = delta.Length();
+                ChVector<> radial = delta / center_dist;
+                // spheres outside of the BC (positive sign) or inside it (negative sign)
+                double dist = sp.normal_sign > 0 ? center_dist - sp.radius : sp.radius - center_dist;
+                double penetration = m_radius - dist;
+                if (penetration <= 0)
+                    break;
+                ChVector<> normal = radial * (double)sp.normal_sign;
+                ChVector<> bc_omega = ToChVector(sp.sphere_angularVelo);
+                ChVector<> r_ct = radial * (double)sp.radius;
+                ChVector<> surf_vel = ToChVector(sp.sphere_velo) + Vcross(bc_omega, r_ct);
+                double m_eff = m_mass * sp.mass / (m_mass + sp.mass);
+                ChVector<> force =
+                    SurfaceContact(i, label, m_s2w, m_eff, penetration, normal, surf_vel, bc_omega, dist, res);
+                // the sphere BC is a moving body, always collect its reactions
+                bc_forces[b] -= force;
+                bc_torques[b] += Vcross(r_ct, -force);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void ChSystemGpuCpu::ComputeForces() {
+    unsigned int n = (unsigned int)m_pos.size();
+    size_t nbcs = m_bc.size();
+
+    if (m_bc_forces_thread.size() != (size_t)m_num_threads) {
+        m_bc_forces_thread.resize(m_num_threads);
+        m_bc_torques_thread.resize(m_num_threads);
+    }
+    for (int t = 0; t < m_num_threads; t++) {
+        m_bc_forces_thread[t].assign(nbcs, ChVector<>(0));
+        m_bc_torques_thread[t].assign(nbcs, ChVector<>(0));
+    }
+
+    ChVector<> weight = m_mass * m_g;
+    unsigned int num_contacts = 0;
+
+    // Each sphere accumulates the forces exerted on it, so no synchronization is needed. Spheres are processed in cell
+    // order for memory locality of the neighbour data.
+#pragma omp parallel num_threads(m_num_threads) reduction(+ : num_contacts)
+    {
+        int thread = ChOMP::GetThreadNum();
+#pragma omp for schedule(static)
+        for (int k = 0; k < (int)n; k++) {
+            unsigned int i = m_cell_spheres[k];
+            unsigned int nc = 0;
+            ContactResult res = SphereContacts(i, nc);
+            BoundaryContacts(i, thread, res);
+            ComputeExtraForces(i, thread, res);
+            res.force += weight;
+            m_acc[i] = ChVector<float>(res.force / m_mass);
+            m_ang_acc[i] = ChVector<float>(res.ang_acc);
+            num_contacts += nc;
+        }
+    }
+    m_num_contacts = num_contacts / 2;
+
+    // Reduce the reactions on the boundaries
+    for (size_t b = 0; b < nbcs; b++) {
+        ChVector<> force(0);
+        ChVector<> torque(0);
+        for (int t = 0; t < m_num_threads; t++) {
+            force += m_bc_forces_thread[t][b];
+            torque += m_bc_torques_thread[t][b];
+        }
+        m_bc[b].reaction_forces = ToFloat3(force);
+        if (m_bc_types[b] == BC_type::SPHERE)
+            m_bc[b].sphere_params.reaction_torques = ToFloat3(torque);
+    }
+}
+
+void ChSystemGpuCpu::IntegrateSpheres() {
+    unsigned int n = (unsigned int)m_pos.size();
+    double dt = m_step_size;
+    bool friction = m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS;
+    int unsafe = -1;
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < (int)n; i++) {
+        if (m_fixed[i])
+            continue;
+
+        ChVector<> acc(m_acc[i]);
+        ChVector<> acc_old(m_acc_old[i]);
+        ChVector<> vel_old(m_vel[i]);
+
+        if (std::abs(vel_old.x()) >= m_max_safe_vel || std::abs(vel_old.y()) >= m_max_safe_vel ||
+            std::abs(vel_old.z()) >= m_max_safe_vel || std::isnan(acc.Length2())) {
+#pragma omp critical
+            unsafe = i;
+        }
+
+        ChVector<> dv;
+        ChVector<> dx;
+        switch (m_integrator) {
+            case CHGPU_TIME_INTEGRATOR::FORWARD_EULER:
+                dv = acc * dt;
+                dx = vel_old * dt;
+                break;
+            case CHGPU_TIME_INTEGRATOR::EXTENDED_TAYLOR:
+                dv = acc * dt;
+                dx = (vel_old + 0.5 * acc * dt) * dt;
+                break;
+            case CHGPU_TIME_INTEGRATOR::CENTERED_DIFFERENCE:
+                dv = acc * dt;
+                dx = (vel_old + dv) * dt;
+                break;
+            case CHGPU_TIME_INTEGRATOR::CHUNG: {
+                const double gamma_hat = 28.0 / 27.0;
+                dv = dt * (1.5 * acc - 0.5 * acc_old);
+                dx = dt * (vel_old + dt * (gamma_hat * acc + (0.5 - gamma_hat) * acc_old));
+                break;
+            }
+        }
+        m_vel[i] = ChVector<float>(vel_old + dv);
+        m_pos[i] += dx;
+
+        if (friction) {
+            ChVector<> ang_acc(m_ang_acc[i]);
+            ChVector<> dw = (m_integrator == CHGPU_TIME_INTEGRATOR::CHUNG)
+                                ? dt * (1.5 * ang_acc - 0.5 * ChVector<>(m_ang_acc_old[i]))
+                                : ang_acc * dt;
+            m_omega[i] += ChVector<float>(dw);
+        }
+    }
+
+    if (unsafe >= 0) {
+        CHGPU_ERROR("Unsafe velocity computed -- sphere is %d, vel is (%f, %f, %f)\n", unsafe, m_vel[unsafe].x(),
+                    m_vel[unsafe].y(), m_vel[unsafe].z());
+    }
+}
+
+void ChSystemGpuCpu::UpdateFrictionData() {
+    int nslots = (int)m_contact_partners.size();
+    bool multi_step = m_friction_mode == CHGPU_FRICTION_MODE::MULTI_STEP || m_use_mat_based;
+
+    // Release the slots of contacts which were not active during the last step
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int k = 0; k < nslots; k++) {
+        if (!m_contact_active[k]) {
+            m_contact_partners[k] = NULL_CHGPU_ID;
+            if (multi_step) {
+                m_contact_history[k] = ChVector<float>(0);
+                m_contact_duration[k] = 0;
+            }
+        } else {
+            m_contact_active[k] = 0;
+        }
+    }
+}
+
+double ChSystemGpuCpu::AdvanceSimulation(float duration) {
+    if (!m_initialized)
+        CHGPU_ERROR("ERROR! AdvanceSimulation called before Initialize.\n");
+
+    unsigned int nsteps = (unsigned int)std::round(duration / m_step_size);
+    bool friction = m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS;
+
+    ChTimer<double> timer;
+    timer.start();
+
+    for (unsigned int s = 0; s < nsteps; s++) {
+        UpdateBCPositions();
+        BuildCellList();
+        PrepareStep();
+
+        // Keep the accelerations of the previous step for the multistep integrators
+        std::swap(m_acc, m_acc_old);
+        std::swap(m_ang_acc, m_ang_acc_old);
+
+        ComputeForces();
+        FinalizeForces();
+        IntegrateSpheres();
+        if (friction)
+            UpdateFrictionData();
+
+        m_time += m_step_size;
+    }
+
+    timer.stop();
+    m_timer_total += timer();
+    m_sphere_updates += (unsigned long long)nsteps * m_pos.size();
+
+    return nsteps * m_step_size;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSystemGpuCpu::WriteParticleFile(const std::string& outfilename) const {
+    if (m_output_mode != CHGPU_OUTPUT_MODE::CSV)
+        return;
+
+    std::ofstream ptFile(outfilename, std::ios::out);
+
+    // Dump to a stream, write to file only at end
+    std::ostringstream outstrstream;
+    bool friction = m_friction_mode != CHGPU_FRICTION_MODE::FRICTIONLESS;
+
+    outstrstream << "x,y,z";
+    if (GET_OUTPUT_SETTING(VEL_COMPONENTS))
+        outstrstream << ",vx,vy,vz";
+    if (GET_OUTPUT_SETTING(ABSV))
+        outstrstream << ",absv";
+    if (GET_OUTPUT_SETTING(FIXITY))
+        outstrstream << ",fixed";
+    if (friction && GET_OUTPUT_SETTING(ANG_VEL_COMPONENTS))
+        outstrstream << ",wx,wy,wz";
+    if (GET_OUTPUT_SETTING(FORCE_COMPONENTS))
+        outstrstream << ",fx,fy,fz";
+    outstrstream << "\n";
+
+    for (size_t n = 0; n < m_pos.size(); n++) {
+        outstrstream << (float)m_pos[n].x() << "," << (float)m_pos[n].y() << "," << (float)m_pos[n].z();
+        if (GET_OUTPUT_SETTING(VEL_COMPONENTS))
+            outstrstream << "," << m_vel[n].x() << "," << m_vel[n].y() << "," << m_vel[n].z();
+        if (GET_OUTPUT_SETTING(ABSV))
+            outstrstream << "," << m_vel[n].Length();
+        if (GET_OUTPUT_SETTING(FIXITY))
+            outstrstream << "," << (int)m_fixed[n];
+        if (friction && GET_OUTPUT_SETTING(ANG_VEL_COMPONENTS))
+            outstrstream << "," << m_omega[n].x() << "," << m_omega[n].y() << "," << m_omega[n].z();
+        if (GET_OUTPUT_SETTING(FORCE_COMPONENTS)) {
+            ChVector<> f = (ChVector<>(m_acc.size() ? m_acc[n] : ChVector<float>(0)) - m_g) * m_mass;
+            outstrstream << "," << f.x() << "," << f.y() << "," << f.z();
+        }
+        outstrstream << "\n";
+    }
+
+    ptFile << outstrstream.str();
+}
+
+// =============================================================================
+
+ChSystemGpuMeshCpu::ChSystemGpuMeshCpu(float sphere_rad,
+                                       float density,
+                                       const ChVector<float>& boxDims,
+                                       ChVector<float> O)
+    : ChSystemGpuCpu(sphere_rad, density, boxDims, O),
+      mesh_verbosity(CHGPU_MESH_VERBOSITY::QUIET),
+      use_mesh_normals(false),
+      m_mesh_collision(true),
+      m_mesh_histmap_offset(0) {}
+
+unsigned int ChSystemGpuMeshCpu::AddMesh(std::shared_ptr<geometry::ChTriangleMeshConnected> mesh, float mass) {
+    unsigned int id = static_cast<unsigned int>(m_meshes.size());
+    m_meshes.push_back(mesh);
+    m_mesh_masses.push_back(mass);
+
+    return id;
+}
+
+unsigned int ChSystemGpuMeshCpu::AddMesh(const std::string& filename,
+                                         const ChVector<float>& translation,
+                                         const ChMatrix33<float>& rotscale,
+                                         float mass) {
+    auto mesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+    bool flag = mesh->LoadWavefrontMesh(filename, true, false);
+    if (!flag)
+        CHGPU_ERROR("ERROR! Mesh %s failed to load in!\n", filename.c_str());
+    if (mesh->getNumTriangles() == 0)
+        printf("WARNING: Mesh %s has no triangles!\n", filename.c_str());
+    mesh->Transform(translation, rotscale.cast<double>());
+
+    unsigned int id = static_cast<unsigned int>(m_meshes.size());
+    m_meshes.push_back(mesh);
+    m_mesh_masses.push_back(mass);
+
+    return id;
+}
+
+std::vector<unsigned int> ChSystemGpuMeshCpu::AddMeshes(const std::vector<std::string>& objfilenames,
+                                                        const std::vector<ChVector<float>>& translations,
+                                                        const std::vector<ChMatrix33<float>>& rotscales,
+                                                        const std::vector<float>& masses) {
+    unsigned int size = (unsigned int)objfilenames.size();
+    if (size != rotscales.size() || size != translations.size() || size != masses.size())
+        CHGPU_ERROR("ERROR! Mesh loading vectors must all have same size!\n");
+    if (size == 0)
+        printf("WARNING: No meshes provided!\n");
+
+    std::vector<unsigned int> ids(size);
+    for (unsigned int i = 0; i < size; i++) {
+        ids[i] = AddMesh(objfilenames[i], translations[i], rotscales[i], masses[i]);
+    }
+
+    return ids;
+}
+
+void ChSystemGpuMeshCpu::ApplyMeshMotion(unsigned int mesh_id,
+                                         const ChVector<>& pos,
+                                         const ChQuaternion<>& rot,
+                                         const ChVector<>& lin_vel,
+                                         const ChVector<>& ang_vel) {
+    auto& frame = m_mesh_frames[mesh_id];
+    frame.pos = pos;
+    frame.rot = ChMatrix33<>(rot);
+    frame.lin_vel = lin_vel;
+    frame.ang_vel = ang_vel;
+}
+
+void ChSystemGpuMeshCpu::Initialize() {
+    // Triangle soup, in the mesh frames
+    m_triangles.clear();
+    unsigned int family = 0;
+    for (const auto& mesh : m_meshes) {
+        for (int i = 0; i < mesh->getNumTriangles(); i++) {
+            geometry::ChTriangle tri = mesh->getTriangle(i);
+            Triangle t = {tri.p1, tri.p2, tri.p3, family};
+
+            // If we wish to correct surface orientation based on given vertex normals, rather than using RHR...
+            if (use_mesh_normals) {
+                int normal_i = mesh->m_face_n_indices.at(i).x();
+                ChVector<double> normal = mesh->m_normals.at(normal_i);
+                if (Vdot(Vcross(tri.p2 - tri.p1, tri.p3 - tri.p1), normal) < 0)
+                    std::swap(t.p2, t.p3);
+            }
+
+            m_triangles.push_back(t);
+        }
+        family++;
+        MESH_INFO_PRINTF("Done writing family %d\n", family);
+    }
+
+    MeshFrame frame;
+    frame.pos = ChVector<>(0);
+    frame.rot = ChMatrix33<>(1);
+    frame.lin_vel = ChVector<>(0);
+    frame.ang_vel = ChVector<>(0);
+    m_mesh_frames.assign(m_meshes.size(), frame);
+    m_mesh_forces.assign(m_meshes.size(), ChVector<>(0));
+    m_mesh_torques.assign(m_meshes.size(), ChVector<>(0));
+    m_tri_nodes.resize(3 * m_triangles.size());
+
+    if (m_use_mat_based)
+        ComputeMaterialParams(m_s2m);
+
+    ChSystemGpuCpu::Initialize();
+
+    // Triangle labels come right after the sphere labels and before the BC labels, so that they do not collide with
+    // the labels of BCs created after initialization (the number of meshes is fixed at this point)
+    m_mesh_histmap_offset = (unsigned int)m_pos.size() + 1;
+    m_bc_histmap_offset = m_mesh_histmap_offset + (unsigned int)m_meshes.size();
+
+    MESH_INFO_PRINTF("Done setting up %zu triangles in %zu meshes\n", m_triangles.size(), m_meshes.size());
+}
+
+void ChSystemGpuMeshCpu::PrepareStep() {
+    size_t nmeshes = m_meshes.size();
+    if (m_mesh_forces_thread.size() != (size_t)m_num_threads) {
+        m_mesh_forces_thread.resize(m_num_threads);
+        m_mesh_torques_thread.resize(m_num_threads);
+    }
+    for (int t = 0; t < m_num_threads; t++) {
+        m_mesh_forces_thread[t].assign(nmeshes, ChVector<>(0));
+        m_mesh_torques_thread[t].assign(nmeshes, ChVector<>(0));
+    }
+
+    m_cell_tri_start.assign(m_cell_start.size(), 0);
+    m_cell_triangles.clear();
+    if (!m_mesh_collision || m_triangles.empty())
+        return;
+
+    int ntri = (int)m_triangles.size();
+
+    // Transform triangles to the absolute frame
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int t = 0; t < ntri; t++) {
+        const auto& tri = m_triangles[t];
+        const auto& frame = m_mesh_frames[tri.family];
+        m_tri_nodes[3 * t + 0] = frame.pos + frame.rot * tri.p1;
+        m_tri_nodes[3 * t + 1] = frame.pos + frame.rot * tri.p2;
+        m_tri_nodes[3 * t + 2] = frame.pos + frame.rot * tri.p3;
+    }
+
+    // Bin the triangles in the cells overlapped by their bounding boxes, inflated by the sphere radius.
+    // Each sphere then only checks the triangles in its own cell, so each sphere-triangle pair is found once.
+    auto cell_range = [this](int t, int lo[3], int hi[3]) {
+        ChVector<> bmin = Vmin(Vmin(m_tri_nodes[3 * t], m_tri_nodes[3 * t + 1]), m_tri_nodes[3 * t + 2]);
+        ChVector<> bmax = Vmax(Vmax(m_tri_nodes[3 * t], m_tri_nodes[3 * t + 1]), m_tri_nodes[3 * t + 2]);
+        bmin = (bmin - m_radius - m_grid_min) / m_cell_size;
+        bmax = (bmax + m_radius - m_grid_min) / m_cell_size;
+        bool inside = true;
+        for (int d = 0; d < 3; d++) {
+            // the last cell extends to infinity, as the grid only covers the spheres
+            lo[d] = std::max((int)std::floor(bmin[d]), 0);
+            hi[d] = std::min((int)std::floor(bmax[d]), m_grid_dim[d] - 1);
+            if (bmax[d] < 0 || lo[d] > m_grid_dim[d] - 1)
+                inside = false;
+        }
+        return inside;
+    };
+
+    for (int t = 0; t < ntri; t++) {
+        int lo[3], hi[3];
+        if (!cell_range(t, lo, hi))
+            continue;
+        for (int z = lo[2]; z <= hi[2]; z++)
+            for (int y = lo[1]; y <= hi[1]; y++)
+                for (int x = lo[0]; x <= hi[0]; x++)
+                    m_cell_tri_start[(z * m_grid_dim[1] + y) * m_grid_dim[0] + x + 1]++;
+    }
+    for (size_t c = 0; c + 1 < m_cell_tri_start.size(); c++)
+        m_cell_tri_start[c + 1] += m_cell_tri_start[c];
+    m_cell_triangles.resize(m_cell_tri_start.back());
+    std::vector<unsigned int> fill(m_cell_tri_start.begin(), m_cell_tri_start.end() - 1);
+    for (int t = 0; t < ntri; t++) {
+        int lo[3], hi[3];
+        if (!cell_range(t, lo, hi))
+            continue;
+        for (int z = lo[2]; z <= hi[2]; z++)
+            for (int y = lo[1]; y <= hi[1]; y++)
+                for (int x = lo[0]; x <= hi[0]; x++)
+                    m_cell_triangles[fill[(z * m_grid_dim[1] + y) * m_grid_dim[0] + x]++] = t;
+    }
+}
+
+void ChSystemGpuMeshCpu::ComputeExtraForces(unsigned int i, int thread, ContactResult& res) {
+    if (m_cell_triangles.empty())
+        return;
+
+    unsigned int cell = m_sphere_cell[i];
+    unsigned int start = m_cell_tri_start[cell];
+    unsigned int end = m_cell_tri_start[cell + 1];
+    const ChVector<>& pos = m_pos[i];
+
+    for (unsigned int k = start; k < end; k++) {
+        unsigned int t = m_cell_triangles[k];
+        ChVector<> normal;
+        ChVector<> pt1;
+        double depth;
+        if (!FaceSphereCD(m_tri_nodes[3 * t], m_tri_nodes[3 * t + 1], m_tri_nodes[3 * t + 2], pos, m_radius, normal,
+                          depth, pt1))
+            continue;
+
+        unsigned int fam = m_triangles[t].family;
+        const auto& frame = m_mesh_frames[fam];
+        double mesh_mass = m_mesh_masses[fam];
+        double m_eff = m_mass * mesh_mass / (m_mass + mesh_mass);
+
+        // velocity of the mesh at the center of the contact volume
+        ChVector<> r = pt1 + normal * (depth / 2) - frame.pos;
+        ChVector<> surf_vel = frame.lin_vel + Vcross(frame.ang_vel, r);
+
+        ChVector<> force = SurfaceContact(i, m_mesh_histmap_offset + fam, m_s2m, m_eff, -depth, normal, surf_vel,
+                                          frame.ang_vel, m_radius + depth / 2, res);
+
+        // Force on the mesh is opposite the force on the sphere
+        m_mesh_forces_thread[thread][fam] -= force;
+        m_mesh_torques_thread[thread][fam] += Vcross(pt1 - frame.pos, -force);
+    }
+}
+
+void ChSystemGpuMeshCpu::FinalizeForces() {
+    for (size_t m = 0; m < m_meshes.size(); m++) {
+        m_mesh_forces[m] = ChVector<>(0);
+        m_mesh_torques[m] = ChVector<>(0);
+        for (int t = 0; t < m_num_threads; t++) {
+            m_mesh_forces[m] += m_mesh_forces_thread[t][m];
+            m_mesh_torques[m] += m_mesh_torques_thread[t][m];
+        }
+    }
+}
+
+void ChSystemGpuMeshCpu::CollectMeshContactForces(std::vector<ChVector<>>& forces, std::vector<ChVector<>>& torques) {
+    forces = m_mesh_forces;
+    torques = m_mesh_torques;
+}
+
+void ChSystemGpuMeshCpu::CollectMeshContactForces(int mesh, ChVector<>& force, ChVector<>& torque) {
+    force = m_mesh_forces[mesh];
+    torque = m_mesh_torques[mesh];
+}
+
+void ChSystemGpuMeshCpu::WriteMesh(const std::string& outfilename, unsigned int i) const {
+    if (m_output_mode == CHGPU_OUTPUT_MODE::NONE) {
+        return;
+    }
+    if (i >= m_meshes.size()) {
+        printf("WARNING: attempted to write mesh %u, yet only %zu meshes present. No mesh file generated.\n", i,
+               m_meshes.size());
+        return;
+    }
+
+    std::string ofile;
+    if (outfilename.substr(outfilename.length() - std::min(outfilename.length(), (size_t)4)) != ".vtk" &&
+        outfilename.substr(outfilename.length() - std::min(outfilename.length(), (size_t)4)) != ".VTK")
+        ofile = outfilename + ".vtk";
+    else
+        ofile = outfilename;
+    std::ofstream outfile(ofile, std::ios::out);
+    std::ostringstream ostream;
+    ostream << "# vtk DataFile Version 2.0\n";
+    ostream << "VTK from simulation\n";
+    ostream << "ASCII\n";
+    ostream << "\n\n";
+
+    ostream << "DATASET UNSTRUCTURED_GRID\n";
+
+    const auto& mmesh = m_meshes.at(i);
+    const auto& frame = m_mesh_frames.at(i);
+
+    // Writing vertices
+    ostream << "POINTS " << mmesh->getCoordsVertices().size() << " float" << std::endl;
+    for (auto& v : mmesh->getCoordsVertices()) {
+        ChVector<float> point(frame.pos + frame.rot * v);
+        ostream << point.x() << " " << point.y() << " " << point.z() << std::endl;
+    }
+
+    // Writing faces
+    ostream << "\n\n";
+    ostream << "CELLS " << mmesh->getIndicesVertexes().size() << " " << 4 * mmesh->getIndicesVertexes().size()
+            << std::endl;
+    for (auto& f : mmesh->getIndicesVertexes())
+        ostream << "3 " << f.x() << " " << f.y() << " " << f.z() << std::endl;
+
+    // Writing face types. Type 5 is generally triangles
+    ostream << "\n\n";
+    ostream << "CELL_TYPES " << mmesh->getIndicesVertexes().size() << std::endl;
+    auto nfaces = mmesh->getIndicesVertexes().size();
+    for (size_t j = 0; j < nfaces; j++)
+        ostream << "5 " << std::endl;
+
+    outfile << ostream.str();
+}
+
+void ChSystemGpuMeshCpu::WriteMeshes(const std::string& outfilename) const {
+    if (m_output_mode == CHGPU_OUTPUT_MODE::NONE) {
+        return;
+    }
+    if (m_meshes.size() == 0) {
+        printf(
+            "WARNING: attempted to write meshes to file yet no mesh found in system cache. No mesh file "
+            "generated.\n");
+        return;
+    }
+
+    std::vector<unsigned int> vertexOffset(m_meshes.size() + 1, 0);
+    size_t total_f = 0;
+    size_t total_v = 0;
+
+    std::string ofile;
+    if (outfilename.substr(outfilename.length() - std::min(outfilename.length(), (size_t)4)) != ".vtk" &&
+        outfilename.substr(outfilename.length() - std::min(outfilename.length(), (size_t)4)) != ".VTK")
+        ofile = outfilename + ".vtk";
+    else
+        ofile = outfilename;
+    std::ofstream outfile(ofile, std::ios::out);
+    std::ostringstream ostream;
+    ostream << "# vtk DataFile Version 2.0\n";
+    ostream << "VTK from simulation\n";
+    ostream << "ASCII\n";
+    ostream << "\n\n";
+
+    ostream << "DATASET UNSTRUCTURED_GRID\n";
+
+    // Prescan the V and F: to write all meshes to one file, we need vertex number offset info
+    unsigned int mesh_num = 0;
+    for (const auto& mmesh : m_meshes) {
+        vertexOffset[mesh_num + 1] = (unsigned int)mmesh->getCoordsVertices().size();
+        total_v += mmesh->getCoordsVertices().size();
+        total_f += mmesh->getIndicesVertexes().size();
+        mesh_num++;
+    }
+    for (unsigned int i = 1; i < m_meshes.size(); i++)
+        vertexOffset[i] = vertexOffset[i] + vertexOffset[i - 1];
+
+    // Writing vertices
+    ostream << "POINTS " << total_v << " float" << std::endl;
+    mesh_num = 0;
+    for (const auto& mmesh : m_meshes) {
+        const auto& frame = m_mesh_frames.at(mesh_num);
+        for (auto& v : mmesh->getCoordsVertices()) {
+            ChVector<float> point(frame.pos + frame.rot * v);
+            ostream << point.x() << " " << point.y() << " " << point.z() << std::endl;
+        }
+        mesh_num++;
+    }
+
+    // Writing faces
+    ostream << "\n\n";
+    ostream << "CELLS " << total_f << " " << 4 * total_f << std::endl;
+    mesh_num = 0;
+    for (const auto& mmesh : m_meshes) {
+        for (auto& f : mmesh->getIndicesVertexes()) {
+            ostream << "3 " << f.x() + vertexOffset[mesh_num] << " " << f.y() + vertexOffset[mesh_num] << " "
+                    << f.z() + vertexOffset[mesh_num] << std::endl;
+        }
+        mesh_num++;
+    }
+
+    // Writing face types. Type 5 is generally triangles
+    ostream << "\n\n";
+    ostream << "CELL_TYPES " << total_f << std::endl;
+    for (const auto& mmesh : m_meshes) {
+        auto nfaces = mmesh->getIndicesVertexes().size();
+        for (size_t j = 0; j < nfaces; j++)
+            ostream << "5 " << std::endl;
+    }
+
+    outfile << ostream.str();
+}
+
+}  // namespace gpu
+}  // namespace chrono
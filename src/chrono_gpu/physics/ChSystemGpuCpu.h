@@ -0,0 +1,610 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Multithreaded CPU implementation of the Chrono::Gpu monodisperse-sphere SMC
+// engine. Same public interface as ChSystemGpu / ChSystemGpuMesh, with all
+// quantities kept in user units.
+//
+// =============================================================================
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono_gpu/ChApiGpu.h"
+#include "chrono_gpu/ChGpuDefines.h"
+#include "chrono_gpu/physics/ChGpuBoundaryConditions.h"
+
+#include "chrono/core/ChVector.h"
+#include "chrono/core/ChMatrix33.h"
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+namespace chrono {
+namespace gpu {
+
+/// @addtogroup gpu_physics
+/// @{
+
+/// CPU implementation of a Chrono::Gpu system.
+/// Contacts between the (identical) spheres are found with a uniform cell list rebuilt at each step; sphere-sphere,
+/// sphere-boundary and sphere-mesh forces are evaluated one sphere at a time in an OpenMP parallel loop, so that no
+/// synchronization is needed and results do not depend on the number of threads. The contact models, friction history
+/// bookkeeping and time integrators are those of the CUDA implementation.
+class CH_GPU_API ChSystemGpuCpu {
+  public:
+    /// Construct system with given sphere radius, density, big domain dimensions and center.
+    ChSystemGpuCpu(float sphere_rad,
+                   float density,
+                   const ChVector<float>& boxDims,
+                   ChVector<float> O = ChVector<float>(0));
+
+    virtual ~ChSystemGpuCpu() {}
+
+    /// Set the number of OpenMP threads (default: number of available processors).
+    void SetNumThreads(int num_threads);
+
+    /// Set gravitational acceleration vector.
+    void SetGravitationalAcceleration(const ChVector<float>& g);
+
+    /// Set particle positions, velocities and angular velocities.
+    void SetParticles(const std::vector<ChVector<float>>& points,
+                      const std::vector<ChVector<float>>& vels = std::vector<ChVector<float>>(),
+                      const std::vector<ChVector<float>>& ang_vels = std::vector<ChVector<float>>());
+
+    /// Set the big domain to be fixed or not.
+    /// If fixed, it will ignore any given position functions.
+    void SetBDFixed(bool fixed) { m_BD_fixed = fixed; }
+
+    /// Set the center of the big box domain, relative to the origin of the coordinate system (default: [0,0,0]).
+    /// Note that the domain is always axis-aligned. The user must make sure that all SPH particles are inside this
+    /// domain. Must be called before Initialize().
+    void SetBDCenter(const ChVector<float>& O) { m_BD_center = O; }
+
+    /// Set flags indicating whether or not a particle is fixed.
+    /// MUST be called only once and MUST be called before Initialize.
+    void SetParticleFixed(const std::vector<bool>& fixed);
+
+    /// Set the output mode of the simulation (only CSV and NONE are supported).
+    void SetParticleOutputMode(CHGPU_OUTPUT_MODE mode);
+
+    /// Set output settings bit flags by bitwise ORing settings in CHGPU_OUTPUT_FLAGS.
+    void SetParticleOutputFlags(unsigned int flags) { output_flags = flags; }
+
+    /// Set timestep size.
+    void SetFixedStepSize(float size_UU) { m_step_size = size_UU; }
+
+    /// Set the time integration scheme for the system.
+    void SetTimeIntegrator(CHGPU_TIME_INTEGRATOR new_integrator) { m_integrator = new_integrator; }
+
+    /// Set friction formulation.
+    /// The frictionless setting uses a streamlined solver and avoids storing any physics information associated with
+    /// tangential motion.
+    void SetFrictionMode(CHGPU_FRICTION_MODE new_mode) { m_friction_mode = new_mode; }
+
+    /// Set rolling resistence formulation.
+    /// NOTE: This requires friction to be active, otherwise this setting will be ignored.
+    void SetRollingMode(CHGPU_ROLLING_MODE new_mode) { m_rolling_mode = new_mode; }
+
+    /// Set sphere-to-sphere static friction coefficient.
+    void SetStaticFrictionCoeff_SPH2SPH(float mu) { m_s2s.mu_s = mu; }
+    /// Set sphere-to-wall static friction coefficient.
+    void SetStaticFrictionCoeff_SPH2WALL(float mu) { m_s2w.mu_s = mu; }
+    /// Set sphere-to-sphere rolling friction coefficient -- units and use vary by rolling friction mode.
+    void SetRollingCoeff_SPH2SPH(float mu) { m_s2s.mu_r = mu; }
+    /// Set sphere-to-wall rolling friction coefficient -- units and use vary by rolling friction mode.
+    void SetRollingCoeff_SPH2WALL(float mu) { m_s2w.mu_r = mu; }
+
+    /// Set sphere-to-sphere spinning friction coefficient -- units and use vary by spinning friction mode.
+    void SetSpinningCoeff_SPH2SPH(float mu) { m_s2s.mu_spin = mu; }
+    /// Set sphere-to-wall spinning friction coefficient -- units and use vary by spinning friction mode.
+    void SetSpinningCoeff_SPH2WALL(float mu) { m_s2w.mu_spin = mu; }
+
+    /// Set sphere-to-sphere normal contact stiffness.
+    void SetKn_SPH2SPH(double someValue) { m_s2s.kn = someValue; }
+    /// Set sphere-to-wall normal contact stiffness.
+    void SetKn_SPH2WALL(double someValue) { m_s2w.kn = someValue; }
+
+    /// Set sphere-to-sphere normal damping coefficient.
+    void SetGn_SPH2SPH(double someValue) { m_s2s.gn = someValue; }
+    /// Set sphere-to-wall normal damping coefficient.
+    void SetGn_SPH2WALL(double someValue) { m_s2w.gn = someValue; }
+
+    /// Set sphere-to-sphere tangential contact stiffness.
+    void SetKt_SPH2SPH(double someValue) { m_s2s.kt = someValue; }
+    /// Set sphere-to-sphere tangential damping coefficient.
+    void SetGt_SPH2SPH(double someValue) { m_s2s.gt = someValue; }
+
+    /// Set sphere-to-wall tangential contact stiffness.
+    void SetKt_SPH2WALL(double someValue) { m_s2w.kt = someValue; }
+    /// Set sphere-to-wall tangential damping coefficient.
+    void SetGt_SPH2WALL(double someValue) { m_s2w.gt = someValue; }
+
+    /// Set the ratio of cohesion to gravity for monodisperse spheres. Assumes a constant cohesion model.
+    void SetCohesionRatio(float someValue) { m_cohesion_over_gravity = someValue; }
+
+    /// Set the ratio of adhesion to gravity for sphere to wall. Assumes a constant cohesion model.
+    void SetAdhesionRatio_SPH2WALL(float someValue) { m_s2w.adhesion_over_gravity = someValue; }
+
+    /// Use the material-based (Young's modulus, Poisson ratio, restitution) contact model.
+    void UseMaterialBasedModel(bool val) { m_use_mat_based = val; }
+
+    /// Set youngs modulus of spheres.
+    void SetYoungModulus_SPH(double someValue) { m_s2s.E = someValue; }
+    /// Set youngs modulus of boundary.
+    void SetYoungModulus_WALL(double someValue) { m_s2w.E = someValue; }
+
+    /// Set poisson ratio of sphere.
+    void SetPoissonRatio_SPH(double someValue) { m_s2s.nu = someValue; }
+    /// Set poisson ratio of boundary.
+    void SetPoissonRatio_WALL(double someValue) { m_s2w.nu = someValue; }
+
+    /// Set coefficient of restitution of spheres.
+    void SetRestitution_SPH(double someValue) { m_s2s.cor = someValue; }
+    /// Set coefficient of restitution of spheres.
+    void SetRestitution_WALL(double someValue) { m_s2w.cor = someValue; }
+
+    /// Safety check on velocity (user units). Exceeding it is reported as an error.
+    void SetMaxSafeVelocity(float max_vel) { m_max_safe_vel = max_vel; }
+
+    /// Set tuning psi factors for tuning the non-dimensionalization.
+    /// Accepted for interface compatibility with ChSystemGpu; the CPU implementation works in user units.
+    void SetPsiFactors(unsigned int psi_T, unsigned int psi_L, float psi_R = 1.f) {}
+    void SetPsiT(unsigned int psi_T) {}
+    void SetPsiL(unsigned int psi_L) {}
+    void SetPsiR(float psi_R = 1.f) {}
+
+    /// Set simualtion verbosity -- used to check on very large, slow simulations or debug.
+    void SetVerbosity(CHGPU_VERBOSITY level) { verbosity = level; }
+
+    /// Set the simulation time.
+    void SetSimTime(float time) { m_time = time; }
+
+    /// Create an axis-aligned sphere boundary condition.
+    /// A sphere boundary is a moving body, driven by gravity and by the reaction forces from the granular material.
+    size_t CreateBCSphere(const ChVector<float>& center,
+                          float radius,
+                          bool outward_normal,
+                          bool track_forces,
+                          float mass);
+
+    /// Create a Z-axis aligned cone boundary condition.
+    size_t CreateBCConeZ(const ChVector<float>& tip,
+                         float slope,
+                         float hmax,
+                         float hmin,
+                         bool outward_normal,
+                         bool track_forces);
+
+    /// Create a plane boundary condition.
+    size_t CreateBCPlane(const ChVector<float>& pos, const ChVector<float>& normal, bool track_forces);
+
+    /// Create a Z-axis aligned cylinder boundary condition.
+    size_t CreateBCCylinderZ(const ChVector<float>& center, float radius, bool outward_normal, bool track_forces);
+
+    /// Disable a boundary condition by its ID, returns false if the BC does not exist.
+    bool DisableBCbyID(size_t BC_id);
+
+    /// Enable a boundary condition by its ID, returns false if the BC does not exist.
+    bool EnableBCbyID(size_t BC_id);
+
+    /// Set the offset function of a boundary condition, returns false if the BC does not exist.
+    bool SetBCOffsetFunction(size_t BC_id, const GranPositionFunction& offset_function);
+
+    /// Prescribe the motion of the big domain, allows wavetank-style simulations.
+    void setBDWallsMotionFunction(const GranPositionFunction& pos_fn) { m_BD_offset_function = pos_fn; }
+
+    // -------------------------- A plethora of "Get" methods -------------------------------- //
+
+    /// Return current simulation time.
+    float GetSimTime() const { return m_time; }
+
+    /// Return the total number of particles in the system
+    size_t GetNumParticles() const { return m_pos.size(); }
+
+    /// Return the maximum Z position over all particles.
+    double GetMaxParticleZ() const;
+
+    /// Return the minimum Z position over all particles.
+    double GetMinParticleZ() const;
+
+    /// Return the number of particles that are higher than a given Z coordinate
+    unsigned int GetNumParticleAboveZ(float ZValue) const;
+
+    /// Return the number of particles that are higher than a given X coordinate
+    unsigned int GetNumParticleAboveX(float XValue) const;
+
+    /// Return the radius of a spherical particle.
+    float GetParticleRadius() const { return m_radius; }
+
+    /// Return particle position.
+    ChVector<float> GetParticlePosition(int nSphere) const;
+
+    /// Set particle position
+    void SetParticlePosition(int nSphere, const ChVector<double> pos);
+
+    /// Set particle velocity
+    void SetParticleVelocity(int nSphere, const ChVector<double> velo);
+
+    /// Return particle angular velocity.
+    ChVector<float> GetParticleAngVelocity(int nSphere) const;
+
+    /// Return particle linear acceleration.
+    ChVector<float> GetParticleLinAcc(int nSphere) const;
+
+    /// Return the fixity of a particle.
+    bool IsFixed(int nSphere) const { return m_fixed[nSphere] != 0; }
+
+    /// Return particle linear velocity.
+    ChVector<float> GetParticleVelocity(int nSphere) const;
+
+    /// Return the total kinetic energy of all particles.
+    float GetParticlesKineticEnergy() const;
+
+    /// Return position of BC plane.
+    ChVector<float> GetBCPlanePosition(size_t plane_id) const;
+
+    /// Return position of BC sphere.
+    ChVector<float> GetBCSpherePosition(size_t sphere_id) const;
+
+    /// Set position of BC sphere.
+    void SetBCSpherePosition(size_t sphere_bc_id, const ChVector<float>& pos);
+
+    /// Return velocity of BC sphere.
+    ChVector<float> GetBCSphereVelocity(size_t sphere_id) const;
+
+    /// Set velocity of BC sphere.
+    void SetBCSphereVelocity(size_t sphere_bc_id, const ChVector<float>& velo);
+
+    /// Set BC plane rotation.
+    void SetBCPlaneRotation(size_t plane_id, ChVector<double> center, ChVector<double> omega);
+
+    /// Get the reaction forces on a boundary by ID, returns false if the forces are invalid (bad BC type).
+    bool GetBCReactionForces(size_t BC_id, ChVector<float>& force) const;
+
+    /// Return the number of sphere-sphere contacts found at the last step.
+    int GetNumContacts() const { return m_num_contacts; }
+
+    /// Return the number of cells in the neighbour search grid (analogue of the number of subdomains).
+    unsigned int GetNumSDs() const { return (unsigned int)(m_cell_start.size() > 0 ? m_cell_start.size() - 1 : 0); }
+
+    /// Return the solver throughput, in sphere updates per second of wall-clock time.
+    double GetSphereUpdatesPerSecond() const;
+
+    // ------------------------------- End of "Get" methods -------------------------------//
+
+    /// Initialize simulation so that it can be advanced.
+    /// Must be called before AdvanceSimulation and after simulation parameters are set.
+    virtual void Initialize();
+
+    /// Advance simulation by duration in user units, return actual duration elapsed.
+    /// Requires Initialize() to have been called.
+    virtual double AdvanceSimulation(float duration);
+
+    /// Write particle positions according to the system output mode.
+    void WriteParticleFile(const std::string& outfilename) const;
+
+    /// Return the number of bytes allocated for the particle state, contact history and neighbour search.
+    size_t EstimateMemUsage() const;
+
+  protected:
+    /// Sphere-to-X contact parameters, in user units.
+    struct ContactParams {
+        double kn = 0;                      ///< normal stiffness
+        double gn = 0;                      ///< normal damping
+        double kt = 0;                      ///< tangential stiffness
+        double gt = 0;                      ///< tangential damping
+        float mu_s = 0;                     ///< static friction coefficient
+        float mu_r = 0;                     ///< rolling friction coefficient
+        float mu_spin = 0;                  ///< spinning friction coefficient (unused, as in the CUDA engine)
+        float adhesion_over_gravity = 0;    ///< adhesion acceleration, as a fraction of gravity
+        double E = 0;                       ///< Young's modulus of the partner material
+        double nu = 0;                      ///< Poisson ratio of the partner material
+        double cor = 0;                     ///< coefficient of restitution of the partner material
+        double E_eff = 0;                   ///< effective Young's modulus (derived)
+        double G_eff = 0;                   ///< effective shear modulus (derived)
+        double beta = 0;                    ///< damping factor from restitution (derived)
+    };
+
+    /// Per-sphere force and angular acceleration accumulator for one contact evaluation.
+    struct ContactResult {
+        ChVector<double> force;
+        ChVector<double> ang_acc;
+    };
+
+    /// Hook for derived classes: add contact forces on sphere i from additional geometry.
+    virtual void ComputeExtraForces(unsigned int i, int thread, ContactResult& res) {}
+
+    /// Hook for derived classes: prepare additional geometry at the beginning of a step.
+    virtual void PrepareStep() {}
+
+    /// Hook for derived classes: reduce per-thread data at the end of the force loop.
+    virtual void FinalizeForces() {}
+
+    /// Return the friction history slot of the contact between sphere i and the given partner.
+    unsigned int FindContactSlot(unsigned int i, unsigned int partner);
+
+    /// Compute the tangential force for the stiffness-based model (updates the history slot if needed).
+    ChVector<double> FrictionForce(unsigned int slot,
+                                   float mu,
+                                   double kt,
+                                   double gt,
+                                   double hertz,
+                                   double m_eff,
+                                   const ChVector<double>& normal_force,
+                                   const ChVector<double>& vrel_t,
+                                   const ChVector<double>& normal);
+
+    /// Compute the tangential force for the material-based model (updates the history slot).
+    ChVector<double> FrictionForceMatBased(unsigned int slot,
+                                           float mu,
+                                           double G_eff,
+                                           double sqrt_Rd,
+                                           double beta,
+                                           double m_eff,
+                                           const ChVector<double>& normal_force,
+                                           const ChVector<double>& vrel_t,
+                                           const ChVector<double>& normal);
+
+    /// Compute the angular acceleration due to rolling resistance.
+    ChVector<double> RollingAngAcc(float mu_r,
+                                   const ChVector<double>& normal_force,
+                                   const ChVector<double>& my_omega,
+                                   const ChVector<double>& their_omega,
+                                   const ChVector<double>& r_contact) const;
+
+    /// Return true if a material-based contact has lasted long enough for rolling resistance to apply.
+    bool EvaluateRollingFriction(double E_eff, double R_eff, double beta, double m_eff, float duration) const;
+
+    /// Add the contact with a flat surface (wall, plane, mesh triangle) to the sphere accumulator.
+    /// Returns the force applied on the sphere.
+    ChVector<double> SurfaceContact(unsigned int i,
+                                    unsigned int partner,
+                                    const ContactParams& cp,
+                                    double m_eff,
+                                    double penetration,
+                                    const ChVector<double>& normal,
+                                    const ChVector<double>& surf_vel,
+                                    const ChVector<double>& surf_omega,
+                                    double dist,
+                                    ContactResult& res);
+
+    void ComputeMaterialParams(ContactParams& cp) const;
+
+    double m_radius;   ///< sphere radius
+    double m_density;  ///< sphere density
+    double m_mass;     ///< sphere mass
+    double m_inertia_by_r;  ///< sphere moment of inertia divided by radius
+
+    ChVector<float> m_box_dims;   ///< dimensions of the big domain
+    ChVector<float> m_BD_center;  ///< center of the big domain
+    bool m_BD_fixed;
+    GranPositionFunction m_BD_offset_function;
+
+    ChVector<double> m_g;  ///< gravitational acceleration
+    float m_step_size;
+    float m_time;
+    float m_max_safe_vel;
+    int m_num_threads;
+
+    CHGPU_TIME_INTEGRATOR m_integrator;
+    CHGPU_FRICTION_MODE m_friction_mode;
+    CHGPU_ROLLING_MODE m_rolling_mode;
+    CHGPU_VERBOSITY verbosity;
+    CHGPU_OUTPUT_MODE m_output_mode;
+    unsigned int output_flags;
+
+    bool m_use_mat_based;
+    float m_cohesion_over_gravity;
+    ContactParams m_s2s;  ///< sphere-to-sphere parameters
+    ContactParams m_s2w;  ///< sphere-to-boundary parameters
+
+    // Particle state (structure of arrays)
+    std::vector<ChVector<double>> m_pos;
+    std::vector<ChVector<float>> m_vel;
+    std::vector<ChVector<float>> m_omega;
+    std::vector<ChVector<float>> m_acc;
+    std::vector<ChVector<float>> m_acc_old;
+    std::vector<ChVector<float>> m_ang_acc;
+    std::vector<ChVector<float>> m_ang_acc_old;
+    std::vector<char> m_fixed;
+
+    // Friction history: MAX_SPHERES_TOUCHED_BY_SPHERE slots per sphere
+    std::vector<unsigned int> m_contact_partners;
+    std::vector<ChVector<float>> m_contact_history;
+    std::vector<float> m_contact_duration;
+    std::vector<char> m_contact_active;
+
+    // Boundary conditions
+    std::vector<BC_type> m_bc_types;
+    std::vector<BC_params_t<double, double3>> m_bc_rest;  ///< BC parameters at rest (no offset)
+    std::vector<BC_params_t<double, double3>> m_bc;       ///< current BC parameters
+    std::vector<GranPositionFunction> m_bc_offset_functions;
+    std::vector<std::vector<ChVector<double>>> m_bc_forces_thread;  ///< per-thread reaction forces
+    std::vector<std::vector<ChVector<double>>> m_bc_torques_thread;  ///< per-thread reaction torques (sphere BCs)
+
+    // Cell list
+    ChVector<double> m_grid_min;
+    double m_cell_size;
+    int m_grid_dim[3];
+    std::vector<unsigned int> m_cell_start;
+    std::vector<unsigned int> m_cell_spheres;
+    std::vector<unsigned int> m_sphere_cell;
+
+    unsigned int m_num_contacts;          ///< number of sphere-sphere contacts at last step
+    unsigned int m_bc_histmap_offset;     ///< first friction history label used for boundary conditions
+    double m_timer_total;                 ///< wall-clock time spent in AdvanceSimulation
+    unsigned long long m_sphere_updates;  ///< number of sphere updates (spheres times steps)
+    bool m_initialized;
+
+  private:
+    void UpdateBCPositions();
+    void BuildCellList();
+    void ComputeForces();
+    void IntegrateSpheres();
+    void UpdateFrictionData();
+
+    ContactResult SphereContacts(unsigned int i, unsigned int& num_contacts);
+    void BoundaryContacts(unsigned int i, int thread, ContactResult& res);
+
+    size_t CreateBC(BC_type type, const BC_params_t<double, double3>& p);
+};
+
+/// CPU implementation of a Chrono::Gpu mesh system.
+/// Triangles are binned into the cells of the sphere neighbour grid at each step; sphere-triangle forces are evaluated
+/// in the per-sphere force loop and reduced per mesh with thread-local accumulators.
+class CH_GPU_API ChSystemGpuMeshCpu : public ChSystemGpuCpu {
+  public:
+    /// Construct system with given sphere radius, density, big domain dimensions and center.
+    ChSystemGpuMeshCpu(float sphere_rad,
+                       float density,
+                       const ChVector<float>& boxDims,
+                       ChVector<float> O = ChVector<float>(0));
+
+    ~ChSystemGpuMeshCpu() {}
+
+    /// Add a trimesh to the granular system.
+    /// The return value is a mesh identifier which can be used during the simulation to apply rigid body motion to the
+    /// mesh; see ApplyMeshMotion(). This function must be called before Initialize().
+    unsigned int AddMesh(std::shared_ptr<geometry::ChTriangleMeshConnected> mesh, float mass);
+
+    /// Add a trimesh from the specified Wavefront OBJ file to the granular system.
+    /// The return value is a mesh identifier which can be used during the simulation to apply rigid body motion to the
+    /// mesh; see ApplyMeshMotion(). This function must be called before Initialize().
+    unsigned int AddMesh(const std::string& filename,
+                         const ChVector<float>& translation,
+                         const ChMatrix33<float>& rotscale,
+                         float mass);
+
+    /// Add a set of trimeshes from Wavefront OBJ files into granular system.
+    /// The return value is a vector of mesh identifiers which can be used during the simulation to apply rigid body
+    /// motion to the mesh; see ApplyMeshMotion(). This function must be called before Initialize().
+    std::vector<unsigned int> AddMeshes(const std::vector<std::string>& objfilenames,
+                                        const std::vector<ChVector<float>>& translations,
+                                        const std::vector<ChMatrix33<float>>& rotscales,
+                                        const std::vector<float>& masses);
+
+    /// Enable/disable mesh collision (for all defined meshes).
+    void EnableMeshCollision(bool val) { m_mesh_collision = val; }
+
+    /// Enable/disable mesh normal-based orientation correction.
+    void UseMeshNormals(bool val) { use_mesh_normals = val; }
+
+    /// Apply rigid body motion to specified mesh.
+    void ApplyMeshMotion(unsigned int mesh_id,
+                         const ChVector<>& pos,
+                         const ChQuaternion<>& rot,
+                         const ChVector<>& lin_vel,
+                         const ChVector<>& ang_vel);
+
+    /// Return the number of meshes in the system.
+    unsigned int GetNumMeshes() const { return (unsigned int)m_meshes.size(); }
+
+    /// Return the specified mesh in the system.
+    std::shared_ptr<geometry::ChTriangleMeshConnected> GetMesh(unsigned int mesh_id) const { return m_meshes[mesh_id]; }
+
+    /// Return the mass of the specified mesh.
+    float GetMeshMass(unsigned int mesh_id) const { return m_mesh_masses[mesh_id]; }
+
+    /// Set sphere-to-mesh static friction coefficient.
+    void SetStaticFrictionCoeff_SPH2MESH(float mu) { m_s2m.mu_s = mu; }
+    /// Set sphere-to-mesh rolling friction coefficient.
+    void SetRollingCoeff_SPH2MESH(float mu) { m_s2m.mu_r = mu; }
+    /// Set sphere-to-mesh spinning friction coefficient.
+    void SetSpinningCoeff_SPH2MESH(float mu) { m_s2m.mu_spin = mu; }
+
+    /// Set sphere-to-mesh normal contact stiffness.
+    void SetKn_SPH2MESH(double someValue) { m_s2m.kn = someValue; }
+    /// Set sphere-to-mesh normal damping coefficient.
+    void SetGn_SPH2MESH(double someValue) { m_s2m.gn = someValue; }
+
+    /// Set sphere-to-mesh tangential contact stiffness.
+    void SetKt_SPH2MESH(double someValue) { m_s2m.kt = someValue; }
+    /// Set sphere-to-mesh tangential damping coefficient.
+    void SetGt_SPH2MESH(double someValue) { m_s2m.gt = someValue; }
+
+    /// Set material-based youngs modulus of mesh.
+    void SetYoungModulus_MESH(double someValue) { m_s2m.E = someValue; }
+    /// Set material-based poisson ratio of mesh.
+    void SetPoissonRatio_MESH(double someValue) { m_s2m.nu = someValue; }
+    /// Set material-based coefficient of restitution of mesh.
+    void SetRestitution_MESH(double someValue) { m_s2m.cor = someValue; }
+
+    /// Set the ratio of adhesion force to sphere weight for sphere to mesh.
+    void SetAdhesionRatio_SPH2MESH(float someValue) { m_s2m.adhesion_over_gravity = someValue; }
+
+    /// Set verbosity level of mesh operations.
+    void SetMeshVerbosity(CHGPU_MESH_VERBOSITY level) { mesh_verbosity = level; }
+
+    /// Initialize simulation so that it can be advanced.
+    /// Must be called before AdvanceSimulation and after simulation parameters are set.
+    virtual void Initialize() override;
+
+    /// Collect contact forces exerted on all meshes by the granular system.
+    void CollectMeshContactForces(std::vector<ChVector<>>& forces, std::vector<ChVector<>>& torques);
+
+    /// Collect contact forces exerted on the specified meshe by the granular system.
+    void CollectMeshContactForces(int mesh, ChVector<>& force, ChVector<>& torque);
+
+    /// Write visualization files for triangle meshes with current positions.
+    void WriteMesh(const std::string& outfilename, unsigned int i) const;
+
+    /// Write visualization files for triangle meshes with current positions.
+    void WriteMeshes(const std::string& outfilename) const;
+
+  private:
+    /// Triangle in the local frame of its mesh.
+    struct Triangle {
+        ChVector<double> p1, p2, p3;
+        unsigned int family;
+    };
+
+    /// Rigid body state of a mesh.
+    struct MeshFrame {
+        ChVector<double> pos;
+        ChMatrix33<double> rot;
+        ChVector<double> lin_vel;
+        ChVector<double> ang_vel;
+    };
+
+    virtual void ComputeExtraForces(unsigned int i, int thread, ContactResult& res) override;
+    virtual void PrepareStep() override;
+    virtual void FinalizeForces() override;
+
+    CHGPU_MESH_VERBOSITY mesh_verbosity;
+    bool use_mesh_normals;
+    bool m_mesh_collision;
+    ContactParams m_s2m;  ///< sphere-to-mesh parameters
+
+    std::vector<std::shared_ptr<geometry::ChTriangleMeshConnected>> m_meshes;
+    std::vector<float> m_mesh_masses;
+    std::vector<MeshFrame> m_mesh_frames;
+
+    std::vector<Triangle> m_triangles;                   ///< triangle soup, in mesh frames
+    std::vector<ChVector<double>> m_tri_nodes;            ///< triangle vertices in the absolute frame (3 per triangle)
+    std::vector<unsigned int> m_cell_tri_start;           ///< start of each cell in the cell-triangle list
+    std::vector<unsigned int> m_cell_triangles;           ///< triangles overlapping each cell
+    std::vector<std::vector<ChVector<double>>> m_mesh_forces_thread;   ///< per-thread forces on meshes
+    std::vector<std::vector<ChVector<double>>> m_mesh_torques_thread;  ///< per-thread torques on meshes
+    std::vector<ChVector<double>> m_mesh_forces;
+    std::vector<ChVector<double>> m_mesh_torques;
+    unsigned int m_mesh_histmap_offset;  ///< first friction history label used for meshes
+};
+
+/// @} gpu_physics
+
+}  // namespace gpu
+}  // namespace chrono
@@ -18,11 +18,14 @@
 #include "chrono/core/ChMathematics.h"
 #include "chrono/solver/ChDirectSolverLS.h"
 #include "chrono/solver/ChDirectSolverLScomplex.h"
+#include "chrono/solver/ChSupernodalLDLT.h"
+#include "chrono/utils/ChOpenMP.h"
 
 #include <Eigen/Core>
 #include <Eigen/SparseCore>
 #include <Eigen/Eigenvalues>
 
+#include <algorithm>
 #include <numeric>
 
 #include <Spectra/KrylovSchurGEigsSolver.h>
@@ -338,6 +341,267 @@ bool ChGeneralizedEigenvalueSolverLanczos::Solve(const ChSparseMatrix& M,  ///<
 
 
 
+ChGeneralizedEigenvalueSolverBlockLanczos::ChGeneralizedEigenvalueSolverBlockLanczos()
+    : m_block_size(4), m_num_threads(ChOMP::GetNumProcs()) {}
+
+bool ChGeneralizedEigenvalueSolverBlockLanczos::Solve(const ChSparseMatrix& M,  ///< input M matrix, n_v x n_v
+        const ChSparseMatrix& K,  ///< input K matrix, n_v x n_v
+        const ChSparseMatrix& Cq, ///< input Cq matrix of constraint jacobians, n_c x n_v
+        ChMatrixDynamic<std::complex<double>>& V,    ///< output matrix n x n_v with eigenvectors as columns, will be resized
+        ChVectorDynamic<std::complex<double>>& eig,  ///< output vector with n eigenvalues, will be resized.
+        ChVectorDynamic<double>& freq,  ///< output vector with n frequencies [Hz], as f=w/(2*PI), will be resized.
+        ChEigenvalueSolverSettings settings ///< optional: settings for the solver, or n. of desired lower eigenvalues. If =0, return all eigenvalues.)
+)  const
+{
+    int n_vars = (int)M.rows();
+    int n_constr = (int)Cq.rows();
+    int n_free = n_vars - n_constr;  // dimension of the constraint manifold (assuming independent constraints)
+    int n_modes = (settings.n_modes > 0 && settings.n_modes < n_free) ? settings.n_modes : n_free;
+    double sigma = settings.sigma.real();
+    int nthreads = m_num_threads;
+
+    // Shifted constrained matrix, factorized with the (multithreaded) supernodal LDLT solver.
+    // With this sign convention, the first n_vars pivots are positive and the constraint pivots negative.
+    //   S  =  [ K + sigma*M   Cq' ]
+    //         [ Cq             0  ]
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(K.nonZeros() + M.nonZeros() + 2 * Cq.nonZeros());
+    for (int k = 0; k < K.outerSize(); ++k)
+        for (ChSparseMatrix::InnerIterator it(K, k); it; ++it)
+            triplets.push_back(Eigen::Triplet<double>((int)it.row(), (int)it.col(), it.value()));
+    for (int k = 0; k < M.outerSize(); ++k)
+        for (ChSparseMatrix::InnerIterator it(M, k); it; ++it)
+            triplets.push_back(Eigen::Triplet<double>((int)it.row(), (int)it.col(), sigma * it.value()));
+    for (int k = 0; k < Cq.outerSize(); ++k)
+        for (ChSparseMatrix::InnerIterator it(Cq, k); it; ++it) {
+            triplets.push_back(Eigen::Triplet<double>(n_vars + (int)it.row(), (int)it.col(), it.value()));
+            triplets.push_back(Eigen::Triplet<double>((int)it.col(), n_vars + (int)it.row(), it.value()));
+        }
+    ChSparseMatrix S(n_vars + n_constr, n_vars + n_constr);
+    S.setFromTriplets(triplets.begin(), triplets.end());
+
+    ChSupernodalLDLT ldlt;
+    ldlt.SetNumThreads(nthreads);
+    ldlt.Analyze(S, n_vars);
+    if (!ldlt.Factorize(S)) {
+        if (settings.verbose)
+            GetLog() << "Block Lanczos eigenvalue solver FAILED. \n Error: factorization of shifted matrix failed. \n";
+        return false;
+    }
+    if (settings.verbose && ldlt.GetNumPerturbedPivots() > 0)
+        GetLog() << "Block Lanczos eigenvalue solver: shifted matrix is nearly singular, "
+                 << ldlt.GetNumPerturbedPivots() << " perturbed pivots. Consider changing the shift. \n";
+
+    // Y = M * X, parallel over the rows of M
+    auto multiply_M = [&](const Eigen::MatrixXd& X, Eigen::MatrixXd& Y) {
+        Y.resize(n_vars, X.cols());
+#pragma omp parallel for num_threads(nthreads)
+        for (int i = 0; i < n_vars; i++) {
+            for (int c = 0; c < X.cols(); c++) {
+                double sum = 0;
+                for (ChSparseMatrix::InnerIterator it(M, i); it; ++it)
+                    sum += it.value() * X(it.col(), c);
+                Y(i, c) = sum;
+            }
+        }
+    };
+
+    // Y = OP * X, with OP = (K + sigma*M)^-1 * M on the constraint manifold, i.e. solve S*[Y;l] = [M*X;0].
+    // The columns are solved in parallel. OP is self-adjoint in the M inner product.
+    int num_ops = 0;
+    auto apply_OP = [&](const Eigen::MatrixXd& X, Eigen::MatrixXd& Y) {
+        Eigen::MatrixXd MX;
+        multiply_M(X, MX);
+        Y.resize(n_vars, X.cols());
+#pragma omp parallel for num_threads(nthreads)
+        for (int c = 0; c < X.cols(); c++) {
+            ChVectorDynamic<> rhs = ChVectorDynamic<>::Zero(n_vars + n_constr);
+            rhs.head(n_vars) = MX.col(c);
+            ldlt.Solve(rhs);
+            Y.col(c) = rhs.head(n_vars);
+        }
+        num_ops += (int)X.cols();
+    };
+
+    int p = std::max(1, std::min(m_block_size, n_modes));
+    int max_dim = std::min(std::max(2 * n_modes + 2 * p, 20), n_free);  // maximum subspace size before a restart
+    int n_keep = std::min(n_modes + p, max_dim - p);                     // Ritz vectors kept at a restart
+
+    Eigen::MatrixXd Q(n_vars, max_dim + p);   // M-orthonormal Lanczos basis
+    Eigen::MatrixXd MQ(n_vars, max_dim + p);  // M * Q
+    Eigen::MatrixXd T = Eigen::MatrixXd::Zero(max_dim + p, max_dim + p);  // projected operator Q'*M*OP*Q
+
+    // Append to the basis the columns of W, M-orthogonalized against the current basis. Columns that are (nearly)
+    // linearly dependent are replaced by random vectors on the constraint manifold, while the manifold is not
+    // exhausted. Return the new basis size.
+    auto extend_basis = [&](Eigen::MatrixXd& W, int k) {
+        Eigen::MatrixXd MW;
+        multiply_M(W, MW);
+        Eigen::VectorXd ref = (W.cwiseProduct(MW)).colwise().sum().cwiseAbs().cwiseSqrt();
+        // block classical Gram-Schmidt, twice
+        for (int pass = 0; pass < 2 && k > 0; pass++) {
+            Eigen::MatrixXd C = MQ.leftCols(k).transpose() * W;
+            W -= Q.leftCols(k) * C;
+            MW -= MQ.leftCols(k) * C;
+        }
+        int k0 = k;
+        for (int c = 0; c < W.cols() && k < std::min(n_free, max_dim + p); c++) {
+            Eigen::VectorXd w = W.col(c);
+            Eigen::VectorXd mw = MW.col(c);
+            double ref_c = ref(c);
+            for (int attempt = 0; attempt < 2; attempt++) {
+                // orthogonalize against the vectors already accepted in this block (and, for random vectors,
+                // against the whole basis), twice
+                int j0 = (attempt == 0) ? k0 : 0;
+                for (int pass = 0; pass < 2; pass++) {
+                    for (int j = j0; j < k; j++) {
+                        double r = MQ.col(j).dot(w);
+                        w -= r * Q.col(j);
+                        mw -= r * MQ.col(j);
+                    }
+                }
+                double nrm = std::sqrt(std::abs(w.dot(mw)));
+                if (nrm > 1e-10 * ref_c && nrm > 0) {
+                    Q.col(k) = w / nrm;
+                    MQ.col(k) = mw / nrm;
+                    k++;
+                    break;
+                }
+                // deflation: try a random vector instead
+                Eigen::MatrixXd R = Eigen::MatrixXd::Random(n_vars, 1);
+                Eigen::MatrixXd OR;
+                apply_OP(R, OR);
+                Eigen::MatrixXd MOR;
+                multiply_M(OR, MOR);
+                w = OR.col(0);
+                mw = MOR.col(0);
+                ref_c = std::sqrt(std::abs(w.dot(mw)));
+            }
+        }
+        return k;
+    };
+
+    // Starting block: OP applied to random vectors, so that it lies on the constraint manifold
+    Eigen::MatrixXd X = Eigen::MatrixXd::Random(n_vars, p);
+    Eigen::MatrixXd W;
+    apply_OP(X, W);
+    int k = extend_basis(W, 0);
+
+    int a = 0;           // first column of the block to be processed
+    int n_restarts = 0;  // number of restarts
+    int nconv = 0;       // number of converged Ritz pairs
+    Eigen::VectorXd theta;
+    Eigen::MatrixXd Svec;
+    std::vector<int> order;
+
+    while (true) {
+        // Apply OP to the block [a, k) and compute the new columns of T
+        int b = k;
+        Eigen::MatrixXd Y;
+        apply_OP(Q.middleCols(a, b - a), Y);
+        T.block(0, a, b, b - a) = MQ.leftCols(b).transpose() * Y;
+
+        // Extend the basis with the next block
+        W = Y;
+        k = extend_basis(W, b);
+        if (k > b)
+            T.block(b, a, k - b, b - a) = MQ.middleCols(b, k - b).transpose() * Y;
+
+        // Symmetrize T, also setting the rows of the processed block coupling to the new block
+        for (int j = a; j < b; j++) {
+            for (int i = 0; i < b; i++)
+                T(j, i) = T(i, j) = 0.5 * (T(i, j) + T(j, i));
+            for (int i = b; i < k; i++)
+                T(j, i) = T(i, j);
+        }
+
+        // Rayleigh-Ritz on the processed basis [0, b); Ritz values with largest magnitude come first
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> ritz(T.topLeftCorner(b, b));
+        theta = ritz.eigenvalues();
+        Svec = ritz.eigenvectors();
+        order.resize(b);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int i, int j) { return std::abs(theta(i)) > std::abs(theta(j)); });
+
+        // Residual of the Ritz pairs: |T(b:k, 0:b) * s|
+        nconv = 0;
+        if (b >= n_modes) {
+            for (int i = 0; i < n_modes; i++) {
+                double res = (k > b) ? (T.block(b, 0, k - b, b) * Svec.col(order[i])).norm() : 0.0;
+                if (res > settings.tolerance * std::abs(theta(order[i])))
+                    break;
+                nconv++;
+            }
+        }
+        if (nconv == n_modes || k == b)
+            break;
+
+        // Thick restart: keep the n_keep best Ritz vectors and the last block
+        if (k > max_dim) {
+            if (++n_restarts > settings.max_iterations)
+                break;
+            int nb = k - b;
+            Eigen::MatrixXd S_keep(b, n_keep);
+            for (int i = 0; i < n_keep; i++)
+                S_keep.col(i) = Svec.col(order[i]);
+            Eigen::MatrixXd Q_keep = Q.leftCols(b) * S_keep;
+            Eigen::MatrixXd MQ_keep = MQ.leftCols(b) * S_keep;
+            Eigen::MatrixXd T_coupling = T.block(b, 0, nb, b) * S_keep;
+            Eigen::MatrixXd Q_last = Q.middleCols(b, nb);
+            Eigen::MatrixXd MQ_last = MQ.middleCols(b, nb);
+
+            Q.leftCols(n_keep) = Q_keep;
+            MQ.leftCols(n_keep) = MQ_keep;
+            Q.middleCols(n_keep, nb) = Q_last;
+            MQ.middleCols(n_keep, nb) = MQ_last;
+            T.setZero();
+            for (int i = 0; i < n_keep; i++)
+                T(i, i) = theta(order[i]);
+            T.block(n_keep, 0, nb, n_keep) = T_coupling;
+            T.block(0, n_keep, n_keep, nb) = T_coupling.transpose();
+            a = n_keep;
+            k = n_keep + nb;
+        } else {
+            a = b;
+        }
+    }
+
+    if (settings.verbose) {
+        if (nconv < n_modes) {
+            GetLog() << "Block Lanczos eigenvalue solver FAILED. \n";
+            GetLog() << " Error: not converging. \n";
+        } else {
+            GetLog() << "Block Lanczos eigenvalue solver successfull. \n";
+        }
+        GetLog() << " nconv   = " << nconv << "\n";
+        GetLog() << " nrestart= " << n_restarts << "\n";
+        GetLog() << " nops    = " << num_ops << "\n";
+        GetLog() << " n_modes = " << n_modes << "\n";
+        GetLog() << " n_vars  = " << n_vars << "\n";
+        GetLog() << " n_constr= " << n_constr << "\n";
+    }
+    if (nconv < n_modes)
+        return false;
+
+    // Return values. The Ritz value theta = 1/(w^2 + sigma) is mapped back to the eigenvalue -w^2 of the
+    // (-K, M) pencil, as for the other solvers.
+    int b = (int)theta.size();
+    V.setZero(n_vars, n_modes);
+    eig.setZero(n_modes);
+    freq.setZero(n_modes);
+
+    for (int i = 0; i < n_modes; i++) {
+        Eigen::VectorXd v = Q.leftCols(b) * Svec.col(order[i]);
+        V.col(i) = v.normalized();
+        double wsquare = 1.0 / theta(order[i]) - sigma;
+        eig(i) = -wsquare;
+        freq(i) = (1.0 / CH_C_2PI) * sqrt(std::max(wsquare, 0.0));
+    }
+
+    return true;
+}
+
+
 int ChModalSolveUndamped::Solve(
 	const ChSparseMatrix& M,  ///< input M matrix, n_v x n_v
 	const ChSparseMatrix& K,  ///< input K matrix, n_v x n_v  
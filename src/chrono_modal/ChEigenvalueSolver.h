@@ -18,6 +18,8 @@
 #include "chrono_modal/ChApiModal.h"
 #include "chrono/core/ChMatrix.h"
 #include <complex>
+#include <string>
+#include <typeinfo>
 
 namespace chrono {
 
@@ -78,6 +80,11 @@ public:
         ChVectorDynamic<double>& freq,  ///< output vector with n frequencies [Hz], as f=w/(2*PI), will be resized.
         ChEigenvalueSolverSettings settings = 0   ///< optional: settings for the solver, or n. of desired lower eigenvalues. If =0, return all eigenvalues.
     ) const = 0;
+
+    /// Return a string identifying the solver type and the solver parameters that affect the computed modes.
+    /// Used to key cached modes (see ChModalAssembly::SetModesCacheDirectory). The default implementation only
+    /// identifies the solver type; solvers with additional parameters must override it.
+    virtual std::string GetSignature() const { return typeid(*this).name(); }
 };
 
 /// Solves the undamped constrained eigenvalue problem with the Krylov-Schur iterative method.
@@ -100,6 +107,7 @@ public:
         ChEigenvalueSolverSettings settings = 0   ///< optional: settings for the solver, or n. of desired lower eigenvalues. If =0, return all eigenvalues.
     ) const override;
 
+    virtual std::string GetSignature() const override { return "KrylovSchur"; }
 };
 
 /// Solves the undamped constrained eigenvalue problem with the Lanczos iterative method. 
@@ -123,6 +131,45 @@ public:
         ChEigenvalueSolverSettings settings = 0   ///< optional: settings for the solver, or n. of desired lower eigenvalues. If =0, return all eigenvalues.
     ) const  override;
 
+    virtual std::string GetSignature() const override { return "Lanczos"; }
+};
+
+/// Solves the undamped constrained eigenvalue problem with a shift-invert block Lanczos method.
+/// It assumes that K and M matrices are symmetric, hence a real eigenvalue problem.
+/// Intended for large problems: the shifted constrained system [K+sigma*M, Cq'; Cq, 0] is factorized once with
+/// the multithreaded supernodal LDLT solver, and each Lanczos step applies the operator to a block of vectors,
+/// with the linear solves and the sparse matrix products performed in parallel (OpenMP).
+/// The Lanczos basis is fully reorthogonalized (in the M inner product) and thick-restarted when it reaches the
+/// maximum subspace size.
+class ChApiModal ChGeneralizedEigenvalueSolverBlockLanczos : public ChGeneralizedEigenvalueSolver {
+public:
+    ChGeneralizedEigenvalueSolverBlockLanczos();
+    virtual ~ChGeneralizedEigenvalueSolverBlockLanczos() {};
+
+    /// Set the number of vectors in a Lanczos block (default: 4).
+    void SetBlockSize(int block_size) { m_block_size = block_size; }
+
+    /// Set the number of OpenMP threads (default: number of processors).
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Solve the constrained eigenvalue problem (-wsquare*M + K)*x = 0 s.t. Cq*x = 0
+    /// If n_modes=0, return all eigenvalues, otherwise only the first lower n_modes.
+    virtual bool Solve(
+        const ChSparseMatrix& M,  ///< input M matrix, n_v x n_v
+        const ChSparseMatrix& K,  ///< input K matrix, n_v x n_v
+        const ChSparseMatrix& Cq, ///< input Cq matrix of constraint jacobians, n_c x n_v
+        ChMatrixDynamic<std::complex<double>>& V,    ///< output matrix n x n_v with eigenvectors as columns, will be resized
+        ChVectorDynamic<std::complex<double>>& eig,  ///< output vector with n eigenvalues, will be resized.
+        ChVectorDynamic<double>& freq,  ///< output vector with n frequencies [Hz], as f=w/(2*PI), will be resized.
+        ChEigenvalueSolverSettings settings = 0   ///< optional: settings for the solver, or n. of desired lower eigenvalues. If =0, return all eigenvalues.
+    ) const  override;
+
+    /// The block size is part of the signature. The number of threads is not, as it does not change the modes.
+    virtual std::string GetSignature() const override { return "BlockLanczos:" + std::to_string(m_block_size); }
+
+private:
+    int m_block_size;
+    int m_num_threads;
 };
 
 
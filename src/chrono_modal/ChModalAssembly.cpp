@@ -17,6 +17,14 @@
 #include "chrono/physics/ChSystem.h"
 #include "chrono/fea/ChNodeFEAxyz.h"
 #include "chrono/fea/ChNodeFEAxyzrot.h"
+#include "chrono/solver/ChSupernodalLDLT.h"
+#include "chrono/utils/ChOpenMP.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 namespace chrono {
 
@@ -44,6 +52,7 @@ ChModalAssembly::ChModalAssembly(const ChModalAssembly& other) : ChAssembly(othe
     modal_q_dtdt = other.modal_q_dtdt;
     custom_F_modal = other.custom_F_modal;
     internal_nodes_update = other.internal_nodes_update;
+    modes_cache_dir = other.modes_cache_dir;
     m_custom_F_modal_callback = other.m_custom_F_modal_callback;
     m_custom_F_full_callback = other.m_custom_F_full_callback;
 
@@ -129,19 +138,162 @@ void util_sparse_assembly_2x2symm(Eigen::SparseMatrix<double, Eigen::ColMajor, i
 }
 
 
+// Disk cache of computed modes.
+// The key is a FNV-1a hash of the sparsity patterns and values of M, K, Cq, and of the solver settings.
+
+static void util_hash_bytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+static void util_hash_sparse(uint64_t& hash, const ChSparseMatrix& A) {
+    int64_t dims[2] = {A.rows(), A.cols()};
+    util_hash_bytes(hash, dims, sizeof(dims));
+    for (int k = 0; k < A.outerSize(); ++k)
+        for (ChSparseMatrix::InnerIterator it(A, k); it; ++it) {
+            int64_t ij[2] = {it.row(), it.col()};
+            double val = it.value();
+            util_hash_bytes(hash, ij, sizeof(ij));
+            util_hash_bytes(hash, &val, sizeof(val));
+        }
+}
+
+static uint64_t util_modes_key(const ChSparseMatrix& M,
+                               const ChSparseMatrix& K,
+                               const ChSparseMatrix& Cq,
+                               const ChModalSolveUndamped& settings) {
+    uint64_t hash = 14695981039346656037ULL;
+    util_hash_sparse(hash, M);
+    util_hash_sparse(hash, K);
+    util_hash_sparse(hash, Cq);
+    for (const auto& span : settings.freq_spans) {
+        util_hash_bytes(hash, &span.nmodes, sizeof(span.nmodes));
+        util_hash_bytes(hash, &span.freq, sizeof(span.freq));
+    }
+    util_hash_bytes(hash, &settings.tolerance, sizeof(settings.tolerance));
+    util_hash_bytes(hash, &settings.max_iterations, sizeof(settings.max_iterations));
+    std::string solver = settings.msolver.GetSignature();
+    util_hash_bytes(hash, solver.data(), solver.size());
+    return hash;
+}
+
+static std::string util_modes_filename(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "modes_%016llx.dat", (unsigned long long)key);
+    return dir + "/" + name;
+}
+
+static const char util_modes_magic[8] = {'C', 'H', 'M', 'O', 'D', 'E', 'S', '1'};
+
+static bool util_modes_load(const std::string& filename,
+                            uint64_t key,
+                            ChMatrixDynamic<std::complex<double>>& V,
+                            ChVectorDynamic<std::complex<double>>& eig,
+                            ChVectorDynamic<double>& freq) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.good())
+        return false;
+    char magic[8];
+    uint64_t file_key;
+    int64_t dims[2];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&file_key), sizeof(file_key));
+    file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    if (!file.good() || std::memcmp(magic, util_modes_magic, sizeof(magic)) != 0 || file_key != key)
+        return false;
+    V.resize(dims[0], dims[1]);
+    eig.resize(dims[1]);
+    freq.resize(dims[1]);
+    file.read(reinterpret_cast<char*>(V.data()), V.size() * sizeof(std::complex<double>));
+    file.read(reinterpret_cast<char*>(eig.data()), eig.size() * sizeof(std::complex<double>));
+    file.read(reinterpret_cast<char*>(freq.data()), freq.size() * sizeof(double));
+    return file.good();
+}
+
+static void util_modes_save(const std::string& filename,
+                            uint64_t key,
+                            const ChMatrixDynamic<std::complex<double>>& V,
+                            const ChVectorDynamic<std::complex<double>>& eig,
+                            const ChVectorDynamic<double>& freq) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.good()) {
+        GetLog() << "WARNING: cannot write modes cache file " << filename << "\n";
+        return;
+    }
+    int64_t dims[2] = {V.rows(), V.cols()};
+    file.write(util_modes_magic, sizeof(util_modes_magic));
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    file.write(reinterpret_cast<const char*>(V.data()), V.size() * sizeof(std::complex<double>));
+    file.write(reinterpret_cast<const char*>(eig.data()), eig.size() * sizeof(std::complex<double>));
+    file.write(reinterpret_cast<const char*>(freq.data()), freq.size() * sizeof(double));
+}
+
+// Solve the constrained eigenvalue problem, using the disk cache in 'cache_dir' if not empty.
+static void util_solve_modes(const ChSparseMatrix& full_M,
+                             const ChSparseMatrix& full_K,
+                             const ChSparseMatrix& full_Cq,
+                             const ChModalSolveUndamped& n_modes_settings,
+                             const std::string& cache_dir,
+                             ChMatrixDynamic<std::complex<double>>& V,
+                             ChVectorDynamic<std::complex<double>>& eig,
+                             ChVectorDynamic<double>& freq) {
+    if (cache_dir.empty()) {
+        n_modes_settings.Solve(full_M, full_K, full_Cq, V, eig, freq);
+        return;
+    }
+    uint64_t key = util_modes_key(full_M, full_K, full_Cq, n_modes_settings);
+    std::string filename = util_modes_filename(cache_dir, key);
+    if (!util_modes_load(filename, key, V, eig, freq) || V.rows() != full_M.rows()) {
+        n_modes_settings.Solve(full_M, full_K, full_Cq, V, eig, freq);
+        util_modes_save(filename, key, V, eig, freq);
+    } else if (n_modes_settings.verbose) {
+        GetLog() << "Modes loaded from cache file " << filename << "\n";
+    }
+}
+
+// Check if two sparse matrices are identical (same sparsity pattern and values).
+static bool util_sparse_identical(const ChSparseMatrix& A, const ChSparseMatrix& B) {
+    if (A.rows() != B.rows() || A.cols() != B.cols() || A.nonZeros() != B.nonZeros())
+        return false;
+    for (int k = 0; k < A.outerSize(); ++k) {
+        ChSparseMatrix::InnerIterator itA(A, k);
+        ChSparseMatrix::InnerIterator itB(B, k);
+        for (; itA && itB; ++itA, ++itB) {
+            if (itA.col() != itB.col() || itA.value() != itB.value())
+                return false;
+        }
+        if (itA || itB)
+            return false;
+    }
+    return true;
+}
+
+
 
 //---------------------------------------------------------------------------------------
 
 void ChModalAssembly::SwitchModalReductionON(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq, 
     const ChModalSolveUndamped& n_modes_settings, 
     const ChModalDamping& damping_model
+) {
+    this->DoModalReduction(full_M, full_K, full_Cq, n_modes_settings, damping_model, nullptr);
+}
+
+void ChModalAssembly::DoModalReduction(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq, 
+    const ChModalSolveUndamped& n_modes_settings, 
+    const ChModalDamping& damping_model,
+    const SharedReduction* shared
 ) {
     if (is_modal)
         return;
 
 
-    // 1) compute eigenvalue and eigenvectors
-    this->ComputeModesExternalData(full_M, full_K, full_Cq, n_modes_settings);
+    // 1) compute eigenvalue and eigenvectors (or reuse those of an assembly with identical matrices)
+    this->DoComputeModes(full_M, full_K, full_Cq, n_modes_settings, shared);
 
 
     // 2) fetch initial x0 state of assembly, full not reduced
@@ -159,8 +311,58 @@ void ChModalAssembly::SwitchModalReductionON(ChSparseMatrix& full_M, ChSparseMat
     this->SetupModalData(this->modes_V.cols());
 
 
+    // 4) do the Herting reduction as in Sonneville, 2021 (or reuse the one of an assembly with identical matrices)
+    if (shared) {
+        this->Psi = shared->Psi;
+        this->modal_M = shared->modal_M;
+        this->modal_K = shared->modal_K;
+    } else {
+        this->ComputeHertingTransformation(full_M, full_K, full_Cq, this->modes_V, this->Psi);
 
-    // 4) do the Herting reduction as in Sonneville, 2021
+        // Modal reduction of the M K matrices
+        this->modal_M = Psi.transpose() * full_M * Psi;
+        this->modal_K = Psi.transpose() * full_K * Psi;
+    }
+
+    this->modal_R.setZero(modal_M.rows(), modal_M.cols()); // default R=0 , zero damping
+    
+    // Modal reduction of R damping matrix: compute using user-provided damping model 
+    damping_model.ComputeR(*this, this->modal_M, this->modal_K, Psi, this->modal_R);
+
+
+    // Reset to zero all the atomic masses of the boundary nodes because now their mass is represented by  this->modal_M
+    // NOTE! this should be made more generic and future-proof by implementing a virtual method ex. RemoveMass() in all ChPhysicsItem 
+    for (auto& body : bodylist) {
+            body->SetMass(0);
+            body->SetInertia(VNULL);
+    }
+    for (auto& item : this->meshlist) {
+        if (auto mesh = std::dynamic_pointer_cast<ChMesh>(item)) {
+            for (auto& node : mesh->GetNodes()) {
+                if (auto xyz = std::dynamic_pointer_cast<ChNodeFEAxyz>(node))
+                    xyz->SetMass(0);
+                if (auto xyzrot = std::dynamic_pointer_cast<ChNodeFEAxyzrot>(node)) {
+                    xyzrot->SetMass(0);
+                    xyzrot->GetInertia().setZero();
+                }
+            }
+        }
+    }
+    
+    // Invalidate results of the initial eigenvalue analysis because now the DOFs are different after reduction,
+    // to avoid that one could be tempted to plot those eigenmodes, which now are not exactly the ones of the reduced assembly.
+    this->modes_assembly_x0.resize(0);
+    this->modes_damping_ratio.resize(0);
+    this->modes_eig.resize(0);
+    this->modes_freq.resize(0);
+    this->modes_V.resize(0, 0);
+}
+
+void ChModalAssembly::ComputeHertingTransformation(const ChSparseMatrix& full_M, const ChSparseMatrix& full_K, const ChSparseMatrix& full_Cq, 
+    const ChMatrixDynamic<std::complex<double>>& V,
+    ChMatrixDynamic<>& mPsi
+) const {
+    int n_modes = (int)V.cols();
 
     ChSparseMatrix K_II = full_K.block(this->n_boundary_coords_w, this->n_boundary_coords_w, this->n_internal_coords_w, this->n_internal_coords_w);
     ChSparseMatrix K_IB = full_K.block(this->n_boundary_coords_w, 0,                         this->n_internal_coords_w, this->n_boundary_coords_w);
@@ -171,8 +373,8 @@ void ChModalAssembly::SwitchModalReductionON(ChSparseMatrix& full_M, ChSparseMat
     ChSparseMatrix Cq_B = full_Cq.block(0,                         0,                full_Cq.rows(), this->n_boundary_coords_w);
     ChSparseMatrix Cq_I = full_Cq.block(0, this->n_boundary_coords_w,                full_Cq.rows(), this->n_internal_coords_w);
 
-    ChMatrixDynamic<> V_B = this->modes_V.block(0                        , 0,                this->n_boundary_coords_w, this->n_modes_coords_w).real();
-    ChMatrixDynamic<> V_I = this->modes_V.block(this->n_boundary_coords_w, 0,                this->n_internal_coords_w, this->n_modes_coords_w).real();
+    ChMatrixDynamic<> V_B = V.block(0                        , 0,                this->n_boundary_coords_w, n_modes).real();
+    ChMatrixDynamic<> V_I = V.block(this->n_boundary_coords_w, 0,                this->n_internal_coords_w, n_modes).real();
 
     // K_IIc = [ K_II   Cq_I' ]
     //         [ Cq_I     0   ]
@@ -188,96 +390,69 @@ void ChModalAssembly::SwitchModalReductionON(ChSparseMatrix& full_M, ChSparseMat
     
     ChMatrixDynamic<> Psi_S(this->n_internal_coords_w, this->n_boundary_coords_w);
 
-    // avoid computing K_IIc^{-1}, effectively do n times a linear solve:
+    // avoid computing K_IIc^{-1}, effectively do n times a linear solve.
+    // K_IIc is factorized with the multithreaded supernodal LDLT solver and the solves for the columns of Psi_S and
+    // Psi_D run in parallel. The sparse QR solver is used as a fallback if K_IIc is not quasi-definite (e.g.
+    // redundant constraints).
+    int n_IIc = this->n_internal_coords_w + (int)full_Cq.rows();
+    int nthreads = ChOMP::GetNumProcs();
+
+    ChSparseMatrix K_IIc_r = K_IIc;
+    ChSupernodalLDLT ldlt;
+    ldlt.SetNumThreads(nthreads);
+    ldlt.Analyze(K_IIc_r, this->n_internal_coords_w);
+    bool use_ldlt = ldlt.Factorize(K_IIc_r) && ldlt.GetNumPerturbedPivots() == 0;
+
     Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> >   solver;
-    solver.analyzePattern(K_IIc);
-    solver.factorize(K_IIc); 
-    for (int i = 0; i < K_IB.cols(); ++i) { 
-        ChVectorDynamic<> rhs(this->n_internal_coords_w + full_Cq.rows());
-        if (Cq_B.rows())
-            rhs << K_IB.col(i).toDense(), Cq_B.col(i).toDense();
-        else
-            rhs << K_IB.col(i).toDense();
-        ChVectorDynamic<> x = solver.solve(rhs);
-        Psi_S.block(0,i, this->n_internal_coords_w, 1) = -x.head(this->n_internal_coords_w);
-    }
+    if (!use_ldlt) {
+        solver.analyzePattern(K_IIc);
+        solver.factorize(K_IIc);
+    }
+
+    // Solve K_IIc * x = -rhs for all columns of rhs, storing the head of x in the columns of Psi_X
+    auto solve_columns = [&](const ChMatrixDynamic<>& rhs, ChMatrixDynamic<>& Psi_X) {
+        if (use_ldlt) {
+#pragma omp parallel for num_threads(nthreads)
+            for (int i = 0; i < (int)rhs.cols(); ++i) {
+                ChVectorDynamic<> x = rhs.col(i);
+                ldlt.Solve(x);
+                Psi_X.col(i) = -x.head(this->n_internal_coords_w);
+            }
+        } else {
+            for (int i = 0; i < (int)rhs.cols(); ++i) {
+                ChVectorDynamic<> x = solver.solve(rhs.col(i));
+                Psi_X.col(i) = -x.head(this->n_internal_coords_w);
+            }
+        }
+    };
+
+    ChMatrixDynamic<> rhs_S(n_IIc, this->n_boundary_coords_w);
+    if (Cq_B.rows())
+        rhs_S << K_IB.toDense(), Cq_B.toDense();
+    else
+        rhs_S << K_IB.toDense();
+    solve_columns(rhs_S, Psi_S);
 
     // Matrix of dynamic modes (V_B and V_I already computed as constrained eigenmodes, 
     // but use K_IIc instead of K_II anyway, to reuse K_IIc already factored before)
     //
     // {Psi_D; foo} = - K_IIc^{-1} * {(M_IB * V_B + M_II * V_I) ; 0}
 
-    ChMatrixDynamic<> Psi_D(this->n_internal_coords_w, this->n_modes_coords_w);
+    ChMatrixDynamic<> Psi_D(this->n_internal_coords_w, n_modes);
 
-    for (int i = 0; i < this->n_modes_coords_w; ++i) { 
-        ChVectorDynamic<> rhs(this->n_internal_coords_w + full_Cq.rows());
-        rhs << (M_IB * V_B + M_II * V_I).col(i) , Eigen::VectorXd::Zero(full_Cq.rows()) ;
-        ChVectorDynamic<> x = solver.solve(rhs);
-        Psi_D.block(0,i, this->n_internal_coords_w, 1) = -x.head(this->n_internal_coords_w);
-    }
+    ChMatrixDynamic<> rhs_D(n_IIc, n_modes);
+    rhs_D << M_IB * V_B + M_II * V_I, Eigen::MatrixXd::Zero(full_Cq.rows(), n_modes);
+    solve_columns(rhs_D, Psi_D);
 
 
 
     // Psi = [ I     0    ]
     //       [Psi_S  Psi_D]
-    Psi.setZero(this->n_boundary_coords_w + this->n_internal_coords_w, this->n_boundary_coords_w + this->n_modes_coords_w);
+    mPsi.setZero(this->n_boundary_coords_w + this->n_internal_coords_w, this->n_boundary_coords_w + n_modes);
     //***TODO*** maybe prefer sparse Psi matrix, especially for upper blocks...
 
-    Psi << Eigen::MatrixXd::Identity(n_boundary_coords_w, n_boundary_coords_w), Eigen::MatrixXd::Zero(n_boundary_coords_w, n_modes_coords_w),
+    mPsi << Eigen::MatrixXd::Identity(n_boundary_coords_w, n_boundary_coords_w), Eigen::MatrixXd::Zero(n_boundary_coords_w, n_modes),
            Psi_S,                                                               Psi_D;
-
-    // Modal reduction of the M K matrices
-    this->modal_M = Psi.transpose() * full_M * Psi;
-    this->modal_K = Psi.transpose() * full_K * Psi;
-
-    this->modal_R.setZero(modal_M.rows(), modal_M.cols()); // default R=0 , zero damping
-    
-    // Modal reduction of R damping matrix: compute using user-provided damping model 
-    damping_model.ComputeR(*this, this->modal_M, this->modal_K, Psi, this->modal_R);
-
-
-    // Reset to zero all the atomic masses of the boundary nodes because now their mass is represented by  this->modal_M
-    // NOTE! this should be made more generic and future-proof by implementing a virtual method ex. RemoveMass() in all ChPhysicsItem 
-    for (auto& body : bodylist) {
-            body->SetMass(0);
-            body->SetInertia(VNULL);
-    }
-    for (auto& item : this->meshlist) {
-        if (auto mesh = std::dynamic_pointer_cast<ChMesh>(item)) {
-            for (auto& node : mesh->GetNodes()) {
-                if (auto xyz = std::dynamic_pointer_cast<ChNodeFEAxyz>(node))
-                    xyz->SetMass(0);
-                if (auto xyzrot = std::dynamic_pointer_cast<ChNodeFEAxyzrot>(node)) {
-                    xyzrot->SetMass(0);
-                    xyzrot->GetInertia().setZero();
-                }
-            }
-        }
-    }
-    
-    // Invalidate results of the initial eigenvalue analysis because now the DOFs are different after reduction,
-    // to avoid that one could be tempted to plot those eigenmodes, which now are not exactly the ones of the reduced assembly.
-    this->modes_assembly_x0.resize(0);
-    this->modes_damping_ratio.resize(0);
-    this->modes_eig.resize(0);
-    this->modes_freq.resize(0);
-    this->modes_V.resize(0, 0);
-
-    // Debug dump data. ***TODO*** remove
-    if (true) {
-        ChStreamOutAsciiFile fileP("dump_modal_Psi.dat");
-        fileP.SetNumFormat("%.12g");
-        StreamOUTdenseMatlabFormat(Psi, fileP);
-        ChStreamOutAsciiFile fileM("dump_modal_M.dat");
-        fileM.SetNumFormat("%.12g");
-        StreamOUTdenseMatlabFormat(this->modal_M, fileM);
-        ChStreamOutAsciiFile fileK("dump_modal_K.dat");
-        fileK.SetNumFormat("%.12g");
-        StreamOUTdenseMatlabFormat(this->modal_K, fileK);
-        ChStreamOutAsciiFile fileR("dump_modal_R.dat");
-        fileR.SetNumFormat("%.12g");
-        StreamOUTdenseMatlabFormat(this->modal_R, fileR);
-    }
 }
 
 void ChModalAssembly::SwitchModalReductionON(
@@ -300,6 +475,67 @@ void ChModalAssembly::SwitchModalReductionON(
     this->SwitchModalReductionON(full_M, full_K, full_Cq, n_modes_settings, damping_model);
 }
 
+void ChModalAssembly::SwitchModalReductionON(std::vector<std::shared_ptr<ChModalAssembly>>& assemblies,
+    const ChModalSolveUndamped& n_modes_settings, 
+    const ChModalDamping& damping_model
+) {
+    int n = (int)assemblies.size();
+
+    // 1) fetch the full (not reduced) mass and stiffness of each assembly, and group the assemblies with identical
+    //    matrices: only the first one of each group (the reference) is analyzed
+    std::vector<ChSparseMatrix> full_M(n);
+    std::vector<ChSparseMatrix> full_K(n);
+    std::vector<ChSparseMatrix> full_Cq(n);
+    std::vector<uint64_t> keys(n);
+    std::vector<int> reference(n, -1);  // index of the reference assembly
+    std::vector<int> references;        // indices of all reference assemblies
+
+    for (int i = 0; i < n; i++) {
+        if (assemblies[i]->is_modal)
+            continue;
+        assemblies[i]->GetSubassemblyMassMatrix(&full_M[i]);
+        assemblies[i]->GetSubassemblyStiffnessMatrix(&full_K[i]);
+        assemblies[i]->GetSubassemblyConstraintJacobianMatrix(&full_Cq[i]);
+        assemblies[i]->Setup();
+        keys[i] = util_modes_key(full_M[i], full_K[i], full_Cq[i], n_modes_settings);
+        for (int r : references) {
+            if (keys[r] == keys[i] && util_sparse_identical(full_M[r], full_M[i]) &&
+                util_sparse_identical(full_K[r], full_K[i]) && util_sparse_identical(full_Cq[r], full_Cq[i])) {
+                reference[i] = r;
+                break;
+            }
+        }
+        if (reference[i] < 0) {
+            reference[i] = i;
+            references.push_back(i);
+        }
+    }
+
+    // 2) compute the modes and the Herting transformation of the reference assemblies, in parallel.
+    //    This only reads the assemblies, so it is safe to process different assemblies concurrently.
+    int n_ref = (int)references.size();
+    std::vector<SharedReduction> shared(n_ref);
+
+#pragma omp parallel for schedule(dynamic) num_threads(ChOMP::GetNumProcs())
+    for (int j = 0; j < n_ref; j++) {
+        int i = references[j];
+        const auto& assembly = assemblies[i];
+        util_solve_modes(full_M[i], full_K[i], full_Cq[i], n_modes_settings, assembly->modes_cache_dir, shared[j].V,
+                         shared[j].eig, shared[j].freq);
+        assembly->ComputeHertingTransformation(full_M[i], full_K[i], full_Cq[i], shared[j].V, shared[j].Psi);
+        shared[j].modal_M = shared[j].Psi.transpose() * full_M[i] * shared[j].Psi;
+        shared[j].modal_K = shared[j].Psi.transpose() * full_K[i] * shared[j].Psi;
+    }
+
+    // 3) switch all assemblies to modal mode, reusing the reduction of their reference assembly
+    for (int i = 0; i < n; i++) {
+        if (reference[i] < 0)
+            continue;
+        int j = (int)(std::find(references.begin(), references.end(), reference[i]) - references.begin());
+        assemblies[i]->DoModalReduction(full_M[i], full_K[i], full_Cq[i], n_modes_settings, damping_model, &shared[j]);
+    }
+}
+
 
 void ChModalAssembly::SetupModalData(int nmodes_reduction) {
 
@@ -367,6 +603,10 @@ bool ChModalAssembly::ComputeModes(const ChModalSolveUndamped& n_modes_settings)
 }
 
 bool ChModalAssembly::ComputeModesExternalData(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq, const ChModalSolveUndamped& n_modes_settings) {
+    return this->DoComputeModes(full_M, full_K, full_Cq, n_modes_settings, nullptr);
+}
+
+bool ChModalAssembly::DoComputeModes(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq, const ChModalSolveUndamped& n_modes_settings, const SharedReduction* shared) {
 
     this->SetupInitial();
     this->Setup();
@@ -393,7 +633,14 @@ bool ChModalAssembly::ComputeModesExternalData(ChSparseMatrix& full_M, ChSparseM
     // - Must work with large dimension and sparse matrices only
     // - Must work also in free-free cases, with 6 rigid body modes at 0 frequency.
 
-    n_modes_settings.Solve(full_M, full_K, full_Cq, this->modes_V, this->modes_eig, this->modes_freq);
+    if (shared) {
+        this->modes_V = shared->V;
+        this->modes_eig = shared->eig;
+        this->modes_freq = shared->freq;
+    } else {
+        util_solve_modes(full_M, full_K, full_Cq, n_modes_settings, modes_cache_dir, this->modes_V, this->modes_eig,
+                         this->modes_freq);
+    }
 
     this->modes_damping_ratio.setZero(this->modes_freq.rows());
 
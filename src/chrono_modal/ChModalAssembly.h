@@ -21,6 +21,7 @@
 #include "chrono/physics/ChAssembly.h"
 #include "chrono/solver/ChVariablesGeneric.h"
 #include <complex>
+#include <string>
 
 namespace chrono {
 namespace modal {
@@ -93,6 +94,15 @@ class ChApiModal ChModalAssembly : public ChAssembly {
         const ChModalSolveUndamped& n_modes_settings,  ///< int as the n. of lower modes to keep, or a full ChModalSolveUndamped
         const ChModalDamping& damping_model = ChModalDampingNone());    ///< a damping model to use for the reduced model
 
+    /// Perform modal reduction on several assemblies, for example the blades of a wind turbine.
+    /// Assemblies with identical M, K and Cq matrices (same sparsity and values) share a single eigenvalue analysis and
+    /// Herting transformation, while the distinct reductions are computed in parallel (OpenMP).
+    /// Assemblies already in modal mode are skipped.
+    static void SwitchModalReductionON(
+        std::vector<std::shared_ptr<ChModalAssembly>>& assemblies,  ///< assemblies to be reduced
+        const ChModalSolveUndamped& n_modes_settings, ///< int as the n. of lower modes to keep, or a full ChModalSolveUndamped
+        const ChModalDamping& damping_model = ChModalDampingNone());   ///< a damping model to use for the reduced models
+
 
     /// For displaying modes, you can use the following function. It sets the state of this subassembly
     /// (both boundary and inner items) using the n-th eigenvector multiplied by a "amplitude" factor * sin(phase). 
@@ -126,12 +136,46 @@ class ChApiModal ChModalAssembly : public ChAssembly {
     /// In sake of high CPU performance, if no interest in visualization/postprocessing, one can disable this setting to false.
     void SetInternalNodesUpdate(bool mflag);
 
+    /// Set a directory where the modes computed by ComputeModes() and SwitchModalReductionON() are cached on disk
+    /// (default: empty, no caching). The cache file name is a hash of the M, K, Cq matrices, of the solver settings,
+    /// and of the eigensolver type and parameters (see ChGeneralizedEigenvalueSolver::GetSignature): if such a file
+    /// already exists, the modes are loaded from it and the eigenvalue solve is skipped, as when re-running a
+    /// simulation with an unchanged assembly.
+    void SetModesCacheDirectory(const std::string& dir) { modes_cache_dir = dir; }
+
+    /// Get the directory used for caching the computed modes (empty if caching is disabled).
+    const std::string& GetModesCacheDirectory() const { return modes_cache_dir; }
+
 
 protected:
     /// Resize modal matrices and hook up the variables to the  M K R block for the solver. To be used all times
     /// the n. of modes of modal reduction (n_modes_coords_w) is changed.
     void SetupModalData(int nmodes_reduction);
 
+    /// Results of a modal reduction which depend only on the M, K, Cq matrices, shared by identical assemblies.
+    struct SharedReduction {
+        ChMatrixDynamic<std::complex<double>> V;    // eigenvectors
+        ChVectorDynamic<std::complex<double>> eig;  // eigenvalues
+        ChVectorDynamic<double> freq;               // frequencies
+        ChMatrixDynamic<> Psi;                      // Herting transformation
+        ChMatrixDynamic<> modal_M;                  // reduced mass matrix
+        ChMatrixDynamic<> modal_K;                  // reduced stiffness matrix
+    };
+
+    /// Compute the undamped modes from M and K matrices, or copy them from 'shared' if not null.
+    bool DoComputeModes(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq,
+        const ChModalSolveUndamped& n_modes_settings, const SharedReduction* shared);
+
+    /// Perform modal reduction from M and K matrices, reusing the modes and the Herting transformation in 'shared'
+    /// if not null.
+    void DoModalReduction(ChSparseMatrix& full_M, ChSparseMatrix& full_K, ChSparseMatrix& full_Cq,
+        const ChModalSolveUndamped& n_modes_settings, const ChModalDamping& damping_model,
+        const SharedReduction* shared);
+
+    /// Compute the Herting transformation matrix Psi from the full M, K, Cq matrices and the constrained modes V.
+    void ComputeHertingTransformation(const ChSparseMatrix& full_M, const ChSparseMatrix& full_K, const ChSparseMatrix& full_Cq,
+        const ChMatrixDynamic<std::complex<double>>& V, ChMatrixDynamic<>& mPsi) const;
+
 public:
     /// Get the number of modal coordinates. Use SwitchModalReductionOn() to change it.
     int Get_n_modes_coords_w() { return n_modes_coords_w; }
@@ -583,6 +627,8 @@ public:
 
     bool internal_nodes_update;
 
+    std::string modes_cache_dir;  // directory for the disk cache of computed modes (empty: no caching)
+
     friend class ChSystem;
     friend class ChSystemMulticore;
     friend class ChSystemDistributed;
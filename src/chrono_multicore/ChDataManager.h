@@ -191,9 +191,6 @@ typedef blaze::Subvector<const DynamicVector<real>> ConstSubVectorType;
 //// Viscosity
 //#define _GAMMAFFV_ submatrix(_gamma_,  _num_uni_ + _num_bil_ + 3 * _num_rf_c_ + _num_fluid_,  3 * _num_fluid_)
 
-// The maximum number of shear history contacts per smaller body (SMC)
-#define max_shear 20
-
 /// @addtogroup multicore_module
 /// @{
 
@@ -212,8 +209,9 @@ struct host_container {
     custom_vector<real3> ct_body_torque;  ///< Total contact torque on these bodies
 
     // Contact shear history (SMC)
-    custom_vector<vec3> shear_neigh;          ///< Neighbor list of contacting bodies and shapes
-    custom_vector<real3> shear_disp;          ///< Accumulated shear displacement for each neighbor
+    // These vectors hold one entry for each contact at the last step, sorted by the key of the contact shape pair.
+    custom_vector<long long> shear_keys;      ///< Key of the shape pair in contact, per contact pair
+    custom_vector<real3> shear_disp;          ///< Accumulated shear displacement, per contact pair
     custom_vector<real> contact_relvel_init;  ///< Initial relative normal velocity manitude per contact pair
     custom_vector<real> contact_duration;     ///< Accumulated contact duration, per contact pair
 
@@ -120,6 +120,7 @@ class solver_settings {
         min_slip_vel = 1e-4;
         min_roll_vel = 1e-4;
         min_spin_vel = 1e-4;
+        use_simd_contact_forces = false;
         cache_step_length = false;
         precondition = false;
         use_power_iteration = false;
@@ -188,6 +189,9 @@ class solver_settings {
     real min_slip_vel;
     real min_roll_vel;
     real min_spin_vel;
+    /// Evaluate SMC contact forces in SIMD batches (Hooke and Hertz contact force models only; default: false).
+    /// If false, or for other contact force models, contact forces are evaluated one contact at a time.
+    bool use_simd_contact_forces;
 
     /// Along with setting the solver mode, the total number of iterations for each
     /// type of constraints can be performed.
@@ -185,6 +185,14 @@ class CH_MULTICORE_API ChSystemMulticore : public ChSystem {
     int current_threads;
 
   protected:
+    /// Load the new state of all rigid bodies at the end of a step into the Chrono bodies and the position and rotation
+    /// arrays of the data manager. Derived classes can override this to reorder the scatter (e.g. to overlap it with
+    /// communication).
+    virtual void ScatterRigidBodyStates();
+
+    /// Load the new state of the specified rigid body at the end of a step.
+    void ScatterRigidBodyState(int index);
+
     double old_timer, old_timer_cd;
     bool detect_optimal_threads;
 
@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Batched (SIMD) evaluation of SMC contact forces for Chrono::Multicore.
+//
+// The default kernel is compiled with the flags used for the rest of Chrono.
+// On x86 with GCC or Clang, AVX2 and AVX-512 kernels are also compiled (in
+// separate translation units, with the corresponding target flags) and the
+// widest kernel supported by the CPU is selected at run time.
+//
+// =============================================================================
+
+#define CH_SMC_KERNELS_NAMESPACE smc_kernels_default
+#include "chrono_multicore/solver/ChContactKernelsSMC_impl.h"
+
+namespace chrono {
+
+#ifdef CH_SMC_KERNELS_AVX2
+namespace smc_kernels_avx2 {
+int GetWidth();
+const char* GetInstructionSet();
+void CalcContactForces(const ChContactDataSMC& data, int start, int end);
+}  // namespace smc_kernels_avx2
+#endif
+
+#ifdef CH_SMC_KERNELS_AVX512
+namespace smc_kernels_avx512 {
+int GetWidth();
+const char* GetInstructionSet();
+void CalcContactForces(const ChContactDataSMC& data, int start, int end);
+}  // namespace smc_kernels_avx512
+#endif
+
+namespace {
+
+struct Kernel {
+    int width;
+    const char* instruction_set;
+    void (*calc)(const ChContactDataSMC& data, int start, int end);
+};
+
+// Select (once) the widest kernel supported by the CPU.
+// A variant is used only if it is wider than the default kernel.
+const Kernel& SelectKernel() {
+    static const Kernel kernel = []() {
+        Kernel k = {smc_kernels_default::GetWidth(), smc_kernels_default::GetInstructionSet(),
+                    smc_kernels_default::CalcContactForces};
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+    #ifdef CH_SMC_KERNELS_AVX2
+        if (__builtin_cpu_supports("avx2") && smc_kernels_avx2::GetWidth() > k.width)
+            k = {smc_kernels_avx2::GetWidth(), smc_kernels_avx2::GetInstructionSet(),
+                 smc_kernels_avx2::CalcContactForces};
+    #endif
+    #ifdef CH_SMC_KERNELS_AVX512
+        if (__builtin_cpu_supports("avx512f") && smc_kernels_avx512::GetWidth() > k.width)
+            k = {smc_kernels_avx512::GetWidth(), smc_kernels_avx512::GetInstructionSet(),
+                 smc_kernels_avx512::CalcContactForces};
+    #endif
+#endif
+        return k;
+    }();
+    return kernel;
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+bool ChContactKernelsSMC::Supports(ChSystemSMC::ContactForceModel contact_model) {
+    return contact_model == ChSystemSMC::ContactForceModel::Hooke ||
+           contact_model == ChSystemSMC::ContactForceModel::Hertz;
+}
+
+int ChContactKernelsSMC::GetWidth() {
+    return SelectKernel().width;
+}
+
+const char* ChContactKernelsSMC::GetInstructionSet() {
+    return SelectKernel().instruction_set;
+}
+
+void ChContactKernelsSMC::CalcContactForces(const ChContactDataSMC& data, int start, int end) {
+    SelectKernel().calc(data, start, end);
+}
+
+}  // end namespace chrono
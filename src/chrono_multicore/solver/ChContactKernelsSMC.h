@@ -0,0 +1,93 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Batched (SIMD) evaluation of SMC contact forces for Chrono::Multicore.
+//
+// =============================================================================
+
+#pragma once
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/multicore_math/ChMulticoreMath.h"
+
+#include "chrono_multicore/ChApiMulticore.h"
+
+namespace chrono {
+
+/// @addtogroup multicore_solver
+/// @{
+
+/// Input and output arrays for the evaluation of SMC contact forces.
+/// Per-body arrays are indexed by the body IDs in 'body_pairs'; per-contact arrays are indexed by contact; the contact
+/// history arrays are indexed through 'shear_index' (MultiStep tangential displacement mode only).
+struct ChContactDataSMC {
+    ChSystemSMC::ContactForceModel contact_model;         ///< contact force model
+    ChSystemSMC::AdhesionForceModel adhesion_model;       ///< adhesion force model
+    ChSystemSMC::TangentialDisplacementModel displ_mode;  ///< type of tangential displacement history
+    bool use_mat_props;                                   ///< flag specifying how coefficients are obtained
+    real char_vel;                                        ///< characteristic velocity (Hooke)
+    real min_roll_vel;                                    ///< threshold rolling velocity
+    real min_spin_vel;                                    ///< threshold spinning velocity
+    real dT;                                              ///< integration time step
+
+    const vec2* body_pairs;        ///< indices of the body pair in contact
+    const vec2* shape_pairs;       ///< indices of the shape pair in contact
+    const real* body_mass;         ///< body masses (per body)
+    const real3* pos;              ///< body positions
+    const quaternion* rot;         ///< body orientations
+    const real* vel;               ///< body linear and angular velocities
+    const real3* friction;         ///< eff. coefficients of friction (per contact)
+    const real2* modulus;          ///< eff. elasticity and shear modulus (per contact)
+    const real3* adhesion;         ///< eff. adhesion paramters (per contact)
+    const real* cr;                ///< eff. coefficient of restitution (per contact)
+    const real4* smc_params;       ///< eff. SMC parameters k and g (per contact)
+    const real3* pt1;              ///< point on shape 1 (per contact)
+    const real3* pt2;              ///< point on shape 2 (per contact)
+    const real3* normal;           ///< contact normal (per contact)
+    const real* depth;             ///< penetration depth (per contact)
+    const real* eff_radius;        ///< effective contact radius (per contact)
+    const int* shear_index;        ///< index of the contact history entry (per contact)
+    real3* shear_disp;             ///< accumulated shear displacement (per history entry)
+    real* contact_relvel_init;     ///< initial relative normal velocity (per history entry)
+    const real* contact_duration;  ///< duration of persistent contact (per history entry)
+
+    int* ct_bid;       ///< [output] body IDs (two per contact)
+    real3* ct_force;   ///< [output] body force (two per contact)
+    real3* ct_torque;  ///< [output] body torque (two per contact)
+};
+
+/// Batched evaluation of SMC contact forces.
+/// Contacts are processed in batches of GetWidth() contacts: the data of a batch is gathered in structure-of-arrays
+/// form, the forces are evaluated with one SIMD lane per contact (AVX-512, AVX/AVX2, or scalar), and the results are
+/// scattered back to the output arrays. On x86 with GCC or Clang, the widest instruction set supported by the CPU is
+/// selected at run time; otherwise, the instruction set is the one for which Chrono is configured. The results are identical (up to
+/// roundoff) to those of the per-contact evaluation. Only the Hooke and Hertz contact force models are supported.
+class CH_MULTICORE_API ChContactKernelsSMC {
+  public:
+    /// Return true if the batched kernel supports the specified contact force model.
+    static bool Supports(ChSystemSMC::ContactForceModel contact_model);
+
+    /// Return the number of contacts processed per SIMD batch.
+    static int GetWidth();
+
+    /// Return the name of the instruction set used by the batched kernel.
+    static const char* GetInstructionSet();
+
+    /// Calculate the contact forces and torques for the contacts in the range [start, end).
+    static void CalcContactForces(const ChContactDataSMC& data, int start, int end);
+};
+
+/// @} multicore_solver
+
+}  // end namespace chrono
@@ -0,0 +1,23 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// AVX2 variant of the batched SMC contact force kernel.
+// The kernel is only called if the CPU supports this instruction set (see
+// ChContactKernelsSMC.cpp).
+//
+// =============================================================================
+
+#define CH_SMC_KERNELS_TARGET_AVX2
+#define CH_SMC_KERNELS_NAMESPACE smc_kernels_avx2
+#include "chrono_multicore/solver/ChContactKernelsSMC_impl.h"
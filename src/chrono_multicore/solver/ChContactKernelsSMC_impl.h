@@ -0,0 +1,710 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Implementation of the batched (SIMD) evaluation of SMC contact forces.
+//
+// The contact force calculation follows function_CalcContactForces (see
+// ChIterativeSolverMulticoreSMC.cpp), with all data-dependent branches replaced
+// by per-lane selections. Contacts in a batch are gathered from the AoS input
+// arrays into SoA buffers (one SIMD lane per contact), evaluated, and the
+// results scattered back to the output arrays.
+//
+// This file is included by one translation unit per kernel variant, each of
+// which defines CH_SMC_KERNELS_NAMESPACE to a distinct namespace name. If
+// CH_SMC_KERNELS_TARGET_AVX2 or CH_SMC_KERNELS_TARGET_AVX512 is defined, the
+// kernel functions are compiled for that instruction set through a target
+// pragma, while the included headers are compiled for the default target, so
+// that no inline function shared with the rest of Chrono is emitted with
+// instructions the CPU may not support. Otherwise, the instruction set is the
+// one for which Chrono is configured.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "chrono_multicore/solver/ChContactKernelsSMC.h"
+
+#if defined(CH_SMC_KERNELS_TARGET_AVX512) || defined(CH_SMC_KERNELS_TARGET_AVX2) || defined(__AVX512F__) || \
+    defined(__AVX__)
+    #include <immintrin.h>
+#endif
+
+#if defined(CH_SMC_KERNELS_TARGET_AVX512)
+    #define CH_SMC_KERNELS_AVX512_LANES
+    #if defined(__clang__)
+        #pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+    #else
+        #pragma GCC push_options
+        #pragma GCC target("avx512f")
+    #endif
+#elif defined(CH_SMC_KERNELS_TARGET_AVX2)
+    #define CH_SMC_KERNELS_AVX_LANES "AVX2"
+    #if defined(__clang__)
+        #pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+    #else
+        #pragma GCC push_options
+        #pragma GCC target("avx2")
+    #endif
+#elif defined(__AVX512F__)
+    #define CH_SMC_KERNELS_AVX512_LANES
+#elif defined(__AVX2__)
+    #define CH_SMC_KERNELS_AVX_LANES "AVX2"
+#elif defined(__AVX__)
+    #define CH_SMC_KERNELS_AVX_LANES "AVX"
+#endif
+
+namespace chrono {
+namespace CH_SMC_KERNELS_NAMESPACE {
+
+// -----------------------------------------------------------------------------
+// SIMD lane types.
+// A vreal holds one double per contact in a batch and a vmask holds one flag
+// per contact.
+// -----------------------------------------------------------------------------
+
+#if defined(CH_SMC_KERNELS_AVX512_LANES)
+
+const int kWidth = 8;
+const char* kInstructionSet = "AVX-512";
+
+struct vreal {
+    vreal() {}
+    vreal(__m512d a) : v(a) {}
+    vreal(double a) : v(_mm512_set1_pd(a)) {}
+    __m512d v;
+};
+
+typedef __mmask8 vmask;
+
+inline vreal Load(const double* p) {
+    return _mm512_load_pd(p);
+}
+inline void Store(double* p, vreal a) {
+    _mm512_store_pd(p, a.v);
+}
+inline vreal operator+(vreal a, vreal b) {
+    return _mm512_add_pd(a.v, b.v);
+}
+inline vreal operator-(vreal a, vreal b) {
+    return _mm512_sub_pd(a.v, b.v);
+}
+inline vreal operator*(vreal a, vreal b) {
+    return _mm512_mul_pd(a.v, b.v);
+}
+inline vreal operator/(vreal a, vreal b) {
+    return _mm512_div_pd(a.v, b.v);
+}
+inline vreal Sqrt(vreal a) {
+    return _mm512_sqrt_pd(a.v);
+}
+inline vreal Abs(vreal a) {
+    return _mm512_abs_pd(a.v);
+}
+inline vmask operator<(vreal a, vreal b) {
+    return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ);
+}
+inline vmask operator<=(vreal a, vreal b) {
+    return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ);
+}
+inline vmask operator>(vreal a, vreal b) {
+    return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ);
+}
+inline vmask And(vmask a, vmask b) {
+    return a & b;
+}
+inline bool Any(vmask m) {
+    return m != 0;
+}
+inline vreal Select(vmask m, vreal a, vreal b) {
+    return _mm512_mask_blend_pd(m, b.v, a.v);
+}
+
+#elif defined(CH_SMC_KERNELS_AVX_LANES)
+
+const int kWidth = 4;
+const char* kInstructionSet = CH_SMC_KERNELS_AVX_LANES;
+
+struct vreal {
+    vreal() {}
+    vreal(__m256d a) : v(a) {}
+    vreal(double a) : v(_mm256_set1_pd(a)) {}
+    __m256d v;
+};
+
+struct vmask {
+    __m256d m;
+};
+
+inline vreal Load(const double* p) {
+    return _mm256_load_pd(p);
+}
+inline void Store(double* p, vreal a) {
+    _mm256_store_pd(p, a.v);
+}
+inline vreal operator+(vreal a, vreal b) {
+    return _mm256_add_pd(a.v, b.v);
+}
+inline vreal operator-(vreal a, vreal b) {
+    return _mm256_sub_pd(a.v, b.v);
+}
+inline vreal operator*(vreal a, vreal b) {
+    return _mm256_mul_pd(a.v, b.v);
+}
+inline vreal operator/(vreal a, vreal b) {
+    return _mm256_div_pd(a.v, b.v);
+}
+inline vreal Sqrt(vreal a) {
+    return _mm256_sqrt_pd(a.v);
+}
+inline vreal Abs(vreal a) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+}
+inline vmask operator<(vreal a, vreal b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)};
+}
+inline vmask operator<=(vreal a, vreal b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)};
+}
+inline vmask operator>(vreal a, vreal b) {
+    return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)};
+}
+inline vmask And(vmask a, vmask b) {
+    return {_mm256_and_pd(a.m, b.m)};
+}
+inline bool Any(vmask m) {
+    return _mm256_movemask_pd(m.m) != 0;
+}
+inline vreal Select(vmask m, vreal a, vreal b) {
+    return _mm256_blendv_pd(b.v, a.v, m.m);
+}
+
+#else
+
+const int kWidth = 1;
+const char* kInstructionSet = "none";
+
+struct vreal {
+    vreal() {}
+    vreal(double a) : v(a) {}
+    double v;
+};
+
+typedef bool vmask;
+
+inline vreal Load(const double* p) {
+    return *p;
+}
+inline void Store(double* p, vreal a) {
+    *p = a.v;
+}
+inline vreal operator+(vreal a, vreal b) {
+    return a.v + b.v;
+}
+inline vreal operator-(vreal a, vreal b) {
+    return a.v - b.v;
+}
+inline vreal operator*(vreal a, vreal b) {
+    return a.v * b.v;
+}
+inline vreal operator/(vreal a, vreal b) {
+    return a.v / b.v;
+}
+inline vreal Sqrt(vreal a) {
+    return std::sqrt(a.v);
+}
+inline vreal Abs(vreal a) {
+    return std::abs(a.v);
+}
+inline vmask operator<(vreal a, vreal b) {
+    return a.v < b.v;
+}
+inline vmask operator<=(vreal a, vreal b) {
+    return a.v <= b.v;
+}
+inline vmask operator>(vreal a, vreal b) {
+    return a.v > b.v;
+}
+inline vmask And(vmask a, vmask b) {
+    return a && b;
+}
+inline bool Any(vmask m) {
+    return m;
+}
+inline vreal Select(vmask m, vreal a, vreal b) {
+    return m ? a : b;
+}
+
+#endif
+
+inline vreal operator-(vreal a) {
+    return vreal(0.0) - a;
+}
+
+// Evaluate x^e lane by lane (no SIMD counterpart of pow).
+inline vreal Pow(vreal a, double e) {
+    alignas(64) double tmp[kWidth];
+    Store(tmp, a);
+    for (int k = 0; k < kWidth; k++)
+        tmp[k] = std::pow(tmp[k], e);
+    return Load(tmp);
+}
+
+// -----------------------------------------------------------------------------
+// 3D vectors and quaternions with one SIMD lane per contact.
+// -----------------------------------------------------------------------------
+
+struct vreal3 {
+    vreal x, y, z;
+};
+
+struct vquaternion {
+    vreal w, x, y, z;
+};
+
+inline vreal3 operator+(const vreal3& a, const vreal3& b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+inline vreal3 operator-(const vreal3& a, const vreal3& b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+inline vreal3 operator-(const vreal3& a) {
+    return {-a.x, -a.y, -a.z};
+}
+inline vreal3 operator*(vreal s, const vreal3& a) {
+    return {s * a.x, s * a.y, s * a.z};
+}
+inline vreal3 operator/(const vreal3& a, vreal s) {
+    return {a.x / s, a.y / s, a.z / s};
+}
+inline vreal Dot(const vreal3& a, const vreal3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+inline vreal3 Cross(const vreal3& b, const vreal3& c) {
+    return {b.y * c.z - b.z * c.y, b.z * c.x - b.x * c.z, b.x * c.y - b.y * c.x};
+}
+inline vreal Length(const vreal3& a) {
+    return Sqrt(Dot(a, a));
+}
+inline vreal3 Select(vmask m, const vreal3& a, const vreal3& b) {
+    return {Select(m, a.x, b.x), Select(m, a.y, b.y), Select(m, a.z, b.z)};
+}
+
+// Rotate the vector v by the quaternion q (same formula as Rotate for real3).
+inline vreal3 Rotate(const vreal3& v, const vquaternion& q) {
+    vreal3 qv = {q.x, q.y, q.z};
+    vreal3 t = 2.0 * Cross(qv, v);
+    return v + q.w * t + Cross(qv, t);
+}
+
+// Rotate the vector v by the conjugate of the quaternion q.
+inline vreal3 RotateT(const vreal3& v, const vquaternion& q) {
+    return Rotate(v, {q.w, -q.x, -q.y, -q.z});
+}
+
+// -----------------------------------------------------------------------------
+// SoA buffers for one batch of contacts.
+// -----------------------------------------------------------------------------
+
+struct alignas(64) ContactBatch {
+    // Body states
+    double pos1[3][kWidth];
+    double pos2[3][kWidth];
+    double rot1[4][kWidth];
+    double rot2[4][kWidth];
+    double v1[3][kWidth];
+    double v2[3][kWidth];
+    double o1[3][kWidth];
+    double o2[3][kWidth];
+    double mass1[kWidth];
+    double mass2[kWidth];
+
+    // Contact geometry and composite material properties
+    double pt1[3][kWidth];
+    double pt2[3][kWidth];
+    double normal[3][kWidth];
+    double depth[kWidth];
+    double eff_radius[kWidth];
+    double friction[3][kWidth];
+    double modulus[2][kWidth];
+    double adhesion[3][kWidth];
+    double loge[kWidth];
+    double smc_params[4][kWidth];
+
+    // Contact history (MultiStep only); shear displacement and initial velocity are also outputs
+    double sign[kWidth];
+    double shear_disp[3][kWidth];
+    double relvel_init[kWidth];
+    double duration[kWidth];
+
+    // Outputs
+    double force[3][kWidth];
+    double torque1[3][kWidth];
+    double torque2[3][kWidth];
+};
+
+inline void Put(double (&a)[3][kWidth], int k, const real3& v) {
+    a[0][k] = v.x;
+    a[1][k] = v.y;
+    a[2][k] = v.z;
+}
+inline real3 Get(const double (&a)[3][kWidth], int k) {
+    return real3(a[0][k], a[1][k], a[2][k]);
+}
+inline vreal3 Load(const double (&a)[3][kWidth]) {
+    return {Load(a[0]), Load(a[1]), Load(a[2])};
+}
+inline void Store(double (&a)[3][kWidth], const vreal3& v) {
+    Store(a[0], v.x);
+    Store(a[1], v.y);
+    Store(a[2], v.z);
+}
+inline vquaternion Load(const double (&a)[4][kWidth]) {
+    return {Load(a[0]), Load(a[1]), Load(a[2]), Load(a[3])};
+}
+
+// -----------------------------------------------------------------------------
+// Gather the data of the contacts [start, start+n) into the batch buffers.
+// Unused lanes replicate the last contact in the batch.
+// -----------------------------------------------------------------------------
+
+void Gather(const ChContactDataSMC& d, int start, int n, ContactBatch& b) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    bool multi_step = d.displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep;
+
+    for (int k = 0; k < kWidth; k++) {
+        int index = start + std::min(k, n - 1);
+        int b1 = d.body_pairs[index].x;
+        int b2 = d.body_pairs[index].y;
+
+        Put(b.pos1, k, d.pos[b1]);
+        Put(b.pos2, k, d.pos[b2]);
+        for (int i = 0; i < 4; i++) {
+            b.rot1[i][k] = d.rot[b1][i];
+            b.rot2[i][k] = d.rot[b2][i];
+        }
+        for (int i = 0; i < 3; i++) {
+            b.v1[i][k] = d.vel[b1 * 6 + i];
+            b.v2[i][k] = d.vel[b2 * 6 + i];
+            b.o1[i][k] = d.vel[b1 * 6 + 3 + i];
+            b.o2[i][k] = d.vel[b2 * 6 + 3 + i];
+        }
+        b.mass1[k] = d.body_mass[b1];
+        b.mass2[k] = d.body_mass[b2];
+
+        Put(b.pt1, k, d.pt1[index]);
+        Put(b.pt2, k, d.pt2[index]);
+        Put(b.normal, k, d.normal[index]);
+        b.depth[k] = d.depth[index];
+        b.eff_radius[k] = d.eff_radius[index];
+        Put(b.friction, k, d.friction[index]);
+        b.modulus[0][k] = d.modulus[index].x;
+        b.modulus[1][k] = d.modulus[index].y;
+        Put(b.adhesion, k, d.adhesion[index]);
+        for (int i = 0; i < 4; i++)
+            b.smc_params[i][k] = d.smc_params[index][i];
+
+        // Logarithm of the coefficient of restitution, clamped as in the per-contact evaluation
+        real cr_eff = d.cr[index];
+        real loge = (cr_eff < eps) ? std::log(eps) : std::log(cr_eff);
+        if (d.contact_model == ChSystemSMC::ContactForceModel::Hooke)
+            loge = (cr_eff > 1 - eps) ? std::log(1 - eps) : loge;
+        b.loge[k] = loge;
+
+        if (multi_step) {
+            int ctSaveId = d.shear_index[index];
+            b.sign[k] = (d.shape_pairs[index].x > d.shape_pairs[index].y) ? 1.0 : -1.0;
+            Put(b.shear_disp, k, d.shear_disp[ctSaveId]);
+            b.relvel_init[k] = d.contact_relvel_init[ctSaveId];
+            b.duration[k] = d.contact_duration[ctSaveId];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Calculate the contact forces and torques for all lanes of a batch.
+// -----------------------------------------------------------------------------
+
+void Evaluate(const ChContactDataSMC& d, ContactBatch& b) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    const vreal3 zero = {0.0, 0.0, 0.0};
+    bool multi_step = d.displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep;
+
+    // Kinematic information
+    vquaternion rot1 = Load(b.rot1);
+    vquaternion rot2 = Load(b.rot2);
+    vreal3 normal = Load(b.normal);
+
+    vreal3 pt1_loc = RotateT(Load(b.pt1) - Load(b.pos1), rot1);
+    vreal3 pt2_loc = RotateT(Load(b.pt2) - Load(b.pos2), rot2);
+
+    vreal3 o_body1 = Load(b.o1);
+    vreal3 o_body2 = Load(b.o2);
+
+    vreal3 vel1 = Load(b.v1) + Rotate(Cross(o_body1, pt1_loc), rot1);
+    vreal3 vel2 = Load(b.v2) + Rotate(Cross(o_body2, pt2_loc), rot2);
+
+    vreal3 relvel = vel2 - vel1;
+    vreal relvel_n_mag = Dot(relvel, normal);
+    vreal3 relvel_t = relvel - relvel_n_mag * normal;
+
+    // Composite material properties
+    vreal mass1 = Load(b.mass1);
+    vreal mass2 = Load(b.mass2);
+    vreal m_eff = mass1 * mass2 / (mass1 + mass2);
+
+    vreal mu_eff = Load(b.friction[0]);
+    vreal muRoll_eff = Load(b.friction[1]);
+    vreal muSpin_eff = Load(b.friction[2]);
+
+    vreal E_eff = Load(b.modulus[0]);
+    vreal G_eff = Load(b.modulus[1]);
+
+    vreal eff_radius = Load(b.eff_radius);
+
+    // Tangential displacement and contact history
+    vreal t_contact = 0.0;
+    vreal relvel_init = Abs(relvel_n_mag);
+    vreal delta_n = -Load(b.depth);
+    vreal3 delta_t = zero;
+    vreal sign = 1.0;
+    vreal3 shear_disp = zero;
+
+    if (d.displ_mode != ChSystemSMC::TangentialDisplacementModel::None)
+        delta_t = vreal(d.dT) * relvel_t;
+
+    if (multi_step) {
+        // For a new contact, record the initial relative normal velocity.
+        vreal relvel_init_saved = Load(b.relvel_init);
+        relvel_init_saved = Select(relvel_init_saved < 0.0, relvel_init, relvel_init_saved);
+        Store(b.relvel_init, relvel_init_saved);
+
+        // Increment the shear displacement (stored relative to the shape with larger ID) and project it onto the
+        // current contact plane.
+        sign = Load(b.sign);
+        shear_disp = Load(b.shear_disp) + sign * delta_t;
+        shear_disp = shear_disp - Dot(shear_disp, normal) * normal;
+        delta_t = sign * shear_disp;
+
+        relvel_init = Select(relvel_init_saved < d.char_vel, d.char_vel, relvel_init_saved);
+        t_contact = Load(b.duration);
+    }
+
+    // Stiffness and damping coefficients
+    vreal kn, kt, gn, gt, kn_simple, gn_simple;
+
+    switch (d.contact_model) {
+        case ChSystemSMC::ContactForceModel::Hooke:
+            if (d.use_mat_props) {
+                vreal tmp_k = (16.0 / 15) * Sqrt(eff_radius) * E_eff;
+                vreal char_vel = multi_step ? relvel_init : vreal(d.char_vel);
+                vreal v2 = char_vel * char_vel;
+                vreal tmp = CH_C_PI / Load(b.loge);
+                vreal tmp_g = 1.0 + tmp * tmp;
+                kn = tmp_k * Pow(m_eff * v2 / tmp_k, 1.0 / 5);
+                kt = kn;
+                gn = Sqrt(4.0 * m_eff * kn / tmp_g);
+                gt = gn;
+            } else {
+                kn = Load(b.smc_params[0]);
+                kt = Load(b.smc_params[1]);
+                gn = m_eff * Load(b.smc_params[2]);
+                gt = m_eff * Load(b.smc_params[3]);
+            }
+
+            kn_simple = kn;
+            gn_simple = gn;
+
+            break;
+
+        default:  // Hertz
+            if (d.use_mat_props) {
+                vreal sqrt_Rd = Sqrt(eff_radius * delta_n);
+                vreal Sn = 2.0 * E_eff * sqrt_Rd;
+                vreal St = 8.0 * G_eff * sqrt_Rd;
+                vreal loge = Load(b.loge);
+                vreal beta = loge / Sqrt(loge * loge + CH_C_PI * CH_C_PI);
+                kn = (2.0 / 3) * Sn;
+                kt = St;
+                gn = (-2 * std::sqrt(5.0 / 6)) * beta * Sqrt(Sn * m_eff);
+                gt = (-2 * std::sqrt(5.0 / 6)) * beta * Sqrt(St * m_eff);
+            } else {
+                vreal tmp = eff_radius * Sqrt(delta_n);
+                kn = tmp * Load(b.smc_params[0]);
+                kt = tmp * Load(b.smc_params[1]);
+                gn = tmp * m_eff * Load(b.smc_params[2]);
+                gt = tmp * m_eff * Load(b.smc_params[3]);
+            }
+
+            kn_simple = kn / Sqrt(delta_n);
+            gn_simple = gn / Sqrt(Sqrt(delta_n));
+
+            break;
+    }
+
+    // Normal and tangential contact forces, with Coulomb limit on the tangential force.
+    // If there is shear displacement due to contact history, it is scaled consistently with the tangential force.
+    vreal forceN_mag = kn * delta_n - gn * relvel_n_mag;
+    vreal3 forceT_stiff = kt * delta_t;
+    vreal3 forceT_damp = gt * relvel_t;
+
+    vreal3 forceT = forceT_stiff + forceT_damp;
+    vreal forceT_mag = Length(forceT);
+    vreal delta_t_mag = Length(delta_t);
+    vreal forceT_slide = mu_eff * Abs(forceN_mag);
+    vmask slide = forceT_mag > forceT_slide;
+    vmask scale = And(slide, delta_t_mag > eps);
+    forceT = Select(scale, (forceT_slide / forceT_mag) * forceT, Select(slide, zero, forceT));
+
+    if (multi_step) {
+        shear_disp = Select(scale, sign * ((forceT - forceT_damp) / kt), shear_disp);
+        Store(b.shear_disp, shear_disp);
+    }
+
+    vreal3 force = forceN_mag * normal - forceT;
+
+    // Induced torques (in local frames)
+    vreal3 torque1_loc = Cross(pt1_loc, RotateT(force, rot1));
+    vreal3 torque2_loc = Cross(pt2_loc, RotateT(force, rot2));
+
+    // No rolling and spinning friction for contacts shorter than a typical collision (unless critically damped or
+    // over-damped).
+    vreal d_coeff = gn_simple / (2.0 * m_eff * Sqrt(kn_simple / m_eff));
+    vreal t_collision = CH_C_PI * Sqrt(m_eff / (kn_simple * (1.0 - d_coeff * d_coeff)));
+    vmask short_contact = And(d_coeff < 1.0, t_contact <= t_collision);
+    muRoll_eff = Select(short_contact, 0.0, muRoll_eff);
+    muSpin_eff = Select(short_contact, 0.0, muSpin_eff);
+
+    vreal3 v_rot = Rotate(Cross(o_body2, pt2_loc), rot2) - Rotate(Cross(o_body1, pt1_loc), rot1);
+    vreal3 rel_o = Rotate(o_body2, rot2) - Rotate(o_body1, rot1);
+
+    // Rolling friction torque
+    vreal3 m_roll1 = zero;
+    vreal3 m_roll2 = zero;
+
+    vreal v_rot_mag = Length(v_rot);
+    vmask rolling = And(v_rot_mag > d.min_roll_vel, muRoll_eff > eps);
+    if (Any(rolling)) {
+        m_roll1 = Select(rolling, muRoll_eff * Cross(forceN_mag * pt1_loc, RotateT(v_rot, rot1)) / v_rot_mag, zero);
+        m_roll2 = Select(rolling, muRoll_eff * Cross(forceN_mag * pt2_loc, RotateT(v_rot, rot2)) / v_rot_mag, zero);
+    }
+
+    // Spinning friction torque
+    vreal3 m_spin1 = zero;
+    vreal3 m_spin2 = zero;
+
+    vreal rel_o_mag = Length(rel_o);
+    vmask spinning = And(rel_o_mag > d.min_spin_vel, muSpin_eff > eps);
+    if (Any(spinning)) {
+        vreal r1 = Length(pt1_loc);
+        vreal r2 = Length(pt2_loc);
+        vreal xc = (r1 * r1 - r2 * r2) / (2.0 * (r1 + r2 - delta_n)) + 0.5 * (r1 + r2 - delta_n);
+        vreal rc = r1 * r1 - xc * xc;
+        rc = Select(rc < eps, eps, Sqrt(rc));
+
+        vreal3 spin = Dot(rel_o, forceN_mag * normal) * normal;
+        m_spin1 = Select(spinning, muSpin_eff * rc * RotateT(spin, rot1) / rel_o_mag, zero);
+        m_spin2 = Select(spinning, muSpin_eff * rc * RotateT(spin, rot2) / rel_o_mag, zero);
+    }
+
+    // Adhesion
+    switch (d.adhesion_model) {
+        case ChSystemSMC::AdhesionForceModel::Constant:
+            force = force - Load(b.adhesion[0]) * normal;
+            break;
+        case ChSystemSMC::AdhesionForceModel::DMT:
+            force = force - (Load(b.adhesion[1]) * Sqrt(eff_radius)) * normal;
+            break;
+        case ChSystemSMC::AdhesionForceModel::Perko:
+            force = force - (Load(b.adhesion[2]) * eff_radius) * normal;
+            break;
+    }
+
+    Store(b.force, force);
+    Store(b.torque1, -torque1_loc + m_roll1 + m_spin1);
+    Store(b.torque2, torque2_loc - m_roll2 - m_spin2);
+}
+
+// -----------------------------------------------------------------------------
+// Scatter the results for the contacts [start, start+n) to the output arrays.
+// Separated contacts get zero forces and do not update the contact history.
+// -----------------------------------------------------------------------------
+
+void Scatter(const ChContactDataSMC& d, int start, int n, const ContactBatch& b) {
+    bool multi_step = d.displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep;
+
+    for (int k = 0; k < n; k++) {
+        int index = start + k;
+        d.ct_bid[2 * index] = d.body_pairs[index].x;
+        d.ct_bid[2 * index + 1] = d.body_pairs[index].y;
+
+        if (b.depth[k] >= 0) {
+            d.ct_force[2 * index] = real3(0);
+            d.ct_force[2 * index + 1] = real3(0);
+            d.ct_torque[2 * index] = real3(0);
+            d.ct_torque[2 * index + 1] = real3(0);
+            continue;
+        }
+
+        real3 force = Get(b.force, k);
+        d.ct_force[2 * index] = -force;
+        d.ct_force[2 * index + 1] = force;
+        d.ct_torque[2 * index] = Get(b.torque1, k);
+        d.ct_torque[2 * index + 1] = Get(b.torque2, k);
+
+        if (multi_step) {
+            int ctSaveId = d.shear_index[index];
+            d.shear_disp[ctSaveId] = Get(b.shear_disp, k);
+            d.contact_relvel_init[ctSaveId] = b.relvel_init[k];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Kernel entry points.
+// -----------------------------------------------------------------------------
+
+int GetWidth() {
+    return kWidth;
+}
+
+const char* GetInstructionSet() {
+    return kInstructionSet;
+}
+
+// Calculate the contact forces for the contacts [start, end), in batches.
+void CalcContactForces(const ChContactDataSMC& data, int start, int end) {
+    ContactBatch batch;
+    for (int i = start; i < end; i += kWidth) {
+        int n = std::min(kWidth, end - i);
+        Gather(data, i, n, batch);
+        Evaluate(data, batch);
+        Scatter(data, i, n, batch);
+    }
+}
+
+}  // end namespace CH_SMC_KERNELS_NAMESPACE
+}  // end namespace chrono
+
+#if defined(CH_SMC_KERNELS_TARGET_AVX512) || defined(CH_SMC_KERNELS_TARGET_AVX2)
+    #if defined(__clang__)
+        #pragma clang attribute pop
+    #else
+        #pragma GCC pop_options
+    #endif
+#endif
+
+#undef CH_SMC_KERNELS_AVX512_LANES
+#undef CH_SMC_KERNELS_AVX_LANES
@@ -117,7 +117,14 @@ class CH_MULTICORE_API ChIterativeSolverMulticoreSMC : public ChIterativeSolverM
                                 custom_vector<real3>& ct_force,
                                 custom_vector<real3>& ct_torque,
                                 custom_vector<vec2>& shape_pairs,
-                                custom_vector<char>& shear_touch);
+                                custom_vector<int>& shear_index);
+
+    /// Carry the contact history (multi-step tangential displacement model) over to the current contacts.
+    /// The current contact keys must be sorted, with 'order' the corresponding contact indices. On return, the history
+    /// is stored in the same order and 'shear_index' holds the position of each contact in the history arrays.
+    void host_UpdateContactHistory(custom_vector<long long>& keys,
+                                   const custom_vector<int>& order,
+                                   custom_vector<int>& shear_index);
 
     void host_AddContactForces(uint ct_body_count, const custom_vector<int>& ct_body_id);
 
@@ -34,6 +34,7 @@
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
 #include "chrono_multicore/solver/ChIterativeSolverMulticore.h"
+#include "chrono_multicore/solver/ChContactKernelsSMC.h"
 
 #include <thrust/sort.h>
 
@@ -49,6 +50,7 @@ using namespace chrono;
 // in the 'extended' output arrays. The calculated force and torque vectors are
 // therefore duplicated in the output arrays, once for each body involved in the
 // contact (with opposite signs for the two bodies).
+// Any change here must be mirrored in the batched evaluation (ChContactKernelsSMC).
 // -----------------------------------------------------------------------------
 void function_CalcContactForces(
     int index,                                            // index of this contact pair
@@ -77,9 +79,8 @@ void function_CalcContactForces(
     real3* normal,                                        // contact normal (per contact)
     real* depth,                                          // penetration depth (per contact)
     real* eff_radius,                                     // effective contact radius (per contact)
-    vec3* shear_neigh,                                    // neighbor list of contacting bodies and shapes (per body)
-    char* shear_touch,                                    // flag if contact in neighbor list is persistent (per body)
-    real3* shear_disp,                                    // accumulated shear displacement for each neighbor (per body)
+    int* shear_index,                                     // index of the contact history entry (per contact)
+    real3* shear_disp,                                    // accumulated shear displacement (per history entry)
     real* contact_relvel_init,                            // initial relative normal velocity per contact pair
     real* contact_duration,                               // duration of persistent contact between contact pairs
     int* ct_bid,                                          // [output] body IDs (two per contact)
@@ -172,66 +173,26 @@ void function_CalcContactForces(
     real delta_n = -depth[index];
     real3 delta_t = real3(0);
 
-    int i;
-    int contact_id = -1;
-    int shear_body1 = -1;
-    int shear_body2;
-    int shear_shape1;
-    int shear_shape2;
-    bool newcontact = true;
+    int ctSaveId = -1;
+    bool shape1_larger = false;
 
     if (displ_mode == ChSystemSMC::TangentialDisplacementModel::OneStep) {
         delta_t = relvel_t * dT;
     } else if (displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
         delta_t = relvel_t * dT;
 
-        // Identify the two shapes in contact (global shape IDs).
-        int s1 = shape_pairs[index].x;
-        int s2 = shape_pairs[index].y;
-
-        // Contact history information stored on the body with the smaller shape or else the body with larger index.
-        // Currently, it is assumed that the smaller shape is on the body with larger ID. We call this body shear_body1.
-        shear_body1 = std::max(b1, b2);
-        shear_body2 = std::min(b1, b2);
-        shear_shape1 = std::max(s1, s2);
-        shear_shape2 = std::min(s1, s2);
-
-        // Check if contact history already exists. If not, initialize new contact history.
-        for (i = 0; i < max_shear; i++) {
-            int ctIdUnrolled = max_shear * shear_body1 + i;
-            if (shear_neigh[ctIdUnrolled].x == shear_body2 && shear_neigh[ctIdUnrolled].y == shear_shape1 &&
-                shear_neigh[ctIdUnrolled].z == shear_shape2) {
-                contact_duration[ctIdUnrolled] += dT;
-                contact_id = i;
-                newcontact = false;
-                break;
-            }
-        }
-        if (newcontact == true) {
-            for (i = 0; i < max_shear; i++) {
-                int ctIdUnrolled = max_shear * shear_body1 + i;
-                if (shear_neigh[ctIdUnrolled].x == -1) {
-                    contact_id = i;
-                    shear_neigh[ctIdUnrolled].x = shear_body2;
-                    shear_neigh[ctIdUnrolled].y = shear_shape1;
-                    shear_neigh[ctIdUnrolled].z = shear_shape2;
-                    shear_disp[ctIdUnrolled].x = 0;
-                    shear_disp[ctIdUnrolled].y = 0;
-                    shear_disp[ctIdUnrolled].z = 0;
-                    contact_relvel_init[ctIdUnrolled] = relvel_init;
-                    contact_duration[ctIdUnrolled] = 0;
-                    break;
-                }
-            }
-        }
+        // The contact history entry was matched with the previous step before force evaluation (see
+        // host_UpdateContactHistory). The shear displacement is stored relative to the shape with larger ID.
+        ctSaveId = shear_index[index];
+        shape1_larger = shape_pairs[index].x > shape_pairs[index].y;
 
-        // Record that these two bodies are really in contact at this time.
-        int ctSaveId = max_shear * shear_body1 + contact_id;
-        shear_touch[ctSaveId] = true;
+        // For a new contact, record the initial relative normal velocity.
+        if (contact_relvel_init[ctSaveId] < 0)
+            contact_relvel_init[ctSaveId] = relvel_init;
 
         // Increment stored contact history tangential (shear) displacement vector and project it onto the current
         // contact plane.
-        if (shear_body1 == b1) {
+        if (shape1_larger) {
             shear_disp[ctSaveId] += delta_t;
             shear_disp[ctSaveId] -= Dot(shear_disp[ctSaveId], normal[index]) * normal[index];
             delta_t = shear_disp[ctSaveId];
@@ -457,10 +418,10 @@ void function_CalcContactForces(
             forceT *= ratio;
             if (displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
                 delta_t = (forceT - forceT_damp) / kt;
-                if (shear_body1 == b1) {
-                    shear_disp[max_shear * shear_body1 + contact_id] = delta_t;
+                if (shape1_larger) {
+                    shear_disp[ctSaveId] = delta_t;
                 } else {
-                    shear_disp[max_shear * shear_body1 + contact_id] = -delta_t;
+                    shear_disp[ctSaveId] = -delta_t;
                 }
             }
         } else {
@@ -556,9 +517,57 @@ void ChIterativeSolverMulticoreSMC::host_CalcContactForces(custom_vector<int>& c
                                                            custom_vector<real3>& ct_force,
                                                            custom_vector<real3>& ct_torque,
                                                            custom_vector<vec2>& shape_pairs,
-                                                           custom_vector<char>& shear_touch) {
+                                                           custom_vector<int>& shear_index) {
+    int num_contacts = (signed)data_manager->cd_data->num_rigid_contacts;
+
+    // Batched (SIMD) evaluation, if enabled and supported by the contact force model
+    if (data_manager->settings.solver.use_simd_contact_forces &&
+        ChContactKernelsSMC::Supports(data_manager->settings.solver.contact_force_model)) {
+        ChContactDataSMC data;
+        data.contact_model = data_manager->settings.solver.contact_force_model;
+        data.adhesion_model = data_manager->settings.solver.adhesion_force_model;
+        data.displ_mode = data_manager->settings.solver.tangential_displ_mode;
+        data.use_mat_props = data_manager->settings.solver.use_material_properties;
+        data.char_vel = data_manager->settings.solver.characteristic_vel;
+        data.min_roll_vel = data_manager->settings.solver.min_roll_vel;
+        data.min_spin_vel = data_manager->settings.solver.min_spin_vel;
+        data.dT = data_manager->settings.step_size;
+        data.body_pairs = data_manager->cd_data->bids_rigid_rigid.data();
+        data.shape_pairs = shape_pairs.data();
+        data.body_mass = data_manager->host_data.mass_rigid.data();
+        data.pos = data_manager->host_data.pos_rigid.data();
+        data.rot = data_manager->host_data.rot_rigid.data();
+        data.vel = data_manager->host_data.v.data();
+        data.friction = data_manager->host_data.fric_rigid_rigid.data();
+        data.modulus = data_manager->host_data.modulus_rigid_rigid.data();
+        data.adhesion = data_manager->host_data.adhesion_rigid_rigid.data();
+        data.cr = data_manager->host_data.cr_rigid_rigid.data();
+        data.smc_params = data_manager->host_data.smc_rigid_rigid.data();
+        data.pt1 = data_manager->cd_data->cpta_rigid_rigid.data();
+        data.pt2 = data_manager->cd_data->cptb_rigid_rigid.data();
+        data.normal = data_manager->cd_data->norm_rigid_rigid.data();
+        data.depth = data_manager->cd_data->dpth_rigid_rigid.data();
+        data.eff_radius = data_manager->cd_data->erad_rigid_rigid.data();
+        data.shear_index = shear_index.data();
+        data.shear_disp = data_manager->host_data.shear_disp.data();
+        data.contact_relvel_init = data_manager->host_data.contact_relvel_init.data();
+        data.contact_duration = data_manager->host_data.contact_duration.data();
+        data.ct_bid = ct_bid.data();
+        data.ct_force = ct_force.data();
+        data.ct_torque = ct_torque.data();
+
+        // Distribute chunks of a few batches to the threads
+        int chunk = 4 * ChContactKernelsSMC::GetWidth();
+        int num_chunks = (num_contacts + chunk - 1) / chunk;
+#pragma omp parallel for
+        for (int i = 0; i < num_chunks; i++) {
+            ChContactKernelsSMC::CalcContactForces(data, i * chunk, std::min((i + 1) * chunk, num_contacts));
+        }
+        return;
+    }
+
 #pragma omp parallel for
-    for (int index = 0; index < (signed)data_manager->cd_data->num_rigid_contacts; index++) {
+    for (int index = 0; index < num_contacts; index++) {
         function_CalcContactForces(
             index,                                                  // index of this contact pair
             data_manager->cd_data->bids_rigid_rigid.data(),         // indices of the body pair in contact
@@ -586,9 +595,8 @@ void ChIterativeSolverMulticoreSMC::host_CalcContactForces(custom_vector<int>& c
             data_manager->cd_data->norm_rigid_rigid.data(),         // contact normal (per contact)
             data_manager->cd_data->dpth_rigid_rigid.data(),         // penetration depth (per contact)
             data_manager->cd_data->erad_rigid_rigid.data(),         // effective contact radius (per contact)
-            data_manager->host_data.shear_neigh.data(),  // neighbor list of contacting bodies and shapes (per body)
-            shear_touch.data(),                          // flag if contact in neighbor list is persistent (per body)
-            data_manager->host_data.shear_disp.data(),   // accumulated shear displacement for each neighbor (per body)
+            shear_index.data(),                          // index of the contact history entry (per contact)
+            data_manager->host_data.shear_disp.data(),   // accumulated shear displacement (per history entry)
             data_manager->host_data.contact_relvel_init.data(),  // initial relative normal velocity per contact pair
             data_manager->host_data.contact_duration.data(),     // duration of persistent contact between contact pairs
             ct_bid.data(),                                       // [output] body IDs (two per contact)
@@ -598,6 +606,59 @@ void ChIterativeSolverMulticoreSMC::host_CalcContactForces(custom_vector<int>& c
     }
 }
 
+// -----------------------------------------------------------------------------
+// Match the current contacts (sorted by key) with the contact history entries
+// of the previous step (also sorted by key) and build the history arrays for
+// the current step. Entries of contacts that ended are dropped, new contacts
+// get a fresh entry. If several contacts share the same key, the k-th current
+// contact with that key is matched with the k-th previous entry with that key.
+// -----------------------------------------------------------------------------
+void ChIterativeSolverMulticoreSMC::host_UpdateContactHistory(custom_vector<long long>& keys,
+                                                              const custom_vector<int>& order,
+                                                              custom_vector<int>& shear_index) {
+    const custom_vector<long long>& old_keys = data_manager->host_data.shear_keys;
+    const custom_vector<real3>& old_disp = data_manager->host_data.shear_disp;
+    const custom_vector<real>& old_relvel_init = data_manager->host_data.contact_relvel_init;
+    const custom_vector<real>& old_duration = data_manager->host_data.contact_duration;
+
+    int num_contacts = (int)keys.size();
+    real dT = data_manager->settings.step_size;
+
+    custom_vector<real3> disp(num_contacts);
+    custom_vector<real> relvel_init(num_contacts);
+    custom_vector<real> duration(num_contacts);
+    shear_index.resize(num_contacts);
+
+#pragma omp parallel for
+    for (int p = 0; p < num_contacts; p++) {
+        long long key = keys[p];
+
+        // Rank of this contact among the current contacts with the same key
+        int rank = p - (int)(std::lower_bound(keys.begin(), keys.begin() + p, key) - keys.begin());
+
+        // Matching entry (if any) among the previous entries with the same key
+        auto range = std::equal_range(old_keys.begin(), old_keys.end(), key);
+        if (key >= 0 && rank < range.second - range.first) {
+            int m = (int)(range.first - old_keys.begin()) + rank;
+            disp[p] = old_disp[m];
+            relvel_init[p] = old_relvel_init[m];
+            duration[p] = old_duration[m] + dT;
+        } else {
+            // New contact (the initial relative velocity is set when calculating the contact force)
+            disp[p] = real3(0);
+            relvel_init[p] = -1;
+            duration[p] = 0;
+        }
+
+        shear_index[order[p]] = p;
+    }
+
+    data_manager->host_data.shear_keys.swap(keys);
+    data_manager->host_data.shear_disp.swap(disp);
+    data_manager->host_data.contact_relvel_init.swap(relvel_init);
+    data_manager->host_data.contact_duration.swap(duration);
+}
+
 // -----------------------------------------------------------------------------
 // Include contact impulses (linear and rotational) for all bodies that are
 // involved in at least one contact. For each such body, the corresponding
@@ -659,38 +720,40 @@ void ChIterativeSolverMulticoreSMC::ProcessContacts() {
     custom_vector<real3> ct_force(2 * num_rigid_contacts);
     custom_vector<real3> ct_torque(2 * num_rigid_contacts);
 
-    // Set up additional vectors for multi-step tangential model
+    // Set up additional vectors for multi-step tangential model.
+    // The contact history is keyed by the pair of shapes in contact (which also identifies the pair of bodies), with
+    // the larger shape ID in the upper 32 bits so that the key does not depend on the order of the two shapes.
+    // Shapes that are actually separated do not carry any contact history (key -1).
     custom_vector<vec2> shape_pairs;
-    custom_vector<char> shear_touch;
+    custom_vector<int> shear_index;
     if (data_manager->settings.solver.tangential_displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
         shape_pairs.resize(num_rigid_contacts);
-        shear_touch.resize(max_shear * data_manager->num_rigid_bodies);
-        Thrust_Fill(shear_touch, false);
+        custom_vector<long long> keys(num_rigid_contacts);
+        custom_vector<int> order(num_rigid_contacts);
 #pragma omp parallel for
         for (int i = 0; i < (signed)num_rigid_contacts; i++) {
             vec2 pair = I2(int(data_manager->cd_data->contact_shapeIDs[i] >> 32),
                            int(data_manager->cd_data->contact_shapeIDs[i] & 0xffffffff));
             shape_pairs[i] = pair;
+            keys[i] = (data_manager->cd_data->dpth_rigid_rigid[i] < 0)
+                          ? ((long long)std::max(pair.x, pair.y) << 32) | (long long)std::min(pair.x, pair.y)
+                          : -1;
+            order[i] = i;
         }
+
+        // Sort the contacts by key. A stable sort keeps multiple contacts between the same two shapes in narrowphase
+        // order, so that they are matched in the same order with the entries of the previous step.
+        thrust::stable_sort_by_key(THRUST_PAR keys.begin(), keys.end(), order.begin());
+        host_UpdateContactHistory(keys, order, shear_index);
     }
 
-    host_CalcContactForces(ct_bid, ct_force, ct_torque, shape_pairs, shear_touch);
+    host_CalcContactForces(ct_bid, ct_force, ct_torque, shape_pairs, shear_index);
 
     data_manager->host_data.ct_force.resize(2 * num_rigid_contacts);
     data_manager->host_data.ct_torque.resize(2 * num_rigid_contacts);
     thrust::copy(THRUST_PAR ct_force.begin(), ct_force.end(), data_manager->host_data.ct_force.begin());
     thrust::copy(THRUST_PAR ct_torque.begin(), ct_torque.end(), data_manager->host_data.ct_torque.begin());
 
-    if (data_manager->settings.solver.tangential_displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
-#pragma omp parallel for
-        for (int index = 0; index < (signed)data_manager->num_rigid_bodies; index++) {
-            for (int i = 0; i < max_shear; i++) {
-                if (shear_touch[max_shear * index + i] == false)
-                    data_manager->host_data.shear_neigh[max_shear * index + i].x = -1;
-            }
-        }
-    }
-
     // 2. Calculate contact forces and torques - per body basis
     //    Accumulate the contact forces and torques for all bodies that are
     //    involved in at least one contact, by reducing the contact forces and
@@ -42,5 +42,22 @@ void ChTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>&
     friction = GetCoefficientFriction(loc);
 }
 
+void ChTerrain::GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const {
+    height.resize(loc.size());
+    for (size_t i = 0; i < loc.size(); i++)
+        height[i] = GetHeight(loc[i]);
+}
+
+void ChTerrain::GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                   std::vector<double>& height,
+                                   std::vector<ChVector<>>& normal,
+                                   std::vector<float>& friction) const {
+    height.resize(loc.size());
+    normal.resize(loc.size());
+    friction.resize(loc.size());
+    for (size_t i = 0; i < loc.size(); i++)
+        GetProperties(loc[i], height[i], normal[i], friction[i]);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
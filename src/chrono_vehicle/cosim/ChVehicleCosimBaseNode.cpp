@@ -19,6 +19,8 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono_vehicle/cosim/ChVehicleCosimBaseNode.h"
 
 using std::cout;
@@ -80,6 +82,7 @@ const double ChVehicleCosimBaseNode::m_gacc = -9.81;
 ChVehicleCosimBaseNode::ChVehicleCosimBaseNode(const std::string& name)
     : m_name(name),
       m_step_size(1e-4),
+      m_extrapolation_order(0),
       m_cum_sim_time(0),
       m_verbose(true),
       m_num_wheeled_mbs_nodes(0),
@@ -203,6 +206,21 @@ void ChVehicleCosimBaseNode::SetOutDir(const std::string& dir_name, const std::s
     m_outf.open(m_node_out_dir + "/results.dat", std::ios::out);
     m_outf.precision(7);
     m_outf << std::scientific;
+
+    // Create timing output file
+    m_timing_outf.open(m_node_out_dir + "/timing.dat", std::ios::out);
+    m_timing_outf.precision(7);
+    m_timing_outf << std::scientific;
+}
+
+void ChVehicleCosimBaseNode::OutputTimers(int frame) {
+    if (!m_timing_outf.is_open())
+        return;
+
+    // Cumulative execution times: integration, interface data processing, data (un)packing, communication
+    std::string del("  ");
+    m_timing_outf << frame << del << m_cum_sim_time << del << m_timer_compute.GetTimeSeconds() << del
+                  << m_timer_pack.GetTimeSeconds() << del << m_timer_wait.GetTimeSeconds() << std::endl;
 }
 
 std::string ChVehicleCosimBaseNode::OutputFilename(const std::string& dir,
@@ -221,6 +239,57 @@ std::string ChVehicleCosimBaseNode::OutputFilename(const std::string& dir,
     return filename;
 }
 
+void ChVehicleCosimBaseNode::SetInterfaceExtrapolationOrder(int order) {
+    m_extrapolation_order = std::max(0, std::min(order, 2));
+}
+
+// -----------------------------------------------------------------------------
+
+void ChVehicleCosimBaseNode::InterfaceExtrapolator::SetOrder(int order) {
+    m_order = order;
+    while ((int)m_times.size() > m_order + 1) {
+        m_times.pop_front();
+        m_data.pop_front();
+    }
+}
+
+void ChVehicleCosimBaseNode::InterfaceExtrapolator::Add(double time, const double* data, int size) {
+    // Replace data recorded at the same time (e.g., repeated synchronization)
+    if (!m_times.empty() && time <= m_times.back()) {
+        m_times.pop_back();
+        m_data.pop_back();
+    }
+    m_times.push_back(time);
+    m_data.push_back(std::vector<double>(data, data + size));
+    if ((int)m_times.size() > m_order + 1) {
+        m_times.pop_front();
+        m_data.pop_front();
+    }
+}
+
+void ChVehicleCosimBaseNode::InterfaceExtrapolator::Evaluate(double time, double* data) const {
+    int n = (int)m_times.size();
+    int size = (int)m_data.back().size();
+
+    // Lagrange basis polynomials, evaluated at the given time
+    double weights[3];
+    for (int k = 0; k < n; k++) {
+        weights[k] = 1;
+        for (int j = 0; j < n; j++) {
+            if (j != k)
+                weights[k] *= (time - m_times[j]) / (m_times[k] - m_times[j]);
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        data[i] = 0;
+        for (int k = 0; k < n; k++)
+            data[i] += weights[k] * m_data[k][i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 bool ChVehicleCosimBaseNode::IsCosimNode() const {
     if (m_num_terrain_nodes == 1)
         return true;
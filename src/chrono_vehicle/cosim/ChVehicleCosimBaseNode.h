@@ -19,6 +19,7 @@
 #ifndef CH_VEHCOSIM_BASENODE_H
 #define CH_VEHCOSIM_BASENODE_H
 
+#include <deque>
 #include <fstream>
 #include <string>
 #include <iostream>
@@ -135,6 +136,17 @@ class CH_VEHICLE_API ChVehicleCosimBaseNode {
     /// Get the integration step size.
     double GetStepSize() const { return m_step_size; }
 
+    /// Set the order of the polynomial extrapolation of interface data (default: 0).
+    /// A node can advance with its own integration step size over a co-simulation interval (the duration passed to
+    /// Advance) which spans several integration steps. With order 0, the interface data (states or forces) received at
+    /// the last synchronization is held constant over the co-simulation interval. With a higher order (at most 2), the
+    /// interface data is extrapolated in time from the values received at the last synchronization times and is updated
+    /// before each integration step, which allows using coupling intervals much larger than the integration step size.
+    void SetInterfaceExtrapolationOrder(int order);
+
+    /// Get the order of the polynomial extrapolation of interface data.
+    int GetInterfaceExtrapolationOrder() const { return m_extrapolation_order; }
+
     /// Set the name of the output directory and an identifying suffix.
     /// Output files will be created in subdirectories named
     ///    dir_name/[NodeName]suffix/
@@ -154,6 +166,16 @@ class CH_VEHICLE_API ChVehicleCosimBaseNode {
     /// Get the cumulative simulation execution time on this node.
     double GetTotalExecutionTime() const { return m_cum_sim_time; }
 
+    /// Get the cumulative time spent on this node at synchronization points for processing the exchanged interface
+    /// data (e.g., applying received forces or loading states to be sent).
+    double GetTotalComputeTime() const { return m_timer_compute.GetTimeSeconds(); }
+
+    /// Get the cumulative time spent on this node for packing and unpacking the exchanged interface data.
+    double GetTotalPackTime() const { return m_timer_pack.GetTimeSeconds(); }
+
+    /// Get the cumulative time spent on this node waiting for inter-node communication.
+    double GetTotalWaitTime() const { return m_timer_wait.GetTimeSeconds(); }
+
     /// Initialize this node.
     /// This function allows the node to initialize itself and, optionally, perform an initial data exchange with any
     /// other node. A derived class implementation should first call this base class function.
@@ -203,20 +225,56 @@ class CH_VEHICLE_API ChVehicleCosimBaseNode {
         std::vector<ChVector<>> vforce;  ///< contact forces on mesh vertices
     };
 
+    /// Polynomial extrapolation in time of interface data received at synchronization times.
+    /// The data received at the last (order+1) synchronization times is stored and the extrapolated data is obtained by
+    /// evaluating the interpolating (Lagrange) polynomial.
+    class CH_VEHICLE_API InterfaceExtrapolator {
+      public:
+        InterfaceExtrapolator() : m_order(0) {}
+
+        /// Set the extrapolation order (0: constant, 1: linear, 2: quadratic).
+        void SetOrder(int order);
+
+        /// Record the interface data received at the specified synchronization time.
+        void Add(double time, const double* data, int size);
+
+        /// Return true if no interface data was recorded.
+        bool IsEmpty() const { return m_times.empty(); }
+
+        /// Return the time of the last recorded interface data.
+        double GetLastTime() const { return m_times.back(); }
+
+        /// Evaluate the extrapolated interface data at the specified time.
+        /// The extrapolation order is reduced if not enough data was recorded.
+        void Evaluate(double time, double* data) const;
+
+      private:
+        int m_order;
+        std::deque<double> m_times;
+        std::deque<std::vector<double>> m_data;
+    };
+
   protected:
     ChVehicleCosimBaseNode(const std::string& name);
 
     void SendGeometry(const ChVehicleGeometry& geom, int dest) const;
     void RecvGeometry(ChVehicleGeometry& geom, int source) const;
 
+    /// Append the cumulative execution times of this node to the timing output file.
+    /// Called from the OutputData function of all node types.
+    void OutputTimers(int frame);
+
     int m_rank;  ///< MPI rank of this node (in MPI_COMM_WORLD)
 
     double m_step_size;  ///< integration step size
 
+    int m_extrapolation_order;  ///< order of interface data extrapolation (0: no extrapolation)
+
     std::string m_name;          ///< name of the node
     std::string m_out_dir;       ///< top-level output directory
     std::string m_node_out_dir;  ///< node-specific output directory
     std::ofstream m_outf;        ///< output file stream
+    std::ofstream m_timing_outf; ///< timing output file stream
 
     unsigned int m_num_wheeled_mbs_nodes;
     unsigned int m_num_tracked_mbs_nodes;
@@ -226,6 +284,10 @@ class CH_VEHICLE_API ChVehicleCosimBaseNode {
     ChTimer<double> m_timer;  ///< timer for integration cost
     double m_cum_sim_time;    ///< cumulative integration cost
 
+    ChTimer<double> m_timer_compute;  ///< cumulative time for processing interface data at synchronization
+    ChTimer<double> m_timer_pack;     ///< cumulative time for packing and unpacking interface data
+    ChTimer<double> m_timer_wait;     ///< cumulative time waiting for inter-node communication
+
     bool m_verbose;  ///< verbose messages during simulation?
 
     static const double m_gacc;
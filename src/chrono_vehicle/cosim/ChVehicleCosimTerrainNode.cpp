@@ -225,6 +225,8 @@ void ChVehicleCosimTerrainNode::InitializeTrackData() {
 // Only the main terrain node participates in the co-simulation data exchange.
 // -----------------------------------------------------------------------------
 void ChVehicleCosimTerrainNode::Synchronize(int step_number, double time) {
+    m_state_extrap.resize(m_num_objects);
+
     switch (m_interface_type) {
         case InterfaceType::BODY:
             if (m_wheeled)
@@ -245,46 +247,85 @@ void ChVehicleCosimTerrainNode::Synchronize(int step_number, double time) {
 }
 
 void ChVehicleCosimTerrainNode::SynchronizeWheeledBody(int step_number, double time) {
-    for (int i = 0; i < m_num_objects; i++) {
-        if (m_rank == TERRAIN_NODE_RANK) {
-            // Receive rigid body state data for this tire
-            MPI_Status status;
-            double state_data[13];
-            MPI_Recv(state_data, 13, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD, &status);
-
-            m_rigid_state[i].pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
-            m_rigid_state[i].rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
-            m_rigid_state[i].lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
-            m_rigid_state[i].ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+    std::vector<double> all_states(13 * m_num_objects);
+    std::vector<double> all_forces(6 * m_num_objects);
+    std::vector<MPI_Request> recv_req(m_num_objects, MPI_REQUEST_NULL);
+    std::vector<MPI_Request> send_req(m_num_objects, MPI_REQUEST_NULL);
+    std::vector<bool> received(m_num_objects, false);
 
-            if (m_verbose)
-                cout << "[Terrain node] Recv: spindle position (" << i << ") = " << m_rigid_state[i].pos << endl;
+    // Post receives for the rigid body states of all tires
+    if (m_rank == TERRAIN_NODE_RANK) {
+        for (int i = 0; i < m_num_objects; i++) {
+            MPI_Irecv(&all_states[13 * i], 13, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD,
+                      &recv_req[i]);
         }
+    }
 
-        // Set position, rotation, and velocities of proxy rigid body
-        UpdateRigidProxy(i, m_rigid_state[i]);
+    // Process tires in order (proxies must be updated in the same order on all terrain ranks), unpacking incoming
+    // states as they arrive and sending the contact force on each tire as soon as it is available.
+    for (int i = 0; i < m_num_objects; i++) {
+        if (m_rank == TERRAIN_NODE_RANK) {
+            while (!received[i]) {
+                int k;
+                m_timer_wait.start();
+                MPI_Waitany(m_num_objects, recv_req.data(), &k, MPI_STATUS_IGNORE);
+                m_timer_wait.stop();
+
+                m_timer_pack.start();
+                const double* state_data = &all_states[13 * k];
+                m_rigid_state[k].pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
+                m_rigid_state[k].rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
+                m_rigid_state[k].lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
+                m_rigid_state[k].ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+                m_timer_pack.stop();
+
+                // Record state for extrapolation over the co-simulation interval
+                m_state_extrap[k].SetOrder(m_extrapolation_order);
+                m_state_extrap[k].Add(time, state_data, 13);
+
+                received[k] = true;
+
+                if (m_verbose)
+                    cout << "[Terrain node] Recv: spindle position (" << k << ") = " << m_rigid_state[k].pos << endl;
+            }
+        }
 
+        // Set position, rotation, and velocities of proxy rigid body.
         // Collect contact force on rigid proxy and load in m_rigid_contact.
         // It is assumed that this force is given at body center.
         // Note that no force is collected at the first step.
+        m_timer_compute.start();
+        UpdateRigidProxy(i, m_rigid_state[i]);
         if (step_number > 0) {
             GetForceRigidProxy(i, m_rigid_contact[i]);
         }
+        m_timer_compute.stop();
 
         if (m_rank == TERRAIN_NODE_RANK) {
             // Send wheel contact force
-            double force_data[] = {m_rigid_contact[i].force.x(),  m_rigid_contact[i].force.y(),
-                                   m_rigid_contact[i].force.z(),  m_rigid_contact[i].moment.x(),
-                                   m_rigid_contact[i].moment.y(), m_rigid_contact[i].moment.z()};
-            MPI_Send(force_data, 6, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD);
+            m_timer_pack.start();
+            double* force_data = &all_forces[6 * i];
+            force_data[0] = m_rigid_contact[i].force.x();
+            force_data[1] = m_rigid_contact[i].force.y();
+            force_data[2] = m_rigid_contact[i].force.z();
+            force_data[3] = m_rigid_contact[i].moment.x();
+            force_data[4] = m_rigid_contact[i].moment.y();
+            force_data[5] = m_rigid_contact[i].moment.z();
+            m_timer_pack.stop();
+            MPI_Isend(force_data, 6, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD, &send_req[i]);
 
             if (m_verbose)
                 cout << "[Terrain node] Send: spindle force (" << i << ") = " << m_rigid_contact[i].force << endl;
         }
     }
 
-    if (m_rank == TERRAIN_NODE_RANK && m_verbose) {
-        cout << "[Terrain node] step number: " << step_number << "  num contacts: " << GetNumContacts() << endl;
+    if (m_rank == TERRAIN_NODE_RANK) {
+        m_timer_wait.start();
+        MPI_Waitall(m_num_objects, send_req.data(), MPI_STATUSES_IGNORE);
+        m_timer_wait.stop();
+
+        if (m_verbose)
+            cout << "[Terrain node] step number: " << step_number << "  num contacts: " << GetNumContacts() << endl;
     }
 }
 
@@ -296,9 +337,12 @@ void ChVehicleCosimTerrainNode::SynchronizeTrackedBody(int step_number, double t
     // Receive rigid body data for all track shoes
     if (m_rank == TERRAIN_NODE_RANK) {
         MPI_Status status;
+        m_timer_wait.start();
         MPI_Recv(all_states.data(), 13 * m_num_objects, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+        m_timer_wait.stop();
 
         // Unpack rigid body data
+        m_timer_pack.start();
         start_idx = 0;
         for (int i = 0; i < m_num_objects; i++) {
             m_rigid_state[i].pos =
@@ -309,24 +353,30 @@ void ChVehicleCosimTerrainNode::SynchronizeTrackedBody(int step_number, double t
                 ChVector<>(all_states[start_idx + 7], all_states[start_idx + 8], all_states[start_idx + 9]);
             m_rigid_state[i].ang_vel =
                 ChVector<>(all_states[start_idx + 10], all_states[start_idx + 11], all_states[start_idx + 12]);
+            m_state_extrap[i].SetOrder(m_extrapolation_order);
+            m_state_extrap[i].Add(time, &all_states[start_idx], 13);
             start_idx += 13;
         }
+        m_timer_pack.stop();
     }
 
     // Set position, rotation, and velocities of proxy rigid body.
     // Collect contact force on rigid proxy and load in m_rigid_contact.
     // It is assumed that this force is given at body center.
     // Note that no force is collected at the first step.
+    m_timer_compute.start();
     for (int i = 0; i < m_num_objects; i++) {
         UpdateRigidProxy(i, m_rigid_state[i]);
         if (step_number > 0) {
             GetForceRigidProxy(i, m_rigid_contact[i]);
         }
     }
+    m_timer_compute.stop();
 
     // Send contact forces for all track shoes
     if (m_rank == TERRAIN_NODE_RANK) {
         // Pack contact forces
+        m_timer_pack.start();
         start_idx = 0;
         for (int i = 0; i < m_num_objects; i++) {
             all_forces[start_idx + 0] = m_rigid_contact[i].force.x();
@@ -337,8 +387,11 @@ void ChVehicleCosimTerrainNode::SynchronizeTrackedBody(int step_number, double t
             all_forces[start_idx + 5] = m_rigid_contact[i].moment.z();
             start_idx += 6;
         }
+        m_timer_pack.stop();
 
+        m_timer_wait.start();
         MPI_Send(all_forces.data(), 6 * m_num_objects, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD);
+        m_timer_wait.stop();
 
         if (m_verbose)
             cout << "[Terrain node] step number: " << step_number << "  num contacts: " << GetNumContacts() << endl;
@@ -346,60 +399,92 @@ void ChVehicleCosimTerrainNode::SynchronizeTrackedBody(int step_number, double t
 }
 
 void ChVehicleCosimTerrainNode::SynchronizeWheeledMesh(int step_number, double time) {
-    for (int i = 0; i < m_num_objects; i++) {
-        if (m_rank == TERRAIN_NODE_RANK) {
+    std::vector<std::vector<double>> vert_data(m_num_objects);
+    std::vector<std::vector<double>> force_data(m_num_objects);
+    std::vector<MPI_Request> recv_req(m_num_objects, MPI_REQUEST_NULL);
+    std::vector<MPI_Request> send_req(2 * m_num_objects, MPI_REQUEST_NULL);
+    std::vector<bool> received(m_num_objects, false);
+
+    // Post receives for the mesh states of all tires
+    if (m_rank == TERRAIN_NODE_RANK) {
+        for (int i = 0; i < m_num_objects; i++) {
             auto nv = m_geometry[i].m_coll_meshes[0].m_trimesh->getNumVertices();
+            vert_data[i].resize(2 * 3 * nv);
+            MPI_Irecv(vert_data[i].data(), 2 * 3 * nv, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD,
+                      &recv_req[i]);
+        }
+    }
 
-            // Receive mesh state data
-            MPI_Status status;
-            double* vert_data = new double[2 * 3 * nv];
-            MPI_Recv(vert_data, 2 * 3 * nv, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD,
-                     &status);
-
-            for (int iv = 0; iv < nv; iv++) {
-                int offset = 3 * iv;
-                m_mesh_state[i].vpos[iv] =
-                    ChVector<>(vert_data[offset + 0], vert_data[offset + 1], vert_data[offset + 2]);
-                offset += 3 * nv;
-                m_mesh_state[i].vvel[iv] =
-                    ChVector<>(vert_data[offset + 0], vert_data[offset + 1], vert_data[offset + 2]);
+    // Process tires in order (proxies must be updated in the same order on all terrain ranks), unpacking incoming
+    // mesh states as they arrive and sending the contact forces on each tire as soon as they are available.
+    for (int i = 0; i < m_num_objects; i++) {
+        if (m_rank == TERRAIN_NODE_RANK) {
+            while (!received[i]) {
+                int k;
+                m_timer_wait.start();
+                MPI_Waitany(m_num_objects, recv_req.data(), &k, MPI_STATUS_IGNORE);
+                m_timer_wait.stop();
+
+                m_timer_pack.start();
+                auto nv = m_geometry[k].m_coll_meshes[0].m_trimesh->getNumVertices();
+                for (int iv = 0; iv < nv; iv++) {
+                    int offset = 3 * iv;
+                    m_mesh_state[k].vpos[iv] =
+                        ChVector<>(vert_data[k][offset + 0], vert_data[k][offset + 1], vert_data[k][offset + 2]);
+                    offset += 3 * nv;
+                    m_mesh_state[k].vvel[iv] =
+                        ChVector<>(vert_data[k][offset + 0], vert_data[k][offset + 1], vert_data[k][offset + 2]);
+                }
+                m_timer_pack.stop();
+
+                // Record mesh state for extrapolation over the co-simulation interval
+                m_state_extrap[k].SetOrder(m_extrapolation_order);
+                m_state_extrap[k].Add(time, vert_data[k].data(), 2 * 3 * nv);
+
+                received[k] = true;
+
+                ////if (m_verbose)
+                ////    PrintMeshUpdateData(k);
             }
-
-            ////if (m_verbose)
-            ////    PrintMeshUpdateData(i);
-
-            delete[] vert_data;
         }
 
         // Set position, rotation, and velocity of proxy bodies.
-        UpdateMeshProxy(i, m_mesh_state[i]);
-
         // Collect contact forces on subset of mesh vertices and load in m_mesh_contact.
         // Note that no forces are collected at the first step.
+        m_timer_compute.start();
+        UpdateMeshProxy(i, m_mesh_state[i]);
         if (step_number == 0)
             m_mesh_contact[i].nv = 0;
         else
             GetForceMeshProxy(i, m_mesh_contact[i]);
+        m_timer_compute.stop();
 
         if (m_rank == TERRAIN_NODE_RANK) {
             // Send vertex indices and forces.
-            MPI_Send(m_mesh_contact[i].vidx.data(), m_mesh_contact[i].nv, MPI_INT, TIRE_NODE_RANK(i), step_number,
-                     MPI_COMM_WORLD);
-
-            double* force_data = new double[3 * m_mesh_contact[i].nv];
-            for (int iv = 0; iv < m_mesh_contact[i].nv; i++) {
-                force_data[3 * iv + 0] = m_mesh_contact[i].vforce[iv].x();
-                force_data[3 * iv + 1] = m_mesh_contact[i].vforce[iv].y();
-                force_data[3 * iv + 2] = m_mesh_contact[i].vforce[iv].z();
+            m_timer_pack.start();
+            force_data[i].resize(3 * m_mesh_contact[i].nv);
+            for (int iv = 0; iv < m_mesh_contact[i].nv; iv++) {
+                force_data[i][3 * iv + 0] = m_mesh_contact[i].vforce[iv].x();
+                force_data[i][3 * iv + 1] = m_mesh_contact[i].vforce[iv].y();
+                force_data[i][3 * iv + 2] = m_mesh_contact[i].vforce[iv].z();
             }
-            MPI_Send(force_data, 3 * m_mesh_contact[i].nv, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD);
-            delete[] force_data;
+            m_timer_pack.stop();
+            MPI_Isend(m_mesh_contact[i].vidx.data(), m_mesh_contact[i].nv, MPI_INT, TIRE_NODE_RANK(i), step_number,
+                      MPI_COMM_WORLD, &send_req[2 * i + 0]);
+            MPI_Isend(force_data[i].data(), 3 * m_mesh_contact[i].nv, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number,
+                      MPI_COMM_WORLD, &send_req[2 * i + 1]);
 
             if (m_verbose)
                 cout << "[Terrain node] step number: " << step_number << "  num contacts: " << GetNumContacts()
                      << "  vertices in contact: " << m_mesh_contact[i].nv << endl;
         }
     }
+
+    if (m_rank == TERRAIN_NODE_RANK) {
+        m_timer_wait.start();
+        MPI_Waitall(2 * m_num_objects, send_req.data(), MPI_STATUSES_IGNORE);
+        m_timer_wait.stop();
+    }
 }
 
 void ChVehicleCosimTerrainNode::SynchronizeTrackedMesh(int step_number, double time) {
@@ -416,7 +501,19 @@ void ChVehicleCosimTerrainNode::Advance(double step_size) {
     // Let derived classes advance the terrain state
     m_timer.reset();
     m_timer.start();
-    OnAdvance(step_size);
+    if (m_extrapolation_order > 0) {
+        // Advance in increments of the integration step, updating the proxies with extrapolated states
+        double t = 0;
+        while (t < step_size) {
+            double h = std::min<>(m_step_size, step_size - t);
+            if (t > 0)
+                UpdateExtrapolatedProxies(t);
+            OnAdvance(h);
+            t += h;
+        }
+    } else {
+        OnAdvance(step_size);
+    }
     sim_time += step_size;
     m_timer.stop();
     m_cum_sim_time += m_timer();
@@ -428,13 +525,54 @@ void ChVehicleCosimTerrainNode::Advance(double step_size) {
     }
 }
 
+// Set the proxy states extrapolated at the specified time since the last synchronization.
+// Only the main terrain node evaluates the extrapolated states, but all terrain ranks update the proxies (as in
+// Synchronize).
+void ChVehicleCosimTerrainNode::UpdateExtrapolatedProxies(double time) {
+    for (int i = 0; i < m_num_objects; i++) {
+        bool extrapolate = m_rank == TERRAIN_NODE_RANK && !m_state_extrap[i].IsEmpty();
+        double t = extrapolate ? m_state_extrap[i].GetLastTime() + time : 0;
+
+        switch (m_interface_type) {
+            case InterfaceType::BODY:
+                if (extrapolate) {
+                    double state_data[13];
+                    m_state_extrap[i].Evaluate(t, state_data);
+                    m_rigid_state[i].pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
+                    m_rigid_state[i].rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
+                    m_rigid_state[i].rot.Normalize();
+                    m_rigid_state[i].lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
+                    m_rigid_state[i].ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+                }
+                UpdateRigidProxy(i, m_rigid_state[i]);
+                break;
+            case InterfaceType::MESH:
+                if (!m_wheeled)
+                    break;
+                if (extrapolate) {
+                    auto nv = (int)m_mesh_state[i].vpos.size();
+                    std::vector<double> vert_data(2 * 3 * nv);
+                    m_state_extrap[i].Evaluate(t, vert_data.data());
+                    for (int iv = 0; iv < nv; iv++) {
+                        int offset = 3 * iv;
+                        m_mesh_state[i].vpos[iv] =
+                            ChVector<>(vert_data[offset + 0], vert_data[offset + 1], vert_data[offset + 2]);
+                        offset += 3 * nv;
+                        m_mesh_state[i].vvel[iv] =
+                            ChVector<>(vert_data[offset + 0], vert_data[offset + 1], vert_data[offset + 2]);
+                    }
+                }
+                UpdateMeshProxy(i, m_mesh_state[i]);
+                break;
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 void ChVehicleCosimTerrainNode::OutputData(int frame) {
-    // Append to results output file
-    if (m_outf.is_open()) {
-        //// TODO
-    }
+    // Append to timing output file (the compute time includes proxy updates and contact force collection)
+    OutputTimers(frame);
 
     OnOutputData(frame);
 }
@@ -190,6 +190,8 @@ class CH_VEHICLE_API ChVehicleCosimTerrainNode : public ChVehicleCosimBaseNode {
     std::vector<MeshContact> m_mesh_contact;    ///< mesh contact forces (used for MESH communication interface)
     std::vector<TerrainForce> m_rigid_contact;  ///< rigid contact force (used for BODY communication interface)
 
+    std::vector<InterfaceExtrapolator> m_state_extrap;  ///< extrapolators for the states of interacting objects
+
   private:
     void InitializeTireData();
     void InitializeTrackData();
@@ -199,6 +201,8 @@ class CH_VEHICLE_API ChVehicleCosimTerrainNode : public ChVehicleCosimBaseNode {
     void SynchronizeWheeledMesh(int step_number, double time);
     void SynchronizeTrackedMesh(int step_number, double time);
 
+    void UpdateExtrapolatedProxies(double time);
+
     /// Print vertex and face connectivity data for the i-th object, as received at synchronization.
     /// Invoked only when using the MESH communication interface.
     void PrintMeshUpdateData(int i);
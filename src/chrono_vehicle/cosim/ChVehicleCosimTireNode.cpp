@@ -250,6 +250,7 @@ void ChVehicleCosimTireNode::InitializeSystem() {
         }
         case ChSolver::Type::PSOR:
         case ChSolver::Type::PSSOR:
+        case ChSolver::Type::PSOR_PARALLEL:
         case ChSolver::Type::PJACOBI:
         case ChSolver::Type::PMINRES:
         case ChSolver::Type::BARZILAIBORWEIN:
@@ -306,38 +307,58 @@ void ChVehicleCosimTireNode::SynchronizeBody(int step_number, double time) {
 
     // Receive spindle state data from MBS node
     double state_data[13];
+    m_timer_wait.start();
     MPI_Recv(state_data, 13, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_timer_wait.stop();
 
+    m_timer_pack.start();
     BodyState spindle_state;
     spindle_state.pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
     spindle_state.rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
     spindle_state.lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
     spindle_state.ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+    m_timer_pack.stop();
 
     // Pass it to derived class
+    m_timer_compute.start();
     ApplySpindleState(spindle_state);
 
+    // Record spindle state for extrapolation over the co-simulation interval
+    m_spindle_extrap.SetOrder(m_extrapolation_order);
+    m_spindle_extrap.Add(time, state_data, 13);
+    m_timer_compute.stop();
+
     // Send spindle state data to Terrain node
+    m_timer_wait.start();
     MPI_Send(state_data, 13, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD);
+    m_timer_wait.stop();
     if (m_verbose)
         cout << "[Tire node " << m_index << " ] Send: spindle position = " << spindle_state.pos << endl;
 
     // Receive spindle force from TERRAIN NODE and send to MBS node
     double force_data[6];
+    m_timer_wait.start();
     MPI_Recv(force_data, 6, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_timer_wait.stop();
 
+    m_timer_pack.start();
     TerrainForce spindle_force;
     spindle_force.force = ChVector<>(force_data[0], force_data[1], force_data[2]);
     spindle_force.moment = ChVector<>(force_data[3], force_data[4], force_data[5]);
+    m_timer_pack.stop();
 
     if (m_verbose)
         cout << "[Tire node " << m_index << " ] Recv: spindle force = " << spindle_force.force << endl;
 
     // Pass it to derived class
+    m_timer_compute.start();
     ApplySpindleForce(spindle_force);
+    m_timer_compute.stop();
 
     // Send spindle force to MBS node
+    m_timer_wait.start();
     MPI_Send(force_data, 6, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD);
+    m_timer_wait.stop();
 }
 
 void ChVehicleCosimTireNode::SynchronizeMesh(int step_number, double time) {
@@ -345,21 +366,33 @@ void ChVehicleCosimTireNode::SynchronizeMesh(int step_number, double time) {
 
     // Receive spindle state data from MBS node
     double state_data[13];
+    m_timer_wait.start();
     MPI_Recv(state_data, 13, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_timer_wait.stop();
 
+    m_timer_pack.start();
     BodyState spindle_state;
     spindle_state.pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
     spindle_state.rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
     spindle_state.lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
     spindle_state.ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+    m_timer_pack.stop();
 
     // Pass it to derived class.
+    m_timer_compute.start();
     ApplySpindleState(spindle_state);
 
+    // Record spindle state for extrapolation over the co-simulation interval
+    m_spindle_extrap.SetOrder(m_extrapolation_order);
+    m_spindle_extrap.Add(time, state_data, 13);
+
     // Send mesh state (vertex locations and velocities) to TERRAIN node
     MeshState mesh_state;
     LoadMeshState(mesh_state);
-    unsigned int nvs = 3 * (unsigned int)mesh_state.vpos.size();
+    m_timer_compute.stop();
+
+    m_timer_pack.start();
+    unsigned int nvs = (unsigned int)mesh_state.vpos.size();
     double* vert_data = new double[2 * 3 * nvs];
     for (unsigned int iv = 0; iv < nvs; iv++) {
         vert_data[3 * iv + 0] = mesh_state.vpos[iv].x();
@@ -371,18 +404,25 @@ void ChVehicleCosimTireNode::SynchronizeMesh(int step_number, double time) {
         vert_data[3 * nvs + 3 * iv + 1] = mesh_state.vvel[iv].y();
         vert_data[3 * nvs + 3 * iv + 2] = mesh_state.vvel[iv].z();
     }
+    m_timer_pack.stop();
+
+    m_timer_wait.start();
     MPI_Send(vert_data, 2 * 3 * nvs, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD);
+    m_timer_wait.stop();
 
     // Receive mesh forces from TERRAIN node.
     // Note that we use MPI_Probe to figure out the number of indices and forces received.
     int nvc = 0;
+    m_timer_wait.start();
     MPI_Probe(TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
     MPI_Get_count(&status, MPI_INT, &nvc);
     int* index_data = new int[nvc];
     double* mesh_contact_data = new double[3 * nvc];
     MPI_Recv(index_data, nvc, MPI_INT, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
     MPI_Recv(mesh_contact_data, 3 * nvc, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_timer_wait.stop();
 
+    m_timer_pack.start();
     MeshContact mesh_contact;
     mesh_contact.nv = nvc;
     mesh_contact.vidx.resize(nvc);
@@ -393,20 +433,26 @@ void ChVehicleCosimTireNode::SynchronizeMesh(int step_number, double time) {
         mesh_contact.vforce[iv] =
             ChVector<>(mesh_contact_data[3 * iv + 0], mesh_contact_data[3 * iv + 1], mesh_contact_data[3 * iv + 2]);
     }
+    m_timer_pack.stop();
 
     if (m_verbose)
         cout << "[Tire node " << m_index << " ] step number: " << step_number
              << "  vertices in contact: " << mesh_contact.nv << endl;
 
     // Pass the mesh contact forces to the derived class
+    m_timer_compute.start();
     ApplyMeshForces(mesh_contact);
 
     // Send spindle forces to MBS node
     TerrainForce spindle_force;
     LoadSpindleForce(spindle_force);
+    m_timer_compute.stop();
+
     double force_data[] = {spindle_force.force.x(),  spindle_force.force.y(),  spindle_force.force.z(),
                            spindle_force.moment.x(), spindle_force.moment.y(), spindle_force.moment.z()};
+    m_timer_wait.start();
     MPI_Send(force_data, 6, MPI_DOUBLE, MBS_NODE_RANK, step_number, MPI_COMM_WORLD);
+    m_timer_wait.stop();
 
     delete[] vert_data;
     delete[] index_data;
@@ -414,6 +460,9 @@ void ChVehicleCosimTireNode::SynchronizeMesh(int step_number, double time) {
 }
 
 void ChVehicleCosimTireNode::OutputData(int frame) {
+    // Append to timing output file
+    OutputTimers(frame);
+
     OnOutputData(frame);
 }
 
@@ -179,6 +179,8 @@ class CH_VEHICLE_API ChVehicleCosimTireNode : public ChVehicleCosimBaseNode {
     std::shared_ptr<ChBody> m_spindle;  ///< spindle body
     std::shared_ptr<ChWheel> m_wheel;   ///< wheel subsystem (to which a tire is attached)
 
+    InterfaceExtrapolator m_spindle_extrap;  ///< extrapolator for the spindle state received from the MBS node
+
     // Communication data (loaded by derived classes)
     ChVehicleGeometry m_geometry; ///< tire geometry and contact material
 
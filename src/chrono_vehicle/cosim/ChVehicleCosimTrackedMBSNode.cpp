@@ -196,6 +196,7 @@ void ChVehicleCosimTrackedMBSNode::InitializeSystem() {
         }
         case ChSolver::Type::PSOR:
         case ChSolver::Type::PSSOR:
+        case ChSolver::Type::PSOR_PARALLEL:
         case ChSolver::Type::PJACOBI:
         case ChSolver::Type::PMINRES:
         case ChSolver::Type::BARZILAIBORWEIN:
@@ -246,6 +247,7 @@ void ChVehicleCosimTrackedMBSNode::Synchronize(int step_number, double time) {
     int start_idx;
 
     // Pack states of all track shoe bodies
+    m_timer_pack.start();
     start_idx = 0;
     for (int i = 0; i < GetNumTracks(); i++) {
         for (int j = 0; j < GetNumTrackShoes(i); j++) {
@@ -266,17 +268,30 @@ void ChVehicleCosimTrackedMBSNode::Synchronize(int step_number, double time) {
             start_idx += 13;
         }
     }
+    m_timer_pack.stop();
 
     // Send track shoe states to the terrain node
+    m_timer_wait.start();
     MPI_Send(all_states.data(), 13 * num_shoes, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD);
 
     // Receive track shoe forces as applied to the center of the track shoe body.
     // Note that we assume this is the resultant wrench at the track shoe origin (expressed in absolute frame).
     MPI_Status status;
     MPI_Recv(all_forces.data(), 6 * num_shoes, MPI_DOUBLE, TERRAIN_NODE_RANK, step_number, MPI_COMM_WORLD, &status);
+    m_timer_wait.stop();
 
     // Apply track shoe forces on each individual track shoe body
-    start_idx = 0;
+    m_timer_compute.start();
+    ApplyTrackShoeForces(all_forces);
+
+    // Record track shoe forces for extrapolation over the co-simulation interval
+    m_force_extrap.SetOrder(m_extrapolation_order);
+    m_force_extrap.Add(time, all_forces.data(), 6 * num_shoes);
+    m_timer_compute.stop();
+}
+
+void ChVehicleCosimTrackedMBSNode::ApplyTrackShoeForces(const std::vector<double>& all_forces) {
+    int start_idx = 0;
     for (int i = 0; i < GetNumTracks(); i++) {
         for (int j = 0; j < GetNumTrackShoes(i); j++) {
             TerrainForce force;
@@ -293,11 +308,17 @@ void ChVehicleCosimTrackedMBSNode::Synchronize(int step_number, double time) {
 // Advance simulation of the MBS node by the specified duration
 // -----------------------------------------------------------------------------
 void ChVehicleCosimTrackedMBSNode::Advance(double step_size) {
+    std::vector<double> all_forces(6 * GetNumTrackShoes());
+
     m_timer.reset();
     m_timer.start();
     double t = 0;
     while (t < step_size) {
         double h = std::min<>(m_step_size, step_size - t);
+        if (m_extrapolation_order > 0 && t > 0 && !m_force_extrap.IsEmpty()) {
+            m_force_extrap.Evaluate(m_force_extrap.GetLastTime() + t, all_forces.data());
+            ApplyTrackShoeForces(all_forces);
+        }
         PreAdvance();
         m_system->DoStepDynamics(h);
         if (m_DBP_rig) {
@@ -325,6 +346,9 @@ void ChVehicleCosimTrackedMBSNode::OutputData(int frame) {
         m_DBP_outf << endl;
     }
 
+    // Append to timing output file
+    OutputTimers(frame);
+
     // Let derived classes perform specific output
     OnOutputData(frame);
 }
@@ -155,7 +155,12 @@ class CH_VEHICLE_API ChVehicleCosimTrackedMBSNode : public ChVehicleCosimBaseNod
   private:
     void InitializeSystem();
 
+    /// Apply the track shoe forces in the specified array (6 values per track shoe).
+    void ApplyTrackShoeForces(const std::vector<double>& all_forces);
+
     bool m_fix_chassis;
+
+    InterfaceExtrapolator m_force_extrap;  ///< extrapolation of track shoe forces
 };
 
 /// @} vehicle_cosim
@@ -203,6 +203,7 @@ void ChVehicleCosimWheeledMBSNode::InitializeSystem() {
         }
         case ChSolver::Type::PSOR:
         case ChSolver::Type::PSSOR:
+        case ChSolver::Type::PSOR_PARALLEL:
         case ChSolver::Type::PJACOBI:
         case ChSolver::Type::PMINRES:
         case ChSolver::Type::BARZILAIBORWEIN:
@@ -249,17 +250,26 @@ void ChVehicleCosimWheeledMBSNode::InitializeSystem() {
 void ChVehicleCosimWheeledMBSNode::Synchronize(int step_number, double time) {
     MPI_Status status;
 
+    m_force_extrap.resize(m_num_tire_nodes);
+
     for (unsigned int i = 0; i < m_num_tire_nodes; i++) {
         // Send wheel state to the tire node
+        m_timer_compute.start();
         BodyState state = GetSpindleState(i);
+        m_timer_compute.stop();
+
+        m_timer_pack.start();
         double state_data[] = {
             state.pos.x(),     state.pos.y(),     state.pos.z(),                      //
             state.rot.e0(),    state.rot.e1(),    state.rot.e2(),    state.rot.e3(),  //
             state.lin_vel.x(), state.lin_vel.y(), state.lin_vel.z(),                  //
             state.ang_vel.x(), state.ang_vel.y(), state.ang_vel.z()                   //
         };
+        m_timer_pack.stop();
 
+        m_timer_wait.start();
         MPI_Send(state_data, 13, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD);
+        m_timer_wait.stop();
 
         if (m_verbose)
             cout << "[MBS node    ] Send: spindle position (" << i << ") = " << state.pos << endl;
@@ -267,19 +277,43 @@ void ChVehicleCosimWheeledMBSNode::Synchronize(int step_number, double time) {
         // Receive spindle force as applied to the center of the spindle/wheel.
         // Note that we assume this is the resultant wrench at the wheel origin (expressed in absolute frame).
         double force_data[6];
+        m_timer_wait.start();
         MPI_Recv(force_data, 6, MPI_DOUBLE, TIRE_NODE_RANK(i), step_number, MPI_COMM_WORLD, &status);
+        m_timer_wait.stop();
 
+        m_timer_pack.start();
         TerrainForce spindle_force;
         spindle_force.point = GetSpindleBody(i)->GetPos();
         spindle_force.force = ChVector<>(force_data[0], force_data[1], force_data[2]);
         spindle_force.moment = ChVector<>(force_data[3], force_data[4], force_data[5]);
+        m_timer_pack.stop();
+
+        m_timer_compute.start();
         ApplySpindleForce(i, spindle_force);
 
+        // Record spindle force for extrapolation over the co-simulation interval
+        m_force_extrap[i].SetOrder(m_extrapolation_order);
+        m_force_extrap[i].Add(time, force_data, 6);
+        m_timer_compute.stop();
+
         if (m_verbose)
             cout << "[MBS node    ] Recv: spindle force (" << i << ") = " << spindle_force.force << endl;
     }
 }
 
+void ChVehicleCosimWheeledMBSNode::ApplyExtrapolatedSpindleForces(double time) {
+    for (unsigned int i = 0; i < m_num_tire_nodes; i++) {
+        double force_data[6];
+        m_force_extrap[i].Evaluate(time, force_data);
+
+        TerrainForce spindle_force;
+        spindle_force.point = GetSpindleBody(i)->GetPos();
+        spindle_force.force = ChVector<>(force_data[0], force_data[1], force_data[2]);
+        spindle_force.moment = ChVector<>(force_data[3], force_data[4], force_data[5]);
+        ApplySpindleForce(i, spindle_force);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Advance simulation of the MBS node by the specified duration
 // -----------------------------------------------------------------------------
@@ -289,6 +323,8 @@ void ChVehicleCosimWheeledMBSNode::Advance(double step_size) {
     double t = 0;
     while (t < step_size) {
         double h = std::min<>(m_step_size, step_size - t);
+        if (m_extrapolation_order > 0 && t > 0 && !m_force_extrap.empty() && !m_force_extrap[0].IsEmpty())
+            ApplyExtrapolatedSpindleForces(m_force_extrap[0].GetLastTime() + t);
         PreAdvance();
         m_system->DoStepDynamics(h);
         if (m_DBP_rig) {
@@ -316,6 +352,9 @@ void ChVehicleCosimWheeledMBSNode::OutputData(int frame) {
         m_DBP_outf << endl;
     }
 
+    // Append to timing output file
+    OutputTimers(frame);
+
     // Let derived classes perform specific output
     OnOutputData(frame);
 }
@@ -165,7 +165,12 @@ class CH_VEHICLE_API ChVehicleCosimWheeledMBSNode : public ChVehicleCosimBaseNod
   private:
     void InitializeSystem();
 
+    /// Apply the spindle forces extrapolated at the specified time.
+    void ApplyExtrapolatedSpindleForces(double time);
+
     bool m_fix_chassis;
+
+    std::vector<InterfaceExtrapolator> m_force_extrap;  ///< extrapolation of spindle forces
 };
 
 /// @} vehicle_cosim
@@ -39,6 +39,17 @@ void ChVehicleCosimTireNodeFlexible::Advance(double step_size) {
         m_tire->GetMesh()->ResetCounters();
         m_tire->GetMesh()->ResetTimers();
         double h = std::min<>(m_step_size, step_size - t);
+        if (m_extrapolation_order > 0 && t > 0 && !m_spindle_extrap.IsEmpty()) {
+            double state_data[13];
+            m_spindle_extrap.Evaluate(m_spindle_extrap.GetLastTime() + t, state_data);
+            BodyState spindle_state;
+            spindle_state.pos = ChVector<>(state_data[0], state_data[1], state_data[2]);
+            spindle_state.rot = ChQuaternion<>(state_data[3], state_data[4], state_data[5], state_data[6]);
+            spindle_state.rot.Normalize();
+            spindle_state.lin_vel = ChVector<>(state_data[7], state_data[8], state_data[9]);
+            spindle_state.ang_vel = ChVector<>(state_data[10], state_data[11], state_data[12]);
+            ApplySpindleState(spindle_state);
+        }
         m_system->DoStepDynamics(h);
         t += h;
     }
@@ -264,11 +264,14 @@ double CRGTerrain::GetHeight(const ChVector<>& loc) const {
 }
 
 ChVector<> CRGTerrain::GetNormal(const ChVector<>& loc) const {
+    return CalcNormal(loc, GetHeight(loc));
+}
+
+ChVector<> CRGTerrain::CalcNormal(const ChVector<>& loc, double z0) const {
     ChVector<> loc_ISO = ChWorldFrame::ToISO(loc);
     // to avoid 'jumping' of the normal vector, we take this smoothing approach
     const double delta = 0.05;
-    double z0, zfront, zleft;
-    z0 = GetHeight(loc);
+    double zfront, zleft;
     zfront = GetHeight(ChWorldFrame::FromISO(loc_ISO + ChVector<>(delta, 0, 0)));
     zleft = GetHeight(ChWorldFrame::FromISO(loc_ISO + ChVector<>(0, delta, 0)));
     ChVector<> p0(loc_ISO.x(), loc_ISO.y(), z0);
@@ -293,6 +296,27 @@ float CRGTerrain::GetCoefficientFriction(const ChVector<>& loc) const {
     return m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
 }
 
+void CRGTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const {
+    height = GetHeight(loc);
+    normal = CalcNormal(loc, height);
+    friction = m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
+}
+
+// Note that the CRG evaluation functions are not thread-safe, so the query points are processed sequentially.
+void CRGTerrain::GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                    std::vector<double>& height,
+                                    std::vector<ChVector<>>& normal,
+                                    std::vector<float>& friction) const {
+    height.resize(loc.size());
+    normal.resize(loc.size());
+    friction.resize(loc.size());
+    for (size_t i = 0; i < loc.size(); i++) {
+        height[i] = GetHeight(loc[i]);
+        normal[i] = CalcNormal(loc[i], height[i]);
+        friction[i] = m_friction_fun ? (*m_friction_fun)(loc[i]) : m_friction;
+    }
+}
+
 std::shared_ptr<ChBezierCurve> CRGTerrain::GetRoadCenterLine() {
     std::vector<ChVector<>> pathpoints;
 
@@ -92,6 +92,17 @@ class CH_VEHICLE_API CRGTerrain : public ChTerrain {
     /// Otherwise, it returns the constant value specified at construction.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get all terrain characteristics at the point below the specified location.
+    /// The terrain height is evaluated only once and reused in the calculation of the terrain normal.
+    virtual void GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const override;
+
+    /// Get all terrain characteristics at the points below each of the specified locations.
+    /// The terrain height at each location is evaluated only once and reused in the calculation of the terrain normal.
+    virtual void GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                    std::vector<double>& height,
+                                    std::vector<ChVector<>>& normal,
+                                    std::vector<float>& friction) const override;
+
     /// Get the road center line as a Bezier curve.
     std::shared_ptr<ChBezierCurve> GetRoadCenterLine();
 
@@ -147,6 +158,9 @@ class CH_VEHICLE_API CRGTerrain : public ChTerrain {
     void GenerateCurves();
     void SetRoadsidePosts();
 
+    /// Calculate the terrain normal below the specified location, given the terrain height at that location.
+    ChVector<> CalcNormal(const ChVector<>& loc, double height) const;
+
     double m_post_distance; // 0 means no posts
     std::string m_texture_filename;
     bool m_use_texture; // if set, use a textured mesh
@@ -36,5 +36,24 @@ float FlatTerrain::GetCoefficientFriction(const ChVector<>& loc) const {
     return m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
 }
 
+void FlatTerrain::GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const {
+    height.assign(loc.size(), m_height);
+}
+
+void FlatTerrain::GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                     std::vector<double>& height,
+                                     std::vector<ChVector<>>& normal,
+                                     std::vector<float>& friction) const {
+    height.assign(loc.size(), m_height);
+    normal.assign(loc.size(), ChWorldFrame::Vertical());
+    if (m_friction_fun) {
+        friction.resize(loc.size());
+        for (size_t i = 0; i < loc.size(); i++)
+            friction[i] = (*m_friction_fun)(loc[i]);
+    } else {
+        friction.assign(loc.size(), m_friction);
+    }
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -57,6 +57,15 @@ class CH_VEHICLE_API FlatTerrain : public ChTerrain {
     /// Otherwise, it returns the constant value specified at construction.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get the terrain height below each of the specified locations.
+    virtual void GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const override;
+
+    /// Get all terrain characteristics at the points below each of the specified locations.
+    virtual void GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                    std::vector<double>& height,
+                                    std::vector<ChVector<>>& normal,
+                                    std::vector<float>& friction) const override;
+
   private:
     double m_height;   ///< terrain height
     float m_friction;  ///< contact coefficient of friction
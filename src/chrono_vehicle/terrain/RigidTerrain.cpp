@@ -538,12 +538,94 @@ void RigidTerrain::MeshPatch::Initialize() {
         trimesh_shape->SetMesh(m_trimesh, true);
         m_body->AddVisualShape(trimesh_shape);
     }
+
+    BuildGrid();
+}
+
+// Build the height query grid.
+// Each triangle is registered in all grid cells overlapped by the bounding box of its projection onto the grid plane.
+// The cell size is selected such that there are, on average, about 2 triangles per cell.
+void RigidTerrain::MeshPatch::BuildGrid() {
+    const auto& vertices = m_trimesh->getCoordsVertices();
+    const auto& faces = m_trimesh->getIndicesVertexes();
+    int num_faces = (int)faces.size();
+
+    m_cell_start.clear();
+    m_cell_tris.clear();
+    if (num_faces == 0)
+        return;
+
+    // Grid directions, orthogonal to the vertical direction expressed in the patch frame
+    ChVector<> dir;
+    m_vertical = m_body->TransformDirectionParentToLocal(ChWorldFrame::Vertical());
+    m_vertical.DirToDxDyDz(dir, m_axis_u, m_axis_v);
+
+    // Bounds of the projected mesh
+    double umin = std::numeric_limits<double>::max();
+    double vmin = std::numeric_limits<double>::max();
+    double umax = std::numeric_limits<double>::lowest();
+    double vmax = std::numeric_limits<double>::lowest();
+    for (const auto& v : vertices) {
+        double u = Vdot(v, m_axis_u);
+        double w = Vdot(v, m_axis_v);
+        umin = std::min(umin, u);
+        umax = std::max(umax, u);
+        vmin = std::min(vmin, w);
+        vmax = std::max(vmax, w);
+    }
+
+    double delta = std::sqrt(2 * (umax - umin) * (vmax - vmin) / num_faces);
+    if (delta <= 0)
+        delta = std::max(std::max(umax - umin, vmax - vmin), 1e-6);
+
+    m_grid_umin = umin;
+    m_grid_vmin = vmin;
+    m_grid_inv_delta = 1 / delta;
+    m_grid_nu = std::max(1, (int)std::ceil((umax - umin) * m_grid_inv_delta));
+    m_grid_nv = std::max(1, (int)std::ceil((vmax - vmin) * m_grid_inv_delta));
+
+    // Range of grid cells overlapped by the projection of a triangle
+    auto cell_range = [&](const ChVector<int>& f, int& iu0, int& iu1, int& iv0, int& iv1) {
+        double u[3], w[3];
+        for (int k = 0; k < 3; k++) {
+            u[k] = (Vdot(vertices[f[k]], m_axis_u) - m_grid_umin) * m_grid_inv_delta;
+            w[k] = (Vdot(vertices[f[k]], m_axis_v) - m_grid_vmin) * m_grid_inv_delta;
+        }
+        iu0 = ChClamp((int)std::floor(std::min({u[0], u[1], u[2]})), 0, m_grid_nu - 1);
+        iu1 = ChClamp((int)std::floor(std::max({u[0], u[1], u[2]})), 0, m_grid_nu - 1);
+        iv0 = ChClamp((int)std::floor(std::min({w[0], w[1], w[2]})), 0, m_grid_nv - 1);
+        iv1 = ChClamp((int)std::floor(std::max({w[0], w[1], w[2]})), 0, m_grid_nv - 1);
+    };
+
+    // Count the triangles in each cell, then store the triangle indices
+    m_cell_start.assign(m_grid_nu * m_grid_nv + 1, 0);
+    for (int it = 0; it < num_faces; it++) {
+        int iu0, iu1, iv0, iv1;
+        cell_range(faces[it], iu0, iu1, iv0, iv1);
+        for (int iv = iv0; iv <= iv1; iv++)
+            for (int iu = iu0; iu <= iu1; iu++)
+                m_cell_start[iv * m_grid_nu + iu + 1]++;
+    }
+
+    for (size_t i = 1; i < m_cell_start.size(); i++)
+        m_cell_start[i] += m_cell_start[i - 1];
+
+    std::vector<int> cell_next(m_cell_start.begin(), m_cell_start.end() - 1);
+    m_cell_tris.resize(m_cell_start.back());
+    for (int it = 0; it < num_faces; it++) {
+        int iu0, iu1, iv0, iv1;
+        cell_range(faces[it], iu0, iu1, iv0, iv1);
+        for (int iv = iv0; iv <= iv1; iv++)
+            for (int iu = iu0; iu <= iu1; iu++)
+                m_cell_tris[cell_next[iv * m_grid_nu + iu]++] = it;
+    }
 }
 
 // -----------------------------------------------------------------------------
 // Functions for obtaining the terrain height, normal, and coefficient of
 // friction  at the specified location.
-// This is done by casting vertical rays into each patch collision model.
+// This is done by intersecting vertical rays with each patch (using the query
+// grid of mesh patches, or ray casting into the patch collision model).
 // -----------------------------------------------------------------------------
 double RigidTerrain::GetHeight(const ChVector<>& loc) const {
     if (m_height_fun)
@@ -609,6 +691,53 @@ void RigidTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector
         friction = (*m_friction_fun)(loc);
 }
 
+// Minimum number of points in a batch query for processing it in parallel.
+// A single query on a box or grid patch is cheap, so small batches (e.g., the few points sampled by a tire contact
+// model) are faster without the overhead of an OpenMP parallel region.
+static const int batch_parallel_min = 512;
+
+// Number of threads for batch queries.
+// Queries are processed sequentially for small batches, if user-provided functors are present (not assumed
+// thread-safe), or if any mesh patch requires ray casting into its collision model.
+int RigidTerrain::GetNumQueryThreads(int num_points) const {
+    if (num_points < batch_parallel_min)
+        return 1;
+    if (m_height_fun || m_normal_fun || m_friction_fun)
+        return 1;
+    for (const auto& patch : m_patches) {
+        if (patch->m_type != PatchType::BOX && !std::static_pointer_cast<MeshPatch>(patch)->UseGrid())
+            return 1;
+    }
+    return m_system->GetNumThreadsChrono();
+}
+
+void RigidTerrain::GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const {
+    int num_points = (int)loc.size();
+    height.resize(num_points);
+
+    int nthreads = GetNumQueryThreads(num_points);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < num_points; i++) {
+        height[i] = GetHeight(loc[i]);
+    }
+}
+
+void RigidTerrain::GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                      std::vector<double>& height,
+                                      std::vector<ChVector<>>& normal,
+                                      std::vector<float>& friction) const {
+    int num_points = (int)loc.size();
+    height.resize(num_points);
+    normal.resize(num_points);
+    friction.resize(num_points);
+
+    int nthreads = GetNumQueryThreads(num_points);
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < num_points; i++) {
+        GetProperties(loc[i], height[i], normal[i], friction[i]);
+    }
+}
+
 bool RigidTerrain::FindPoint(const ChVector<> loc, double& height, ChVector<>& normal, float& friction) const {
     bool hit = false;
     height = std::numeric_limits<double>::lowest();
@@ -646,7 +775,93 @@ bool RigidTerrain::BoxPatch::FindPoint(const ChVector<>& loc, double& height, Ch
     return std::abs(Cl.x()) <= m_hlength && std::abs(Cl.y()) <= m_hwidth;
 }
 
+// Intersect the line through point p, along the unit direction d, with the triangle (A,B,C).
+// The point is first projected onto the plane normal to d (spanned by the orthonormal directions u and v). If the
+// projection is inside the projected triangle, return the coordinate along d of the intersection point and the
+// triangle normal (oriented along d).
+static bool IntersectTriangle(const ChVector<>& p,
+                              const ChVector<>& d,
+                              const ChVector<>& u,
+                              const ChVector<>& v,
+                              const ChVector<>& A,
+                              const ChVector<>& B,
+                              const ChVector<>& C,
+                              double& s,
+                              ChVector<>& normal) {
+    ChVector<> AB = B - A;
+    ChVector<> AC = C - A;
+    ChVector<> AP = p - A;
+
+    double ab_u = Vdot(AB, u), ab_v = Vdot(AB, v);
+    double ac_u = Vdot(AC, u), ac_v = Vdot(AC, v);
+    double ap_u = Vdot(AP, u), ap_v = Vdot(AP, v);
+
+    // Skip triangles parallel to d
+    double det = ab_u * ac_v - ab_v * ac_u;
+    if (std::abs(det) < 1e-14 * (AB.Length2() + AC.Length2()))
+        return false;
+
+    // Barycentric coordinates of the projected point (with a small tolerance to avoid gaps at shared edges)
+    double b1 = (ap_u * ac_v - ap_v * ac_u) / det;
+    double b2 = (ab_u * ap_v - ab_v * ap_u) / det;
+    const double eps = 1e-10;
+    if (b1 < -eps || b2 < -eps || b1 + b2 > 1 + eps)
+        return false;
+
+    s = Vdot(A, d) + b1 * Vdot(AB, d) + b2 * Vdot(AC, d);
+    normal = Vcross(AB, AC).GetNormalized();
+    if (Vdot(normal, d) < 0)
+        normal = -normal;
+
+    return true;
+}
+
+// The query grid is used unless the patch was rotated after initialization.
+bool RigidTerrain::MeshPatch::UseGrid() const {
+    ChVector<> vertical = m_body->TransformDirectionParentToLocal(ChWorldFrame::Vertical());
+    return !m_cell_start.empty() && (vertical - m_vertical).Length2() < 1e-20;
+}
+
 bool RigidTerrain::MeshPatch::FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const {
+    if (UseGrid()) {
+        ChVector<> p = m_body->TransformPointParentToLocal(loc);
+
+        // Grid cell containing the projection of the query point
+        double fu = (Vdot(p, m_axis_u) - m_grid_umin) * m_grid_inv_delta;
+        double fv = (Vdot(p, m_axis_v) - m_grid_vmin) * m_grid_inv_delta;
+        if (fu < -1e-6 || fv < -1e-6 || fu > m_grid_nu + 1e-6 || fv > m_grid_nv + 1e-6)
+            return false;
+        int cell = ChClamp((int)std::floor(fv), 0, m_grid_nv - 1) * m_grid_nu +
+                   ChClamp((int)std::floor(fu), 0, m_grid_nu - 1);
+
+        // Find the highest intersection with the triangles in this cell
+        const auto& vertices = m_trimesh->getCoordsVertices();
+        const auto& faces = m_trimesh->getIndicesVertexes();
+        bool hit = false;
+        double s_max = std::numeric_limits<double>::lowest();
+        ChVector<> n_max;
+        for (int k = m_cell_start[cell]; k < m_cell_start[cell + 1]; k++) {
+            const auto& f = faces[m_cell_tris[k]];
+            double s;
+            ChVector<> n;
+            if (IntersectTriangle(p, m_vertical, m_axis_u, m_axis_v, vertices[f[0]], vertices[f[1]], vertices[f[2]],
+                                  s, n) &&
+                s > s_max) {
+                hit = true;
+                s_max = s;
+                n_max = n;
+            }
+        }
+
+        if (hit) {
+            ChVector<> point = p + (s_max - Vdot(p, m_vertical)) * m_vertical;
+            height = ChWorldFrame::Height(m_body->TransformPointLocalToParent(point));
+            normal = m_body->TransformDirectionLocalToParent(n_max);
+        }
+
+        return hit;
+    }
+
     ChVector<> from = loc + (m_radius + 1000) * ChWorldFrame::Vertical();
     ChVector<> to = loc - (m_radius + 1000) * ChWorldFrame::Vertical();
 
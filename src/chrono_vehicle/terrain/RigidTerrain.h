@@ -182,7 +182,20 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// Get all terrain characteristics at the point below the specified location.
     /// This is more efficient than calling GetHeight, GetNormal, and GetCoefficientFriction separately as it performs a
     /// single ray-casting operation (if needed at all).
-    virtual void GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const;
+    virtual void GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const override;
+
+    /// Get the terrain height below each of the specified locations.
+    /// If possible (no user-provided functors and no patch requiring ray casting), the query points are processed in
+    /// parallel, using the number of threads set for the containing system.
+    virtual void GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const override;
+
+    /// Get all terrain characteristics at the points below each of the specified locations.
+    /// If possible (no user-provided functors and no patch requiring ray casting), the query points are processed in
+    /// parallel, using the number of threads set for the containing system.
+    virtual void GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                    std::vector<double>& height,
+                                    std::vector<ChVector<>>& normal,
+                                    std::vector<float>& friction) const override;
 
     /// Export all patch meshes as macros in PovRay include files.
     void ExportMeshPovray(const std::string& out_dir, bool smoothed = false);
@@ -213,12 +226,28 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     };
 
     /// Patch represented as a mesh.
+    /// Height queries use a uniform 2D grid of triangle lists, built at initialization in the plane normal to the
+    /// vertical direction. The triangles in the grid cell below the query point are then intersected exactly with the
+    /// vertical line through that point. If the patch is rotated after initialization, queries revert to ray casting
+    /// into the patch collision model.
     struct CH_VEHICLE_API MeshPatch : public Patch {
         std::shared_ptr<geometry::ChTriangleMeshConnected> m_trimesh;  ///< associated mesh (contact and visualization)
         std::shared_ptr<geometry::ChTriangleMeshSoup> m_trimesh_s;     ///< associated contact mesh soup
         std::string m_mesh_name;                                       ///< name of associated mesh
+        ChVector<> m_vertical;                                         ///< vertical direction (patch frame)
+        ChVector<> m_axis_u;                                           ///< first grid direction (patch frame)
+        ChVector<> m_axis_v;                                           ///< second grid direction (patch frame)
+        double m_grid_umin;                                            ///< grid lower bound in first direction
+        double m_grid_vmin;                                            ///< grid lower bound in second direction
+        double m_grid_inv_delta;                                       ///< inverse of grid cell size
+        int m_grid_nu;                                                 ///< number of grid cells in first direction
+        int m_grid_nv;                                                 ///< number of grid cells in second direction
+        std::vector<int> m_cell_start;                                 ///< start of each cell in m_cell_tris
+        std::vector<int> m_cell_tris;                                  ///< mesh triangles in each grid cell
         virtual void Initialize() override;
         virtual bool FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const override;
+        void BuildGrid();
+        bool UseGrid() const;
         virtual void ExportMeshPovray(const std::string& out_dir, bool smoothed = false) override;
         virtual void ExportMeshWavefront(const std::string& out_dir) override;
     };
@@ -233,6 +262,7 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
                   const ChCoordsys<>& position,
                   std::shared_ptr<ChMaterialSurface> material);
     void LoadPatch(const rapidjson::Value& a);
+    int GetNumQueryThreads(int num_points) const;
 
     int m_collision_family;
 };
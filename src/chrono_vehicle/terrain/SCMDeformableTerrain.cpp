@@ -17,9 +17,11 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cmath>
-#include <queue>
+#include <new>
 #include <unordered_set>
 #include <limits>
 
@@ -27,6 +29,19 @@
     #include <omp.h>
 #endif
 
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #undef WIN32_LEAN_AND_MEAN
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
 #include "chrono/assets/ChTexture.h"
@@ -75,6 +90,60 @@ float SCMDeformableTerrain::GetCoefficientFriction(const ChVector<>& loc) const
     return m_friction_fun ? (*m_friction_fun)(loc) : 0.8f;
 }
 
+// Return all terrain characteristics at the specified location.
+void SCMDeformableTerrain::GetProperties(const ChVector<>& loc,
+                                         double& height,
+                                         ChVector<>& normal,
+                                         float& friction) const {
+    m_ground->GetHeightNormal(loc, height, normal);
+    friction = m_friction_fun ? (*m_friction_fun)(loc) : 0.8f;
+}
+
+// Minimum number of points in a batch query for processing it in parallel.
+// Small batches (e.g., the few points sampled by a tire contact model) are faster without the overhead of an OpenMP
+// parallel region.
+static const int batch_parallel_min = 256;
+
+// Return the terrain height at the specified locations.
+void SCMDeformableTerrain::GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const {
+    int num_points = (int)loc.size();
+    height.resize(num_points);
+
+    int nthreads = m_ground->GetSystem() ? m_ground->GetSystem()->GetNumThreadsChrono() : 1;
+    if (num_points < batch_parallel_min)
+        nthreads = 1;
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < num_points; i++) {
+        height[i] = m_ground->GetHeight(loc[i]);
+    }
+}
+
+// Return all terrain characteristics at the specified locations.
+void SCMDeformableTerrain::GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                              std::vector<double>& height,
+                                              std::vector<ChVector<>>& normal,
+                                              std::vector<float>& friction) const {
+    int num_points = (int)loc.size();
+    height.resize(num_points);
+    normal.resize(num_points);
+
+    int nthreads = m_ground->GetSystem() ? m_ground->GetSystem()->GetNumThreadsChrono() : 1;
+    if (num_points < batch_parallel_min)
+        nthreads = 1;
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < num_points; i++) {
+        m_ground->GetHeightNormal(loc[i], height[i], normal[i]);
+    }
+
+    if (m_friction_fun) {
+        friction.resize(num_points);
+        for (int i = 0; i < num_points; i++)
+            friction[i] = (*m_friction_fun)(loc[i]);
+    } else {
+        friction.assign(num_points, 0.8f);
+    }
+}
+
 // Get SCM information at the node closest to the specified location.
 SCMDeformableTerrain::NodeInfo SCMDeformableTerrain::GetNodeInfo(const ChVector<>& loc) const {
     return m_ground->GetNodeInfo(loc);
@@ -196,6 +265,12 @@ void SCMDeformableTerrain::AddMovingPatch(std::shared_ptr<ChBody> body,
     m_ground->m_moving_patch = true;
 }
 
+// Enable paging of grid node tiles.
+void SCMDeformableTerrain::EnableTilePaging(const std::string& filename, double distance) {
+    m_ground->m_grid.OpenPageFile(filename);
+    m_ground->m_paging_distance = distance;
+}
+
 // Set user-supplied callback for evaluating location-dependent soil parameters.
 void SCMDeformableTerrain::RegisterSoilParametersCallback(std::shared_ptr<SoilParametersCallback> cb) {
     m_ground->m_soil_fun = cb;
@@ -264,6 +339,14 @@ int SCMDeformableTerrain::GetNumErosionNodes() const {
     return m_ground->m_num_erosion_nodes;
 }
 
+int SCMDeformableTerrain::GetNumTiles() const {
+    return m_ground->m_grid.GetNumTiles();
+}
+
+int SCMDeformableTerrain::GetNumPagedTiles() const {
+    return m_ground->m_grid.GetNumPagedTiles();
+}
+
 // Timer information
 double SCMDeformableTerrain::GetTimerMovingPatches() const {
     return 1e3 * m_ground->m_timer_moving_patches();
@@ -306,6 +389,8 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << "   Number ray hits:         " << m_ground->m_num_ray_hits << std::endl;
     os << "   Number contact patches:  " << m_ground->m_num_contact_patches << std::endl;
     os << "   Number erosion nodes:    " << m_ground->m_num_erosion_nodes << std::endl;
+    os << "   Number node tiles:       " << m_ground->m_grid.GetNumTiles() << std::endl;
+    os << "   Number paged tiles:      " << m_ground->m_grid.GetNumPagedTiles() << std::endl;
 }
 
 // -----------------------------------------------------------------------------
@@ -321,6 +406,227 @@ SCMContactableData::SCMContactableData(double area_ratio,
       Mohr_mu(std::tan(Mohr_friction * CH_C_DEG_TO_RAD)),
       Janosi_shear(Janosi_shear) {}
 
+// -----------------------------------------------------------------------------
+// Implementation of the SCM node store
+// -----------------------------------------------------------------------------
+
+// Memory-mapped file holding the data of paged-out node tiles.
+// The file grows by segments, each mapped separately, so that the address of a slot does not change when the file
+// grows. Segment k holds FIRST_SEGMENT_SLOTS * 2^k tile slots, so that the file size at most doubles when it grows and
+// the number of mappings (limited by the OS, e.g. vm.max_map_count on Linux) grows only logarithmically with the number
+// of paged-out tiles. The slot size is a multiple of 4 KB, so that segment offsets are multiples of 64 KB (the
+// allocation granularity on Windows).
+class SCMDeformableSoil::NodeStore::PageFile {
+  public:
+    PageFile(const std::string& filename);
+    ~PageFile();
+
+    // Return a free slot, growing the file if needed.
+    int Allocate();
+
+    // Release the specified slot.
+    void Free(int slot) { m_free.push_back(slot); }
+
+    // Return the address of the specified slot.
+    void* GetSlot(int slot) const {
+        int k = GetSegment(slot);
+        return m_segments[k] + (slot - GetSegmentFirst(k)) * SLOT_SIZE;
+    }
+
+  private:
+    static const int FIRST_SEGMENT_SLOTS = 64;
+    static const size_t SLOT_SIZE = ((sizeof(TileData) + 4095) / 4096) * 4096;
+
+    // Number of slots in segment k.
+    static int GetSegmentSlots(int k) { return FIRST_SEGMENT_SLOTS << k; }
+
+    // Index of the first slot in segment k.
+    static int GetSegmentFirst(int k) { return FIRST_SEGMENT_SLOTS * ((1 << k) - 1); }
+
+    // Index of the segment containing the specified slot.
+    static int GetSegment(int slot) {
+        int k = 0;
+        for (int n = slot / FIRST_SEGMENT_SLOTS + 1; n > 1; n >>= 1)
+            k++;
+        return k;
+    }
+
+    std::string m_filename;
+    std::vector<char*> m_segments;  // mapped file segments
+    std::vector<int> m_free;        // free slots
+#ifdef _WIN32
+    HANDLE m_file;
+    std::vector<HANDLE> m_mappings;
+#else
+    int m_file;
+#endif
+};
+
+SCMDeformableSoil::NodeStore::PageFile::PageFile(const std::string& filename) : m_filename(filename) {
+#ifdef _WIN32
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                         NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw ChException("Cannot open SCM page file " + filename);
+#else
+    m_file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_file < 0)
+        throw ChException("Cannot open SCM page file " + filename);
+#endif
+}
+
+SCMDeformableSoil::NodeStore::PageFile::~PageFile() {
+#ifdef _WIN32
+    for (auto segment : m_segments)
+        UnmapViewOfFile(segment);
+    for (auto mapping : m_mappings)
+        CloseHandle(mapping);
+    CloseHandle(m_file);
+#else
+    for (int k = 0; k < (int)m_segments.size(); k++)
+        munmap(m_segments[k], GetSegmentSlots(k) * SLOT_SIZE);
+    close(m_file);
+#endif
+}
+
+int SCMDeformableSoil::NodeStore::PageFile::Allocate() {
+    if (m_free.empty()) {
+        // Grow the file by one segment and map the new segment
+        int k = (int)m_segments.size();
+        size_t segment_size = GetSegmentSlots(k) * SLOT_SIZE;
+        unsigned long long offset = GetSegmentFirst(k) * (unsigned long long)SLOT_SIZE;
+        unsigned long long size = offset + segment_size;
+#ifdef _WIN32
+        HANDLE mapping = CreateFileMappingA(m_file, NULL, PAGE_READWRITE, (DWORD)(size >> 32),
+                                            (DWORD)(size & 0xFFFFFFFF), NULL);
+        if (mapping == NULL)
+            throw ChException("Cannot grow SCM page file " + m_filename);
+        void* addr = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, (DWORD)(offset >> 32), (DWORD)(offset & 0xFFFFFFFF),
+                                   segment_size);
+        if (addr == NULL) {
+            CloseHandle(mapping);
+            throw ChException("Cannot map SCM page file " + m_filename);
+        }
+        m_mappings.push_back(mapping);
+#else
+        if (ftruncate(m_file, (off_t)size) != 0)
+            throw ChException("Cannot grow SCM page file " + m_filename);
+        void* addr = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, (off_t)offset);
+        if (addr == MAP_FAILED)
+            throw ChException("Cannot map SCM page file " + m_filename);
+#endif
+        int first = GetSegmentFirst(k);
+        m_segments.push_back(static_cast<char*>(addr));
+        for (int n = GetSegmentSlots(k) - 1; n >= 0; n--)
+            m_free.push_back(first + n);
+    }
+
+    int slot = m_free.back();
+    m_free.pop_back();
+    return slot;
+}
+
+SCMDeformableSoil::NodeStore::TileData::TileData() {
+    std::fill(used, used + TILE_NODES, 0);
+}
+
+SCMDeformableSoil::NodeStore::Tile::Tile()
+    : hit(new std::atomic<int>[TILE_NODES]), data(new TileData), slot(-1) {
+    nodes = data->nodes;
+    used = data->used;
+    for (int n = 0; n < TILE_NODES; n++)
+        hit[n] = -1;
+}
+
+SCMDeformableSoil::NodeStore::NodeStore() {}
+
+SCMDeformableSoil::NodeStore::~NodeStore() {}
+
+SCMDeformableSoil::NodeStore::Tile* SCMDeformableSoil::NodeStore::GetTile(const ChVector2<int>& tij) const {
+    auto t = m_tiles.find(tij);
+    if (t == m_tiles.end())
+        return nullptr;
+    return t->second.get();
+}
+
+SCMDeformableSoil::NodeStore::Tile* SCMDeformableSoil::NodeStore::AddTile(const ChVector2<int>& tij) {
+    auto& tile = m_tiles[tij];
+    if (!tile) {
+        tile = std::unique_ptr<Tile>(new Tile);
+        m_resident.push_back(tij);
+    } else if (tile->slot != -1) {
+        PageIn(*tile);
+        m_resident.push_back(tij);
+    }
+    return tile.get();
+}
+
+SCMDeformableSoil::NodeRecord* SCMDeformableSoil::NodeStore::Find(const ChVector2<int>& ij) const {
+    Tile* tile = GetTile(TileCoords(ij));
+    if (!tile)
+        return nullptr;
+    int n = NodeIndex(ij);
+    return tile->used[n] ? &tile->nodes[n] : nullptr;
+}
+
+SCMDeformableSoil::NodeRecord& SCMDeformableSoil::NodeStore::At(const ChVector2<int>& ij) const {
+    NodeRecord* nr = Find(ij);
+    assert(nr);
+    return *nr;
+}
+
+SCMDeformableSoil::NodeRecord& SCMDeformableSoil::NodeStore::Insert(const ChVector2<int>& ij, const NodeRecord& nr) {
+    Tile* tile = AddTile(TileCoords(ij));
+    int n = NodeIndex(ij);
+    tile->nodes[n] = nr;
+    tile->used[n] = 1;
+    return tile->nodes[n];
+}
+
+void SCMDeformableSoil::NodeStore::OpenPageFile(const std::string& filename) {
+    // Bring back into memory any tiles paged out to a previous file
+    for (auto& t : m_tiles) {
+        if (t.second->slot != -1) {
+            PageIn(*t.second);
+            m_resident.push_back(t.first);
+        }
+    }
+    m_file.reset();
+    m_file = std::unique_ptr<PageFile>(new PageFile(filename));
+}
+
+void SCMDeformableSoil::NodeStore::PageOut(Tile& tile) {
+    assert(tile.slot == -1);
+    int slot = m_file->Allocate();
+    TileData* data = new (m_file->GetSlot(slot)) TileData(*tile.data);
+    tile.nodes = data->nodes;
+    tile.used = data->used;
+    tile.hit.reset();
+    tile.data.reset();
+    tile.slot = slot;
+}
+
+void SCMDeformableSoil::NodeStore::PageIn(Tile& tile) {
+    assert(tile.slot != -1);
+    tile.data = std::unique_ptr<TileData>(new TileData(*static_cast<TileData*>(m_file->GetSlot(tile.slot))));
+    tile.hit = std::unique_ptr<std::atomic<int>[]>(new std::atomic<int>[TILE_NODES]);
+    for (int n = 0; n < TILE_NODES; n++)
+        tile.hit[n] = -1;
+    tile.nodes = tile.data->nodes;
+    tile.used = tile.data->used;
+    m_file->Free(tile.slot);
+    tile.slot = -1;
+}
+
+void SCMDeformableSoil::NodeStore::Clear() {
+    for (auto& t : m_tiles) {
+        if (t.second->slot != -1)
+            m_file->Free(t.second->slot);
+    }
+    m_tiles.clear();
+    m_resident.clear();
+}
+
 // -----------------------------------------------------------------------------
 // Implementation of SCMDeformableSoil
 // -----------------------------------------------------------------------------
@@ -365,6 +671,8 @@ SCMDeformableSoil::SCMDeformableSoil(ChSystem* system, bool visualization_mesh)
     m_test_offset_down = 0.5;
 
     m_moving_patch = false;
+
+    m_paging_distance = 0;
 }
 
 // Initialize the terrain as a flat grid
@@ -678,16 +986,15 @@ SCMDeformableTerrain::NodeInfo SCMDeformableSoil::GetNodeInfo(const ChVector<>&
     int j = static_cast<int>(std::round(loc_loc.y() / m_delta));
     ChVector2<int> ij(i, j);
 
-    // First query the hash-map
-    auto p = m_grid_map.find(ij);
-    if (p != m_grid_map.end()) {
-        ni.sinkage = p->second.sinkage;
-        ni.sinkage_plastic = p->second.sinkage_plastic;
-        ni.sinkage_elastic = p->second.sinkage_elastic;
-        ni.sigma = p->second.sigma;
-        ni.sigma_yield = p->second.sigma_yield;
-        ni.kshear = p->second.kshear;
-        ni.tau = p->second.tau;
+    // First query the node store
+    if (const NodeRecord* nr = m_grid.Find(ij)) {
+        ni.sinkage = nr->sinkage;
+        ni.sinkage_plastic = nr->sinkage_plastic;
+        ni.sinkage_elastic = nr->sinkage_elastic;
+        ni.sigma = nr->sigma;
+        ni.sigma_yield = nr->sigma_yield;
+        ni.kshear = nr->kshear;
+        ni.tau = nr->tau;
         return ni;
     }
 
@@ -771,10 +1078,9 @@ ChVector<> SCMDeformableSoil::GetInitNormal(const ChVector2<int>& loc) const {
 
 // Get the terrain height (relative to the SCM plane) at the specified grid vertex.
 double SCMDeformableSoil::GetHeight(const ChVector2<int>& loc) const {
-    // First query the hash-map
-    auto p = m_grid_map.find(loc);
-    if (p != m_grid_map.end())
-        return p->second.level;
+    // First query the node store
+    if (const NodeRecord* nr = m_grid.Find(loc))
+        return nr->level;
 
     // Else return undeformed height
     return GetInitHeight(loc);
@@ -858,6 +1164,23 @@ ChVector<> SCMDeformableSoil::GetNormal(const ChVector<>& loc) const {
     return ChWorldFrame::FromISO(nrm_abs);
 }
 
+// Get the terrain height and normal at the point below the specified location.
+void SCMDeformableSoil::GetHeightNormal(const ChVector<>& loc, double& height, ChVector<>& normal) const {
+    // Express location in the SCM frame
+    ChVector<> loc_loc = m_plane.TransformPointParentToLocal(loc);
+
+    // Get height and normal (relative to SCM plane) at closest grid vertex (approximation)
+    int i = static_cast<int>(std::round(loc_loc.x() / m_delta));
+    int j = static_cast<int>(std::round(loc_loc.y() / m_delta));
+    loc_loc.z() = GetHeight(ChVector2<int>(i, j));
+    auto nrm_loc = GetNormal(ChVector2<int>(i, j));
+
+    // Express in global frame
+    ChVector<> loc_abs = m_plane.TransformPointLocalToParent(loc_loc);
+    height = ChWorldFrame::Height(loc_abs);
+    normal = ChWorldFrame::FromISO(m_plane.TransformDirectionLocalToParent(nrm_loc));
+}
+
 // Synchronize information for a moving patch
 void SCMDeformableSoil::UpdateMovingPatch(MovingPatchInfo& p, const ChVector<>& Z) {
     ChVector2<> p_min(+std::numeric_limits<double>::max());
@@ -897,6 +1220,8 @@ void SCMDeformableSoil::UpdateMovingPatch(MovingPatchInfo& p, const ChVector<>&
             p.m_range[j * n_x + i] = ChVector2<int>(i + x_min, j + y_min);
         }
     }
+    p.m_min = ChVector2<int>(x_min, y_min);
+    p.m_max = ChVector2<int>(x_max, y_max);
 
     // Calculate inverse of SCM normal expressed in body frame (for optimization of ray-OBB test)
     ChVector<> dir = p.m_body->TransformDirectionParentToLocal(Z);
@@ -947,6 +1272,8 @@ void SCMDeformableSoil::UpdateFixedPatch(MovingPatchInfo& p) {
             p.m_range[j * n_x + i] = ChVector2<int>(i + x_min, j + y_min);
         }
     }
+    p.m_min = ChVector2<int>(x_min, y_min);
+    p.m_max = ChVector2<int>(x_max, y_max);
 }
 
 // Ray-OBB intersection test
@@ -991,9 +1318,41 @@ static const std::vector<ChVector2<int>> neighbors4{
     ChVector2<int>(0, 1)    // N
 };
 
-// Default implementation uses Map-Reduce for collecting ray intersection hits.
-// The alternative is to simultaenously load the global map of hits while ray casting (using a critical section).
-////#define RAY_CASTING_WITH_CRITICAL_SECTION
+// Number of grid nodes in the blocks processed by one thread during ray casting.
+// Ray hits are collected separately for each block, so that they can be merged without locking and in an order that
+// does not depend on the number of threads.
+static const int ray_casting_block = 1024;
+
+// Find the root of the set containing element x in a union-find forest.
+// Safe for concurrent use with SetUnion (uses path halving with atomic updates).
+static int SetFind(std::atomic<int>* parent, int x) {
+    while (true) {
+        int p = parent[x].load();
+        if (p == x)
+            return x;
+        int gp = parent[p].load();
+        if (gp != p)
+            parent[x].compare_exchange_weak(p, gp);
+        x = gp;
+    }
+}
+
+// Merge the sets containing elements a and b in a union-find forest (lock-free).
+// The larger root is always linked to the smaller one, so that the root of any set is its smallest element,
+// regardless of the order in which concurrent merges are performed.
+static void SetUnion(std::atomic<int>* parent, int a, int b) {
+    while (true) {
+        a = SetFind(parent, a);
+        b = SetFind(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+        int expected = a;
+        if (parent[a].compare_exchange_strong(expected, b))
+            return;
+    }
+}
 
 // Reset the list of forces, and fills it with forces from a soil contact model.
 void SCMDeformableSoil::ComputeInternalForces() {
@@ -1004,7 +1363,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
     // Reset quantities at grid nodes modified over previous step
     // (required for bulldozing effects and for proper visualization coloring)
     for (const auto& ij : m_modified_nodes) {
-        auto& nr = m_grid_map.at(ij);
+        auto& nr = m_grid.At(ij);
         nr.sigma = 0;
         nr.sinkage_elastic = 0;
         nr.step_plastic_flow = 0;
@@ -1060,37 +1419,50 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
     // Information of vertices with ray-cast hits
     struct HitRecord {
+        ChVector2<int> ij;           // grid node
         ChContactable* contactable;  // pointer to hit object
         ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
+        int patch_id;                // index of associated contact patch
+        NodeStore::Tile* tile;       // tile containing the grid node
+        int node;                    // index of the grid node in its tile
+        bool loaded;                 // true if a soil force is applied at this node
+        ChVector<> force;            // soil force, expressed in global frame
+        ChVector<> point;            // force application point, expressed in global frame
     };
 
-    // Hash-map for vertices with ray-cast hits
-    std::unordered_map<ChVector2<int>, HitRecord, CoordHash> hits;
-
-    m_num_ray_casts = 0;
-    m_num_ray_hits = 0;
+    const int nthreads = GetSystem()->GetNumThreadsChrono();
 
     m_timer_ray_casting.start();
-
-#ifdef RAY_CASTING_WITH_CRITICAL_SECTION
-
-    int nthreads = GetSystem()->GetNumThreadsChrono();
-
-    // Loop through all moving patches (user-defined or default one)
-    for (auto& p : m_patches) {
-        // Loop through all vertices in the patch range
-        int num_ray_casts = 0;
-    #pragma omp parallel for num_threads(nthreads) reduction(+ : num_ray_casts)
-        for (int k = 0; k < p.m_range.size(); k++) {
-            ChVector2<int> ij = p.m_range[k];
+    m_timer_ray_testing.start();
+
+    // Process the grid nodes of all moving patches (user-defined or default one) as a single range,
+    // split in blocks of fixed size, and collect hits in per-block buffers.
+    std::vector<int> patch_start(m_patches.size() + 1, 0);
+    for (size_t ip = 0; ip < m_patches.size(); ip++)
+        patch_start[ip + 1] = patch_start[ip] + (int)m_patches[ip].m_range.size();
+    int num_nodes = patch_start.back();
+    int num_blocks = (num_nodes + ray_casting_block - 1) / ray_casting_block;
+
+    std::vector<std::vector<HitRecord>> b_hits(num_blocks);        // hits in each block
+    std::vector<std::vector<ChVector2<int>>> b_tiles(num_blocks);  // tiles of hit nodes in each block
+
+    int num_ray_casts = 0;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(+ : num_ray_casts)
+    for (int ib = 0; ib < num_blocks; ib++) {
+        int k_start = ib * ray_casting_block;
+        int k_end = std::min(k_start + ray_casting_block, num_nodes);
+        int ip = (int)(std::upper_bound(patch_start.begin(), patch_start.end(), k_start) - patch_start.begin()) - 1;
+
+        for (int k = k_start; k < k_end; k++) {
+            while (k >= patch_start[ip + 1])
+                ip++;
+            const auto& p = m_patches[ip];
+            ChVector2<int> ij = p.m_range[k - patch_start[ip]];
 
             // Move from (i, j) to (x, y, z) representation in the world frame
             double x = ij.x() * m_delta;
             double y = ij.y() * m_delta;
-            double z;
-    #pragma omp critical(SCM_ray_casting)
-            z = GetHeight(ij);
+            double z = GetHeight(ij);
 
             ChVector<> vertex_abs = m_plane.TransformPointLocalToParent(ChVector<>(x, y, z));
 
@@ -1108,90 +1480,79 @@ void SCMDeformableSoil::ComputeInternalForces() {
             num_ray_casts++;
 
             if (mrayhit_result.hit) {
-    #pragma omp critical(SCM_ray_casting)
-                {
-                    // If this is the first hit from this node, initialize the node record
-                    if (m_grid_map.find(ij) == m_grid_map.end()) {
-                        m_grid_map.insert(std::make_pair(ij, NodeRecord(z, z, GetInitNormal(ij))));
-                    }
-
-                    // Add to our map of hits to process
-                    HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-                    hits.insert(std::make_pair(ij, record));
-                    m_num_ray_hits++;
-                }
+                // Add to the hits of this block
+                HitRecord record = {ij, mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
+                b_hits[ib].push_back(record);
+                auto tij = NodeStore::TileCoords(ij);
+                if (b_tiles[ib].empty() || b_tiles[ib].back() != tij)
+                    b_tiles[ib].push_back(tij);
             }
         }
-        m_num_ray_casts += num_ray_casts;
     }
 
-#else
-
-    // Map-reduce approach (to eliminate critical section)
-
-    const int nthreads = GetSystem()->GetNumThreadsChrono();
-    std::vector<std::unordered_map<ChVector2<int>, HitRecord, CoordHash>> t_hits(nthreads);
-
-    // Loop through all moving patches (user-defined or default one)
-    for (auto& p : m_patches) {
-        m_timer_ray_testing.start();
-
-        // Loop through all vertices in the patch range
-        int num_ray_casts = 0;
-    #pragma omp parallel for num_threads(nthreads) reduction(+ : num_ray_casts)
-        for (int k = 0; k < p.m_range.size(); k++) {
-            int t_num = ChOMP::GetThreadNum();
-            ChVector2<int> ij = p.m_range[k];
-
-            // Move from (i, j) to (x, y, z) representation in the world frame
-            double x = ij.x() * m_delta;
-            double y = ij.y() * m_delta;
-            double z = GetHeight(ij);
-
-            ChVector<> vertex_abs = m_plane.TransformPointLocalToParent(ChVector<>(x, y, z));
+    m_num_ray_casts = num_ray_casts;
 
-            // Create ray at current grid location
-            collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
-            ChVector<> to = vertex_abs + m_Z * m_test_offset_up;
-            ChVector<> from = to - m_Z * m_test_offset_down;
+    m_timer_ray_testing.stop();
 
-            // Ray-OBB test (quick rejection)
-            if (m_moving_patch && !RayOBBtest(p, from, m_Z))
-                continue;
+    // Create any missing tiles for the hit nodes (serial, one lookup per tile and block)
+    std::vector<int> hit_start(num_blocks + 1, 0);
+    for (int ib = 0; ib < num_blocks; ib++) {
+        hit_start[ib + 1] = hit_start[ib] + (int)b_hits[ib].size();
+        for (const auto& tij : b_tiles[ib])
+            m_grid.AddTile(tij);
+    }
 
-            // Cast ray into collision system
-            GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-            num_ray_casts++;
+    // Merge the per-block hit buffers
+    int num_hits = hit_start.back();
+    std::vector<HitRecord> hits(num_hits);
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for (int ib = 0; ib < num_blocks; ib++) {
+        std::copy(b_hits[ib].begin(), b_hits[ib].end(), hits.begin() + hit_start[ib]);
+    }
 
-            if (mrayhit_result.hit) {
-                // Add to our map of hits to process
-                HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-                t_hits[t_num].insert(std::make_pair(ij, record));
-            }
+    // Claim the hit nodes.  A node may be hit more than once if moving patches overlap, in which case only the
+    // first hit (in the merged list) is retained.
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        auto& h = hits[i];
+        h.tile = m_grid.GetTile(NodeStore::TileCoords(h.ij));
+        h.node = NodeStore::NodeIndex(h.ij);
+        auto& hit = h.tile->hit[h.node];
+        int crt = hit.load();
+        while ((crt == -1 || i < crt) && !hit.compare_exchange_weak(crt, i)) {
         }
+    }
 
-        m_timer_ray_testing.stop();
-
-        m_num_ray_casts += num_ray_casts;
-
-        // Sequential insertion in global hits
-        for (int t_num = 0; t_num < nthreads; t_num++) {
-            for (auto& h : t_hits[t_num]) {
-                // If this is the first hit from this node, initialize the node record
-                if (m_grid_map.find(h.first) == m_grid_map.end()) {
-                    double z = GetInitHeight(h.first);
-                    m_grid_map.insert(std::make_pair(h.first, NodeRecord(z, z, GetInitNormal(h.first))));
-                }
-                ////hits.insert(h);
-            }
+    // If this is the first hit from a node, initialize the node record.
+    // Each record is initialized by the thread which claimed the node, so no locking is needed.
+    int num_duplicates = 0;
+#pragma omp parallel for num_threads(nthreads) reduction(+ : num_duplicates)
+    for (int i = 0; i < num_hits; i++) {
+        auto& h = hits[i];
+        if (h.tile->hit[h.node].load() != i) {
+            h.tile = nullptr;
+            num_duplicates++;
+            continue;
+        }
+        if (!h.tile->used[h.node]) {
+            double z = GetInitHeight(h.ij);
+            h.tile->nodes[h.node] = NodeRecord(z, z, GetInitNormal(h.ij));
+            h.tile->used[h.node] = 1;
+        }
+    }
 
-            hits.insert(t_hits[t_num].begin(), t_hits[t_num].end());
-            t_hits[t_num].clear();
+    // Discard duplicate hits
+    if (num_duplicates > 0) {
+        hits.erase(std::remove_if(hits.begin(), hits.end(), [](const HitRecord& h) { return h.tile == nullptr; }),
+                   hits.end());
+        num_hits = (int)hits.size();
+#pragma omp parallel for num_threads(nthreads)
+        for (int i = 0; i < num_hits; i++) {
+            hits[i].tile->hit[hits[i].node] = i;
         }
-        m_num_ray_hits = (int)hits.size();
     }
 
-#endif
+    m_num_ray_hits = num_hits;
 
     m_timer_ray_casting.stop();
 
@@ -1211,57 +1572,54 @@ void SCMDeformableSoil::ComputeInternalForces() {
     };
     std::vector<ContactPatchRecord> contact_patches;
 
-    // Loop through all hit nodes and determine to which contact patch they belong.
-    // Use a queue-based flood-filling algorithm based on the neighbors of each hit node.
-    m_num_contact_patches = 0;
-    for (auto& h : hits) {
-        if (h.second.patch_id != -1)
-            continue;
+    // Find the connected sets of hit nodes (contact patches), using a concurrent union-find.
+    // Linking each hit node to its E and N neighbors is sufficient to connect all 4-neighbors.
+    std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[num_hits]);
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        parent[i] = i;
+    }
 
-        ChVector2<int> ij = h.first;
-
-        // Make a new contact patch and add this hit node to it
-        h.second.patch_id = m_num_contact_patches++;
-        ContactPatchRecord patch;
-        patch.nodes.push_back(ij);
-        patch.points.push_back(ChVector2<>(m_delta * ij.x(), m_delta * ij.y()));
-
-        // Add current node to the work queue
-        std::queue<ChVector2<int>> todo;
-        todo.push(ij);
-
-        while (!todo.empty()) {
-            auto crt = hits.find(todo.front());  // Current hit node is first element in queue
-            todo.pop();                          // Remove first element from queue
-
-            ChVector2<int> crt_ij = crt->first;
-            int crt_patch = crt->second.patch_id;
-
-            // Loop through the neighbors of the current hit node
-            for (int k = 0; k < 4; k++) {
-                ChVector2<int> nbr_ij = crt_ij + neighbors4[k];
-                // If neighbor is not a hit node, move on
-                auto nbr = hits.find(nbr_ij);
-                if (nbr == hits.end())
-                    continue;
-                // If neighbor already assigned to a contact patch, move on
-                if (nbr->second.patch_id != -1)
-                    continue;
-                // Assign neighbor to the same contact patch
-                nbr->second.patch_id = crt_patch;
-                // Add neighbor point to patch lists
-                patch.nodes.push_back(nbr_ij);
-                patch.points.push_back(ChVector2<>(m_delta * nbr_ij.x(), m_delta * nbr_ij.y()));
-                // Add neighbor to end of work queue
-                todo.push(nbr_ij);
-            }
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        const auto& h = hits[i];
+        auto tij = NodeStore::TileCoords(h.ij);
+        for (int k = 2; k < 4; k++) {
+            ChVector2<int> nbr_ij = h.ij + neighbors4[k];
+            auto nbr_tij = NodeStore::TileCoords(nbr_ij);
+            const NodeStore::Tile* nbr_tile = (nbr_tij == tij) ? h.tile : m_grid.GetTile(nbr_tij);
+            if (!nbr_tile || !nbr_tile->hit)  // neighbor tile not created or paged out
+                continue;
+            int nbr = nbr_tile->hit[NodeStore::NodeIndex(nbr_ij)].load();
+            if (nbr != -1)
+                SetUnion(parent.get(), i, nbr);
         }
-        contact_patches.push_back(patch);
+    }
+
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        parent[i] = SetFind(parent.get(), i);
+    }
+
+    // Number the contact patches in the order of their first hit node (the root of each set)
+    m_num_contact_patches = 0;
+    for (int i = 0; i < num_hits; i++) {
+        int root = parent[i].load();
+        hits[i].patch_id = (root == i) ? m_num_contact_patches++ : hits[root].patch_id;
+    }
+
+    contact_patches.resize(m_num_contact_patches);
+    for (const auto& h : hits) {
+        auto& patch = contact_patches[h.patch_id];
+        patch.nodes.push_back(h.ij);
+        patch.points.push_back(ChVector2<>(m_delta * h.ij.x(), m_delta * h.ij.y()));
     }
 
     // Calculate area and perimeter of each contact patch.
     // Calculate approximation to Beker term 1/b.
-    for (auto& p : contact_patches) {
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for (int ip = 0; ip < m_num_contact_patches; ip++) {
+        auto& p = contact_patches[ip];
         utils::ChConvexHull2D ch(p.points);
         p.area = ch.GetArea();
         p.perimeter = ch.GetPerimeter();
@@ -1280,29 +1638,31 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
     m_timer_contact_forces.start();
 
-    // Initialize local values for the soil parameters
-    double Bekker_Kphi = m_Bekker_Kphi;
-    double Bekker_Kc = m_Bekker_Kc;
-    double Bekker_n = m_Bekker_n;
-    double Mohr_cohesion = m_Mohr_cohesion;
-    double Mohr_mu = m_Mohr_mu;
-    double Janosi_shear = m_Janosi_shear;
-    double elastic_K = m_elastic_K;
-    double damping_R = m_damping_R;
-
-    // Process only hit nodes
-    for (auto& h : hits) {
-        ChVector2<> ij = h.first;
-
-        auto& nr = m_grid_map.at(ij);      // node record
+    // Process only hit nodes.
+    // Each hit node is processed independently; a user-provided soil parameters callback is invoked serially.
+#pragma omp parallel for num_threads(m_soil_fun ? 1 : nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        auto& h = hits[i];
+
+        auto& nr = h.tile->nodes[h.node];  // node record
         const double& ca = nr.normal.z();  // cosine of angle between local normal and SCM plane vertical
 
-        ChContactable* contactable = h.second.contactable;
-        const ChVector<>& hit_point_abs = h.second.abs_point;
-        int patch_id = h.second.patch_id;
+        ChContactable* contactable = h.contactable;
+        const ChVector<>& hit_point_abs = h.abs_point;
+        int patch_id = h.patch_id;
 
         auto hit_point_loc = m_plane.TransformPointParentToLocal(hit_point_abs);
 
+        // Initialize local values for the soil parameters
+        double Bekker_Kphi = m_Bekker_Kphi;
+        double Bekker_Kc = m_Bekker_Kc;
+        double Bekker_n = m_Bekker_n;
+        double Mohr_cohesion = m_Mohr_cohesion;
+        double Mohr_mu = m_Mohr_mu;
+        double Janosi_shear = m_Janosi_shear;
+        double elastic_K = m_elastic_K;
+        double damping_R = m_damping_R;
+
         if (m_soil_fun) {
             double Mohr_friction;
             m_soil_fun->Set(hit_point_loc, Bekker_Kphi, Bekker_Kc, Bekker_n, Mohr_cohesion, Mohr_friction, Janosi_shear,
@@ -1322,11 +1682,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
             continue;
         }
 
-        // Mark current node as modified
-        m_modified_nodes.push_back(ij);
-
         // Calculate velocity at touched grid node
-        ChVector<> point_local(ij.x() * m_delta, ij.y() * m_delta, nr.level);
+        ChVector<> point_local(h.ij.x() * m_delta, h.ij.y() * m_delta, nr.level);
         ChVector<> point_abs = m_plane.TransformPointLocalToParent(point_local);
         ChVector<> speed_abs = contactable->GetContactPointSpeed(point_abs);
 
@@ -1385,12 +1742,34 @@ void SCMDeformableSoil::ComputeInternalForces() {
             Ft = T * m_area * nr.tau;
         }
 
+        // Cache force and application point (loads are created below, in the order of hits)
+        h.loaded = true;
+        h.force = Fn + Ft;
+        h.point = point_abs;
+
+        // Update grid node height (in local SCM frame, along SCM z axis)
+        nr.level = nr.level_initial - nr.sinkage / ca;
+
+    }  // end loop on ray hits
+
+    // Create loads for all loaded hit nodes
+    for (const auto& h : hits) {
+        if (!h.loaded)
+            continue;
+
+        // Mark current node as modified
+        m_modified_nodes.push_back(h.ij);
+
+        ChContactable* contactable = h.contactable;
+        const ChVector<>& force = h.force;
+        const ChVector<>& point_abs = h.point;
+
         if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
             // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
             // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
             // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
             std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
-            std::shared_ptr<ChLoadBodyForce> mload(new ChLoadBodyForce(srigidbody, Fn + Ft, false, point_abs, false));
+            std::shared_ptr<ChLoadBodyForce> mload(new ChLoadBodyForce(srigidbody, force, false, point_abs, false));
             this->Add(mload);
 
             // Accumulate contact force for this rigid body.
@@ -1399,7 +1778,6 @@ void SCMDeformableSoil::ComputeInternalForces() {
             auto itr = m_contact_forces.find(contactable);
             if (itr == m_contact_forces.end()) {
                 // Create new entry and initialize generalized force.
-                ChVector<> force = Fn + Ft;
                 TerrainForce frc;
                 frc.point = srigidbody->GetPos();
                 frc.force = force;
@@ -1407,7 +1785,6 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 m_contact_forces.insert(std::make_pair(contactable, frc));
             } else {
                 // Update generalized force.
-                ChVector<> force = Fn + Ft;
                 itr->second.force += force;
                 itr->second.moment += Vcross(Vsub(point_abs, srigidbody->GetPos()), force);
             }
@@ -1415,18 +1792,20 @@ void SCMDeformableSoil::ComputeInternalForces() {
             // [](){} Trick: no deletion for this shared ptr
             std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
             std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
-            mload->loader.SetForce(Fn + Ft);
+            mload->loader.SetForce(force);
             mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
             this->Add(mload);
 
             // Accumulate contact forces for this surface.
             //// TODO
         }
+    }
 
-        // Update grid node height (in local SCM frame, along SCM z axis)
-        nr.level = nr.level_initial - nr.sinkage / ca;
-
-    }  // end loop on ray hits
+    // Clear the hit markers in the node store
+#pragma omp parallel for num_threads(nthreads)
+    for (int i = 0; i < num_hits; i++) {
+        hits[i].tile->hit[hits[i].node] = -1;
+    }
 
     m_timer_contact_forces.stop();
 
@@ -1454,7 +1833,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
             // Calculate the displaced material from all touched nodes and identify boundary
             double tot_step_flow = 0;
             for (const auto& ij : p.nodes) {                     // for each node in contact patch
-                const auto& nr = m_grid_map.at(ij);              //   get node record
+                const auto& nr = m_grid.At(ij);                  //   get node record
                 if (nr.sigma <= 0)                               //   if node not touched
                     continue;                                    //     skip (not in effective patch)
                 tot_step_flow += nr.step_plastic_flow;           //   accumulate displaced material
@@ -1462,10 +1841,11 @@ void SCMDeformableSoil::ComputeInternalForces() {
                     ChVector2<int> nbr_ij = ij + neighbors4[k];  //     neighbor node coordinates
                     ////if (!CheckMeshBounds(nbr_ij))                     //     if neighbor out of bounds
                     ////    continue;                                     //       skip neighbor
-                    if (m_grid_map.find(nbr_ij) == m_grid_map.end())  //     if neighbor not yet recorded
-                        p_boundary.insert(nbr_ij);                    //       set neighbor as boundary
-                    else if (m_grid_map.at(nbr_ij).sigma <= 0)        //     if neighbor not touched
-                        p_boundary.insert(nbr_ij);                    //       set neighbor as boundary
+                    const NodeRecord* nbr_nr = m_grid.Find(nbr_ij);  //     neighbor node record
+                    if (!nbr_nr)                                     //     if neighbor not yet recorded
+                        p_boundary.insert(nbr_ij);                   //       set neighbor as boundary
+                    else if (nbr_nr->sigma <= 0)                     //     if neighbor not touched
+                        p_boundary.insert(nbr_ij);                   //       set neighbor as boundary
                 }
             }
             tot_step_flow *= GetSystem()->GetStep();
@@ -1476,13 +1856,13 @@ void SCMDeformableSoil::ComputeInternalForces() {
             // Raise boundary (create a sharp spike which will be later smoothed out with erosion)
             for (const auto& ij : p_boundary) {                                  // for each node in bndry
                 m_modified_nodes.push_back(ij);                                  //   mark as modified
-                if (m_grid_map.find(ij) == m_grid_map.end()) {                   //   if not yet recorded
+                if (!m_grid.Find(ij)) {                                          //   if not yet recorded
                     double z = GetInitHeight(ij);                                //     undeformed height
                     const ChVector<>& n = GetInitNormal(ij);                     //     terrain normal
-                    m_grid_map.insert(std::make_pair(ij, NodeRecord(z, z, n)));  //     add new node record
+                    m_grid.Insert(ij, NodeRecord(z, z, n));                      //     add new node record
                     m_modified_nodes.push_back(ij);                              //     mark as modified
                 }                                                                //
-                auto& nr = m_grid_map.at(ij);                                    //   node record
+                auto& nr = m_grid.At(ij);                                        //   node record
                 nr.erosion = true;                                               //   add to erosion domain
                 AddMaterialToNode(diff, nr);                                     //   add raise amount
             }
@@ -1506,16 +1886,17 @@ void SCMDeformableSoil::ComputeInternalForces() {
                     ChVector2<int> nbr_ij = ij + neighbors4[k];  //   neighbor node coordinates
                     ////if (!CheckMeshBounds(nbr_ij))                       //   if out of bounds
                     ////    continue;                                       //     ignore neighbor
-                    if (m_grid_map.find(nbr_ij) == m_grid_map.end()) {  //   if neighbor not yet recorded
+                    NodeRecord* nbr_nr = m_grid.Find(nbr_ij);           //   neighbor node record
+                    if (!nbr_nr) {                                      //   if neighbor not yet recorded
                         double z = GetInitHeight(nbr_ij);               //     undeformed height at neighbor location
                         const ChVector<>& n = GetInitNormal(nbr_ij);    //     terrain normal at neighbor location
                         NodeRecord nr(z, z, n);                         //     create new record
                         nr.erosion = true;                              //     include in erosion domain
-                        m_grid_map.insert(std::make_pair(nbr_ij, nr));  //     add new node record
+                        m_grid.Insert(nbr_ij, nr);                      //     add new node record
                         front.insert(nbr_ij);                           //     add neighbor to new front
                         m_modified_nodes.push_back(nbr_ij);             //     mark as modified
                     } else {                                            //   if neighbor previously recorded
-                        NodeRecord& nr = m_grid_map.at(nbr_ij);         //     get existing record
+                        NodeRecord& nr = *nbr_nr;                       //     get existing record
                         if (!nr.erosion && nr.sigma <= 0) {             //     if neighbor not touched
                             nr.erosion = true;                          //       include in erosion domain
                             front.insert(nbr_ij);                       //       add neighbor to new front
@@ -1536,13 +1917,13 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
         for (int iter = 0; iter < m_erosion_iterations; iter++) {
             for (const auto& ij : erosion_domain) {
-                auto& nr = m_grid_map.at(ij);
+                auto& nr = m_grid.At(ij);
                 for (int k = 0; k < 4; k++) {
                     ChVector2<int> nbr_ij = ij + neighbors4[k];
-                    auto rec = m_grid_map.find(nbr_ij);
-                    if (rec == m_grid_map.end())
+                    auto rec = m_grid.Find(nbr_ij);
+                    if (!rec)
                         continue;
-                    auto& nbr_nr = rec->second;
+                    auto& nbr_nr = *rec;
 
                     // (3.1) Flow remaining material to neighbor
                     double diff = 0.5 * (nr.massremainder - nbr_nr.massremainder) / 4;  //// TODO: rethink this!
@@ -1587,7 +1968,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
         for (const auto& ij : m_modified_nodes) {
             if (!CheckMeshBounds(ij))                 // if node outside mesh
                 continue;                             //   do nothing
-            const auto& nr = m_grid_map.at(ij);       // grid node record
+            const auto& nr = m_grid.At(ij);           // grid node record
             int iv = GetMeshVertexIndex(ij);          // mesh vertex index
             UpdateMeshVertexCoordinates(ij, iv, nr);  // update vertex coordinates and color
             modified_vertices.push_back(iv);          // cache in list of modified mesh vertices
@@ -1599,6 +1980,26 @@ void SCMDeformableSoil::ComputeInternalForces() {
     }
 
     m_timer_visualization.stop();
+
+    // -------------------------------------
+    // Page out tiles far from all patches
+    // -------------------------------------
+
+    if (m_grid.IsPaging()) {
+        int dist = static_cast<int>(std::ceil(m_paging_distance / m_delta));
+        m_grid.PageOut([this, dist](const ChVector2<int>& tij) {
+            // Range of grid indices in this tile
+            ChVector2<int> t_min = tij * NodeStore::TILE_SIZE;
+            ChVector2<int> t_max = t_min + ChVector2<int>(NodeStore::TILE_SIZE - 1);
+            // Keep the tile in memory if it is within the given distance from any patch
+            for (const auto& p : m_patches) {
+                if (t_max.x() >= p.m_min.x() - dist && t_min.x() <= p.m_max.x() + dist &&
+                    t_max.y() >= p.m_min.y() - dist && t_min.y() <= p.m_max.y() + dist)
+                    return false;
+            }
+            return true;
+        });
+    }
 }
 
 void SCMDeformableSoil::AddMaterialToNode(double amount, NodeRecord& nr) {
@@ -1710,14 +2111,13 @@ void SCMDeformableSoil::UpdateMeshVertexNormal(const ChVector2<int> ij, int iv)
 std::vector<SCMDeformableTerrain::NodeLevel> SCMDeformableSoil::GetModifiedNodes(bool all_nodes) const {
     std::vector<SCMDeformableTerrain::NodeLevel> nodes;
     if (all_nodes) {
-        for (const auto& nr : m_grid_map) {
-            nodes.push_back(std::make_pair(nr.first, nr.second.level));
-        }
+        m_grid.ForEach([&nodes](const ChVector2<int>& ij, const NodeRecord& nr) {
+            nodes.push_back(std::make_pair(ij, nr.level));
+        });
     } else {
         for (const auto& ij : m_modified_nodes) {
-            auto rec = m_grid_map.find(ij);
-            assert(rec != m_grid_map.end());
-            nodes.push_back(std::make_pair(ij, rec->second.level));
+            const auto& nr = m_grid.At(ij);
+            nodes.push_back(std::make_pair(ij, nr.level));
         }
     }
     return nodes;
@@ -1728,8 +2128,8 @@ std::vector<SCMDeformableTerrain::NodeLevel> SCMDeformableSoil::GetModifiedNodes
 //       As such, some plot types may be incorrect at these nodes.
 void SCMDeformableSoil::SetModifiedNodes(const std::vector<SCMDeformableTerrain::NodeLevel>& nodes) {
     for (const auto& n : nodes) {
-        // Modify existing entry in grid map or insert new one
-        m_grid_map[n.first] = SCMDeformableSoil::NodeRecord(n.second, n.second, GetInitNormal(n.first));
+        // Modify existing entry in node store or insert new one
+        m_grid.Insert(n.first, SCMDeformableSoil::NodeRecord(n.second, n.second, GetInitNormal(n.first)));
     }
 
     // Update visualization
@@ -1738,7 +2138,7 @@ void SCMDeformableSoil::SetModifiedNodes(const std::vector<SCMDeformableTerrain:
             auto ij = n.first;                           // grid location
             if (!CheckMeshBounds(ij))                    // if outside mesh
                 continue;                                //   do nothing
-            const auto& nr = m_grid_map.at(ij);          // grid node record
+            const auto& nr = m_grid.At(ij);              // grid node record
             int iv = GetMeshVertexIndex(ij);             // mesh vertex index
             UpdateMeshVertexCoordinates(ij, iv, nr);     // update vertex coordinates and color
             if (!m_trimesh_shape->IsWireframe())         // if not in wireframe mode
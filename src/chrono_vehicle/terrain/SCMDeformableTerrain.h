@@ -20,6 +20,8 @@
 #ifndef SCM_DEFORMABLE_TERRAIN_H
 #define SCM_DEFORMABLE_TERRAIN_H
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <ostream>
 #include <unordered_map>
@@ -156,6 +158,15 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                         const ChVector<>& OOBB_dims     ///< [in] OOBB dimensions
     );
 
+    /// Enable paging of SCM grid node records to a memory-mapped file (default: disabled).
+    /// Records of modified grid nodes are stored in dense tiles, created when a node in the tile is first modified.
+    /// If paging is enabled, tiles farther than the specified distance from all patches are moved out of memory into
+    /// the specified file. Paged-out tiles remain accessible (e.g., through GetHeight) and are brought back into memory
+    /// if one of their nodes is modified again.
+    void EnableTilePaging(const std::string& filename,  ///< [in] name of the page file (created or overwritten)
+                          double distance               ///< [in] minimum distance to all patches
+    );
+
     /// Class to be used as a callback interface for location-dependent soil parameters.
     /// A derived class must implement Set() and set *all* soil parameters (no defaults are provided).
     class CH_VEHICLE_API SoilParametersCallback {
@@ -202,6 +213,22 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     /// Otherwise, it returns the constant value of 0.8.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get all terrain characteristics at the point below the specified location.
+    /// The grid node closest to the specified location is located only once.
+    virtual void GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const override;
+
+    /// Get the terrain height below each of the specified locations.
+    /// The query points are processed in parallel, using the number of threads set for the containing system.
+    virtual void GetHeightBatch(const std::vector<ChVector<>>& loc, std::vector<double>& height) const override;
+
+    /// Get all terrain characteristics at the points below each of the specified locations.
+    /// The query points are processed in parallel, using the number of threads set for the containing system. A
+    /// user-provided friction functor is evaluated sequentially.
+    virtual void GetPropertiesBatch(const std::vector<ChVector<>>& loc,
+                                    std::vector<double>& height,
+                                    std::vector<ChVector<>>& normal,
+                                    std::vector<float>& friction) const override;
+
     /// Get SCM information at the node closest to the specified location.
     NodeInfo GetNodeInfo(const ChVector<>& loc) const;
 
@@ -271,6 +298,10 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     int GetNumContactPatches() const;
     /// Return the number of nodes in the erosion domain at last step (bulldosing effects).
     int GetNumErosionNodes() const;
+    /// Return the number of grid node tiles (in memory or paged out).
+    int GetNumTiles() const;
+    /// Return the number of grid node tiles paged out to file.
+    int GetNumPagedTiles() const;
 
     /// Return time for updating moving patches at last step (ms).
     double GetTimerMovingPatches() const;
@@ -357,6 +388,8 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
         ChVector<> m_center;                  // OOBB center, relative to body
         ChVector<> m_hdims;                   // OOBB half-dimensions
         std::vector<ChVector2<int>> m_range;  // current grid nodes covered by the patch
+        ChVector2<int> m_min;                 // current minimum grid indices covered by the patch
+        ChVector2<int> m_max;                 // current maximum grid indices covered by the patch
         ChVector<> m_ooN;                     // current inverse of SCM normal in body frame
     };
 
@@ -404,6 +437,116 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
         std::size_t operator()(const ChVector2<int>& p) const { return p.x() * 31 + p.y(); }
     };
 
+    // Store for the records of modified grid nodes.
+    // Node records are kept in dense square tiles of TILE_SIZE x TILE_SIZE grid nodes, created when first touched and
+    // keyed by their tile coordinates. Lookups do not modify the store and can be performed concurrently.  Tiles are
+    // created (or brought back into memory) only in serial sections; once a tile is in memory, records of different
+    // nodes in that tile can be initialized and modified concurrently (no locking).
+    // Optionally, tiles can be paged out to a memory-mapped file. Node records of paged-out tiles remain accessible.
+    class NodeStore {
+      public:
+        static const int TILE_BITS = 5;
+        static const int TILE_SIZE = 1 << TILE_BITS;
+        static const int TILE_NODES = TILE_SIZE * TILE_SIZE;
+
+        // Node data of a tile (in memory or in the page file).
+        struct TileData {
+            TileData();
+            NodeRecord nodes[TILE_NODES];  // node records (row-major within the tile)
+            char used[TILE_NODES];         // flags for nodes with a valid record
+        };
+
+        struct Tile {
+            Tile();
+            NodeRecord* nodes;                        // node records (in memory or in the page file)
+            char* used;                               // valid record flags (in memory or in the page file)
+            std::unique_ptr<std::atomic<int>[]> hit;  // index of the current ray-cast hit at each node (-1 if none)
+            std::unique_ptr<TileData> data;           // tile data (null if paged out)
+            int slot;                                 // page file slot (-1 if in memory)
+        };
+
+        NodeStore();
+        ~NodeStore();
+
+        // Coordinates of the tile containing the specified grid node.
+        static ChVector2<int> TileCoords(const ChVector2<int>& ij) {
+            return ChVector2<int>(ij.x() >> TILE_BITS, ij.y() >> TILE_BITS);
+        }
+
+        // Index of the specified grid node within its tile.
+        static int NodeIndex(const ChVector2<int>& ij) {
+            return (ij.x() & (TILE_SIZE - 1)) + TILE_SIZE * (ij.y() & (TILE_SIZE - 1));
+        }
+
+        // Return the tile with specified tile coordinates (nullptr if not created).
+        // Note that the returned tile may be paged out (no hit markers).
+        Tile* GetTile(const ChVector2<int>& tij) const;
+
+        // Return the tile with specified tile coordinates, creating it or bringing it into memory if needed.
+        // Not thread safe.
+        Tile* AddTile(const ChVector2<int>& tij);
+
+        // Return the record of the specified grid node (nullptr if the node was never modified).
+        NodeRecord* Find(const ChVector2<int>& ij) const;
+
+        // Return the record of the specified grid node, which must exist.
+        NodeRecord& At(const ChVector2<int>& ij) const;
+
+        // Set the record of the specified grid node (not thread safe).
+        NodeRecord& Insert(const ChVector2<int>& ij, const NodeRecord& nr);
+
+        // Invoke the given function with the grid coordinates and record of all modified grid nodes.
+        template <typename Function>
+        void ForEach(Function f) const {
+            for (const auto& t : m_tiles) {
+                for (int n = 0; n < TILE_NODES; n++) {
+                    if (t.second->used[n])
+                        f(ChVector2<int>(t.first.x() * TILE_SIZE + n % TILE_SIZE,
+                                         t.first.y() * TILE_SIZE + n / TILE_SIZE),
+                          t.second->nodes[n]);
+                }
+            }
+        }
+
+        // Open the file used for paging out tiles.
+        void OpenPageFile(const std::string& filename);
+
+        // Return true if a page file was opened.
+        bool IsPaging() const { return m_file != nullptr; }
+
+        // Page out all tiles in memory whose tile coordinates satisfy the given predicate.
+        template <typename Predicate>
+        void PageOut(Predicate pred) {
+            size_t num_resident = 0;
+            for (size_t k = 0; k < m_resident.size(); k++) {
+                if (pred(m_resident[k]))
+                    PageOut(*m_tiles.at(m_resident[k]));
+                else
+                    m_resident[num_resident++] = m_resident[k];
+            }
+            m_resident.resize(num_resident);
+        }
+
+        // Return the number of tiles (in memory or paged out).
+        int GetNumTiles() const { return (int)m_tiles.size(); }
+
+        // Return the number of paged out tiles.
+        int GetNumPagedTiles() const { return (int)(m_tiles.size() - m_resident.size()); }
+
+        // Delete all tiles.
+        void Clear();
+
+      private:
+        class PageFile;
+
+        void PageOut(Tile& tile);
+        void PageIn(Tile& tile);
+
+        std::unordered_map<ChVector2<int>, std::unique_ptr<Tile>, CoordHash> m_tiles;  // all tiles
+        std::vector<ChVector2<int>> m_resident;                                      // tiles in memory
+        std::unique_ptr<PageFile> m_file;                                            // page file
+    };
+
     // Create visualization mesh
     void CreateVisualizationMesh(double sizeX, double sizeY);
 
@@ -431,6 +574,9 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     // Get the terrain normal (expressed in World frame) at the point below the specified location.
     ChVector<> GetNormal(const ChVector<>& loc) const;
 
+    // Get the terrain height and normal (expressed in World frame) at the point below the specified location.
+    void GetHeightNormal(const ChVector<>& loc, double& height, ChVector<>& normal) const;
+
     // Get index of trimesh vertex corresponding to the specified grid node.
     int GetMeshVertexIndex(const ChVector2<int>& loc);
 
@@ -512,12 +658,14 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
 
     ChMatrixDynamic<> m_heights;  // (base) grid heights (when initializing from height-field map)
 
-    std::unordered_map<ChVector2<int>, NodeRecord, CoordHash> m_grid_map;  // modified grid nodes (persistent)
-    std::vector<ChVector2<int>> m_modified_nodes;                          // modified grid nodes (current)
+    NodeStore m_grid;                              // modified grid nodes (persistent)
+    std::vector<ChVector2<int>> m_modified_nodes;  // modified grid nodes (current)
 
     std::vector<MovingPatchInfo> m_patches;  // set of active moving patches
     bool m_moving_patch;                     // user-specified moving patches?
 
+    double m_paging_distance;  // minimum distance to all patches for paging out node tiles
+
     double m_test_offset_down;  // offset for ray start
     double m_test_offset_up;    // offset for ray end
 
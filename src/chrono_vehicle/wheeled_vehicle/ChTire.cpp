@@ -252,26 +252,21 @@ bool ChTire::DiscTerrainCollision4pt(
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
 
-    // Calculate four contact points in the contact patch
-    ChVector<> ptQ1 = wheel_bottom_location + dx * longitudinal;
-    double hQ1 = terrain.GetHeight(ptQ1);
-    double ptQ1_height = ChWorldFrame::Height(ptQ1);
-    ptQ1 = ptQ1 - (ptQ1_height - hQ1) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ2 = wheel_bottom_location - dx * longitudinal;
-    double hQ2 = terrain.GetHeight(ptQ2);
-    double ptQ2_height = ChWorldFrame::Height(ptQ2);
-    ptQ2 = ptQ2 - (ptQ2_height - hQ2) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ3 = wheel_bottom_location + dy * lateral;
-    double hQ3 = terrain.GetHeight(ptQ3);
-    double ptQ3_height = ChWorldFrame::Height(ptQ3);
-    ptQ3 = ptQ3 - (ptQ3_height - hQ3) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ4 = wheel_bottom_location - dy * lateral;
-    double hQ4 = terrain.GetHeight(ptQ4);
-    double ptQ4_height = ChWorldFrame::Height(ptQ4);
-    ptQ4 = ptQ4 - (ptQ4_height - hQ4) * ChWorldFrame::Vertical();
+    // Calculate four contact points in the contact patch and project them onto the terrain.
+    // The query buffers are reused across calls (per thread, as tires may be processed concurrently).
+    static thread_local std::vector<ChVector<>> ptQ(4);
+    static thread_local std::vector<double> hQ(4);
+    ptQ[0] = wheel_bottom_location + dx * longitudinal;
+    ptQ[1] = wheel_bottom_location - dx * longitudinal;
+    ptQ[2] = wheel_bottom_location + dy * lateral;
+    ptQ[3] = wheel_bottom_location - dy * lateral;
+    terrain.GetHeightBatch(ptQ, hQ);
+    for (int i = 0; i < 4; i++)
+        ptQ[i] = ptQ[i] - (ChWorldFrame::Height(ptQ[i]) - hQ[i]) * ChWorldFrame::Vertical();
+    const ChVector<>& ptQ1 = ptQ[0];
+    const ChVector<>& ptQ2 = ptQ[1];
+    const ChVector<>& ptQ3 = ptQ[2];
+    const ChVector<>& ptQ4 = ptQ[3];
 
     // Calculate a smoothed road surface normal
     ChVector<> rQ2Q1 = ptQ1 - ptQ2;
@@ -334,14 +329,23 @@ bool ChTire::DiscTerrainCollisionEnvelope(
 
     const size_t n_div = 180;
     double x_step = 2.0 * disc_radius / n_div;
+
+    // Sample the terrain height along the longitudinal direction.
+    // The query buffers are reused across calls (per thread, as tires may be processed concurrently).
+    static thread_local std::vector<ChVector<>> pTest(n_div - 1);
+    static thread_local std::vector<double> q(n_div - 1);
+    for (size_t i = 1; i < n_div; i++) {
+        double x = -disc_radius + x_step * double(i);
+        pTest[i - 1] = disc_center + x * longitudinal;
+    }
+    terrain.GetHeightBatch(pTest, q);
+
     double A = 0;  // overlapping area of tire disc and road surface contour
     for (size_t i = 1; i < n_div; i++) {
         double x = -disc_radius + x_step * double(i);
-        ChVector<> pTest = disc_center + x * longitudinal;
-        double q = terrain.GetHeight(pTest);
-        double a = ChWorldFrame::Height(pTest) - sqrt(disc_radius * disc_radius - x * x);
-        if (q > a) {
-            A += q - a;
+        double a = ChWorldFrame::Height(pTest[i - 1]) - sqrt(disc_radius * disc_radius - x * x);
+        if (q[i - 1] > a) {
+            A += q[i - 1] - a;
         }
     }
     A *= x_step;
@@ -191,6 +191,8 @@ int main(int argc, char* argv[]) {
     cli.AddOption<double>("Demo", "t,end_time", "Simulation length");
     cli.AddOption<std::string>("Demo", "o,outdir", "Output directory (must not exist)", "");
     cli.AddOption<bool>("Demo", "m,perf_mon", "Enable performance monitoring", "false");
+    cli.AddOption<int>("Demo", "b,balance", "Number of steps between load rebalancings (0: disabled)", "0");
+    cli.AddOption<int>("Demo", "r,report", "Number of steps between load balance reports (0: disabled)", "0");
     cli.AddOption<bool>("Demo", "v,verbose", "Enable verbose output", "false");
 
     if (!cli.Parse(argc, argv, my_rank == 0)) {
@@ -207,6 +209,8 @@ int main(int argc, char* argv[]) {
     std::string outdir = cli.GetAsType<std::string>("outdir");
     const bool output_data = outdir.compare("") != 0;
     const bool monitor = cli.GetAsType<bool>("m");
+    const int balance_interval = cli.GetAsType<int>("balance");
+    const int report_interval = cli.GetAsType<int>("report");
     const bool verbose = cli.GetAsType<bool>("v");
 
     // Check that required parameters were specified
@@ -267,6 +271,10 @@ int main(int argc, char* argv[]) {
     my_sys.GetDomain()->SetSplitAxis(0);  // Split along the x-axis
     my_sys.GetDomain()->SetSimDomain(domlo, domhi);
 
+    // Load balancing
+    my_sys.SetLoadBalancing(balance_interval);
+    my_sys.SetLoadReport(report_interval);
+
     if (verbose)
         my_sys.GetDomain()->PrintDomain();
 
@@ -0,0 +1,165 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Radu Serban
+// =============================================================================
+//
+// Dam break problem (see demo_FSI_DamBreak) solved with the multithreaded CPU
+// implementation of the explicit WCSPH solver.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChSystemFsiCpu.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+// Chrono namespaces
+using namespace chrono;
+using namespace chrono::fsi;
+
+//------------------------------------------------------------------
+
+// Output directories and settings
+const std::string out_dir = GetChronoOutputPath() + "FSI_Dam_Break_CPU/";
+
+// Output frequency
+bool output = true;
+double out_fps = 20;
+
+// Dimension of the space domain
+double bxDim = 6.0;
+double byDim = 1.0;
+double bzDim = 4.0;
+
+// Dimension of the fluid domain
+double fxDim = 2.0;
+double fyDim = 1.0;
+double fzDim = 2.0;
+
+// Final simulation time
+double t_end = 10.0;
+
+//------------------------------------------------------------------
+// Create the objects of the MBD system. Rigid bodies, and if FSI,
+// their BCE representation are created and added to the systems
+//------------------------------------------------------------------
+void CreateSolidPhase(ChSystemSMC& sysMBS, ChSystemFsiCpu& sysFSI) {
+    // General setting of ground body
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(false);
+    sysMBS.AddBody(ground);
+
+    // Add BCE particles attached on the walls into FSI system
+    sysFSI.AddContainerBCE(ground, ChFrame<>(), ChVector<>(bxDim, byDim, bzDim), ChVector<int>(2, 0, 2));
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    // Create oputput directories
+    if (!filesystem::create_directory(filesystem::path(out_dir))) {
+        std::cerr << "Error creating directory " << out_dir << std::endl;
+        return 1;
+    }
+    if (!filesystem::create_directory(filesystem::path(out_dir + "/particles"))) {
+        std::cerr << "Error creating directory " << out_dir + "/particles" << std::endl;
+        return 1;
+    }
+
+    // Create a physics system and an FSI system
+    ChSystemSMC sysMBS;
+    ChSystemFsiCpu sysFSI(&sysMBS);
+
+    // Use the default input file or you may enter your input parameters as a command line argument.
+    // Optionally, specify the number of OpenMP threads as a second argument.
+    std::string inputJson = GetChronoDataFile("fsi/input_json/demo_FSI_DamBreak_Explicit.json");
+    if (argc == 1) {
+        std::cout << "Use the default JSON file" << std::endl;
+    } else if (argc == 2 || argc == 3) {
+        std::cout << "Use the specified JSON file" << std::endl;
+        inputJson = std::string(argv[1]);
+        if (argc == 3)
+            sysFSI.SetNumThreads(std::atoi(argv[2]));
+    } else {
+        std::cout << "usage: ./demo_FSI_DamBreak_CPU <json_file> [num_threads]" << std::endl;
+        return 1;
+    }
+    sysFSI.ReadParametersFromFile(inputJson);
+
+    // Set up the periodic boundary condition (only in Y direction)
+    auto initSpace0 = sysFSI.GetInitialSpacing();
+    ChVector<> cMin = ChVector<>(-bxDim / 2 - 10.0 * initSpace0, -byDim / 2 - 1.0 * initSpace0 / 2.0, -2.0 * bzDim);
+    ChVector<> cMax = ChVector<>(bxDim / 2 + 10.0 * initSpace0, byDim / 2 + 1.0 * initSpace0 / 2.0, 2.0 * bzDim);
+    sysFSI.SetBoundaries(cMin, cMax);
+
+    // Create Fluid region and discretize with SPH particles
+    ChVector<> boxCenter(-bxDim / 2 + fxDim / 2, 0.0, fzDim / 2);
+    ChVector<> boxHalfDim(fxDim / 2, fyDim / 2, fzDim / 2);
+
+    // Use a chrono sampler to create a bucket of points
+    chrono::utils::GridSampler<> sampler(initSpace0);
+    chrono::utils::Generator::PointVector points = sampler.SampleBox(boxCenter, boxHalfDim);
+
+    // Add fluid particles from the sampler points to the FSI system
+    size_t numPart = points.size();
+    double gz = std::abs(sysFSI.Get_G_acc().z());
+    for (int i = 0; i < numPart; i++) {
+        // Calculate the pressure of a steady state (p = rho*g*h)
+        auto pre_ini = sysFSI.GetDensity() * gz * (-points[i].z() + fzDim);
+        auto rho_ini = sysFSI.GetDensity() + pre_ini / (sysFSI.GetSoundSpeed() * sysFSI.GetSoundSpeed());
+        sysFSI.AddSPHParticle(points[i], rho_ini, pre_ini, sysFSI.GetViscosity());
+    }
+
+    // Create Solid region and attach BCE SPH particles
+    CreateSolidPhase(sysMBS, sysFSI);
+
+    // Complete construction of the FSI system
+    sysFSI.Initialize();
+
+    // Start the simulation
+    double dT = sysFSI.GetStepSize();
+    unsigned int output_steps = (unsigned int)round(1 / (out_fps * dT));
+
+    double time = 0;
+    int current_step = 0;
+
+    ChTimer<> timer;
+    timer.start();
+    while (time < t_end) {
+        // Save data of the simulation
+        if (output && current_step % output_steps == 0) {
+            std::cout << "step: " << current_step << "  time: " << time
+                      << "  particle updates/s: " << sysFSI.GetParticleUpdatesPerSecond() << std::endl;
+            sysFSI.PrintParticleToFile(out_dir + "/particles");
+        }
+
+        // Call the FSI solver
+        sysFSI.DoStepDynamics_FSI();
+
+        time += dT;
+        current_step++;
+    }
+    timer.stop();
+    std::cout << "\nSimulation time: " << timer() << " seconds" << std::endl;
+    std::cout << "SPH solver time: " << sysFSI.GetTimerTotal() << " seconds" << std::endl;
+    std::cout << "Particle updates/s: " << sysFSI.GetParticleUpdatesPerSecond() << "\n" << std::endl;
+
+    return 0;
+}
@@ -43,6 +43,7 @@ void SetChronoSolver(chrono::ChSystem& sys,
         if (slvr_type != chrono::ChSolver::Type::BARZILAIBORWEIN &&  //
             slvr_type != chrono::ChSolver::Type::APGD &&             //
             slvr_type != chrono::ChSolver::Type::PSOR &&             //
+            slvr_type != chrono::ChSolver::Type::PSOR_PARALLEL &&    //
             slvr_type != chrono::ChSolver::Type::PSSOR) {
             slvr_type = chrono::ChSolver::Type::BARZILAIBORWEIN;
         }
@@ -62,6 +62,8 @@ bool GetProblemSpecs(int argc,
                      int& nthreads_tire,
                      int& nthreads_terrain,
                      double& step_size,
+                     double& step_cosim,
+                     int& extrap_order,
                      bool& fixed_settling_time,
                      double& KE_threshold,
                      double& settling_time,
@@ -120,6 +122,8 @@ int main(int argc, char** argv) {
     int nthreads_tire = 1;
     int nthreads_terrain = 1;
     double step_size = 1e-4;
+    double step_cosim = 1e-4;
+    int extrap_order = 0;
     bool fixed_settling_time = true;
     double KE_threshold = std::numeric_limits<double>::infinity();
     double settling_time = 0.4;
@@ -140,7 +144,7 @@ int main(int argc, char** argv) {
     std::string suffix = "";
     bool verbose = true;
     if (!GetProblemSpecs(argc, argv, rank, terrain_specfile, tire_specfile, nthreads_tire, nthreads_terrain, step_size,
-                         fixed_settling_time, KE_threshold, settling_time, sim_time, act_type, base_vel, slip,
+                         step_cosim, extrap_order, fixed_settling_time, KE_threshold, settling_time, sim_time, act_type, base_vel, slip,
                          total_mass, toe_angle, dbp_filter_window, use_checkpoint, output_fps, vis_output_fps,
                          render_fps, sim_output, settling_output, vis_output, render, verbose, suffix)) {
         MPI_Finalize();
@@ -208,9 +212,10 @@ int main(int argc, char** argv) {
     MPI_Barrier(MPI_COMM_WORLD);
 
     // Number of simulation steps between miscellaneous events.
-    int sim_steps = (int)std::ceil(sim_time / step_size);
-    int output_steps = (int)std::ceil(1 / (output_fps * step_size));
-    int vis_output_steps = (int)std::ceil(1 / (vis_output_fps * step_size));
+    // Co-simulation steps are of length step_cosim (the nodes advance with their own step_size in between).
+    int sim_steps = (int)std::ceil(sim_time / step_cosim);
+    int output_steps = (int)std::ceil(1 / (output_fps * step_cosim));
+    int vis_output_steps = (int)std::ceil(1 / (vis_output_fps * step_cosim));
 
     // Initialize co-simulation framework (specify 1 tire node).
     cosim::InitializeFramework(1);
@@ -392,6 +397,9 @@ int main(int argc, char** argv) {
 
     }  // if TERRAIN_NODE_RANK
 
+    // Extrapolate interface data when co-simulation steps span multiple integration steps
+    node->SetInterfaceExtrapolationOrder(extrap_order);
+
     // Initialize systems
     // (perform initial inter-node data exchange)
     node->Initialize();
@@ -402,14 +410,14 @@ int main(int argc, char** argv) {
     int vis_output_frame = 0;
 
     for (int is = 0; is < sim_steps; is++) {
-        double time = is * step_size;
+        double time = is * step_cosim;
 
         if (verbose && rank == 0)
             cout << is << " ---------------------------- " << endl;
         MPI_Barrier(MPI_COMM_WORLD);
 
         node->Synchronize(is, time);
-        node->Advance(step_size);
+        node->Advance(step_cosim);
         if (verbose)
             cout << "Node" << rank << " sim time = " << node->GetStepExecutionTime() << "  ["
                  << node->GetTotalExecutionTime() << "]" << endl;
@@ -443,6 +451,8 @@ bool GetProblemSpecs(int argc,
                      int& nthreads_tire,
                      int& nthreads_terrain,
                      double& step_size,
+                     double& step_cosim,
+                     int& extrap_order,
                      bool& fixed_settling_time,
                      double& KE_threshold,
                      double& settling_time,
@@ -483,6 +493,9 @@ bool GetProblemSpecs(int argc,
     cli.AddOption<double>("Simulation", "sim_time", "Simulation length after settling phase [s]",
                           std::to_string(sim_time));
     cli.AddOption<double>("Simulation", "step_size", "Integration step size [s]", std::to_string(step_size));
+    cli.AddOption<double>("Simulation", "step_cosim", "Co-simulation step size [s] (default: integration step size)");
+    cli.AddOption<int>("Simulation", "extrap_order", "Order of interface data extrapolation (0, 1, or 2)",
+                       std::to_string(extrap_order));
 
     cli.AddOption<int>("Simulation", "threads_tire", "Number of OpenMP threads for the tire node",
                        std::to_string(nthreads_tire));
@@ -562,6 +575,8 @@ bool GetProblemSpecs(int argc,
 
     sim_time = cli.GetAsType<double>("sim_time");
     step_size = cli.GetAsType<double>("step_size");
+    step_cosim = cli.CheckOption("step_cosim") ? cli.GetAsType<double>("step_cosim") : step_size;
+    extrap_order = cli.GetAsType<int>("extrap_order");
 
     total_mass = cli.GetAsType<double>("total_mass");
     toe_angle = cli.GetAsType<double>("toe_angle");
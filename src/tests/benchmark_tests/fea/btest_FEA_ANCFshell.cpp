@@ -13,6 +13,8 @@
 // =============================================================================
 //
 // Benchmark test for ANCF shell elements.
+// The ANCFshell32_MINRES_T* tests run the same model with 1, 2, 4, and 8 threads
+// to measure the scaling of the (colored) parallel element force assembly.
 //
 // Note that the MKL Pardiso and Mumps solvers are set to lock the sparsity
 // pattern, but not to use the sparsity pattern learner.
@@ -97,6 +99,13 @@ class ANCFshell_PARDISOPROJECT : public ANCFshell<N> {
     ANCFshell_PARDISOPROJECT() : ANCFshell<N>(SolverType::PARDISO_PROJECT) {}
 };
 
+// Scaling of the element force assembly (colored by ChMesh) with the number of threads.
+template <int NT>
+class ANCFshell32_MINRES_Threads : public ANCFshell<32> {
+  public:
+    ANCFshell32_MINRES_Threads() : ANCFshell<32>(SolverType::MINRES) { m_system->SetNumThreads(NT); }
+};
+
 template <int N>
 ANCFshell<N>::ANCFshell(SolverType solver_type) {
     m_system = new ChSystemSMC();
@@ -275,6 +284,11 @@ CH_BM_SIMULATION_LOOP(ANCFshell16_MINRES, ANCFshell_MINRES<16>, NUM_SKIP_STEPS,
 CH_BM_SIMULATION_LOOP(ANCFshell32_MINRES, ANCFshell_MINRES<32>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(ANCFshell64_MINRES, ANCFshell_MINRES<64>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
+CH_BM_SIMULATION_LOOP(ANCFshell32_MINRES_T1, ANCFshell32_MINRES_Threads<1>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(ANCFshell32_MINRES_T2, ANCFshell32_MINRES_Threads<2>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(ANCFshell32_MINRES_T4, ANCFshell32_MINRES_Threads<4>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(ANCFshell32_MINRES_T8, ANCFshell32_MINRES_Threads<8>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
 CH_BM_SIMULATION_LOOP(ANCFshell08_SparseQR, ANCFshell_SparseQR<8>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(ANCFshell16_SparseQR, ANCFshell_SparseQR<16>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(ANCFshell32_SparseQR, ANCFshell_SparseQR<32>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
@@ -14,7 +14,8 @@
 //
 // Benchmark test for sparse matrix setup (assembly of system matrix).
 // This provides a measure of the effect and performance of using the "sparsity
-// learner".
+// learner". It also compares the built-in sparse direct solvers (SparseLU,
+// SparseQR, and the supernodal SparseLDLT) with the optional external ones.
 //
 // =============================================================================
 
@@ -160,6 +161,36 @@ class SystemFixture : public ::benchmark::Fixture {
     }                                                                                 \
     BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
 
+#define BM_SOLVER_LU(TEST_NAME, N, WITH_LEARNER)                                      \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) { \
+        auto solver = chrono_types::make_shared<ChSolverSparseLU>();                  \
+        solver->UseSparsityPatternLearner(WITH_LEARNER);                              \
+        solver->LockSparsityPattern(true);                                            \
+        solver->SetVerbose(false);                                                    \
+        m_system->SetSolver(solver);                                                  \
+        while (st.KeepRunning()) {                                                    \
+            solver->ForceSparsityPatternUpdate();                                     \
+            m_system->DoStaticLinear();                                               \
+        }                                                                             \
+        Report(st);                                                                   \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
+#define BM_SOLVER_LDLT(TEST_NAME, N, WITH_LEARNER)                                    \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) { \
+        auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();                \
+        solver->UseSparsityPatternLearner(WITH_LEARNER);                              \
+        solver->LockSparsityPattern(true);                                            \
+        solver->SetVerbose(false);                                                    \
+        m_system->SetSolver(solver);                                                  \
+        while (st.KeepRunning()) {                                                    \
+            solver->ForceSparsityPatternUpdate();                                     \
+            m_system->DoStaticLinear();                                               \
+        }                                                                             \
+        Report(st);                                                                   \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
 #define BM_SOLVER_QR(TEST_NAME, N, WITH_LEARNER)                                      \
     BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) { \
         auto solver = chrono_types::make_shared<ChSolverSparseQR>();                  \
@@ -225,6 +256,28 @@ BM_SOLVER_QR(QR_no_learner_4000, 4000, false)
 BM_SOLVER_QR(QR_learner_8000, 8000, true)
 BM_SOLVER_QR(QR_no_learner_8000, 8000, false)
 
+BM_SOLVER_LU(LU_learner_500, 500, true)
+BM_SOLVER_LU(LU_no_learner_500, 500, false)
+BM_SOLVER_LU(LU_learner_1000, 1000, true)
+BM_SOLVER_LU(LU_no_learner_1000, 1000, false)
+BM_SOLVER_LU(LU_learner_2000, 2000, true)
+BM_SOLVER_LU(LU_no_learner_2000, 2000, false)
+BM_SOLVER_LU(LU_learner_4000, 4000, true)
+BM_SOLVER_LU(LU_no_learner_4000, 4000, false)
+BM_SOLVER_LU(LU_learner_8000, 8000, true)
+BM_SOLVER_LU(LU_no_learner_8000, 8000, false)
+
+BM_SOLVER_LDLT(LDLT_learner_500, 500, true)
+BM_SOLVER_LDLT(LDLT_no_learner_500, 500, false)
+BM_SOLVER_LDLT(LDLT_learner_1000, 1000, true)
+BM_SOLVER_LDLT(LDLT_no_learner_1000, 1000, false)
+BM_SOLVER_LDLT(LDLT_learner_2000, 2000, true)
+BM_SOLVER_LDLT(LDLT_no_learner_2000, 2000, false)
+BM_SOLVER_LDLT(LDLT_learner_4000, 4000, true)
+BM_SOLVER_LDLT(LDLT_no_learner_4000, 4000, false)
+BM_SOLVER_LDLT(LDLT_learner_8000, 8000, true)
+BM_SOLVER_LDLT(LDLT_no_learner_8000, 8000, false)
+
 int main(int argc, char* argv[]) {
     ::benchmark::Initialize(&argc, argv);
     ::benchmark::RunSpecifiedBenchmarks();
@@ -13,6 +13,8 @@
 // =============================================================================
 //
 // Chrono::Multicore benchmark program using SMC method for frictional contact.
+// The settling test is run with batched (SIMD) and per-contact evaluation of the
+// contact forces; the contact force throughput (contacts/s) is reported for each.
 //
 // The global reference frame has Z up.
 // =============================================================================
@@ -40,7 +42,7 @@ using namespace chrono;
 
 class SettlingSMC : public utils::ChBenchmarkTest {
   public:
-    SettlingSMC();
+    SettlingSMC(bool use_simd = true);
     ~SettlingSMC() { delete m_system; }
 
     void SetNumthreads(int nthreads) { m_system->SetNumThreads(nthreads); }
@@ -48,15 +50,29 @@ class SettlingSMC : public utils::ChBenchmarkTest {
     void SimulateVis();
 
     virtual ChSystem* GetSystem() override { return m_system; }
-    virtual void ExecuteStep() override { m_system->DoStepDynamics(m_step); }
+    virtual void ExecuteStep() override;
+
+    /// Reset the accumulated number of processed contacts and contact processing time.
+    void ResetContactCounters();
+
+    /// Return the average number of contacts processed per step.
+    double GetNumContactsPerStep() const { return m_num_steps ? m_num_contacts / m_num_steps : 0; }
+
+    /// Return the contact force evaluation throughput (contacts per second of contact processing time).
+    double GetContactRate() const { return m_timer_contacts > 0 ? m_num_contacts / m_timer_contacts : 0; }
 
   private:
     ChSystemMulticoreSMC* m_system;
     double m_step;
     unsigned int m_num_particles;
+
+    double m_num_contacts;    ///< accumulated number of processed contacts
+    double m_timer_contacts;  ///< accumulated contact processing time
+    int m_num_steps;          ///< number of steps since last reset
 };
 
-SettlingSMC::SettlingSMC() : m_system(new ChSystemMulticoreSMC), m_step(1e-3) {
+SettlingSMC::SettlingSMC(bool use_simd)
+    : m_system(new ChSystemMulticoreSMC), m_step(1e-3), m_num_contacts(0), m_timer_contacts(0), m_num_steps(0) {
     // Simulation parameters
     double gravity = 9.81;
 
@@ -77,6 +93,9 @@ SettlingSMC::SettlingSMC() : m_system(new ChSystemMulticoreSMC), m_step(1e-3) {
     m_system->GetSettings()->solver.contact_force_model = ChSystemSMC::ContactForceModel::Hertz;
     m_system->GetSettings()->solver.adhesion_force_model = ChSystemSMC::AdhesionForceModel::Constant;
 
+    // Batched (SIMD) or per-contact evaluation of contact forces
+    m_system->GetSettings()->solver.use_simd_contact_forces = use_simd;
+
     // Material properties (shared)
     float Y = 2e6f;
     float mu = 0.4f;
@@ -138,6 +157,25 @@ SettlingSMC::SettlingSMC() : m_system(new ChSystemMulticoreSMC), m_step(1e-3) {
     m_num_particles = gen.getTotalNumBodies();
 }
 
+void SettlingSMC::ExecuteStep() {
+    m_system->DoStepDynamics(m_step);
+    m_num_contacts += m_system->GetNumContacts();
+    m_timer_contacts += m_system->GetTimerProcessContact();
+    m_num_steps++;
+}
+
+void SettlingSMC::ResetContactCounters() {
+    m_num_contacts = 0;
+    m_timer_contacts = 0;
+    m_num_steps = 0;
+}
+
+// Same test, with per-contact evaluation of contact forces
+class SettlingSMC_scalar : public SettlingSMC {
+  public:
+    SettlingSMC_scalar() : SettlingSMC(false) {}
+};
+
 // Run settling simulation with visualization
 void SettlingSMC::SimulateVis() {
 #ifdef CHRONO_OPENGL
@@ -162,19 +200,27 @@ void SettlingSMC::SimulateVis() {
 #define NUM_SKIP_STEPS 500  // number of steps for hot start
 #define NUM_SIM_STEPS 500   // number of simulation steps for benchmarking
 
-using TEST_NAME = chrono::utils::ChBenchmarkFixture<SettlingSMC, 0>;
-BENCHMARK_DEFINE_F(TEST_NAME, Settle)(benchmark::State& st) {
-    Reset(NUM_SKIP_STEPS);
-    m_test->SetNumthreads((int)st.range(0));
+template <typename TEST>
+void RunSettling(utils::ChBenchmarkFixture<TEST, 0>& fixture, benchmark::State& st) {
+    fixture.Reset(NUM_SKIP_STEPS);
+    fixture.m_test->SetNumthreads((int)st.range(0));
+    fixture.m_test->ResetContactCounters();
     while (st.KeepRunning()) {
-        m_test->Simulate(NUM_SIM_STEPS);
+        fixture.m_test->Simulate(NUM_SIM_STEPS);
     }
-    Report(st);
-    std::cout << "Simulated " << m_test->GetNumParticles() << " particles ";
+    fixture.Report(st);
+    st.counters["Contacts"] = fixture.m_test->GetNumContactsPerStep();
+    st.counters["Contacts_per_sec"] = fixture.m_test->GetContactRate();
+    std::cout << "Simulated " << fixture.m_test->GetNumParticles() << " particles ";
 #pragma omp parallel
 #pragma omp master
     std::cout << "using " << ChOMP::GetNumThreads() << " threads." << std::endl;
 }
+
+using TEST_NAME = chrono::utils::ChBenchmarkFixture<SettlingSMC, 0>;
+BENCHMARK_DEFINE_F(TEST_NAME, Settle)(benchmark::State& st) {
+    RunSettling(*this, st);
+}
 BENCHMARK_REGISTER_F(TEST_NAME, Settle)
     ->Unit(benchmark::kMillisecond)
     ->Iterations(1)
@@ -182,6 +228,17 @@ BENCHMARK_REGISTER_F(TEST_NAME, Settle)
     ->UseRealTime()
     ->DenseRange(TEST_MIN_THREADS, TEST_MAX_THREADS, TEST_STEP_THREADS);
 
+using TEST_NAME_SCALAR = chrono::utils::ChBenchmarkFixture<SettlingSMC_scalar, 0>;
+BENCHMARK_DEFINE_F(TEST_NAME_SCALAR, Settle)(benchmark::State& st) {
+    RunSettling(*this, st);
+}
+BENCHMARK_REGISTER_F(TEST_NAME_SCALAR, Settle)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(1)
+    ->Repetitions(1)
+    ->UseRealTime()
+    ->DenseRange(TEST_MIN_THREADS, TEST_MAX_THREADS, TEST_STEP_THREADS);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
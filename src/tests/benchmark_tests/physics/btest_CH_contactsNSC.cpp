@@ -0,0 +1,244 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Benchmark test for the storage of NSC contacts.
+//
+// - ContactStore: time the per-step passes over the contacts of a contact
+//   container (insertion, loading to/from the solver, reaction fetching and
+//   contact reporting), comparing the pooled contact storage used by
+//   ChContactContainerNSC with the linked-list storage used previously.
+// - GranularNSC: step time for a granular settling problem.
+//
+// =============================================================================
+
+#include <list>
+#include <vector>
+
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+
+using namespace chrono;
+
+typedef ChContactContainerNSC::ChContactNSC_6_6 ContactType;
+
+// =============================================================================
+
+// Contact storage using linked lists of contacts, with reuse of contact objects (former implementation).
+class ContactListStore {
+  public:
+    ContactListStore(ChContactContainer* container) : m_container(container), m_n_added(0) {}
+    ~ContactListStore() {
+        for (auto contact : m_list)
+            delete contact;
+    }
+
+    void Begin() {
+        m_last = m_list.begin();
+        m_n_added = 0;
+    }
+
+    void Add(ChBody* objA, ChBody* objB, const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
+        if (m_last != m_list.end()) {
+            (*m_last)->Reset(objA, objB, cinfo, cmat);
+            m_last++;
+        } else {
+            m_list.push_back(new ContactType(m_container, objA, objB, cinfo, cmat));
+            m_last = m_list.end();
+        }
+        m_n_added++;
+    }
+
+    void End() {
+        while (m_last != m_list.end()) {
+            delete (*m_last);
+            m_last = m_list.erase(m_last);
+        }
+    }
+
+    template <typename Function>
+    void ForEach(Function f) {
+        for (auto contact : m_list)
+            f(*contact);
+    }
+
+  private:
+    ChContactContainer* m_container;
+    std::list<ContactType*> m_list;
+    std::list<ContactType*>::iterator m_last;
+    int m_n_added;
+};
+
+// Contact storage using a contact pool (current implementation).
+class ContactPoolStore {
+  public:
+    ContactPoolStore(ChContactContainer* container) : m_container(container) {}
+
+    void Begin() { m_pool.Rewind(); }
+
+    void Add(ChBody* objA, ChBody* objB, const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
+        m_pool.Add(m_container, objA, objB, cinfo, cmat);
+    }
+
+    void End() {}
+
+    template <typename Function>
+    void ForEach(Function f) {
+        for (size_t i = 0; i < m_pool.size(); i++)
+            f(m_pool[i]);
+    }
+
+  private:
+    ChContactContainer* m_container;
+    ChContactPool<ContactType> m_pool;
+};
+
+// Perform the passes over contacts executed during one time step of a ChSystemNSC.
+template <class STORE>
+class ContactStoreTest {
+  public:
+    ContactStoreTest(int num_contacts);
+
+    void ExecuteStep();
+
+  private:
+    ChSystemNSC m_system;
+    std::vector<std::shared_ptr<ChBody>> m_bodies;
+    std::vector<collision::ChCollisionInfo> m_cinfo;
+    ChMaterialCompositeNSC m_cmat;
+    STORE m_store;
+    ChVectorDynamic<> m_L;
+    ChVectorDynamic<> m_Qc;
+    ChVectorDynamic<> m_R;
+};
+
+template <class STORE>
+ContactStoreTest<STORE>::ContactStoreTest(int num_contacts) : m_store(m_system.GetContactContainer().get()) {
+    // Create a chain of bodies with one contact between any two consecutive bodies
+    for (int i = 0; i <= num_contacts; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(0, i * 1.0, 0));
+        m_system.AddBody(body);
+        m_bodies.push_back(body);
+    }
+
+    m_cinfo.resize(num_contacts);
+    for (int i = 0; i < num_contacts; i++) {
+        m_cinfo[i].vpA = ChVector<>(0, i * 1.0 + 0.5, 0);
+        m_cinfo[i].vpB = ChVector<>(0, i * 1.0 + 0.499, 0);
+        m_cinfo[i].vN = ChVector<>(0, 1, 0);
+        m_cinfo[i].distance = -0.001;
+    }
+
+    m_system.Setup();
+    m_L.setZero(3 * num_contacts);
+    m_Qc.setZero(3 * num_contacts);
+    m_R.setZero(m_system.GetNcoords_w());
+
+    // Load the store a first time (hot start)
+    ExecuteStep();
+}
+
+template <class STORE>
+void ContactStoreTest<STORE>::ExecuteStep() {
+    // Collision detection
+    m_store.Begin();
+    for (size_t i = 0; i < m_cinfo.size(); i++)
+        m_store.Add(m_bodies[i].get(), m_bodies[i + 1].get(), m_cinfo[i], m_cmat);
+    m_store.End();
+
+    // Load solver data, solve, fetch reactions
+    unsigned int off = 0;
+    m_store.ForEach([&](ContactType& contact) {
+        contact.ContIntLoadConstraint_C(off, m_Qc, 1.0, true, 0.1);
+        contact.ContIntToDescriptor(off, m_L, m_Qc);
+        off += 3;
+    });
+    off = 0;
+    m_store.ForEach([&](ContactType& contact) {
+        contact.ContIntFromDescriptor(off, m_L);
+        contact.ContIntLoadResidual_CqL(off, m_R, m_L, 1.0);
+        contact.ContIntStateScatterReactions(off, m_L);
+        off += 3;
+    });
+
+    // Report contacts
+    double fn = 0;
+    m_store.ForEach([&](ContactType& contact) { fn += contact.GetContactForce().x(); });
+    benchmark::DoNotOptimize(fn);
+}
+
+template <class STORE>
+static void BM_ContactStore(benchmark::State& st) {
+    ContactStoreTest<STORE> test((int)st.range(0));
+    for (auto _ : st) {
+        test.ExecuteStep();
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ContactStore, ContactListStore)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(200000);
+BENCHMARK_TEMPLATE(BM_ContactStore, ContactPoolStore)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(200000);
+
+// =============================================================================
+
+template <int N>
+class GranularTestNSC : public utils::ChBenchmarkTest {
+  public:
+    GranularTestNSC();
+    ~GranularTestNSC() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(m_step); }
+
+  private:
+    ChSystemNSC* m_system;
+    double m_step;
+};
+
+template <int N>
+GranularTestNSC<N>::GranularTestNSC() : m_system(new ChSystemNSC()), m_step(1e-3) {
+    m_system->SetSolverMaxIterations(50);
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // N x N x N layers of spheres, dropped in a box
+    double radius = 0.1;
+    for (int ix = 0; ix < N; ix++) {
+        for (int iy = 0; iy < N; iy++) {
+            for (int iz = 0; iz < N; iz++) {
+                auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, false, true, mat);
+                ball->SetPos(ChVector<>((ix - N / 2) * 2.01 * radius, (iy + 0.5) * 2.01 * radius + 0.05,
+                                        (iz - N / 2) * 2.01 * radius));
+                m_system->Add(ball);
+            }
+        }
+    }
+
+    double hdim = (N / 2 + 1) * 2.01 * radius;
+    auto floorBody = chrono_types::make_shared<ChBodyEasyBox>(2 * hdim, 0.2, 2 * hdim, 1000, false, true, mat);
+    floorBody->SetPos(ChVector<>(0, -0.1, 0));
+    floorBody->SetBodyFixed(true);
+    m_system->Add(floorBody);
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 500  // number of steps for hot start
+#define NUM_SIM_STEPS 200   // number of simulation steps for each benchmark
+
+CH_BM_SIMULATION_LOOP(GranularNSC10, GranularTestNSC<10>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(GranularNSC20, GranularTestNSC<20>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
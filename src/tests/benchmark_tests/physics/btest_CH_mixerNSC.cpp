@@ -13,6 +13,8 @@
 // =============================================================================
 //
 // Benchmark test for contact simulation using NSC contact.
+// The MixerNSC064_PSORpar tests report the scaling of the parallel (graph
+// colored) PSOR solver with the number of threads.
 //
 // =============================================================================
 
@@ -31,7 +33,10 @@ using namespace chrono;
 
 // =============================================================================
 
-template <int N>
+// N:        number of bodies of each shape
+// NTHREADS: if positive, use the parallel PSOR solver with the specified number of threads;
+//           otherwise, use the default (sequential) PSOR solver
+template <int N, int NTHREADS = 0>
 class MixerTestNSC : public utils::ChBenchmarkTest {
   public:
     MixerTestNSC();
@@ -47,8 +52,13 @@ class MixerTestNSC : public utils::ChBenchmarkTest {
     double m_step;
 };
 
-template <int N>
-MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+template <int N, int NTHREADS>
+MixerTestNSC<N, NTHREADS>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+    if (NTHREADS > 0) {
+        m_system->SetNumThreads(NTHREADS);
+        m_system->SetSolverType(ChSolver::Type::PSOR_PARALLEL);
+    }
+
     auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
 
     for (int bi = 0; bi < N; bi++) {
@@ -101,8 +111,8 @@ MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
     m_system->AddLink(motor);
 }
 
-template <int N>
-void MixerTestNSC<N>::SimulateVis() {
+template <int N, int NTHREADS>
+void MixerTestNSC<N, NTHREADS>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     // Create the Irrlicht visualization system
     auto vis = chrono_types::make_shared<irrlicht::ChVisualSystemIrrlicht>();
@@ -132,6 +142,16 @@ void MixerTestNSC<N>::SimulateVis() {
 CH_BM_SIMULATION_LOOP(MixerNSC032, MixerTestNSC<32>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(MixerNSC064, MixerTestNSC<64>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
+using MixerTestNSC064_PSORpar1 = MixerTestNSC<64, 1>;
+using MixerTestNSC064_PSORpar2 = MixerTestNSC<64, 2>;
+using MixerTestNSC064_PSORpar4 = MixerTestNSC<64, 4>;
+using MixerTestNSC064_PSORpar8 = MixerTestNSC<64, 8>;
+
+CH_BM_SIMULATION_LOOP(MixerNSC064_PSORpar1, MixerTestNSC064_PSORpar1, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_PSORpar2, MixerTestNSC064_PSORpar2, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_PSORpar4, MixerTestNSC064_PSORpar4, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_PSORpar8, MixerTestNSC064_PSORpar8, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
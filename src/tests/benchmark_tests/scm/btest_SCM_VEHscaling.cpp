@@ -12,12 +12,17 @@
 // Author: Radu Serban
 // =============================================================================
 //
+// Scaling of the SCM terrain computations with the number of threads, for a
+// convoy of HMMWV vehicles driving in a column on SCM terrain.
+//
 // The global reference frame has Z up.
 // All units SI.
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include "chrono/physics/ChSystemSMC.h"
@@ -55,6 +60,10 @@ double delta = 0.05;        // SCM grid spacing
 
 double target_speed = 10;
 
+// Number of vehicles in the convoy and distance between consecutive vehicles
+int num_vehicles = 1;
+double spacing = 10;
+
 // Simulation run time
 double end_time = 10;
 
@@ -100,6 +109,7 @@ int main(int argc, char* argv[]) {
     end_time = cli.GetAsType<double>("end_time");
     nthreads = cli.GetAsType<int>("nthreads");
     wheel_patches = cli.GetAsType<bool>("wheel_patches");
+    num_vehicles = cli.GetAsType<int>("num_vehicles");
 
     chrono_collsys = cli.GetAsType<bool>("csys");
 #ifndef CHRONO_COLLISION
@@ -117,6 +127,10 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Collision system: " << (chrono_collsys ? "Chrono" : "Bullet") << std::endl;
     std::cout << "Num SCM threads: " << nthreads << std::endl;
+    std::cout << "Num vehicles: " << num_vehicles << std::endl;
+
+    // Extend the terrain so that all vehicles in the convoy start on SCM terrain
+    terrainLength = std::max(terrainLength, 2 * (spacing * (num_vehicles - 1) + 10));
 
     // ------------------------
     // Create the Chrono system
@@ -132,56 +146,51 @@ int main(int argc, char* argv[]) {
 #endif
     }
 
-    // --------------------
-    // Create HMMWV vehicle
-    // --------------------
-    ChVector<> init_loc(0, 2, 0.5);
-    ChQuaternion<> init_rot = Q_from_AngZ(0);
-
-    HMMWV_Full hmmwv(&sys);
-    hmmwv.SetChassisFixed(false);
-    hmmwv.SetInitPosition(ChCoordsys<>(init_loc, init_rot));
-    hmmwv.SetPowertrainType(PowertrainModelType::SHAFTS);
-    hmmwv.SetDriveType(DrivelineTypeWV::AWD);
-    hmmwv.SetTireType(TireModelType::RIGID);
-    hmmwv.SetTireStepSize(step_size);
-    hmmwv.Initialize();
-
-    if (visualize) {
-        hmmwv.SetChassisVisualizationType(VisualizationType::NONE);
-        hmmwv.SetSuspensionVisualizationType(VisualizationType::MESH);
-        hmmwv.SetSteeringVisualizationType(VisualizationType::NONE);
-        hmmwv.SetWheelVisualizationType(VisualizationType::MESH);
-        hmmwv.SetTireVisualizationType(VisualizationType::MESH);
-    } else {
-        hmmwv.SetChassisVisualizationType(VisualizationType::NONE);
-        hmmwv.SetSuspensionVisualizationType(VisualizationType::NONE);
-        hmmwv.SetSteeringVisualizationType(VisualizationType::NONE);
-        hmmwv.SetWheelVisualizationType(VisualizationType::NONE);
-        hmmwv.SetTireVisualizationType(VisualizationType::NONE);
+    // -------------------------------------------
+    // Create the HMMWV vehicles and their drivers
+    // -------------------------------------------
+    std::vector<std::unique_ptr<HMMWV_Full>> hmmwvs;
+    std::vector<std::unique_ptr<ChPathFollowerDriver>> drivers;
+
+    for (int iv = 0; iv < num_vehicles; iv++) {
+        ChVector<> init_loc(-iv * spacing, 2, 0.5);
+        ChQuaternion<> init_rot = Q_from_AngZ(0);
+
+        auto hmmwv = chrono_types::make_unique<HMMWV_Full>(&sys);
+        hmmwv->SetChassisFixed(false);
+        hmmwv->SetInitPosition(ChCoordsys<>(init_loc, init_rot));
+        hmmwv->SetPowertrainType(PowertrainModelType::SHAFTS);
+        hmmwv->SetDriveType(DrivelineTypeWV::AWD);
+        hmmwv->SetTireType(TireModelType::RIGID);
+        hmmwv->SetTireStepSize(step_size);
+        hmmwv->Initialize();
+
+        VisualizationType vis_type = (visualize && iv == 0) ? VisualizationType::MESH : VisualizationType::NONE;
+        hmmwv->SetChassisVisualizationType(VisualizationType::NONE);
+        hmmwv->SetSuspensionVisualizationType(vis_type);
+        hmmwv->SetSteeringVisualizationType(VisualizationType::NONE);
+        hmmwv->SetWheelVisualizationType(vis_type);
+        hmmwv->SetTireVisualizationType(vis_type);
+
+        // Disable automatic vehicle realtime
+        hmmwv->GetVehicle().EnableRealtime(false);
+
+        // Create driver system
+        double pathLength = 1.5 * target_speed * end_time;
+        auto path = StraightLinePath(init_loc, init_loc + ChVector<>(pathLength, 0, 0), 0);
+        auto driver = chrono_types::make_unique<ChPathFollowerDriver>(hmmwv->GetVehicle(), path, "Box path",
+                                                                       target_speed);
+        driver->Initialize();
+
+        // Reasonable defaults for the underlying PID
+        driver->GetSpeedController().SetGains(0.4, 0, 0);
+        driver->GetSteeringController().SetGains(0.4, 0.1, 0.2);
+        driver->GetSteeringController().SetLookAheadDistance(2);
+
+        hmmwvs.push_back(std::move(hmmwv));
+        drivers.push_back(std::move(driver));
     }
 
-    // -----------------------------------------------------------
-    // Set tire contact material, contact model, and visualization
-    // -----------------------------------------------------------
-    auto wheel_material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
-    wheel_material->SetFriction(0.8f);
-    wheel_material->SetYoungModulus(1.0e6f);
-    wheel_material->SetRestitution(0.1f);
-
-    // --------------------
-    // Create driver system
-    // --------------------
-    double pathLength = 1.5 * target_speed * end_time;
-    auto path = StraightLinePath(init_loc, init_loc + ChVector<>(pathLength, 0, 0), 0);
-    ChPathFollowerDriver driver(hmmwv.GetVehicle(), path, "Box path", target_speed);
-    driver.Initialize();
-
-    // Reasonable defaults for the underlying PID
-    driver.GetSpeedController().SetGains(0.4, 0, 0);
-    driver.GetSteeringController().SetGains(0.4, 0.1, 0.2);
-    driver.GetSteeringController().SetLookAheadDistance(2);
-
     // ------------------
     // Create the terrain
     // ------------------
@@ -205,15 +214,17 @@ int main(int argc, char* argv[]) {
                                         10);  // number of concentric vertex selections subject to erosion
     }
 
-    if (wheel_patches) {
-        // Optionally, enable moving patch feature (multiple patches around each wheel)
-        for (auto& axle : hmmwv.GetVehicle().GetAxles()) {
-            terrain.AddMovingPatch(axle->m_wheels[0]->GetSpindle(), ChVector<>(0, 0, 0), ChVector<>(1, 0.5, 1));
-            terrain.AddMovingPatch(axle->m_wheels[1]->GetSpindle(), ChVector<>(0, 0, 0), ChVector<>(1, 0.5, 1));
+    for (const auto& hmmwv : hmmwvs) {
+        if (wheel_patches) {
+            // Optionally, enable moving patch feature (multiple patches around each wheel)
+            for (auto& axle : hmmwv->GetVehicle().GetAxles()) {
+                terrain.AddMovingPatch(axle->m_wheels[0]->GetSpindle(), ChVector<>(0, 0, 0), ChVector<>(1, 0.5, 1));
+                terrain.AddMovingPatch(axle->m_wheels[1]->GetSpindle(), ChVector<>(0, 0, 0), ChVector<>(1, 0.5, 1));
+            }
+        } else {
+            // Optionally, enable moving patch feature (single patch around vehicle chassis)
+            terrain.AddMovingPatch(hmmwv->GetChassisBody(), ChVector<>(0, 0, 0), ChVector<>(5, 3, 1));
         }
-    } else {
-        // Optionally, enable moving patch feature (single patch around vehicle chassis)
-        terrain.AddMovingPatch(hmmwv.GetChassisBody(), ChVector<>(0, 0, 0), ChVector<>(5, 3, 1));
     }
 
     terrain.SetPlotType(vehicle::SCMDeformableTerrain::PLOT_SINKAGE, 0, 0.1);
@@ -225,7 +236,7 @@ int main(int argc, char* argv[]) {
     std::shared_ptr<ChWheeledVehicleVisualSystemIrrlicht> vis;
     if (visualize) {
         vis = chrono_types::make_shared<ChWheeledVehicleVisualSystemIrrlicht>();
-        vis->AttachVehicle(&hmmwv.GetVehicle());
+        vis->AttachVehicle(&hmmwvs[0]->GetVehicle());
         vis->SetWindowTitle("Chrono SCM test");
         vis->SetChaseCamera(ChVector<>(0.0, 0.0, 1.75), 6.0, 0.5);
         vis->Initialize();
@@ -243,9 +254,6 @@ int main(int argc, char* argv[]) {
     // ---------------
     bool stats_done = false;
 
-    // Disable automatic vehicle realtime
-    hmmwv.GetVehicle().EnableRealtime(false);
-
     // Solver settings
     sys.SetSolverMaxIterations(50);
 
@@ -256,6 +264,7 @@ int main(int argc, char* argv[]) {
     double chrono_setup = 0;
     double raytest = 0;
     double raycast = 0;
+    double patches = 0;
 
     ChTimer<> timer;
     timer.start();
@@ -269,9 +278,9 @@ int main(int argc, char* argv[]) {
                 double rtf = timer() / end_time;
                 int nsteps = (int)(end_time / step_size);
 
-                std::string fname = "stats_" + std::to_string(nthreads) + ".out";
+                std::string fname = "stats_" + std::to_string(num_vehicles) + "_" + std::to_string(nthreads) + ".out";
                 std::ofstream ofile(fname.c_str(), std::ios_base::app);
-                ofile << raytest / nsteps << " " << raycast / nsteps << " " << rtf << endl;
+                ofile << raytest / nsteps << " " << raycast / nsteps << " " << patches / nsteps << " " << rtf << endl;
                 ofile.close();
                 cout << "\nOUTPUT FILE: " << fname << endl;
 
@@ -282,6 +291,7 @@ int main(int argc, char* argv[]) {
                 cout << "chrono setup (s):  " << chrono_setup << endl;
                 cout << "raytesting (s):    " << raytest / 1e3 << endl;
                 cout << "raycasting (s):    " << raycast / 1e3 << endl;
+                cout << "patches (s):       " << patches / 1e3 << endl;
                 cout << "RTF:               " << rtf << endl;
                 cout << "\nSCM stats for last step:" << endl;
                 terrain.PrintStepStatistics(cout);
@@ -306,22 +316,24 @@ int main(int argc, char* argv[]) {
         }
 #endif
 
-        // Driver inputs
-        DriverInputs driver_inputs = driver.GetInputs();
-
         // Update modules
-        driver.Synchronize(time);
         terrain.Synchronize(time);
-        hmmwv.Synchronize(time, driver_inputs, terrain);
+        for (int iv = 0; iv < num_vehicles; iv++) {
+            DriverInputs driver_inputs = drivers[iv]->GetInputs();
+            drivers[iv]->Synchronize(time);
+            hmmwvs[iv]->Synchronize(time, driver_inputs, terrain);
 #ifdef CHRONO_IRRLICHT
-        if (vis)
-            vis->Synchronize("", driver_inputs);
+            if (vis && iv == 0)
+                vis->Synchronize("", driver_inputs);
 #endif
+        }
 
         // Advance dynamics
-        driver.Advance(step_size);
         terrain.Advance(step_size);
-        hmmwv.Advance(step_size);
+        for (int iv = 0; iv < num_vehicles; iv++) {
+            drivers[iv]->Advance(step_size);
+            hmmwvs[iv]->Advance(step_size);
+        }
         sys.DoStepDynamics(step_size);
 #ifdef CHRONO_IRRLICHT
         if (vis)
@@ -332,6 +344,7 @@ int main(int argc, char* argv[]) {
         chrono_setup += sys.GetTimerSetup();
         raytest += terrain.GetTimerRayTesting();
         raycast += terrain.GetTimerRayCasting();
+        patches += terrain.GetTimerContactPatches();
 
         // Increment frame number
         step_number++;
@@ -344,6 +357,7 @@ void AddCommandLineOptions(ChCLI& cli) {
     cli.AddOption<double>("Test", "s,step_size", "Step size", std::to_string(step_size));
     cli.AddOption<double>("Test", "e,end_time", "End time", std::to_string(end_time));
     cli.AddOption<int>("Test", "n,nthreads", "Number threads", std::to_string(nthreads));
+    cli.AddOption<int>("Test", "m,num_vehicles", "Number of vehicles in convoy", std::to_string(num_vehicles));
     cli.AddOption<bool>("Test", "c,csys", "Use Chrono multicore collision (false: Bullet)",
                         std ::to_string(chrono_collsys));
     cli.AddOption<bool>("Test", "w,wheel_patches", "Use patches under each wheel", std::to_string(wheel_patches));
@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the incremental broadphase of the Chrono collision system.
+// A few spheres are moved kinematically over a field of fixed boxes and fixed
+// spheres. The number of contacts found with the incremental broadphase must
+// match the one found with the default broadphase at each step. Ray casts (which
+// use the broadphase grid) must also give the same results.
+//
+// =============================================================================
+
+#include "chrono/collision/ChCollisionSystemChrono.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+class BroadphaseTest {
+  public:
+    BroadphaseTest(bool incremental);
+
+    void Advance(double time, double step);
+    int GetNcontacts() { return sys.GetNcontacts(); }
+    bool RayHit(const ChVector<>& from, const ChVector<>& to, ChVector<>& point);
+
+  private:
+    ChSystemNSC sys;
+    std::vector<std::shared_ptr<ChBody>> movers;
+};
+
+BroadphaseTest::BroadphaseTest(bool incremental) {
+    auto csys = chrono_types::make_shared<ChCollisionSystemChrono>();
+    csys->SetBroadphaseGridResolution(ChVector<int>(8, 8, 2));
+    if (incremental)
+        csys->SetBroadphaseIncremental(true, 0.05);
+    sys.SetCollisionSystem(csys);
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // Field of fixed boxes, with fixed spheres on some of them
+    for (int ix = 0; ix < 10; ix++) {
+        for (int iy = 0; iy < 10; iy++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.9, 0.9, 0.2, 1000, mat, ChCollisionSystemType::CHRONO);
+            box->SetPos(ChVector<>(ix, iy, -0.1));
+            box->SetBodyFixed(true);
+            sys.AddBody(box);
+
+            if ((ix + iy) % 3 == 0) {
+                auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.2, 1000, mat, ChCollisionSystemType::CHRONO);
+                ball->SetPos(ChVector<>(ix, iy, 0.2));
+                ball->SetBodyFixed(true);
+                sys.AddBody(ball);
+            }
+        }
+    }
+
+    // Spheres moved across the field
+    for (int i = 0; i < 4; i++) {
+        auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.3, 1000, mat, ChCollisionSystemType::CHRONO);
+        sys.AddBody(ball);
+        movers.push_back(ball);
+    }
+}
+
+void BroadphaseTest::Advance(double time, double step) {
+    // Prescribe the positions of the moving spheres
+    for (int i = 0; i < 4; i++) {
+        movers[i]->SetPos(ChVector<>(time * (1 + i), 1.5 + 2 * i, 0.25));
+        movers[i]->SetPos_dt(VNULL);
+    }
+    sys.DoStepDynamics(step);
+}
+
+bool BroadphaseTest::RayHit(const ChVector<>& from, const ChVector<>& to, ChVector<>& point) {
+    ChCollisionSystem::ChRayhitResult result;
+    sys.GetCollisionSystem()->RayHit(from, to, result);
+    point = result.abs_hitPoint;
+    return result.hit;
+}
+
+TEST(ChBroadphase, incremental) {
+    BroadphaseTest full(false);
+    BroadphaseTest incremental(true);
+
+    double step = 1e-2;
+    for (int i = 0; i < 200; i++) {
+        full.Advance(i * step, step);
+        incremental.Advance(i * step, step);
+        ASSERT_GT(full.GetNcontacts(), 0);
+        ASSERT_EQ(full.GetNcontacts(), incremental.GetNcontacts());
+
+        // Vertical rays through a fixed box (without sphere) and through the center of the first moving sphere
+        for (auto xy : {ChVector<>(1, 1, 0), ChVector<>(i * step, 1.5, 0)}) {
+            ChVector<> from(xy.x(), xy.y(), 5);
+            ChVector<> to(xy.x(), xy.y(), -5);
+            ChVector<> point_full;
+            ChVector<> point_incremental;
+            ASSERT_TRUE(full.RayHit(from, to, point_full));
+            ASSERT_TRUE(incremental.RayHit(from, to, point_incremental));
+            ASSERT_NEAR((point_full - point_incremental).Length(), 0.0, 1e-10);
+        }
+    }
+}
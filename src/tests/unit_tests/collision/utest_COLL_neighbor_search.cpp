@@ -0,0 +1,109 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit tests for the grid-based fixed-radius neighbor search.
+// - The neighbor lists of random points are compared against a brute-force
+//   O(N^2) search, for 1 and several threads.
+// - The list must not be rebuilt while no point moved more than half the skin,
+//   and must be rebuilt after a larger motion.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <random>
+
+#include "chrono/collision/ChNeighborSearch.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static std::vector<ChVector<>> RandomPoints(int num_points) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<ChVector<>> points(num_points);
+    for (auto& p : points)
+        p = ChVector<>(dist(gen), 2 * dist(gen), 0.5 * dist(gen));
+    return points;
+}
+
+// Check the neighbor lists against a brute-force search
+static void CheckNeighbors(const ChNeighborSearch& search, const std::vector<ChVector<>>& points, double cutoff) {
+    ASSERT_EQ(search.GetNumPoints(), points.size());
+    size_t num_pairs = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        std::vector<unsigned int> expected;
+        for (size_t j = 0; j < points.size(); j++) {
+            if (j != i && (points[j] - points[i]).Length() <= cutoff)
+                expected.push_back((unsigned int)j);
+        }
+        std::vector<unsigned int> found(search.GetNeighbors(i), search.GetNeighbors(i) + search.GetNumNeighbors(i));
+        std::sort(found.begin(), found.end());
+        ASSERT_EQ(found, expected);
+        num_pairs += expected.size();
+    }
+    ASSERT_EQ(search.GetNumPairs(), num_pairs / 2);
+}
+
+TEST(ChNeighborSearch, brute_force) {
+    auto points = RandomPoints(2000);
+    double radius = 0.08;
+    double skin = 0.02;
+
+    for (int num_threads : {1, 4}) {
+        ChNeighborSearch search;
+        search.SetNumThreads(num_threads);
+        search.SetSkin(skin);
+        ASSERT_TRUE(search.Update(points, radius));
+        CheckNeighbors(search, points, radius + skin);
+    }
+}
+
+TEST(ChNeighborSearch, skin) {
+    auto points = RandomPoints(2000);
+    double radius = 0.08;
+    double skin = 0.02;
+
+    ChNeighborSearch search;
+    search.SetSkin(skin);
+    ASSERT_TRUE(search.Update(points, radius));
+    ASSERT_EQ(search.GetNumRebuilds(), 1);
+
+    // Motion below half the skin: the list is kept and still contains all pairs within the radius
+    for (auto& p : points)
+        p += ChVector<>(0.3 * skin, 0, 0);
+    points[7] -= ChVector<>(0, 0.3 * skin, 0);
+    ASSERT_FALSE(search.Update(points, radius));
+    ASSERT_EQ(search.GetNumRebuilds(), 1);
+    for (size_t i = 0; i < points.size(); i++) {
+        const unsigned int* nbrs = search.GetNeighbors(i);
+        unsigned int num_nbrs = search.GetNumNeighbors(i);
+        for (size_t j = 0; j < points.size(); j++) {
+            if (j != i && (points[j] - points[i]).Length() <= radius)
+                ASSERT_TRUE(std::find(nbrs, nbrs + num_nbrs, (unsigned int)j) != nbrs + num_nbrs);
+        }
+    }
+
+    // A single point moving more than half the skin triggers a rebuild
+    points[5] += ChVector<>(0.6 * skin, 0, 0);
+    ASSERT_TRUE(search.Update(points, radius));
+    ASSERT_EQ(search.GetNumRebuilds(), 2);
+    CheckNeighbors(search, points, radius + skin);
+
+    // A larger search radius also triggers a rebuild
+    ASSERT_TRUE(search.Update(points, 1.1 * radius));
+    ASSERT_EQ(search.GetNumRebuilds(), 3);
+    ASSERT_EQ(search.GetNumUpdates(), 4);
+}
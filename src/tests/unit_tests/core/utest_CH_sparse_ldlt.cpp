@@ -0,0 +1,113 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit tests for the supernodal sparse LDLT factorization.
+// The solutions of a symmetric positive definite system and of a KKT system
+// (with zero constraint block) are compared against Eigen's SparseLU. The
+// numeric factorization is then repeated with the same symbolic analysis.
+//
+// =============================================================================
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/solver/ChSupernodalLDLT.h"
+
+#include <Eigen/SparseLU>
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Stiffness-like matrix on a grid with 3 DOFs per node, optionally augmented with constraint rows
+static ChSparseMatrix CreateMatrix(int grid, int num_constraints) {
+    int dof = 3;
+    int nv = grid * grid * dof;
+    int n = nv + num_constraints;
+    auto id = [&](int i, int j, int d) { return (i * grid + j) * dof + d; };
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < grid; i++) {
+        for (int j = 0; j < grid; j++) {
+            for (int d = 0; d < dof; d++) {
+                int a = id(i, j, d);
+                triplets.emplace_back(a, a, 10.0 + d);
+                for (int e = 0; e < dof; e++) {
+                    if (i + 1 < grid) {
+                        triplets.emplace_back(a, id(i + 1, j, e), -0.5);
+                        triplets.emplace_back(id(i + 1, j, e), a, -0.5);
+                    }
+                    if (j + 1 < grid) {
+                        triplets.emplace_back(a, id(i, j + 1, e), -0.5);
+                        triplets.emplace_back(id(i, j + 1, e), a, -0.5);
+                    }
+                }
+            }
+        }
+    }
+    for (int c = 0; c < num_constraints; c++) {
+        for (int k = 0; k < 3; k++) {
+            int v = (c * 97 + k * 13) % nv;
+            double w = 1.0 + 0.1 * k;
+            triplets.emplace_back(nv + c, v, w);
+            triplets.emplace_back(v, nv + c, w);
+        }
+    }
+
+    ChSparseMatrix A(n, n);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+    A.makeCompressed();
+    return A;
+}
+
+static void CheckSolution(const ChSparseMatrix& A, int num_positive) {
+    int n = (int)A.rows();
+    ChVectorDynamic<> b(n);
+    for (int i = 0; i < n; i++)
+        b(i) = std::sin(0.1 * i) + 1;
+
+    Eigen::SparseMatrix<double> Ac = A;
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu;
+    lu.compute(Ac);
+    ASSERT_EQ(lu.info(), Eigen::Success);
+    ChVectorDynamic<> x_lu = lu.solve(b);
+
+    ChSupernodalLDLT ldlt;
+    ldlt.SetNumThreads(2);
+    ldlt.Analyze(A, num_positive);
+    ASSERT_TRUE(ldlt.Factorize(A));
+    ChVectorDynamic<> x = b;
+    ldlt.Solve(x);
+
+    ASSERT_EQ(ldlt.GetNumPerturbedPivots(), 0);
+    ASSERT_NEAR((A * x - b).norm() / b.norm(), 0.0, 1e-12);
+    ASSERT_NEAR((x - x_lu).norm() / x_lu.norm(), 0.0, 1e-10);
+
+    // Refactorize a matrix with the same pattern, reusing the symbolic analysis
+    ChSparseMatrix A2 = A;
+    for (int k = 0; k < A2.nonZeros(); k++)
+        A2.valuePtr()[k] *= 2;
+    ASSERT_TRUE(ldlt.Factorize(A2));
+    x = b;
+    ldlt.Solve(x);
+    ASSERT_NEAR((x - 0.5 * x_lu).norm() / x_lu.norm(), 0.0, 1e-10);
+}
+
+TEST(ChSupernodalLDLT, spd) {
+    auto A = CreateMatrix(30, 0);
+    CheckSolution(A, -1);
+}
+
+TEST(ChSupernodalLDLT, kkt) {
+    auto A = CreateMatrix(30, 40);
+    CheckSolution(A, 30 * 30 * 3);
+}
@@ -0,0 +1,111 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the colored assembly of FEA element forces in ChMesh.
+// A plate of ANCF shell elements, clamped along one edge, is deformed under
+// gravity. The internal and gravity forces assembled by the mesh (element by
+// element in parallel, color by color) must match those obtained by looping
+// over the elements in their original order (as done by the previous parallel
+// loop with atomic updates). The assembled stiffness matrix must not depend on
+// the number of threads.
+//
+// =============================================================================
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/fea/ChElementShellANCF_3423.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+TEST(ChMesh, colored_assembly) {
+    ChSystemSMC sys;
+    sys.Set_G_acc(ChVector<>(0, 0, -9.81));
+    sys.SetNumThreads(4);
+
+    auto solver = chrono_types::make_shared<ChSolverMINRES>();
+    solver->SetMaxIterations(200);
+    solver->SetTolerance(1e-12);
+    sys.SetSolver(solver);
+
+    // Plate of nx x ny shell elements, clamped at x = 0
+    int nx = 6;
+    int ny = 6;
+    double dx = 0.1;
+    double dy = 0.1;
+    double thickness = 0.01;
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    for (int j = 0; j <= ny; j++) {
+        for (int i = 0; i <= nx; i++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, j * dy, 0), ChVector<>(0, 0, 1));
+            node->SetMass(0);
+            node->SetFixed(i == 0);
+            mesh->AddNode(node);
+        }
+    }
+
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, 2.1e7, 0.3);
+    auto node = [&](int i, int j) {
+        return std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(j * (nx + 1) + i));
+    };
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++) {
+            auto element = chrono_types::make_shared<ChElementShellANCF_3423>();
+            element->SetNodes(node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1));
+            element->SetDimensions(dx, dy);
+            element->AddLayer(thickness, 0, mat);
+            element->SetAlphaDamp(0.01);
+            mesh->AddElement(element);
+        }
+    }
+    sys.Add(mesh);
+
+    // Deform the plate under gravity
+    for (int k = 0; k < 10; k++)
+        sys.DoStepDynamics(1e-3);
+
+    // Elements sharing a node are in different colors
+    EXPECT_GT(mesh->GetNumElementColors(), 1u);
+
+    // Forces assembled by the mesh (colored, in parallel)
+    ChVectorDynamic<> R_colored(sys.GetNcoords_w());
+    R_colored.setZero();
+    mesh->IntLoadResidual_F(mesh->GetOffset_w(), R_colored, 0.5);
+
+    // Forces assembled element by element, in the original element order
+    ChVectorDynamic<> R_ref(sys.GetNcoords_w());
+    R_ref.setZero();
+    for (const auto& element : mesh->GetElements())
+        element->EleIntLoadResidual_F(R_ref, 0.5);
+    for (const auto& element : mesh->GetElements())
+        element->EleIntLoadResidual_F_gravity(R_ref, sys.Get_G_acc(), 0.5);
+
+    ASSERT_GT(R_ref.norm(), 0);
+    EXPECT_LE((R_colored - R_ref).norm(), 1e-12 * R_ref.norm());
+
+    // Assembled stiffness matrix, with multiple threads and with a single thread
+    ChSparseMatrix K_parallel;
+    sys.GetStiffnessMatrix(&K_parallel);
+
+    sys.SetNumThreads(1);
+    ChSparseMatrix K_serial;
+    sys.GetStiffnessMatrix(&K_serial);
+
+    ASSERT_GT(K_serial.norm(), 0);
+    EXPECT_EQ((K_parallel - K_serial).norm(), 0);
+}
@@ -0,0 +1,194 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the matrix-free mode of ChMesh.
+// A cantilever made of corotational hexahedra and tetrahedra (with their own
+// matrix-free products) and of springs (using the default cached element matrix)
+// falls under gravity and is integrated with the implicit Euler method and the
+// MINRES solver (with diagonal preconditioning). The trajectories obtained with
+// assembled element matrices and in matrix-free mode must match, also with
+// parallel system descriptor products. The default element implementation of the
+// matrix-free products (based on the assembled element matrix) is also checked.
+//
+// =============================================================================
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChElementSpring.h"
+#include "chrono/fea/ChElementTetraCorot_4.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+class Cantilever {
+  public:
+    Cantilever(bool matrix_free);
+
+    void Simulate(double step, int num_steps);
+
+    std::shared_ptr<ChNodeFEAxyz> GetTipNode() const { return m_tip; }
+    std::shared_ptr<ChMesh> GetMesh() const { return m_mesh; }
+    ChSystemSMC& GetSystem() { return m_sys; }
+
+  private:
+    ChSystemSMC m_sys;
+    std::shared_ptr<ChMesh> m_mesh;
+    std::shared_ptr<ChNodeFEAxyz> m_tip;
+};
+
+Cantilever::Cantilever(bool matrix_free) {
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_RayleighDampingK(0.01);
+    material->Set_density(1000);
+
+    m_mesh = chrono_types::make_shared<ChMesh>();
+    m_mesh->SetMatrixFree(matrix_free);
+
+    // Nodes on a (nx+1) x 2 x 2 grid, fixed at x = 0
+    int nx = 6;
+    double h = 0.1;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++) {
+        for (int j = 0; j < 2; j++) {
+            for (int k = 0; k < 2; k++) {
+                auto node = chrono_types::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, k * h));
+                node->SetFixed(i == 0);
+                m_mesh->AddNode(node);
+                nodes.push_back(node);
+            }
+        }
+    }
+    m_tip = nodes.back();
+
+    auto node = [&](int i, int j, int k) { return nodes[4 * i + 2 * j + k]; };
+
+    auto add_tetra = [&](std::shared_ptr<ChNodeFEAxyz> n1, std::shared_ptr<ChNodeFEAxyz> n2,
+                         std::shared_ptr<ChNodeFEAxyz> n3, std::shared_ptr<ChNodeFEAxyz> n4) {
+        auto tetra = chrono_types::make_shared<ChElementTetraCorot_4>();
+        tetra->SetNodes(n1, n2, n3, n4);
+        tetra->SetMaterial(material);
+        m_mesh->AddElement(tetra);
+    };
+
+    // Hexahedra over the first half of the beam, 5 tetrahedra per cell over the second half
+    for (int i = 0; i < nx / 2; i++) {
+        auto hexa = chrono_types::make_shared<ChElementHexaCorot_8>();
+        hexa->SetNodes(node(i, 0, 0), node(i, 1, 0), node(i, 1, 1), node(i, 0, 1),  //
+                       node(i + 1, 0, 0), node(i + 1, 1, 0), node(i + 1, 1, 1), node(i + 1, 0, 1));
+        hexa->SetMaterial(material);
+        m_mesh->AddElement(hexa);
+    }
+    for (int i = nx / 2; i < nx; i++) {
+        add_tetra(node(i, 0, 0), node(i + 1, 0, 0), node(i, 1, 0), node(i, 0, 1));
+        add_tetra(node(i + 1, 1, 0), node(i, 1, 0), node(i + 1, 0, 0), node(i + 1, 1, 1));
+        add_tetra(node(i + 1, 0, 1), node(i + 1, 0, 0), node(i, 0, 1), node(i + 1, 1, 1));
+        add_tetra(node(i, 1, 1), node(i, 0, 1), node(i, 1, 0), node(i + 1, 1, 1));
+        add_tetra(node(i + 1, 0, 0), node(i, 1, 0), node(i, 0, 1), node(i + 1, 1, 1));
+    }
+
+    // Diagonal springs on the top face
+    for (int i = 0; i < nx; i++) {
+        auto spring = chrono_types::make_shared<ChElementSpring>();
+        spring->SetNodes(node(i, 0, 1), node(i + 1, 1, 1));
+        spring->SetSpringK(1e5);
+        spring->SetDamperR(10);
+        m_mesh->AddElement(spring);
+    }
+
+    m_sys.Add(m_mesh);
+
+    auto solver = chrono_types::make_shared<ChSolverMINRES>();
+    solver->SetMaxIterations(500);
+    solver->SetTolerance(1e-14);
+    solver->EnableDiagonalPreconditioner(true);
+    m_sys.SetSolver(solver);
+
+    m_sys.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT);
+}
+
+void Cantilever::Simulate(double step, int num_steps) {
+    for (int i = 0; i < num_steps; i++)
+        m_sys.DoStepDynamics(step);
+}
+
+TEST(ChMesh, matrix_free) {
+    Cantilever assembled(false);
+    Cantilever matrix_free(true);
+
+    assembled.Simulate(1e-3, 100);
+    matrix_free.Simulate(1e-3, 100);
+
+    auto pos_assembled = assembled.GetTipNode()->GetPos();
+    auto pos_matrix_free = matrix_free.GetTipNode()->GetPos();
+    ASSERT_LT(pos_assembled.y(), 0.1 - 1e-4);
+    ASSERT_NEAR((pos_assembled - pos_matrix_free).Length(), 0.0, 1e-8);
+    ASSERT_NEAR((assembled.GetTipNode()->GetPos_dt() - matrix_free.GetTipNode()->GetPos_dt()).Length(), 0.0, 1e-6);
+}
+
+TEST(ChMesh, matrix_free_parallel_descriptor) {
+    Cantilever serial(true);
+    Cantilever parallel(true);
+    parallel.GetSystem().GetSystemDescriptor()->SetNumThreads(2);
+    parallel.GetSystem().GetSystemDescriptor()->SetParallelThreshold(0);
+
+    serial.Simulate(1e-3, 100);
+    parallel.Simulate(1e-3, 100);
+
+    auto pos_serial = serial.GetTipNode()->GetPos();
+    auto pos_parallel = parallel.GetTipNode()->GetPos();
+    ASSERT_NEAR((pos_serial - pos_parallel).Length(), 0.0, 1e-8);
+}
+
+TEST(ChElementBase, default_matrix_free_products) {
+    Cantilever cantilever(true);
+    cantilever.Simulate(1e-3, 10);
+
+    auto& descriptor = *cantilever.GetSystem().GetSystemDescriptor();
+    int n_q = descriptor.CountActiveVariables();
+    ChVectorDynamic<> x(n_q);
+    x.setRandom();
+
+    double Kfactor = 2;
+    double Rfactor = 0.3;
+    double Mfactor = 0.1;
+
+    for (auto& element : cantilever.GetMesh()->GetElements()) {
+        ChVectorDynamic<> Hx(n_q);
+        ChVectorDynamic<> Hx_default(n_q);
+        ChVectorDynamic<> D(n_q);
+        ChVectorDynamic<> D_default(n_q);
+        Hx.setZero();
+        Hx_default.setZero();
+        D.setZero();
+        D_default.setZero();
+
+        element->KRMmatricesMultiplyAndAdd(Hx, x, Kfactor, Rfactor, Mfactor);
+        element->ChElementBase::KRMmatricesMultiplyAndAdd(Hx_default, x, Kfactor, Rfactor, Mfactor);
+        element->KRMmatricesDiagonalAdd(D, Kfactor, Rfactor, Mfactor);
+        element->ChElementBase::KRMmatricesDiagonalAdd(D_default, Kfactor, Rfactor, Mfactor);
+
+        double tol = 1e-12 * std::max(1.0, Hx.lpNorm<Eigen::Infinity>());
+        for (int i = 0; i < n_q; i++)
+            ASSERT_NEAR(Hx(i), Hx_default(i), tol);
+        tol = 1e-12 * std::max(1.0, D.lpNorm<Eigen::Infinity>());
+        for (int i = 0; i < n_q; i++)
+            ASSERT_NEAR(D(i), D_default(i), tol);
+    }
+}
@@ -0,0 +1,109 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Author: Radu Serban
+// =============================================================================
+//
+// Unit test for the CPU WCSPH solver: a column of fluid at rest in a tank
+// (periodic in the Y direction) must remain at rest, confined by the BCE
+// markers, with a hydrostatic pressure distribution.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChSystemFsiCpu.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fsi;
+
+TEST(ChronoFsiCpu, hydrostatic) {
+    // Tank and fluid dimensions
+    double bxDim = 0.4;
+    double byDim = 0.2;
+    double bzDim = 0.4;
+    double fzDim = 0.3;
+
+    double spacing = 0.05;
+    double g = 9.81;
+
+    ChSystemSMC sysMBS;
+    ChSystemFsiCpu sysFSI(&sysMBS);
+    sysFSI.SetVerbose(false);
+    sysFSI.SetInitialSpacing(spacing);
+    sysFSI.SetKernelLength(spacing);
+    sysFSI.SetDensity(1000);
+    sysFSI.SetViscosity(1);
+    sysFSI.SetMaxVelocity(3);
+    sysFSI.Set_G_acc(ChVector<>(0, 0, -g));
+    sysFSI.SetStepSize(2e-4);
+    sysFSI.SetDensityReinitSteps(200);
+
+    ChVector<> cMin(-bxDim / 2 - 10 * spacing, -byDim / 2 - spacing / 2, -2 * bzDim);
+    ChVector<> cMax(+bxDim / 2 + 10 * spacing, +byDim / 2 + spacing / 2, +2 * bzDim);
+    sysFSI.SetBoundaries(cMin, cMax);
+
+    // Fluid particles, initialized with the hydrostatic pressure
+    double rho0 = sysFSI.GetDensity();
+    double Cs = sysFSI.GetSoundSpeed();
+    chrono::utils::GridSampler<> sampler(spacing);
+    auto points = sampler.SampleBox(ChVector<>(0, 0, fzDim / 2), ChVector<>(bxDim / 2, byDim / 2, fzDim / 2));
+    for (const auto& p : points) {
+        double pres = rho0 * g * (fzDim - p.z());
+        sysFSI.AddSPHParticle(p, rho0 + pres / (Cs * Cs), pres, sysFSI.GetViscosity());
+    }
+
+    // Tank walls
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sysMBS.AddBody(ground);
+    sysFSI.AddContainerBCE(ground, ChFrame<>(), ChVector<>(bxDim, byDim, bzDim), ChVector<int>(2, 0, -1));
+
+    sysFSI.Initialize();
+    ASSERT_EQ(sysFSI.GetNumFluidMarkers(), points.size());
+    ASSERT_GT(sysFSI.GetNumBoundaryMarkers(), 0u);
+
+    while (sysFSI.GetSimTime() < 0.25)
+        sysFSI.DoStepDynamics_FSI();
+
+    const auto& pos = sysFSI.GetParticlePositions();
+    const auto& vel = sysFSI.GetParticleVelocities();
+    auto props = sysFSI.GetParticleFluidProperties();
+
+    double max_vel = 0;
+    double sum_pres_bottom = 0;
+    int num_bottom = 0;
+    for (size_t i = 0; i < sysFSI.GetNumFluidMarkers(); i++) {
+        // Fluid must stay inside the tank
+        ASSERT_GT(pos[i].z(), -spacing);
+        ASSERT_LT(std::abs(pos[i].x()), bxDim / 2 + spacing);
+        max_vel = std::max(max_vel, vel[i].Length());
+
+        // Average pressure in the bottom layer
+        if (pos[i].z() < spacing / 2) {
+            sum_pres_bottom += props[i].y();
+            num_bottom++;
+        }
+    }
+
+    ASSERT_GT(num_bottom, 0);
+    double pres_bottom = sum_pres_bottom / num_bottom;
+    double pres_ref = rho0 * g * fzDim;
+
+    ASSERT_LT(max_vel, 0.05);
+    ASSERT_NEAR(pres_bottom, pres_ref, 0.05 * pres_ref);
+}
@@ -0,0 +1,267 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit tests for the CPU implementation of Chrono::Gpu:
+// - spheres settled on a triangle mesh (ChSystemGpuMeshCpu) load the mesh with
+//   their total weight;
+// - spheres settled on a plane BC inside a cylinder BC load the plane with their
+//   total weight and stay inside the cylinder;
+// - BCs created after initialization give the same results as BCs created
+//   before, also when spheres touch the BCs and a mesh at the same time;
+// - a stack of spheres settles at the expected heights with the material-based
+//   contact model;
+// - results are identical with 1 and several threads.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/utils/ChUtilsSamplers.h"
+#include "chrono_gpu/physics/ChSystemGpuCpu.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::gpu;
+
+static const float radius = 0.5f;
+static const float density = 1.53f;
+static const float gravity = 980.f;
+static const float step_size = 1e-4f;
+
+static float SphereMass() {
+    return 4.f / 3.f * (float)CH_C_PI * radius * radius * radius * density;
+}
+
+// Set the stiffness-based contact model, with friction and rolling resistance
+static void SetContactModel(ChSystemGpuCpu& gpu_sys) {
+    gpu_sys.SetVerbosity(CHGPU_VERBOSITY::QUIET);
+    gpu_sys.SetGravitationalAcceleration(ChVector<float>(0, 0, -gravity));
+    gpu_sys.SetFrictionMode(CHGPU_FRICTION_MODE::MULTI_STEP);
+    gpu_sys.SetTimeIntegrator(CHGPU_TIME_INTEGRATOR::CHUNG);
+    gpu_sys.SetFixedStepSize(step_size);
+
+    gpu_sys.SetKn_SPH2SPH(1e7);
+    gpu_sys.SetKn_SPH2WALL(1e7);
+    gpu_sys.SetGn_SPH2SPH(2e4);
+    gpu_sys.SetGn_SPH2WALL(2e4);
+    gpu_sys.SetKt_SPH2SPH(2e6);
+    gpu_sys.SetKt_SPH2WALL(1e6);
+    gpu_sys.SetGt_SPH2SPH(50);
+    gpu_sys.SetGt_SPH2WALL(50);
+    gpu_sys.SetStaticFrictionCoeff_SPH2SPH(0.5f);
+    gpu_sys.SetStaticFrictionCoeff_SPH2WALL(0.5f);
+
+    gpu_sys.SetRollingMode(CHGPU_ROLLING_MODE::SCHWARTZ);
+    gpu_sys.SetRollingCoeff_SPH2SPH(0.0008f);
+    gpu_sys.SetRollingCoeff_SPH2WALL(0.0008f);
+}
+
+// Set the sphere-mesh contact model
+static void SetMeshContactModel(ChSystemGpuMeshCpu& gpu_sys) {
+    gpu_sys.SetKn_SPH2MESH(1e7);
+    gpu_sys.SetGn_SPH2MESH(2e4);
+    gpu_sys.SetKt_SPH2MESH(1e6);
+    gpu_sys.SetGt_SPH2MESH(50);
+    gpu_sys.SetStaticFrictionCoeff_SPH2MESH(0.5f);
+    gpu_sys.SetRollingCoeff_SPH2MESH(0.0008f);
+}
+
+// Square horizontal mesh (two triangles with upward normals) at the given height
+static std::shared_ptr<geometry::ChTriangleMeshConnected> CreateFloorMesh(double z, double half_size) {
+    auto mesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+    ChVector<> p1(-half_size, -half_size, z);
+    ChVector<> p2(+half_size, -half_size, z);
+    ChVector<> p3(+half_size, +half_size, z);
+    ChVector<> p4(-half_size, +half_size, z);
+    mesh->addTriangle(p1, p2, p3);
+    mesh->addTriangle(p1, p3, p4);
+    return mesh;
+}
+
+// Grid of 3x3 spheres, just above the given height
+static std::vector<ChVector<float>> SphereGrid(float z) {
+    std::vector<ChVector<float>> points;
+    for (int i = -1; i <= 1; i++)
+        for (int j = -1; j <= 1; j++)
+            points.push_back(ChVector<float>(1.5f * i, 1.5f * j, z + 1.1f * radius));
+    return points;
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(gpuCpu, mesh) {
+    ChSystemGpuMeshCpu gpu_sys(radius, density, ChVector<float>(20, 20, 20));
+    SetContactModel(gpu_sys);
+    SetMeshContactModel(gpu_sys);
+    gpu_sys.AddMesh(CreateFloorMesh(-5, 8), 1000);
+    gpu_sys.SetParticles(SphereGrid(-5));
+    gpu_sys.Initialize();
+    ASSERT_EQ(gpu_sys.GetNumMeshes(), 1u);
+
+    gpu_sys.AdvanceSimulation(0.5f);
+
+    // The spheres rest on the mesh, which carries their total weight
+    double weight = gpu_sys.GetNumParticles() * SphereMass() * gravity;
+    ChVector<> force;
+    ChVector<> torque;
+    gpu_sys.CollectMeshContactForces(0, force, torque);
+    ASSERT_NEAR(force.z(), -weight, 1e-2 * weight);
+    ASSERT_LT(gpu_sys.GetParticlesKineticEnergy(), 1e-2);
+    for (int i = 0; i < (int)gpu_sys.GetNumParticles(); i++)
+        ASSERT_NEAR(gpu_sys.GetParticlePosition(i).z(), -5 + radius, 1e-2);
+}
+
+TEST(gpuCpu, boundary_conditions) {
+    ChSystemGpuCpu gpu_sys(radius, density, ChVector<float>(20, 20, 20));
+    SetContactModel(gpu_sys);
+    size_t plane = gpu_sys.CreateBCPlane(ChVector<float>(0, 0, -5), ChVector<float>(0, 0, 1), true);
+    size_t cyl = gpu_sys.CreateBCCylinderZ(ChVector<float>(0, 0, 0), 3, false, true);
+
+    // Spheres with some initial horizontal velocity, pushing them against the cylinder
+    auto points = SphereGrid(-5);
+    std::vector<ChVector<float>> vels;
+    for (const auto& p : points)
+        vels.push_back(20.f * ChVector<float>(p.x(), p.y(), 0));
+    gpu_sys.SetParticles(points, vels);
+    gpu_sys.Initialize();
+
+    gpu_sys.AdvanceSimulation(0.5f);
+
+    // The plane carries the total weight of the spheres
+    double weight = gpu_sys.GetNumParticles() * SphereMass() * gravity;
+    ChVector<float> plane_force;
+    ASSERT_TRUE(gpu_sys.GetBCReactionForces(plane, plane_force));
+    ASSERT_NEAR(plane_force.z(), -weight, 1e-2 * weight);
+
+    // All spheres are inside the cylinder, resting on the plane
+    for (int i = 0; i < (int)gpu_sys.GetNumParticles(); i++) {
+        ChVector<float> pos = gpu_sys.GetParticlePosition(i);
+        ASSERT_LT(std::sqrt(pos.x() * pos.x() + pos.y() * pos.y()), 3 - 0.99 * radius);
+        ASSERT_NEAR(pos.z(), -5 + radius, 1e-2);
+    }
+
+    // Disabled BCs do not report forces
+    ChVector<float> cyl_force;
+    ASSERT_TRUE(gpu_sys.GetBCReactionForces(cyl, cyl_force));
+    ASSERT_TRUE(gpu_sys.DisableBCbyID(cyl));
+    ASSERT_FALSE(gpu_sys.GetBCReactionForces(cyl, cyl_force));
+}
+
+TEST(gpuCpu, bc_after_initialize) {
+    // Spheres sliding along the floor mesh, against a wall BC. Two BCs are created before initialization in the first
+    // system and after initialization in the second one. The friction histories of the BC and mesh contacts must be
+    // kept separate in both cases.
+    std::vector<ChVector<float>> pos[2];
+    std::vector<ChVector<float>> vel[2];
+    for (int k = 0; k < 2; k++) {
+        ChSystemGpuMeshCpu gpu_sys(radius, density, ChVector<float>(20, 20, 20));
+        SetContactModel(gpu_sys);
+        SetMeshContactModel(gpu_sys);
+        gpu_sys.AddMesh(CreateFloorMesh(-5, 8), 1000);
+
+        std::vector<ChVector<float>> points;
+        std::vector<ChVector<float>> vels;
+        for (int i = 0; i < 4; i++) {
+            points.push_back(ChVector<float>(4 - radius, 1.5f * i, -5 + radius));
+            vels.push_back(ChVector<float>(0, 10, 0));
+        }
+        gpu_sys.SetParticles(points, vels);
+
+        if (k == 0) {
+            gpu_sys.CreateBCPlane(ChVector<float>(0, 0, 8), ChVector<float>(0, 0, -1), false);
+            gpu_sys.CreateBCPlane(ChVector<float>(4, 0, 0), ChVector<float>(-1, 0, 0), true);
+            gpu_sys.Initialize();
+        } else {
+            gpu_sys.Initialize();
+            gpu_sys.CreateBCPlane(ChVector<float>(0, 0, 8), ChVector<float>(0, 0, -1), false);
+            gpu_sys.CreateBCPlane(ChVector<float>(4, 0, 0), ChVector<float>(-1, 0, 0), true);
+        }
+
+        gpu_sys.AdvanceSimulation(0.1f);
+
+        for (int i = 0; i < (int)gpu_sys.GetNumParticles(); i++) {
+            pos[k].push_back(gpu_sys.GetParticlePosition(i));
+            vel[k].push_back(gpu_sys.GetParticleVelocity(i));
+        }
+    }
+
+    for (size_t i = 0; i < pos[0].size(); i++) {
+        ASSERT_EQ(pos[1][i], pos[0][i]);
+        ASSERT_EQ(vel[1][i], vel[0][i]);
+    }
+}
+
+TEST(gpuCpu, material_based) {
+    ChSystemGpuCpu gpu_sys(radius, density, ChVector<float>(20, 20, 20));
+    SetContactModel(gpu_sys);
+    gpu_sys.UseMaterialBasedModel(true);
+    gpu_sys.SetYoungModulus_SPH(1e8);
+    gpu_sys.SetYoungModulus_WALL(1e8);
+    gpu_sys.SetPoissonRatio_SPH(0.3);
+    gpu_sys.SetPoissonRatio_WALL(0.3);
+    gpu_sys.SetRestitution_SPH(0.5);
+    gpu_sys.SetRestitution_WALL(0.5);
+
+    // Stack of spheres on the bottom wall of the domain
+    float bottom = -10.f;
+    std::vector<ChVector<float>> points;
+    for (int i = 0; i < 5; i++)
+        points.push_back(ChVector<float>(0, 0, bottom + radius + 2.1f * radius * i));
+    gpu_sys.SetParticles(points);
+    gpu_sys.SetBDFixed(true);
+    gpu_sys.Initialize();
+
+    gpu_sys.AdvanceSimulation(1.0f);
+
+    ASSERT_LT(gpu_sys.GetParticlesKineticEnergy(), 1e-2);
+    for (int i = 0; i < 5; i++) {
+        ChVector<float> pos = gpu_sys.GetParticlePosition(i);
+        ASSERT_NEAR(pos.x(), 0, 1e-3);
+        ASSERT_NEAR(pos.y(), 0, 1e-3);
+        ASSERT_NEAR(pos.z(), bottom + radius + 2 * radius * i, 2e-2);
+    }
+}
+
+TEST(gpuCpu, threads) {
+    std::vector<ChVector<float>> pos[2];
+    std::vector<ChVector<float>> omg[2];
+    int num_threads[2] = {1, 4};
+
+    for (int k = 0; k < 2; k++) {
+        ChSystemGpuCpu gpu_sys(radius, density, ChVector<float>(20, 20, 20));
+        SetContactModel(gpu_sys);
+        gpu_sys.SetNumThreads(num_threads[k]);
+        gpu_sys.SetCohesionRatio(0.5f);
+        gpu_sys.CreateBCCylinderZ(ChVector<float>(0, 0, 0), 5, false, true);
+
+        utils::HCPSampler<float> sampler(2.02f * radius);
+        gpu_sys.SetParticles(sampler.SampleCylinderZ(ChVector<float>(0, 0, -5), 4, 4));
+        gpu_sys.Initialize();
+
+        gpu_sys.AdvanceSimulation(0.05f);
+
+        for (int i = 0; i < (int)gpu_sys.GetNumParticles(); i++) {
+            pos[k].push_back(gpu_sys.GetParticlePosition(i));
+            omg[k].push_back(gpu_sys.GetParticleAngVelocity(i));
+        }
+    }
+
+    ASSERT_GT(pos[0].size(), 100u);
+    ASSERT_EQ(pos[0].size(), pos[1].size());
+    for (size_t i = 0; i < pos[0].size(); i++) {
+        ASSERT_EQ(pos[1][i], pos[0][i]);
+        ASSERT_EQ(omg[1][i], omg[0][i]);
+    }
+}
@@ -0,0 +1,143 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit tests for the modal eigensolvers, on a cantilever beam in a modal assembly.
+// - The frequencies computed with the block Lanczos solver must match those
+//   computed with the Lanczos solver.
+// - Modes cached on disk (see ChModalAssembly::SetModesCacheDirectory) must be
+//   reloaded identically when the analysis of the same assembly is repeated.
+//
+// =============================================================================
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChLinkMate.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "chrono_modal/ChModalAssembly.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::modal;
+using namespace chrono::fea;
+
+static const int num_modes = 6;
+
+// Create a cantilever beam, clamped at one end, in a modal assembly.
+// The end nodes are boundary nodes, the other nodes are internal nodes.
+static std::shared_ptr<ChModalAssembly> CreateCantilever(ChSystem& sys, int n_elements) {
+    auto assembly = chrono_types::make_shared<ChModalAssembly>();
+    sys.Add(assembly);
+
+    auto mesh_internal = chrono_types::make_shared<ChMesh>();
+    auto mesh_boundary = chrono_types::make_shared<ChMesh>();
+    mesh_internal->SetAutomaticGravity(false);
+    mesh_boundary->SetAutomaticGravity(false);
+    assembly->AddInternal(mesh_internal);
+    assembly->Add(mesh_boundary);
+
+    auto section = chrono_types::make_shared<ChBeamSectionEulerAdvanced>();
+    section->SetDensity(1000);
+    section->SetYoungModulus(100e6);
+    section->SetGwithPoissonRatio(0.31);
+    section->SetAsRectangularSection(0.05, 0.3);
+
+    auto node_A = chrono_types::make_shared<ChNodeFEAxyzrot>();
+    node_A->SetMass(0);
+    node_A->GetInertia().setZero();
+    mesh_boundary->AddNode(node_A);
+
+    auto node_B = chrono_types::make_shared<ChNodeFEAxyzrot>(ChFrame<>(ChVector<>(6, 0, 0)));
+    node_B->SetMass(0);
+    node_B->GetInertia().setZero();
+    mesh_boundary->AddNode(node_B);
+
+    ChBuilderBeamEuler builder;
+    builder.BuildBeam(mesh_internal, section, n_elements, node_A, node_B, ChVector<>(0, 1, 0));
+
+    auto base = chrono_types::make_shared<ChBodyEasyBox>(1, 2, 2, 200, false, false);
+    base->SetBodyFixed(true);
+    base->SetPos(ChVector<>(-0.5, 0, 0));
+    assembly->Add(base);
+
+    auto root = chrono_types::make_shared<ChLinkMateGeneric>();
+    root->Initialize(node_A, base, ChFrame<>(ChVector<>(0, 0, 1), QUNIT));
+    assembly->Add(root);
+
+    sys.Setup();
+    sys.Update();
+
+    return assembly;
+}
+
+TEST(ChModalAssembly, block_lanczos) {
+    ChSystemNSC sys_lanczos;
+    ChSystemNSC sys_block;
+    auto assembly_lanczos = CreateCantilever(sys_lanczos, 20);
+    auto assembly_block = CreateCantilever(sys_block, 20);
+
+    ChGeneralizedEigenvalueSolverLanczos solver_lanczos;
+    ChGeneralizedEigenvalueSolverBlockLanczos solver_block;
+    solver_block.SetBlockSize(3);
+    solver_block.SetNumThreads(2);
+
+    assembly_lanczos->ComputeModes(ChModalSolveUndamped(num_modes, 1e-5, 500, 1e-10, false, solver_lanczos));
+    assembly_block->ComputeModes(ChModalSolveUndamped(num_modes, 1e-5, 500, 1e-10, false, solver_block));
+
+    const auto& freq_lanczos = assembly_lanczos->Get_modes_frequencies();
+    const auto& freq_block = assembly_block->Get_modes_frequencies();
+    ASSERT_EQ(freq_lanczos.size(), num_modes);
+    ASSERT_EQ(freq_block.size(), num_modes);
+    for (int i = 0; i < num_modes; i++) {
+        ASSERT_GT(freq_lanczos(i), 0);
+        ASSERT_NEAR(freq_block(i), freq_lanczos(i), 1e-6 * freq_lanczos(i));
+    }
+}
+
+TEST(ChModalAssembly, modes_cache) {
+    const std::string cache_dir = "modes_cache";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(cache_dir)));
+
+    // Reference analysis, without caching
+    ChSystemNSC sys_ref;
+    auto assembly_ref = CreateCantilever(sys_ref, 10);
+    assembly_ref->ComputeModes(num_modes);
+
+    // First analysis: the modes are computed and written to the cache
+    ChSystemNSC sys_first;
+    auto assembly_first = CreateCantilever(sys_first, 10);
+    assembly_first->SetModesCacheDirectory(cache_dir);
+    assembly_first->ComputeModes(num_modes);
+
+    // Second analysis of an identical assembly: the modes are loaded from the cache
+    ChSystemNSC sys_second;
+    auto assembly_second = CreateCantilever(sys_second, 10);
+    assembly_second->SetModesCacheDirectory(cache_dir);
+    assembly_second->ComputeModes(num_modes);
+
+    ASSERT_EQ(assembly_first->Get_modes_frequencies().size(), num_modes);
+    ASSERT_TRUE(assembly_second->Get_modes_V() == assembly_first->Get_modes_V());
+    ASSERT_TRUE(assembly_second->Get_modes_eig() == assembly_first->Get_modes_eig());
+    ASSERT_TRUE(assembly_second->Get_modes_frequencies() == assembly_first->Get_modes_frequencies());
+
+    // The cached modes are those of the solver
+    for (int i = 0; i < num_modes; i++) {
+        double freq = assembly_ref->Get_modes_frequencies()(i);
+        ASSERT_NEAR(assembly_second->Get_modes_frequencies()(i), freq, 1e-8 * freq);
+    }
+}
@@ -0,0 +1,122 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the modal reduction of several assemblies at once.
+// Three cantilever beams (two identical, one with a finer mesh) are reduced with
+// a single call to the static ChModalAssembly::SwitchModalReductionON. The
+// reduced matrices must match those obtained by reducing each assembly on its
+// own, and the two identical assemblies must share the same reduction.
+//
+// =============================================================================
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChLinkMate.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "chrono_modal/ChModalAssembly.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::modal;
+using namespace chrono::fea;
+
+static const int num_modes = 6;
+
+// Create a cantilever beam, clamped at one end, in a modal assembly.
+// The end nodes are boundary nodes, the other nodes are internal nodes.
+static std::shared_ptr<ChModalAssembly> CreateCantilever(ChSystem& sys, int n_elements) {
+    auto assembly = chrono_types::make_shared<ChModalAssembly>();
+    sys.Add(assembly);
+
+    auto mesh_internal = chrono_types::make_shared<ChMesh>();
+    auto mesh_boundary = chrono_types::make_shared<ChMesh>();
+    mesh_internal->SetAutomaticGravity(false);
+    mesh_boundary->SetAutomaticGravity(false);
+    assembly->AddInternal(mesh_internal);
+    assembly->Add(mesh_boundary);
+
+    auto section = chrono_types::make_shared<ChBeamSectionEulerAdvanced>();
+    section->SetDensity(1000);
+    section->SetYoungModulus(100e6);
+    section->SetGwithPoissonRatio(0.31);
+    section->SetAsRectangularSection(0.05, 0.3);
+
+    auto node_A = chrono_types::make_shared<ChNodeFEAxyzrot>();
+    node_A->SetMass(0);
+    node_A->GetInertia().setZero();
+    mesh_boundary->AddNode(node_A);
+
+    auto node_B = chrono_types::make_shared<ChNodeFEAxyzrot>(ChFrame<>(ChVector<>(6, 0, 0)));
+    node_B->SetMass(0);
+    node_B->GetInertia().setZero();
+    mesh_boundary->AddNode(node_B);
+
+    ChBuilderBeamEuler builder;
+    builder.BuildBeam(mesh_internal, section, n_elements, node_A, node_B, ChVector<>(0, 1, 0));
+
+    auto base = chrono_types::make_shared<ChBodyEasyBox>(1, 2, 2, 200, false, false);
+    base->SetBodyFixed(true);
+    base->SetPos(ChVector<>(-0.5, 0, 0));
+    assembly->Add(base);
+
+    auto root = chrono_types::make_shared<ChLinkMateGeneric>();
+    root->Initialize(node_A, base, ChFrame<>(ChVector<>(0, 0, 1), QUNIT));
+    assembly->Add(root);
+
+    sys.Setup();
+    sys.Update();
+
+    return assembly;
+}
+
+// Check that two matrices match, relative to the largest entry
+static void CheckMatrix(const ChMatrixDynamic<>& A, const ChMatrixDynamic<>& B, double rtol) {
+    ASSERT_EQ(A.rows(), B.rows());
+    ASSERT_EQ(A.cols(), B.cols());
+    ASSERT_NEAR((A - B).lpNorm<Eigen::Infinity>(), 0.0, rtol * B.lpNorm<Eigen::Infinity>());
+}
+
+TEST(ChModalAssembly, multiple_reduction) {
+    std::vector<int> n_elements = {10, 10, 14};
+
+    // Reduce all assemblies with a single call
+    std::vector<ChSystemNSC> sys(n_elements.size());
+    std::vector<std::shared_ptr<ChModalAssembly>> assemblies;
+    for (size_t i = 0; i < n_elements.size(); i++)
+        assemblies.push_back(CreateCantilever(sys[i], n_elements[i]));
+    ChModalAssembly::SwitchModalReductionON(assemblies, num_modes);
+
+    // Reduce each assembly on its own
+    std::vector<ChSystemNSC> sys_ref(n_elements.size());
+    for (size_t i = 0; i < n_elements.size(); i++) {
+        auto assembly_ref = CreateCantilever(sys_ref[i], n_elements[i]);
+        assembly_ref->SwitchModalReductionON(num_modes);
+
+        ASSERT_TRUE(assemblies[i]->IsModalMode());
+        ASSERT_TRUE(assembly_ref->IsModalMode());
+        ASSERT_EQ(assemblies[i]->Get_n_modes_coords_w(), assembly_ref->Get_n_modes_coords_w());
+        CheckMatrix(assemblies[i]->Get_modal_Psi(), assembly_ref->Get_modal_Psi(), 1e-8);
+        CheckMatrix(assemblies[i]->Get_modal_M(), assembly_ref->Get_modal_M(), 1e-8);
+        CheckMatrix(assemblies[i]->Get_modal_K(), assembly_ref->Get_modal_K(), 1e-8);
+    }
+
+    // The identical assemblies share the same reduction
+    ASSERT_TRUE(assemblies[1]->Get_modal_Psi() == assemblies[0]->Get_modal_Psi());
+    ASSERT_TRUE(assemblies[1]->Get_modal_M() == assemblies[0]->Get_modal_M());
+    ASSERT_TRUE(assemblies[1]->Get_modal_K() == assemblies[0]->Get_modal_K());
+    ASSERT_NE(assemblies[2]->Get_modal_Psi().rows(), assemblies[0]->Get_modal_Psi().rows());
+}
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the batched (SIMD) evaluation of SMC contact forces.
+// Two identical systems are created with a fixed set of contacts (overlapping
+// spheres resting on a fixed box, with non-zero linear and angular velocities).
+// One system uses the batched kernel, the other the per-contact evaluation. The
+// contact forces and torques on all bodies must match up to roundoff, for the
+// supported contact force models and tangential displacement modes.
+//
+// =============================================================================
+
+#include <random>
+#include <tuple>
+
+#include "chrono_multicore/physics/ChSystemMulticore.h"
+#include "chrono_multicore/solver/ChContactKernelsSMC.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+
+typedef std::tuple<ChSystemSMC::ContactForceModel, ChSystemSMC::TangentialDisplacementModel, bool> SIMDParams;
+
+class SIMDContactForceTest : public ::testing::TestWithParam<SIMDParams> {
+  protected:
+    // Create a system with the given contact force evaluation method.
+    ChSystemMulticoreSMC* CreateSystem(bool use_simd);
+};
+
+ChSystemMulticoreSMC* SIMDContactForceTest::CreateSystem(bool use_simd) {
+    auto sys = new ChSystemMulticoreSMC;
+    sys->Set_G_acc(ChVector<>(0, 0, -9.81));
+    sys->SetNumThreads(1);
+    sys->GetSettings()->solver.contact_force_model = std::get<0>(GetParam());
+    sys->GetSettings()->solver.tangential_displ_mode = std::get<1>(GetParam());
+    sys->GetSettings()->solver.use_material_properties = std::get<2>(GetParam());
+    sys->GetSettings()->solver.use_simd_contact_forces = use_simd;
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetYoungModulus(1e7f);
+    mat->SetPoissonRatio(0.3f);
+    mat->SetRestitution(0.2f);
+    mat->SetFriction(0.4f);
+    mat->SetKn(2e5f);
+    mat->SetGn(40);
+    mat->SetKt(2e5f);
+    mat->SetGt(20);
+
+    auto ground = std::shared_ptr<ChBody>(sys->NewBody());
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddBox(mat, 5, 5, 0.5, ChVector<>(0, 0, -0.5));
+    ground->GetCollisionModel()->BuildModel();
+    sys->AddBody(ground);
+
+    // Grid of spheres, slightly overlapping each other and the ground
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    double radius = 0.1;
+    double mass = 1;
+    for (int ix = 0; ix < 5; ix++) {
+        for (int iy = 0; iy < 5; iy++) {
+            for (int iz = 0; iz < 2; iz++) {
+                auto ball = std::shared_ptr<ChBody>(sys->NewBody());
+                ball->SetMass(mass);
+                ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetPos(ChVector<>(ix * 1.99 * radius, iy * 1.99 * radius, radius * (0.99 + iz * 1.98)) +
+                             0.002 * ChVector<>(dist(gen), dist(gen), 0));
+                ball->SetPos_dt(0.1 * ChVector<>(dist(gen), dist(gen), dist(gen)));
+                ball->SetWvel_par(ChVector<>(dist(gen), dist(gen), dist(gen)));
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                ball->GetCollisionModel()->AddSphere(mat, radius);
+                ball->GetCollisionModel()->BuildModel();
+                sys->AddBody(ball);
+            }
+        }
+    }
+
+    return sys;
+}
+
+TEST_P(SIMDContactForceTest, compare) {
+    ASSERT_TRUE(ChContactKernelsSMC::Supports(std::get<0>(GetParam())));
+
+    ChSystemMulticoreSMC* sys_simd = CreateSystem(true);
+    ChSystemMulticoreSMC* sys_scalar = CreateSystem(false);
+
+    // Take a few steps, so that the contact history is also exercised (MultiStep mode)
+    double rtol = 1e-8;
+    for (int step = 0; step < 5; step++) {
+        sys_simd->DoStepDynamics(1e-4);
+        sys_scalar->DoStepDynamics(1e-4);
+
+        ASSERT_GT(sys_simd->GetNumContacts(), 0u);
+        ASSERT_EQ(sys_simd->GetNumContacts(), sys_scalar->GetNumContacts());
+
+        const auto& bodies_simd = sys_simd->Get_bodylist();
+        const auto& bodies_scalar = sys_scalar->Get_bodylist();
+        for (size_t i = 0; i < bodies_simd.size(); i++) {
+            real3 frc_simd = sys_simd->GetBodyContactForce((uint)i);
+            real3 frc_scalar = sys_scalar->GetBodyContactForce((uint)i);
+            real3 trq_simd = sys_simd->GetBodyContactTorque((uint)i);
+            real3 trq_scalar = sys_scalar->GetBodyContactTorque((uint)i);
+            ASSERT_NEAR(Length(frc_simd - frc_scalar), 0.0, rtol * (1 + Length(frc_scalar)));
+            ASSERT_NEAR(Length(trq_simd - trq_scalar), 0.0, rtol * (1 + Length(trq_scalar)));
+            ASSERT_NEAR((bodies_simd[i]->GetPos() - bodies_scalar[i]->GetPos()).Length(), 0.0, 1e-12);
+        }
+    }
+
+    delete sys_simd;
+    delete sys_scalar;
+}
+
+INSTANTIATE_TEST_SUITE_P(ChronoMulticore,
+                         SIMDContactForceTest,
+                         ::testing::Combine(::testing::Values(ChSystemSMC::ContactForceModel::Hooke,
+                                                              ChSystemSMC::ContactForceModel::Hertz),
+                                            ::testing::Values(ChSystemSMC::TangentialDisplacementModel::OneStep,
+                                                              ChSystemSMC::TangentialDisplacementModel::MultiStep),
+                                            ::testing::Bool()));
@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the persistent contact cache of ChContactContainerNSC.
+// A stack of boxes settles on a fixed ground. Once settled, all contacts must be
+// matched to contacts from the previous step and warm starting the solver with
+// the cached multipliers must reduce the number of iterations. Replacing the top
+// box with a new body must not carry over the multipliers of the old one.
+// The test is run with the Bullet collision system (with its persistent contact
+// manifolds disabled, so that the container cache is used) and, if available,
+// with the Chrono collision system.
+//
+// =============================================================================
+
+#include "chrono/ChConfig.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Narrowphase callback which discards the persistent reaction caches of the collision system,
+// so that the contact container cache is used for all contacts.
+class DiscardReactionCache : public ChCollisionSystem::NarrowphaseCallback {
+  public:
+    virtual bool OnNarrowphase(ChCollisionInfo& contactinfo) override {
+        contactinfo.reaction_cache = nullptr;
+        return true;
+    }
+};
+
+// Simulate the box stack with or without contact cache and return the number of solver
+// iterations over a time interval after the stack has settled.
+static void SettleStack(ChCollisionSystemType collision_type, bool use_cache, int& iterations) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(collision_type);
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto narrow_callback = chrono_types::make_shared<DiscardReactionCache>();
+    sys.GetCollisionSystem()->RegisterNarrowphaseCallback(narrow_callback);
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(500);
+    solver->SetTolerance(1e-8);
+    solver->EnableWarmStart(true);
+    sys.SetSolver(solver);
+
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(sys.GetContactContainer());
+    container->EnableContactCache(use_cache);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 1, 4, 1000, mat, collision_type);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::shared_ptr<ChBody> top;
+    for (int i = 0; i < 3; i++) {
+        top = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, mat, collision_type);
+        top->SetPos(ChVector<>(0, 0.25 + i * 0.5, 0));
+        sys.AddBody(top);
+    }
+
+    double step = 1e-3;
+
+    // Let the stack settle
+    while (sys.GetChTime() < 0.5) {
+        sys.DoStepDynamics(step);
+    }
+
+    // Count solver iterations over a time interval
+    iterations = 0;
+    while (sys.GetChTime() < 0.6) {
+        sys.DoStepDynamics(step);
+        iterations += solver->GetIterations();
+
+        ASSERT_GT(container->GetNcontacts(), 0);
+        if (use_cache) {
+            ASSERT_EQ(container->GetNcontactsNew(), 0);
+            ASSERT_EQ(container->GetNcontactsMatched(), container->GetNcontacts());
+        } else {
+            ASSERT_EQ(container->GetNcontactsMatched(), 0);
+        }
+    }
+
+    if (!use_cache)
+        return;
+
+    // Replace the top box with a new body at the same location.
+    // Only the contacts between the two lower boxes and the ground can be matched.
+    int num_contacts = container->GetNcontacts();
+    auto pos = top->GetPos();
+    auto rot = top->GetRot();
+    sys.RemoveBody(top);
+    top.reset();
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, mat, collision_type);
+    box->SetPos(pos);
+    box->SetRot(rot);
+    sys.AddBody(box);
+
+    sys.DoStepDynamics(step);
+    ASSERT_GT(container->GetNcontactsNew(), 0);
+    ASSERT_LT(container->GetNcontactsMatched(), num_contacts);
+}
+
+static void TestContactCache(ChCollisionSystemType collision_type) {
+    int iterations_no_cache = 0;
+    int iterations_cache = 0;
+    SettleStack(collision_type, false, iterations_no_cache);
+    SettleStack(collision_type, true, iterations_cache);
+
+    // The cache must reduce the number of iterations, relative to a cold start.
+    ASSERT_GT(iterations_no_cache, 0);
+    ASSERT_LT(iterations_cache, iterations_no_cache);
+}
+
+TEST(ChContactContainerNSC, contact_cache_bullet) {
+    TestContactCache(ChCollisionSystemType::BULLET);
+}
+
+TEST(ChContactContainerNSC, contact_cache_chrono) {
+#ifndef CHRONO_COLLISION
+    GTEST_SKIP() << "Chrono collision system not available";
+#endif
+
+    TestContactCache(ChCollisionSystemType::CHRONO);
+}
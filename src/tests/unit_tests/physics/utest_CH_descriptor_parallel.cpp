@@ -0,0 +1,168 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the parallel products and projections of ChSystemDescriptor.
+// The system descriptor of a system with frictional contacts and joints is
+// used to compare the results of the serial and parallel implementations of
+// ShurComplementProduct, SystemProduct and ConstraintsProject. In deterministic
+// mode, the results must be bit-compatible with the serial ones.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+class DescriptorParallelTest : public ::testing::TestWithParam<bool> {
+  protected:
+    DescriptorParallelTest();
+
+    ChSystemNSC sys;
+};
+
+DescriptorParallelTest::DescriptorParallelTest() {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+    sys.SetSolverMaxIterations(20);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    // Pile of spheres (frictional contacts)
+    double radius = 0.1;
+    for (int ix = 0; ix < 6; ix++) {
+        for (int iy = 0; iy < 4; iy++) {
+            for (int iz = 0; iz < 6; iz++) {
+                auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, false, true, mat);
+                ball->SetPos(ChVector<>((ix - 3) * 2.01 * radius + 0.01 * iy, (iy + 0.5) * 1.99 * radius,
+                                        (iz - 3) * 2.01 * radius));
+                sys.AddBody(ball);
+            }
+        }
+    }
+
+    // Pendulum chain (bilateral constraints)
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < 10; i++) {
+        auto link = chrono_types::make_shared<ChBody>();
+        link->SetPos(ChVector<>(2 + 0.2 * i, 2, 0));
+        sys.AddBody(link);
+        auto rev = chrono_types::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(link, prev, ChCoordsys<>(ChVector<>(1.9 + 0.2 * i, 2, 0)));
+        sys.AddLink(rev);
+        prev = link;
+    }
+
+    // Advance the system so that the descriptor holds contacts and joints
+    for (int i = 0; i < 20; i++)
+        sys.DoStepDynamics(1e-3);
+}
+
+TEST_P(DescriptorParallelTest, products) {
+    bool deterministic = GetParam();
+    auto descriptor = sys.GetSystemDescriptor();
+
+    int n_q = descriptor->CountActiveVariables();
+    int n_c = descriptor->CountActiveConstraints();
+    ASSERT_GT(n_c, 0);
+
+    ChVectorDynamic<> l(n_c);
+    ChVectorDynamic<> x(n_q + n_c);
+    l.setRandom();
+    x.setRandom();
+
+    // Serial results
+    descriptor->SetNumThreads(1);
+    ChVectorDynamic<> Nl_serial, Zx_serial, Pl_serial(l);
+    descriptor->ShurComplementProduct(Nl_serial, l);
+    descriptor->SystemProduct(Zx_serial, x);
+    descriptor->ConstraintsProject(Pl_serial);
+
+    // Parallel results
+    descriptor->SetNumThreads(4);
+    descriptor->SetParallelThreshold(0);
+    descriptor->EnableDeterministic(deterministic);
+    ChVectorDynamic<> Nl_parallel, Zx_parallel, Pl_parallel(l);
+    descriptor->ShurComplementProduct(Nl_parallel, l);
+    descriptor->SystemProduct(Zx_parallel, x);
+    descriptor->ConstraintsProject(Pl_parallel);
+
+    ASSERT_GT(descriptor->GetNumColors(), 1);
+    ASSERT_LT(descriptor->GetNumColors(), descriptor->GetConstraintsList().size());
+
+    ASSERT_EQ(Nl_serial.size(), Nl_parallel.size());
+    ASSERT_EQ(Zx_serial.size(), Zx_parallel.size());
+
+    if (deterministic) {
+        for (int i = 0; i < n_c; i++)
+            ASSERT_EQ(Nl_serial(i), Nl_parallel(i));
+        for (int i = 0; i < n_q + n_c; i++)
+            ASSERT_EQ(Zx_serial(i), Zx_parallel(i));
+    } else {
+        double tol = 1e-10 * Nl_serial.lpNorm<Eigen::Infinity>();
+        for (int i = 0; i < n_c; i++)
+            ASSERT_NEAR(Nl_serial(i), Nl_parallel(i), tol);
+        tol = 1e-10 * Zx_serial.lpNorm<Eigen::Infinity>();
+        for (int i = 0; i < n_q + n_c; i++)
+            ASSERT_NEAR(Zx_serial(i), Zx_parallel(i), tol);
+    }
+
+    for (int i = 0; i < n_c; i++)
+        ASSERT_EQ(Pl_serial(i), Pl_parallel(i));
+}
+
+TEST_P(DescriptorParallelTest, schedule_reuse) {
+    auto descriptor = sys.GetSystemDescriptor();
+    descriptor->SetNumThreads(4);
+    descriptor->SetParallelThreshold(0);
+    descriptor->EnableDeterministic(GetParam());
+
+    // Re-inserting the same constraints keeps the schedule
+    ChVectorDynamic<> l(descriptor->CountActiveConstraints());
+    ChVectorDynamic<> Nl1, Nl2;
+    l.setRandom();
+    descriptor->ShurComplementProduct(Nl1, l);
+    auto num_colors = descriptor->GetNumColors();
+
+    auto constraints = descriptor->GetConstraintsList();
+    auto variables = descriptor->GetVariablesList();
+    descriptor->BeginInsertion();
+    for (auto c : constraints)
+        descriptor->InsertConstraint(c);
+    for (auto v : variables)
+        descriptor->InsertVariables(v);
+    descriptor->EndInsertion();
+
+    descriptor->ShurComplementProduct(Nl2, l);
+    ASSERT_EQ(descriptor->GetNumColors(), num_colors);
+    for (int i = 0; i < l.size(); i++)
+        ASSERT_EQ(Nl1(i), Nl2(i));
+
+    // Below the size threshold, the serial implementation is used
+    descriptor->SetParallelThreshold((int)constraints.size() + 1);
+    descriptor->ShurComplementProduct(Nl2, l);
+    for (int i = 0; i < l.size(); i++)
+        ASSERT_NEAR(Nl1(i), Nl2(i), 1e-10 * Nl1.lpNorm<Eigen::Infinity>());
+}
+
+INSTANTIATE_TEST_SUITE_P(ChSystemDescriptor, DescriptorParallelTest, ::testing::Values(true, false));
@@ -0,0 +1,136 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit tests for island decomposition.
+// - The island mode of the parallel PSOR solver is compared against the serial
+//   PSOR solver on a system made of independent stacks of spheres and pendulum
+//   chains. With a fixed number of iterations, the results must match.
+// - With sleeping enabled, bodies connected through contacts (a resting stack)
+//   must fall asleep together, while an unconnected falling body stays awake.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSORparallel.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Create independent sub-systems (stacks of spheres and pendulum chains) on a common fixed ground
+static void CreateIslands(ChSystemNSC& sys, int num_stacks, int num_chains) {
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 0.2, 20, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    double radius = 0.1;
+    for (int is = 0; is < num_stacks; is++) {
+        for (int iy = 0; iy < 3; iy++) {
+            auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, false, true, mat);
+            ball->SetPos(ChVector<>(-8 + is * 0.5 + 0.01 * iy, (iy + 0.5) * 1.99 * radius, 0));
+            sys.AddBody(ball);
+        }
+    }
+
+    for (int ic = 0; ic < num_chains; ic++) {
+        std::shared_ptr<ChBody> prev = ground;
+        for (int i = 0; i < 4; i++) {
+            auto link = chrono_types::make_shared<ChBody>();
+            link->SetPos(ChVector<>(0.2 * i, 4, -8 + ic * 0.5));
+            sys.AddBody(link);
+            auto rev = chrono_types::make_shared<ChLinkLockRevolute>();
+            rev->Initialize(link, prev, ChCoordsys<>(ChVector<>(0.2 * i - 0.1, 4, -8 + ic * 0.5)));
+            sys.AddLink(rev);
+            prev = link;
+        }
+    }
+}
+
+TEST(ChSolverPSORparallel, islands) {
+    int num_stacks = 8;
+    int num_chains = 6;
+    int num_iterations = 30;
+
+    ChSystemNSC sys_serial;
+    CreateIslands(sys_serial, num_stacks, num_chains);
+    sys_serial.SetSolverType(ChSolver::Type::PSOR);
+    sys_serial.SetSolverMaxIterations(num_iterations);
+    sys_serial.SetSolverTolerance(0);
+
+    ChSystemNSC sys_islands;
+    CreateIslands(sys_islands, num_stacks, num_chains);
+    sys_islands.SetSolverType(ChSolver::Type::PSOR_PARALLEL);
+    sys_islands.SetSolverMaxIterations(num_iterations);
+    sys_islands.SetSolverTolerance(0);
+    auto solver = std::static_pointer_cast<ChSolverPSORparallel>(sys_islands.GetSolver());
+    solver->SetNumThreads(4);
+    solver->EnableIslands(true);
+
+    for (int i = 0; i < 50; i++) {
+        sys_serial.DoStepDynamics(1e-3);
+        sys_islands.DoStepDynamics(1e-3);
+    }
+
+    // One island per stack (contacts with the fixed ground do not connect stacks) and per chain
+    ASSERT_EQ(solver->GetNumIslands(), num_stacks + num_chains);
+    ASSERT_EQ(solver->GetIterations(), num_iterations);
+
+    const auto& bodies_serial = sys_serial.Get_bodylist();
+    const auto& bodies_islands = sys_islands.Get_bodylist();
+    ASSERT_EQ(bodies_serial.size(), bodies_islands.size());
+    for (size_t i = 0; i < bodies_serial.size(); i++) {
+        ASSERT_NEAR((bodies_serial[i]->GetPos() - bodies_islands[i]->GetPos()).Length(), 0.0, 1e-10);
+        ASSERT_NEAR((bodies_serial[i]->GetPos_dt() - bodies_islands[i]->GetPos_dt()).Length(), 0.0, 1e-8);
+    }
+}
+
+TEST(ChSystem, sleeping_islands) {
+    ChSystemNSC sys;
+    sys.SetUseSleeping(true);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.6f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 0.2, 20, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    // Stack of two resting boxes
+    auto bottom = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, false, true, mat);
+    bottom->SetPos(ChVector<>(0, 0.25, 0));
+    sys.AddBody(bottom);
+
+    auto top = chrono_types::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, false, true, mat);
+    top->SetPos(ChVector<>(0, 0.75, 0));
+    sys.AddBody(top);
+
+    // Box falling far from the stack
+    auto falling = chrono_types::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, false, true, mat);
+    falling->SetPos(ChVector<>(5, 20, 0));
+    sys.AddBody(falling);
+
+    while (sys.GetChTime() < 1.5)
+        sys.DoStepDynamics(1e-2);
+
+    ASSERT_TRUE(bottom->GetSleeping());
+    ASSERT_TRUE(top->GetSleeping());
+    ASSERT_FALSE(falling->GetSleeping());
+}
@@ -0,0 +1,115 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for reuse of the Newton matrix across steps in the HHT integrator.
+// A pendulum chain is simulated with and without Jacobian reuse, using a sparse
+// direct solver with locked sparsity pattern. The two trajectories must match
+// to within the integration tolerance, with fewer matrix factorizations and a
+// single symbolic analysis when reusing the Newton matrix.
+//
+// =============================================================================
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+class PendulumChain {
+  public:
+    PendulumChain(bool reuse);
+
+    void Simulate(double step, int num_steps);
+
+    std::shared_ptr<ChBody> GetLastLink() const { return m_links.back(); }
+    int GetNumSetups() const { return m_num_setups; }
+    int GetNumSolves() const { return m_num_solves; }
+    std::shared_ptr<ChSolverSparseLU> GetSolver() const { return m_solver; }
+
+  private:
+    ChSystemNSC m_sys;
+    std::shared_ptr<ChTimestepperHHT> m_integrator;
+    std::shared_ptr<ChSolverSparseLU> m_solver;
+    std::vector<std::shared_ptr<ChBody>> m_links;
+    int m_num_setups;
+    int m_num_solves;
+};
+
+PendulumChain::PendulumChain(bool reuse) : m_num_setups(0), m_num_solves(0) {
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    m_sys.AddBody(ground);
+
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < 5; i++) {
+        auto link = chrono_types::make_shared<ChBody>();
+        link->SetMass(1);
+        link->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        link->SetPos(ChVector<>(0.5 + i, 0, 0));
+        m_sys.AddBody(link);
+
+        auto rev = chrono_types::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(link, prev, ChCoordsys<>(ChVector<>(i, 0, 0)));
+        m_sys.AddLink(rev);
+
+        m_links.push_back(link);
+        prev = link;
+    }
+
+    m_solver = chrono_types::make_shared<ChSolverSparseLU>();
+    m_solver->LockSparsityPattern(true);
+    m_sys.SetSolver(m_solver);
+
+    m_sys.SetTimestepperType(ChTimestepper::Type::HHT);
+    m_integrator = std::static_pointer_cast<ChTimestepperHHT>(m_sys.GetTimestepper());
+    m_integrator->SetAlpha(-0.2);
+    m_integrator->SetMaxiters(20);
+    m_integrator->SetAbsTolerances(1e-8);
+    m_integrator->SetRelTolerance(1e-6);
+    m_integrator->SetStepControl(false);
+    m_integrator->SetModifiedNewton(true);
+    m_integrator->SetJacobianReuse(reuse);
+}
+
+void PendulumChain::Simulate(double step, int num_steps) {
+    for (int i = 0; i < num_steps; i++) {
+        m_sys.DoStepDynamics(step);
+        m_num_setups += m_integrator->GetNumSetupCalls();
+        m_num_solves += m_integrator->GetNumSolveCalls();
+    }
+}
+
+TEST(ChTimestepperHHT, jacobian_reuse) {
+    PendulumChain ref(false);
+    PendulumChain reuse(true);
+
+    ref.Simulate(1e-3, 1000);
+    reuse.Simulate(1e-3, 1000);
+
+    std::cout << "Default: setups = " << ref.GetNumSetups() << "  solves = " << ref.GetNumSolves() << std::endl;
+    std::cout << "Reuse:   setups = " << reuse.GetNumSetups() << "  solves = " << reuse.GetNumSolves() << std::endl;
+    std::cout << "Reuse:   symbolic analyses = " << reuse.GetSolver()->GetNumAnalyzeCalls()
+              << "  factorizations = " << reuse.GetSolver()->GetNumSetupCalls() << std::endl;
+
+    ASSERT_LT(reuse.GetNumSetups(), ref.GetNumSetups());
+    ASSERT_EQ(reuse.GetSolver()->GetNumAnalyzeCalls(), 1);
+    ASSERT_EQ(ref.GetSolver()->GetNumAnalyzeCalls(), 1);
+
+    auto pos_ref = ref.GetLastLink()->GetPos();
+    auto pos_reuse = reuse.GetLastLink()->GetPos();
+    ASSERT_NEAR((pos_ref - pos_reuse).Length(), 0.0, 1e-3);
+}
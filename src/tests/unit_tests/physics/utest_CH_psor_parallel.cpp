@@ -0,0 +1,119 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the parallel PSOR solver.
+// Two identical systems with stacks of boxes settle on a fixed ground using the
+// serial PSOR solver. The same step is then solved with the serial PSOR solver
+// and with the parallel (colored) PSOR solver, using the same tolerance. The
+// sweep orders differ, so the results are not bit-identical, but both solvers
+// must reach the requested constraint violation and produce the same contact
+// reaction forces on all bodies (up to the solver tolerance).
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverPSORparallel.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static const int num_stacks = 3;
+static const int num_boxes = 3;
+static const double tolerance = 1e-7;
+
+// Create stacks of boxes on a common fixed ground
+static void CreateStacks(ChSystemNSC& sys) {
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 0.2, 20, 1000, false, true, mat);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    for (int is = 0; is < num_stacks; is++) {
+        for (int ib = 0; ib < num_boxes; ib++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, false, true, mat);
+            box->SetPos(ChVector<>(-3 + 2.0 * is, 0.25 + ib * 0.5, 0));
+            sys.AddBody(box);
+        }
+    }
+}
+
+TEST(ChSolverPSORparallel, stacks) {
+    ChSystemNSC sys_serial;
+    ChSystemNSC sys_parallel;
+    CreateStacks(sys_serial);
+    CreateStacks(sys_parallel);
+    sys_serial.SetSolverType(ChSolver::Type::PSOR);
+    sys_parallel.SetSolverType(ChSolver::Type::PSOR);
+
+    // Let both stacks settle with the serial solver (identical trajectories)
+    while (sys_serial.GetChTime() < 0.3) {
+        sys_serial.DoStepDynamics(1e-3);
+        sys_parallel.DoStepDynamics(1e-3);
+    }
+
+    // Solve the next step with the serial and parallel solvers
+    auto solver_serial = chrono_types::make_shared<ChSolverPSOR>();
+    solver_serial->SetMaxIterations(5000);
+    solver_serial->SetTolerance(tolerance);
+    solver_serial->EnableWarmStart(true);
+    sys_serial.SetSolver(solver_serial);
+
+    auto solver_parallel = chrono_types::make_shared<ChSolverPSORparallel>();
+    solver_parallel->SetMaxIterations(5000);
+    solver_parallel->SetTolerance(tolerance);
+    solver_parallel->EnableWarmStart(true);
+    solver_parallel->SetNumThreads(4);
+    sys_parallel.SetSolver(solver_parallel);
+
+    sys_serial.DoStepDynamics(1e-3);
+    sys_parallel.DoStepDynamics(1e-3);
+
+    // Both solvers converged to the same tolerance
+    ASSERT_LT(solver_serial->GetIterations(), solver_serial->GetMaxIterations());
+    ASSERT_LT(solver_parallel->GetIterations(), solver_parallel->GetMaxIterations());
+    ASSERT_LE(solver_serial->GetError(), tolerance);
+    ASSERT_LE(solver_parallel->GetError(), tolerance);
+    ASSERT_GT(solver_parallel->GetNumColors(), 1);
+
+    // Contact reactions match on all bodies
+    const auto& bodies_serial = sys_serial.Get_bodylist();
+    const auto& bodies_parallel = sys_parallel.Get_bodylist();
+    ASSERT_EQ(bodies_serial.size(), bodies_parallel.size());
+    ASSERT_EQ(sys_serial.GetNcontacts(), sys_parallel.GetNcontacts());
+
+    for (size_t i = 0; i < bodies_serial.size(); i++) {
+        ChVector<> frc_serial = bodies_serial[i]->GetContactForce();
+        ChVector<> frc_parallel = bodies_parallel[i]->GetContactForce();
+        ASSERT_NEAR((frc_serial - frc_parallel).Length(), 0.0, 1e-3 * frc_serial.Length());
+        ASSERT_NEAR((bodies_serial[i]->GetPos() - bodies_parallel[i]->GetPos()).Length(), 0.0, 1e-8);
+    }
+
+    // Once settled, the net contact force on each box balances its weight
+    // (up to the stabilization terms used to recover penetrations)
+    for (int is = 0; is < num_stacks; is++) {
+        for (int ib = 0; ib < num_boxes; ib++) {
+            const auto& box = bodies_parallel[1 + is * num_boxes + ib];
+            double weight = box->GetMass() * 9.81;
+            ASSERT_NEAR(box->GetContactForce().y(), weight, 5e-2 * weight);
+        }
+    }
+}
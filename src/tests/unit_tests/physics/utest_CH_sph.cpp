@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for the SPH proximity container.
+// The densities and forces accumulated over the neighbor lists are compared
+// against a pairwise O(N^2) evaluation, for SPH nodes with non-uniform kernel
+// radii (the kernel radius of a pair is the average of the two node radii).
+// Results must be identical with 1 and several threads.
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/physics/ChMatterSPH.h"
+#include "chrono/physics/ChProximityContainerSPH.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+class SPHTest {
+  public:
+    SPHTest(int num_threads);
+
+    void Evaluate();
+
+    const std::vector<std::shared_ptr<ChNodeSPH>>& GetNodes() const { return m_fluid->GetNodes(); }
+
+  private:
+    ChSystemNSC m_sys;
+    std::shared_ptr<ChMatterSPH> m_fluid;
+    std::shared_ptr<ChProximityContainerSPH> m_container;
+};
+
+SPHTest::SPHTest(int num_threads) {
+    m_sys.SetNumThreads(num_threads);
+
+    m_fluid = chrono_types::make_shared<ChMatterSPH>();
+    m_fluid->SetCollide(false);
+    m_fluid->GetMaterial().Set_viscosity(0.5);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (int i = 0; i < 1500; i++)
+        m_fluid->AddNode(ChVector<>(0.4 * dist(gen), 0.4 * dist(gen), 0.2 * dist(gen)));
+    for (const auto& node : m_fluid->GetNodes()) {
+        node->SetMass(0.01 * (1 + dist(gen)));
+        node->SetKernelRadius(0.04 * (1 + dist(gen)));
+        node->SetPos_dt(ChVector<>(dist(gen) - 0.5, dist(gen) - 0.5, dist(gen) - 0.5));
+    }
+    m_sys.Add(m_fluid);
+
+    m_container = chrono_types::make_shared<ChProximityContainerSPH>();
+    m_sys.Add(m_container);
+}
+
+void SPHTest::Evaluate() {
+    for (const auto& node : GetNodes())
+        node->density = 0;
+    m_container->AccumulateStep1();
+
+    for (const auto& node : GetNodes()) {
+        node->volume = node->GetMass() / node->density;
+        node->pressure = 100 * (node->density - 1);
+        node->UserForce = VNULL;
+    }
+    m_container->AccumulateStep2();
+}
+
+TEST(ChProximityContainerSPH, pairwise) {
+    SPHTest test(4);
+    test.Evaluate();
+    const auto& nodes = test.GetNodes();
+    double viscosity = 0.5;
+
+    for (const auto& A : nodes) {
+        double density = 0;
+        ChVector<> force(0);
+        for (const auto& B : nodes) {
+            if (B == A)
+                continue;
+            ChVector<> r = B->GetPos() - A->GetPos();
+            double d = r.Length();
+            double h = 0.5 * (A->GetKernelRadius() + B->GetKernelRadius());
+            if (d >= h)
+                continue;
+            double h3 = h * h * h;
+            density += B->GetMass() * (315.0 / (64.0 * CH_C_PI * h3 * h3 * h3)) * std::pow(h * h - d * d, 3);
+            double W_press = -(45.0 / (CH_C_PI * h3 * h3)) * (h - d) * (h - d);
+            force += r * (W_press * A->volume * 0.5 * (A->pressure + B->pressure) * B->volume);
+            double W_visc = (45.0 / (CH_C_PI * h3 * h3)) * (h - d);
+            force += (B->GetPos_dt() - A->GetPos_dt()) * (A->volume * viscosity * B->volume * W_visc);
+        }
+        ASSERT_GT(density, 0);
+        ASSERT_NEAR(A->density, density, 1e-10 * density);
+        ASSERT_NEAR((A->UserForce - force).Length(), 0.0, 1e-10 * (1 + force.Length()));
+    }
+}
+
+TEST(ChProximityContainerSPH, threads) {
+    SPHTest test1(1);
+    SPHTest testN(4);
+    test1.Evaluate();
+    testN.Evaluate();
+
+    const auto& nodes1 = test1.GetNodes();
+    const auto& nodesN = testN.GetNodes();
+    ASSERT_EQ(nodes1.size(), nodesN.size());
+    for (size_t i = 0; i < nodes1.size(); i++) {
+        ASSERT_EQ(nodes1[i]->density, nodesN[i]->density);
+        ASSERT_EQ(nodes1[i]->UserForce, nodesN[i]->UserForce);
+    }
+}
@@ -0,0 +1,128 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2022 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Unit test for paging of SCM grid node tiles.
+// A fixed box pressed into the soil deforms the nodes of a single tile. The box
+// is then moved away (the tile is paged out to file) and finally brought back
+// partially overlapping its first footprint (the tile is paged back in). The
+// terrain heights and the list of modified nodes must be preserved at every
+// stage for the nodes which the box does not touch again.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <map>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/physics/ChBodyEasy.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const double delta = 0.04;  // SCM grid spacing
+static const double step = 1e-3;   // integration step size
+
+// Collect the modified nodes of the SCM terrain, keyed by their grid indices.
+static std::map<std::pair<int, int>, double> GetNodes(const SCMDeformableTerrain& terrain) {
+    std::map<std::pair<int, int>, double> nodes;
+    for (const auto& n : terrain.GetModifiedNodes(true))
+        nodes[std::make_pair(n.first.x(), n.first.y())] = n.second;
+    return nodes;
+}
+
+// Sample the terrain height on a regular set of points in the region [x_min, x_max] x [y_min, y_max].
+static std::vector<double> GetHeights(const SCMDeformableTerrain& terrain,
+                                      double x_min,
+                                      double x_max,
+                                      double y_min,
+                                      double y_max) {
+    std::vector<double> heights;
+    for (double x = x_min; x <= x_max; x += delta / 3)
+        for (double y = y_min; y <= y_max; y += delta / 3)
+            heights.push_back(terrain.GetHeight(ChVector<>(x, y, 1)));
+    return heights;
+}
+
+TEST(SCMDeformableTerrain, tile_paging) {
+    std::string page_file = "scm_paging_test.dat";
+
+    {
+        ChSystemSMC sys;
+        sys.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+        // SCM terrain, with tiles farther than 0.1 m from the moving patch paged out
+        auto terrain = chrono_types::make_shared<SCMDeformableTerrain>(&sys, false);
+        terrain->SetSoilParameters(2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+        terrain->Initialize(8.0, 4.0, delta);
+        terrain->EnableTilePaging(page_file, 0.1);
+
+        // Fixed box pressed into the soil. With TILE_SIZE = 32, the footprint of the box (x in [-2.17, -1.67],
+        // y in [0.35, 0.85]) lies entirely in the tile with grid indices x in [-64, -33] and y in [0, 31].
+        auto material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.2, 1000, false, true, material);
+        box->SetBodyFixed(true);
+        sys.Add(box);
+        terrain->AddMovingPatch(box, VNULL, ChVector<>(0.6, 0.6, 0.6));
+
+        // Press the box 3 cm into the soil, then lift it to unload the soil
+        box->SetPos(ChVector<>(-1.92, 0.6, 0.1 - 0.03));
+        for (int i = 0; i < 5; i++)
+            sys.DoStepDynamics(step);
+        box->SetPos(ChVector<>(-1.92, 0.6, 0.5));
+        sys.DoStepDynamics(step);
+
+        auto nodes1 = GetNodes(*terrain);
+        auto heights1 = GetHeights(*terrain, -2.2, -1.64, 0.32, 0.88);
+        ASSERT_FALSE(nodes1.empty());
+        ASSERT_EQ(terrain->GetNumPagedTiles(), 0);
+        int num_tiles = terrain->GetNumTiles();
+
+        // Move the box far away: the deformed tiles are paged out and remain accessible
+        box->SetPos(ChVector<>(2.0, -1.0, 0.5));
+        sys.DoStepDynamics(step);
+
+        ASSERT_EQ(terrain->GetNumTiles(), num_tiles);
+        ASSERT_EQ(terrain->GetNumPagedTiles(), num_tiles);
+        EXPECT_EQ(GetNodes(*terrain), nodes1);
+        EXPECT_EQ(GetHeights(*terrain, -2.2, -1.64, 0.32, 0.88), heights1);
+
+        // Press the box again, shifted by 30 cm along x: the tile is paged back in
+        box->SetPos(ChVector<>(-1.62, 0.6, 0.1 - 0.03));
+        for (int i = 0; i < 5; i++)
+            sys.DoStepDynamics(step);
+
+        ASSERT_EQ(terrain->GetNumPagedTiles(), 0);
+
+        // Nodes of the first footprint left of the new moving patch (x < -1.92) must be unchanged
+        auto nodes3 = GetNodes(*terrain);
+        int num_checked = 0;
+        for (const auto& n : nodes1) {
+            if (n.first.first * delta >= -1.95)
+                continue;
+            auto n3 = nodes3.find(n.first);
+            ASSERT_TRUE(n3 != nodes3.end());
+            EXPECT_EQ(n3->second, n.second);
+            num_checked++;
+        }
+        EXPECT_GT(num_checked, 0);
+        auto heights3 = GetHeights(*terrain, -2.2, -1.96, 0.32, 0.88);
+        EXPECT_EQ(std::vector<double>(heights1.begin(), heights1.begin() + heights3.size()), heights3);
+    }
+
+    std::remove(page_file.c_str());
+}